@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# This software is part of OpenMono, see http://developer.openmono.com
+# Released under the MIT license, see LICENSE.txt
+
+"""
+Convert a TrueType/OpenType or BDF font to an anti-aliased Mono font (AAFont),
+as a C++ header file to include in an application.
+
+Usage: font2aafont.py [-s size] [-n name] [--first 32] [--last 126] font target.h
+
+TrueType fonts are rasterized at the given pixel size with 8-bit coverage,
+that is quantized to 4 bits per pixel. Kerning pairs are measured for all
+characters in the range. BDF fonts are bitmap fonts, their pixels become
+either fully background or fully foreground, and they have no kerning.
+
+TrueType conversion requires the Pillow imaging library (pip install Pillow).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+class Glyph(object):
+    def __init__(self, width, height, advance, x_offset, y_offset, pixels):
+        self.width = width
+        self.height = height
+        self.advance = advance
+        self.x_offset = x_offset
+        self.y_offset = y_offset     # from baseline to glyph top, negative is up
+        self.pixels = pixels         # row-first 4-bit coverage values
+
+
+def quantize(value):
+    return (value * 15 + 127) // 255
+
+
+def load_truetype(path, size, chars):
+    try:
+        from PIL import ImageFont
+    except ImportError:
+        sys.stderr.write("ERROR: font2aafont needs the Pillow module: pip install Pillow\n")
+        sys.exit(1)
+
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+
+    glyphs = {}
+    for ch in chars:
+        left, top, right, bottom = font.getbbox(ch)
+        advance = int(round(font.getlength(ch)))
+        if right <= left or bottom <= top:
+            glyphs[ch] = Glyph(0, 0, advance, 0, 0, [])
+            continue
+
+        mask = font.getmask(ch, mode='L')
+        width, height = mask.size
+        pixels = [quantize(mask.getpixel((x, y))) for y in range(height) for x in range(width)]
+        glyphs[ch] = Glyph(width, height, advance, left, top - ascent, pixels)
+
+    kerning = []
+    for a in chars:
+        for b in chars:
+            adjust = int(round(font.getlength(a + b) - font.getlength(a) - font.getlength(b)))
+            if adjust != 0:
+                kerning.append((ord(a), ord(b), max(-128, min(127, adjust))))
+
+    return glyphs, kerning, ascent + descent, ascent
+
+
+def load_bdf(path, chars):
+    glyphs = {}
+    ascent = descent = 0
+    wanted = set(ord(c) for c in chars)
+
+    with open(path) as bdf:
+        lines = iter(bdf.read().splitlines())
+
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == 'FONT_ASCENT':
+            ascent = int(fields[1])
+        elif fields[0] == 'FONT_DESCENT':
+            descent = int(fields[1])
+        elif fields[0] == 'STARTCHAR':
+            code, advance, bbx, rows = -1, 0, (0, 0, 0, 0), []
+            for line in lines:
+                fields = line.split()
+                if fields[0] == 'ENCODING':
+                    code = int(fields[1])
+                elif fields[0] == 'DWIDTH':
+                    advance = int(fields[1])
+                elif fields[0] == 'BBX':
+                    bbx = tuple(int(v) for v in fields[1:5])
+                elif fields[0] == 'BITMAP':
+                    for line in lines:
+                        if line.startswith('ENDCHAR'):
+                            break
+                        rows.append(int(line.strip(), 16) if line.strip() else 0)
+                    break
+
+            if code not in wanted:
+                continue
+
+            width, height, x_off, y_off = bbx
+            row_bits = ((width + 7) // 8) * 8
+            pixels = []
+            for row in rows[:height]:
+                for x in range(width):
+                    pixels.append(15 if row & (1 << (row_bits - 1 - x)) else 0)
+            glyphs[chr(code)] = Glyph(width, height, advance, x_off, -(y_off + height), pixels)
+
+    for ch in chars:
+        if ch not in glyphs:
+            glyphs[ch] = Glyph(0, 0, 0, 0, 0, [])
+
+    return glyphs, [], ascent + descent, ascent
+
+
+def pack(pixels):
+    data = bytearray()
+    for i in range(0, len(pixels), 2):
+        low = pixels[i + 1] if i + 1 < len(pixels) else 0
+        data.append((pixels[i] << 4) | low)
+    return data
+
+
+def write_header(target, source, name, chars, glyphs, kerning, y_advance, ascent):
+    guard = re.sub(r'[^A-Za-z0-9]', '_', os.path.basename(target))
+    bitmap = bytearray()
+    glyph_lines = []
+    for ch in chars:
+        g = glyphs[ch]
+        glyph_lines.append("    { %5i, %3i, %3i, %3i, %4i, %4i }, // '%s'"
+                           % (len(bitmap), g.width, g.height, g.advance, g.x_offset, g.y_offset,
+                              ch if ch not in "\\'" else '\\' + ch))
+        bitmap += pack(g.pixels)
+
+    with open(target, 'w') as out:
+        out.write("// Generated by font2aafont.py from %s\n\n" % os.path.basename(source))
+        out.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+        out.write("#include <aafont.h>\n\n")
+
+        out.write("static const uint8_t %sBitmap[%i] = {\n" % (name, max(1, len(bitmap))))
+        rows = [', '.join('0x%02X' % b for b in bitmap[i:i+16]) for i in range(0, len(bitmap), 16)]
+        out.write('    ' + (',\n    '.join(rows) if rows else '0x00'))
+        out.write("\n};\n\n")
+
+        out.write("static const AAGlyph %sGlyphs[%i] = {\n" % (name, len(chars)))
+        out.write('\n'.join(glyph_lines))
+        out.write("\n};\n\n")
+
+        kerning_ref = '0'
+        if kerning:
+            out.write("static const AAKernPair %sKerning[%i] = {\n" % (name, len(kerning)))
+            out.write(',\n'.join("    { %i, %i, %i }" % k for k in sorted(kerning)))
+            out.write("\n};\n\n")
+            kerning_ref = '%sKerning' % name
+
+        out.write("const AAFont %s = { %sBitmap, %sGlyphs, %s, %i, %i, %i, %i, %i };\n\n"
+                  % (name, name, name, kerning_ref, len(kerning),
+                     ord(chars[0]), ord(chars[-1]), y_advance, ascent))
+        out.write("#endif\n")
+
+    return len(bitmap)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert TTF/BDF fonts to anti-aliased Mono fonts")
+    parser.add_argument('-s', '--size', type=int, default=16, help="TrueType pixel size (default 16)")
+    parser.add_argument('-n', '--name', help="C++ symbol name (default is derived from file name)")
+    parser.add_argument('--first', type=int, default=32, help="first character code (default 32)")
+    parser.add_argument('--last', type=int, default=126, help="last character code (default 126)")
+    parser.add_argument('source', help="source font (.ttf, .otf or .bdf)")
+    parser.add_argument('target', help="target header file")
+    args = parser.parse_args()
+
+    chars = [chr(c) for c in range(args.first, args.last + 1)]
+    if args.source.lower().endswith('.bdf'):
+        glyphs, kerning, y_advance, ascent = load_bdf(args.source, chars)
+    else:
+        glyphs, kerning, y_advance, ascent = load_truetype(args.source, args.size, chars)
+
+    name = args.name
+    if not name:
+        base = os.path.splitext(os.path.basename(args.source))[0]
+        name = re.sub(r'[^A-Za-z0-9]', '', base) + (str(args.size) if not args.source.lower().endswith('.bdf') else '') + 'AA'
+
+    size = write_header(args.target, args.source, name, chars, glyphs, kerning, y_advance, ascent)
+    print("Converted %s to %s: %i glyphs, %i kerning pairs, %i bitmap bytes"
+          % (args.source, args.target, len(chars), len(kerning), size))
+
+
+if __name__ == '__main__':
+    main()
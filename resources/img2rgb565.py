@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+# This software is part of OpenMono, see http://developer.openmono.com
+# Released under the MIT license, see LICENSE.txt
+
+"""
+Convert a PNG or BMP image to the native Mono RGB565 image format (.565),
+that can be displayed with mono::media::RGB565Image and ImageView.
+
+Usage: img2rgb565.py [-b background] source.png target.565
+
+The file layout is: the magic bytes 'M565', width and height as 16-bit little
+endian, followed by all pixels as 16-bit little endian RGB565 values in
+top-down rows without padding.
+
+Transparent pixels are composited onto the background color (default black).
+Requires the Pillow imaging library (pip install Pillow).
+"""
+
+import argparse
+import struct
+import sys
+
+try:
+    from PIL import Image
+except ImportError:
+    sys.stderr.write("ERROR: img2rgb565 needs the Pillow module: pip install Pillow\n")
+    sys.exit(1)
+
+MAGIC = b'M565'
+MAX_SIZE = 0xFFFF
+
+
+def parse_color(text):
+    text = text.lstrip('#')
+    if len(text) != 6:
+        raise argparse.ArgumentTypeError("color must be on the form RRGGBB")
+    return tuple(int(text[i:i+2], 16) for i in (0, 2, 4))
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def convert(source, target, background):
+    img = Image.open(source).convert('RGBA')
+    width, height = img.size
+    if width > MAX_SIZE or height > MAX_SIZE:
+        raise ValueError("image is too large: %ix%i" % (width, height))
+
+    canvas = Image.new('RGBA', img.size, background + (255,))
+    canvas.alpha_composite(img)
+
+    pixels = bytearray()
+    for r, g, b, _ in canvas.getdata():
+        pixels += struct.pack('<H', rgb565(r, g, b))
+
+    with open(target, 'wb') as out:
+        out.write(MAGIC)
+        out.write(struct.pack('<HH', width, height))
+        out.write(pixels)
+
+    return width, height
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert PNG/BMP images to Mono RGB565 images")
+    parser.add_argument('-b', '--background', type=parse_color, default=(0, 0, 0),
+                        help="background color for transparent pixels, as RRGGBB")
+    parser.add_argument('source', help="source image (PNG or BMP)")
+    parser.add_argument('target', help="target .565 file")
+    args = parser.parse_args()
+
+    width, height = convert(args.source, args.target, args.background)
+    print("Converted %s to %s (%ix%i)" % (args.source, args.target, width, height))
+
+
+if __name__ == '__main__':
+    main()
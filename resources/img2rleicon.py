@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# This software is part of OpenMono, see http://developer.openmono.com
+# Released under the MIT license, see LICENSE.txt
+
+"""
+Convert a PNG image to a run-length compressed Mono icon (MonoRleIcon), as a
+C++ header file to include in an application or the framework.
+
+Usage: img2rleicon.py [-n name] source.png target.h
+
+The blend value of each pixel is taken from the alpha channel. Images without
+alpha use the inverted luminance, such that dark pixels become foreground.
+
+The run data is a sequence of runs. Each run starts with a header byte: the
+upper 2 bits is the run type (0x00: background, 0x40: foreground, 0x80:
+blended) and the lower 6 bits is the run length minus one. Blended runs are
+followed by one blend value per pixel.
+
+Requires the Pillow imaging library (pip install Pillow).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+RUN_BACKGROUND = 0x00
+RUN_FOREGROUND = 0x40
+RUN_BLENDED = 0x80
+MAX_RUN = 64
+
+
+def encode(alphas):
+    """Run-length encode a flat list of 8-bit blend values"""
+    runs = bytearray()
+    i = 0
+    count = len(alphas)
+    while i < count:
+        value = alphas[i]
+        start = i
+        if value in (0, 255):
+            while i < count and i - start < MAX_RUN and alphas[i] == value:
+                i += 1
+            kind = RUN_BACKGROUND if value == 0 else RUN_FOREGROUND
+            runs.append(kind | (i - start - 1))
+        else:
+            while i < count and i - start < MAX_RUN and alphas[i] not in (0, 255):
+                i += 1
+            runs.append(RUN_BLENDED | (i - start - 1))
+            runs += bytes(alphas[start:i])
+    return runs
+
+
+def decode(runs):
+    """Inverse of encode, used to verify the output"""
+    alphas = []
+    i = 0
+    while i < len(runs):
+        header = runs[i]
+        i += 1
+        length = (header & 0x3F) + 1
+        kind = header & 0xC0
+        if kind == RUN_BACKGROUND:
+            alphas += [0] * length
+        elif kind == RUN_FOREGROUND:
+            alphas += [255] * length
+        else:
+            alphas += list(runs[i:i+length])
+            i += length
+    return alphas
+
+
+def symbol_name(path):
+    """speaker-16.png -> speaker16Rle, like the img2icon naming"""
+    base = os.path.splitext(os.path.basename(path))[0]
+    parts = [p for p in re.split(r'[^A-Za-z0-9]+', base) if p]
+    name = parts[0] + ''.join(p[:1].upper() + p[1:] for p in parts[1:])
+    return name + 'Rle'
+
+
+def load_alphas(source):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.stderr.write("ERROR: img2rleicon needs the Pillow module: pip install Pillow\n")
+        sys.exit(1)
+
+    img = Image.open(source)
+    if 'A' in img.getbands() or 'transparency' in img.info:
+        alphas = list(img.convert('RGBA').getchannel('A').getdata())
+    else:
+        alphas = [255 - v for v in img.convert('L').getdata()]
+    return img.size, alphas
+
+
+def write_header(target, source, name, size, runs):
+    guard = re.sub(r'[^A-Za-z0-9]', '_', os.path.basename(target))
+    lines = []
+    for i in range(0, len(runs), 16):
+        lines.append('    ' + ', '.join('0x%02X' % b for b in runs[i:i+16]))
+
+    with open(target, 'w') as out:
+        out.write("// Generated by img2rleicon.py from %s\n\n" % os.path.basename(source))
+        out.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+        out.write("#include <mono_icon.h>\n\n")
+        out.write("static const uint8_t %sRuns[%i] = {\n" % (name, len(runs)))
+        out.write(',\n'.join(lines))
+        out.write("\n};\n\n")
+        out.write("const mono::display::MonoRleIcon %s = { %i, %i, %i, %sRuns };\n\n"
+                  % (name, size[0], size[1], len(runs), name))
+        out.write("#endif\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert PNG images to compressed Mono icons")
+    parser.add_argument('-n', '--name', help="C++ symbol name (default is derived from file name)")
+    parser.add_argument('source', help="source image (PNG)")
+    parser.add_argument('target', help="target header file")
+    args = parser.parse_args()
+
+    size, alphas = load_alphas(args.source)
+    runs = encode(alphas)
+    if len(runs) > 0xFFFF or decode(runs) != alphas:
+        sys.stderr.write("ERROR: cannot compress %s\n" % args.source)
+        sys.exit(1)
+
+    name = args.name or symbol_name(args.source)
+    write_header(args.target, args.source, name, size, runs)
+    print("Converted %s to %s: %i bytes, uncompressed %i bytes"
+          % (args.source, args.target, len(runs), len(alphas)))
+
+
+if __name__ == '__main__':
+    main()
@@ -365,7 +365,7 @@ void ACT8600PowerSystem::reg1Interrupts(uint32_t diff)
 
     if (diff < FaultTolerenceUs)
     {
-        mono::Timer::callOnce<ACT8600PowerSystem>(1, this, &ACT8600PowerSystem::reg1InterruptFollowup);
+        mono::asyncAfter<ACT8600PowerSystem>(1, this, &ACT8600PowerSystem::reg1InterruptFollowup);
         return;
     }
 
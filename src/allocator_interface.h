@@ -0,0 +1,38 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef mono_allocator_interface_h
+#define mono_allocator_interface_h
+
+#include <stdint.h>
+
+namespace mono {
+
+    /**
+     * @brief Abstract interface for memory allocators, like fixed size pools
+     *
+     * Framework classes that allocate on your behalf, like @ref make_managed_in,
+     * can take an allocator instead of using `malloc` and `free`. This lets you
+     * serve frequent, equally sized allocations from a pool, to avoid HEAP
+     * fragmentation.
+     */
+    class IAllocator
+    {
+    public:
+
+        /**
+         * @brief Allocate a block of memory, aligned to 8 bytes
+         * @param size The number of bytes to allocate
+         * @return Pointer to the block, or `NULL` if no memory is available
+         */
+        virtual void *allocate(uint32_t size) = 0;
+
+        /**
+         * @brief Return a block to the allocator
+         * @param block A block returned by @ref allocate
+         */
+        virtual void deallocate(void *block) = 0;
+    };
+}
+
+#endif /* mono_allocator_interface_h */
@@ -8,6 +8,9 @@
 #include <us_ticker_api.h>
 #include "rtc_interface.h"
 #include "scheduled_task.h"
+#include "heap_monitor.h"
+#include "tracer.h"
+#include "log_sink.h"
 #include <consoles.h>
 
 #ifdef DEVICE_SERIAL
@@ -62,24 +65,36 @@ void AppRunLoop::process()
         }
     }
 
+    HeapMonitor::newIteration();
+
     uint32_t start = us_ticker_read();
 
     //handle touch inputs
+    MONO_TRACE_BEGIN("touch");
     if (IApplicationContext::Instance->TouchSystem != NULL)
         IApplicationContext::Instance->TouchSystem->processTouchInput();
+    MONO_TRACE_END("touch");
 
     uint32_t tEnd = us_ticker_read();
 
-    //run dynamic tasks
+    //run deferred calls and dynamic tasks
+    MONO_TRACE_BEGIN("deferred calls");
+    DeferredCalls.process(tEnd);
+    MONO_TRACE_END("deferred calls");
     processDynamicTaskQueue();
 
     // run scheduled tasks
+    MONO_TRACE_BEGIN("scheduled tasks");
     ScheduledTask::processScheduledTasks();
+    MONO_TRACE_END("scheduled tasks");
     
     uint32_t end = us_ticker_read();
 
     TouchSystemTime = tEnd - start;
     DynamicTaskQueueTime = end - tEnd;
+
+    // write a few buffered log messages, to keep the iteration short
+    LogSink::Default().drain(4);
 }
 
 void AppRunLoop::CheckUsbDtr()
@@ -97,7 +112,11 @@ void AppRunLoop::processDynamicTaskQueue()
 
     IRunLoopTask *task = taskQueueHead;
     while (task != NULL) {
+        // the handler may delete the task, so the name is read before
+        const char *name = task->taskName();
+        MONO_TRACE_BEGIN(name);
         task->taskHandler();
+        MONO_TRACE_END(name);
 
         if (task->singleShot)
         {
@@ -8,6 +8,7 @@
 #include <application_run_loop_task_interface.h>
 #include <mn_digital_out.h>
 #include <deprecated.h>
+#include "deferred_call_queue.h"
 
 namespace mono {
     
@@ -116,6 +117,16 @@ namespace mono {
          * queue. Expect that the majority of your code are executed here.
          */
         uint32_t DynamicTaskQueueTime;
+
+        /**
+         * @brief The callbacks queued by @ref async and @ref asyncAfter
+         *
+         * The queue is processed in every run loop iteration, just before
+         * the dynamic task queue. Its time is included in
+         * @ref DynamicTaskQueueTime. You can read its overflow and latency
+         * counters, to tune your application.
+         */
+        DeferredCallQueue DeferredCalls;
         
         
         AppRunLoop();
@@ -57,6 +57,14 @@ namespace mono {
          * take some time.
          */
         virtual void taskHandler() = 0;
+
+        /**
+         * The name of the task, used to label its span in the trace of the
+         * run loop. Override this to tell tasks apart in the trace.
+         *
+         * @return A static string, that outlives the task
+         */
+        virtual const char *taskName() const { return "run loop task"; }
         
     };
 }
@@ -0,0 +1,26 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "async.h"
+#include "application_context_interface.h"
+#include <us_ticker_api.h>
+
+using namespace mono;
+
+bool mono::asyncCall(const mbed::FunctionPointer &handler, const void *owner, uint32_t delayMs)
+{
+    DeferredCallQueue &queue = IApplicationContext::Instance->RunLoop->DeferredCalls;
+    uint32_t now = us_ticker_read();
+
+    // a full queue counts the overflow, we may be in an interrupt and
+    // cannot allocate a timer instead
+    if (delayMs == 0)
+        return queue.post(handler, owner, now);
+
+    return queue.postDelayed(handler, owner, delayMs*1000, now);
+}
+
+int mono::cancelAsync(const void *cnxt)
+{
+    return IApplicationContext::Instance->RunLoop->DeferredCalls.cancel(cnxt);
+}
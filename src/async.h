@@ -4,10 +4,25 @@
 #ifndef async_h
 #define async_h
 
-#include "mn_timer.h"
+#include "deferred_call_queue.h"
 
 namespace mono {
 
+    /**
+     * @brief Queue a callback on the run loop, see @ref async
+     *
+     * The callback is placed in the run loop's @ref DeferredCallQueue. If the
+     * queue is full, the callback is dropped and counted in
+     * @ref DeferredCallQueue::Overflows. Nothing is allocated, so this is safe
+     * in interrupt routines.
+     *
+     * @param handler The callback
+     * @param owner The object the callback belongs to, used by @ref cancelAsync
+     * @param delayMs The delay in milliseconds, `0` for the next run loop iteration
+     * @return `false` if the queue was full and the callback is dropped
+     */
+    bool asyncCall(const mbed::FunctionPointer &handler, const void *owner, uint32_t delayMs);
+
     /**
      * @brief Call a C++ function/member asynchronously
      * 
@@ -22,26 +37,25 @@ namespace mono {
      * async<AppClass>(this, &MyClass::methodToCall);
      * @endcode
      *
-     * This function uses the @ref Timer to schedule the function call on the 
-     * run loop.
+     * The call is stored in a fixed size queue in the run loop, and does not
+     * allocate any memory. It is safe to call `async` from interrupt routines.
+     * If the same method on the same object is already waiting, the call is
+     * not queued again. If the queue is full, the call is dropped and `async`
+     * returns `false`.
      *
      * ## Aborting
      *
-     * You are able to abort the function call, as long the the function has not
-     * executed. This `async` function returns a pointer to the underlying
-     * @ref Timer object. You can use this pointer to *Stop* the @ref Timer.
-     * *Note* that when the timer executes it is dealloced, to you pointer is
-     * not be valid at that point. Normally you can only expect the pointer to 
-     * be valid in the same stack frame, as it was created.
+     * You can remove pending calls with @ref cancelAsync, for example in the
+     * destructor of the context object.
      *
      * @param cnxt The context pointer, normally `this`
      * @param method A pointer to the member function on the *Context* class.
-     * @return A pointer to the @ref Timer object that will execute the async call
+     * @return `false` if the queue was full and the call is dropped
      */
     template <typename Context>
-    Timer* async(Context *cnxt, void(Context::*method)(void))
+    bool async(Context *cnxt, void(Context::*method)(void))
     {
-        return Timer::callOnce<Context>(0, cnxt, method);
+        return asyncCall(DeferredCallQueue::handler(cnxt, method), cnxt, 0);
     }
 
     /**
@@ -57,25 +71,59 @@ namespace mono {
      * async(&MyClass::MyStaticFunction);
      * @endcode
      *
-     * This function uses the @ref Timer to schedule the function call on the
-     * run loop.
+     * The call is stored in a fixed size queue in the run loop, and does not
+     * allocate any memory. It is safe to call `async` from interrupt routines.
+     * If the queue is full, the call is dropped and `async` returns `false`.
      *
-     * ## Aborting
+     * @param cFunction A pointer to the C function.
+     * @return `false` if the queue was full and the call is dropped
+     */
+    inline bool async(void(*cFunction)(void))
+    {
+        return asyncCall(DeferredCallQueue::handler(cFunction), 0, 0);
+    }
+
+    /**
+     * @brief Call a C++ function/member on the run loop, after a delay
+     *
+     * Like @ref async, but the call is made no earlier than `delayMs` from
+     * now. Delayed calls share a timer heap in the run loop, and do not
+     * allocate memory or use a hardware ticker each.
+     *
+     * @code
+     * asyncAfter<MyClass>(250, this, &MyClass::methodToCall);
+     * @endcode
      *
-     * You are able to abort the function call, as long the the function has not
-     * executed. This `async` function returns a pointer to the underlying
-     * @ref Timer object. You can use this pointer to *Stop* the @ref Timer.
-     * *Note* that when the timer executes it is dealloced, to you pointer is
-     * not be valid at that point. Normally you can only expect the pointer to
-     * be valid in the same stack frame, as it was created.
+     * @param delayMs The delay in milliseconds
+     * @param cnxt The context pointer, normally `this`
+     * @param method A pointer to the member function on the *Context* class.
+     * @return `false` if the timer heap was full and the call is dropped
+     */
+    template <typename Context>
+    bool asyncAfter(uint32_t delayMs, Context *cnxt, void(Context::*method)(void))
+    {
+        return asyncCall(DeferredCallQueue::handler(cnxt, method), cnxt, delayMs);
+    }
+
+    /**
+     * @brief Call a C function on the run loop, after a delay
      *
+     * @param delayMs The delay in milliseconds
      * @param cFunction A pointer to the C function.
-     * @return A pointer to the @ref Timer object that will execute the async call
+     * @return `false` if the timer heap was full and the call is dropped
      */
-    inline Timer* async(void(*cFunction)(void))
+    inline bool asyncAfter(uint32_t delayMs, void(*cFunction)(void))
     {
-        return Timer::callOnce(0, cFunction);
+        return asyncCall(DeferredCallQueue::handler(cFunction), 0, delayMs);
     }
+
+    /**
+     * @brief Remove pending @ref async and @ref asyncAfter calls to an object
+     *
+     * @param cnxt The context object, given to `async`
+     * @return The number of calls removed
+     */
+    int cancelAsync(const void *cnxt);
 }
 
 #endif /* async_h */
@@ -0,0 +1,425 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+//
+// Host benchmark runner. Each benchmark is warmed up, then timed in a
+// number of samples. A sample calls the benchmark enough times to take at
+// least the minimum sample time, and the time per call is recorded.
+// Results are printed as a table, and optionally written as JSON and
+// compared against a stored baseline. Timings are compared by their
+// minimum, which is the least disturbed by other load on the machine.
+// Operation counts reported with countOperations are compared exactly.
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace bench;
+
+namespace {
+
+    struct Benchmark
+    {
+        const char *suite;
+        const char *name;
+        BenchmarkFunction function;
+    };
+
+    struct Result
+    {
+        std::string suite, name;
+        uint64_t callsPerSample;
+        uint32_t samples;
+        uint64_t operations;
+        double minNs, meanNs, p50Ns, p90Ns, p99Ns;
+    };
+
+    struct Options
+    {
+        const char *filter;
+        const char *jsonPath;
+        const char *baselinePath;
+        uint32_t samples;
+        uint32_t warmupMs;
+        uint32_t sampleUs;
+        double tolerancePercent;
+        bool compareTime, compareOperations;
+        bool list;
+
+        Options() : filter(0), jsonPath(0), baselinePath(0), samples(25),
+            warmupMs(50), sampleUs(2000), tolerancePercent(15),
+            compareTime(true), compareOperations(true), list(false) {}
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    uint64_t operationCount = 0;
+
+    std::vector<Benchmark> &registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    double elapsedNs(Clock::time_point start, Clock::time_point end)
+    {
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    // nearest rank percentile of sorted values
+    double percentile(const std::vector<double> &sorted, double percent)
+    {
+        size_t rank = (size_t) (percent / 100.0 * sorted.size() + 0.5);
+        if (rank < 1)
+            rank = 1;
+        if (rank > sorted.size())
+            rank = sorted.size();
+        return sorted[rank - 1];
+    }
+
+    Result run(const Benchmark &benchmark, const Options &options)
+    {
+        // count the operations of a single call
+        operationCount = 0;
+        benchmark.function();
+        uint64_t operations = operationCount;
+
+        // warm up caches and estimate the time per call
+        uint64_t calls = 0;
+        Clock::time_point start = Clock::now();
+        Clock::time_point now = start;
+        double warmupNs = options.warmupMs * 1e6;
+        do
+        {
+            benchmark.function();
+            calls++;
+            if ((calls & 0x0F) == 0 || calls < 16)
+                now = Clock::now();
+        } while (elapsedNs(start, now) < warmupNs);
+
+        double perCallNs = elapsedNs(start, now) / calls;
+        uint64_t batch = (uint64_t) (options.sampleUs * 1000.0 / perCallNs);
+        if (batch < 1)
+            batch = 1;
+
+        std::vector<double> samples;
+        for (uint32_t s=0; s<options.samples; s++)
+        {
+            Clock::time_point begin = Clock::now();
+            for (uint64_t i=0; i<batch; i++)
+                benchmark.function();
+            Clock::time_point end = Clock::now();
+
+            samples.push_back(elapsedNs(begin, end) / batch);
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.suite = benchmark.suite;
+        result.name = benchmark.name;
+        result.callsPerSample = batch;
+        result.samples = options.samples;
+        result.operations = operations;
+        result.minNs = samples.front();
+        result.meanNs = 0;
+        for (size_t i=0; i<samples.size(); i++)
+            result.meanNs += samples[i];
+        result.meanNs /= samples.size();
+        result.p50Ns = percentile(samples, 50);
+        result.p90Ns = percentile(samples, 90);
+        result.p99Ns = percentile(samples, 99);
+        return result;
+    }
+
+    // MARK: JSON
+
+    void writeJsonString(FILE *out, const std::string &str)
+    {
+        fputc('"', out);
+        for (size_t i=0; i<str.size(); i++)
+        {
+            if (str[i] == '"' || str[i] == '\\')
+                fputc('\\', out);
+            fputc(str[i], out);
+        }
+        fputc('"', out);
+    }
+
+    bool writeJson(const char *path, const std::vector<Result> &results)
+    {
+        FILE *out = fopen(path, "w");
+        if (out == 0)
+        {
+            fprintf(stderr, "Could not write %s\n", path);
+            return false;
+        }
+
+        fprintf(out, "{\"benchmarks\":[");
+        for (size_t i=0; i<results.size(); i++)
+        {
+            const Result &r = results[i];
+            fprintf(out, i == 0 ? "\n  {\"suite\":" : ",\n  {\"suite\":");
+            writeJsonString(out, r.suite);
+            fprintf(out, ",\"name\":");
+            writeJsonString(out, r.name);
+            fprintf(out, ",\"calls_per_sample\":%llu,\"samples\":%u,\"operations\":%llu,"
+                    "\"min_ns\":%.2f,\"mean_ns\":%.2f,\"p50_ns\":%.2f,\"p90_ns\":%.2f,\"p99_ns\":%.2f}",
+                    (unsigned long long) r.callsPerSample, r.samples,
+                    (unsigned long long) r.operations, r.minNs, r.meanNs, r.p50Ns, r.p90Ns, r.p99Ns);
+        }
+        fprintf(out, "\n]}\n");
+        fclose(out);
+        return true;
+    }
+
+    // reads a string value after "key": in a JSON object, no escapes needed
+    bool readJsonString(const char *object, const char *key, std::string &value)
+    {
+        std::string pattern = std::string("\"") + key + "\":\"";
+        const char *start = strstr(object, pattern.c_str());
+        if (start == 0)
+            return false;
+
+        start += pattern.size();
+        value.clear();
+        for (const char *c = start; *c != 0 && *c != '"'; c++)
+        {
+            if (*c == '\\' && c[1] != 0)
+                c++;
+            value += *c;
+        }
+        return true;
+    }
+
+    bool readJsonNumber(const char *object, const char *key, double &value)
+    {
+        std::string pattern = std::string("\"") + key + "\":";
+        const char *start = strstr(object, pattern.c_str());
+        if (start == 0)
+            return false;
+
+        value = strtod(start + pattern.size(), 0);
+        return true;
+    }
+
+    // loads results written by writeJson, one benchmark per object
+    bool readBaseline(const char *path, std::vector<Result> &baseline)
+    {
+        FILE *in = fopen(path, "r");
+        if (in == 0)
+            return false;
+
+        std::string content;
+        char buffer[512];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), in)) > 0)
+            content.append(buffer, count);
+        fclose(in);
+
+        size_t pos = 0;
+        while ((pos = content.find("{\"suite\":", pos)) != std::string::npos)
+        {
+            size_t end = content.find('}', pos);
+            std::string object = content.substr(pos, end - pos);
+
+            Result result;
+            double operations = 0;
+            if (readJsonString(object.c_str(), "suite", result.suite) &&
+                readJsonString(object.c_str(), "name", result.name) &&
+                readJsonNumber(object.c_str(), "min_ns", result.minNs))
+            {
+                readJsonNumber(object.c_str(), "operations", operations);
+                result.operations = (uint64_t) operations;
+                baseline.push_back(result);
+            }
+
+            pos = end;
+        }
+
+        return true;
+    }
+
+    // returns the number of regressions
+    int compare(const std::vector<Result> &results, const std::vector<Result> &baseline,
+                const Options &options)
+    {
+        int regressions = 0;
+        printf("\nCompared to baseline (");
+        if (options.compareTime)
+            printf("min time, tolerance %.0f%%%s", options.tolerancePercent,
+                   options.compareOperations ? ", " : "");
+        if (options.compareOperations)
+            printf("operations, exact");
+        printf("):\n");
+
+        for (size_t i=0; i<results.size(); i++)
+        {
+            const Result &r = results[i];
+            const Result *base = 0;
+            for (size_t b=0; b<baseline.size(); b++)
+            {
+                if (baseline[b].suite == r.suite && baseline[b].name == r.name)
+                    base = &baseline[b];
+            }
+
+            if (base == 0)
+            {
+                printf("  %-12s %-36s new\n", r.suite.c_str(), r.name.c_str());
+                continue;
+            }
+
+            double change = (r.minNs / base->minNs - 1.0) * 100.0;
+            bool slower = options.compareTime && change > options.tolerancePercent;
+            bool moreWork = options.compareOperations && r.operations > base->operations;
+            if (slower || moreWork)
+                regressions++;
+
+            printf("  %-12s %-36s", r.suite.c_str(), r.name.c_str());
+            if (options.compareTime)
+                printf(" %+7.1f%%", change);
+            if (options.compareOperations && (r.operations > 0 || base->operations > 0))
+                printf(" %8llu -> %llu ops", (unsigned long long) base->operations,
+                       (unsigned long long) r.operations);
+            else if (!options.compareTime)
+                printf("        -");
+            printf("%s\n", slower || moreWork ? "  REGRESSION" : "");
+        }
+
+        return regressions;
+    }
+
+    void usage(const char *program)
+    {
+        printf("Usage: %s [options]\n"
+               "  --filter <text>       Only run benchmarks with text in suite or name\n"
+               "  --samples <n>         Number of timed samples (default 25)\n"
+               "  --warmup-ms <n>       Warm-up time per benchmark (default 50)\n"
+               "  --sample-us <n>       Minimum time of a sample (default 2000)\n"
+               "  --json <file>         Write results as JSON\n"
+               "  --baseline <file>     Compare with results from --json, fail on regressions\n"
+               "  --tolerance <percent> Allowed slowdown of the min time (default 15)\n"
+               "  --compare <what>      Compare 'time', 'operations' or 'all' (default)\n"
+               "  --list                List benchmarks without running them\n",
+               program);
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for (int i=1; i<argc; i++)
+        {
+            const char *arg = argv[i];
+            const char *value = i+1 < argc ? argv[i+1] : 0;
+
+            if (strcmp(arg, "--list") == 0)
+            {
+                options.list = true;
+                continue;
+            }
+
+            if (value == 0)
+                return false;
+
+            if (strcmp(arg, "--filter") == 0)
+                options.filter = value;
+            else if (strcmp(arg, "--samples") == 0)
+                options.samples = atoi(value) > 0 ? atoi(value) : 1;
+            else if (strcmp(arg, "--warmup-ms") == 0)
+                options.warmupMs = atoi(value);
+            else if (strcmp(arg, "--sample-us") == 0)
+                options.sampleUs = atoi(value);
+            else if (strcmp(arg, "--json") == 0)
+                options.jsonPath = value;
+            else if (strcmp(arg, "--baseline") == 0)
+                options.baselinePath = value;
+            else if (strcmp(arg, "--tolerance") == 0)
+                options.tolerancePercent = atof(value);
+            else if (strcmp(arg, "--compare") == 0)
+            {
+                options.compareTime = strcmp(value, "time") == 0 || strcmp(value, "all") == 0;
+                options.compareOperations = strcmp(value, "operations") == 0 || strcmp(value, "all") == 0;
+                if (!options.compareTime && !options.compareOperations)
+                    return false;
+            }
+            else
+                return false;
+
+            i++;
+        }
+
+        return true;
+    }
+}
+
+void bench::countOperations(uint64_t operations)
+{
+    operationCount += operations;
+}
+
+Registration::Registration(const char *suite, const char *name, BenchmarkFunction function)
+{
+    Benchmark benchmark = { suite, name, function };
+    registry().push_back(benchmark);
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Result> results;
+    if (!options.list)
+        printf("%-12s %-36s %10s %10s %10s %10s %10s\n", "suite", "benchmark",
+               "p50 ns", "p90 ns", "p99 ns", "min ns", "ops");
+
+    for (size_t i=0; i<registry().size(); i++)
+    {
+        const Benchmark &benchmark = registry()[i];
+        if (options.filter != 0 && strstr(benchmark.suite, options.filter) == 0 &&
+            strstr(benchmark.name, options.filter) == 0)
+            continue;
+
+        if (options.list)
+        {
+            printf("%s / %s\n", benchmark.suite, benchmark.name);
+            continue;
+        }
+
+        Result r = run(benchmark, options);
+        printf("%-12s %-36s %10.1f %10.1f %10.1f %10.1f %10llu\n", r.suite.c_str(), r.name.c_str(),
+               r.p50Ns, r.p90Ns, r.p99Ns, r.minNs, (unsigned long long) r.operations);
+        fflush(stdout);
+        results.push_back(r);
+    }
+
+    if (options.jsonPath != 0 && !writeJson(options.jsonPath, results))
+        return 2;
+
+    if (options.baselinePath != 0)
+    {
+        std::vector<Result> baseline;
+        if (!readBaseline(options.baselinePath, baseline))
+        {
+            printf("\nNo baseline at %s, record one with --json\n", options.baselinePath);
+            return 2;
+        }
+
+        int regressions = compare(results, baseline, options);
+        if (regressions > 0)
+        {
+            printf("%i benchmark(s) are slower than the baseline!\n", regressions);
+            return 1;
+        }
+    }
+
+    return 0;
+}
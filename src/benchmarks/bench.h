@@ -0,0 +1,72 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef bench_h
+#define bench_h
+
+#include <stdint.h>
+
+namespace bench {
+
+    /** @brief A benchmark body, runs the measured operation once */
+    typedef void (*BenchmarkFunction)();
+
+    /**
+     * @brief Adds a benchmark to the runner, use the @ref BENCHMARK macro
+     */
+    class Registration
+    {
+    public:
+        Registration(const char *suite, const char *name, BenchmarkFunction function);
+    };
+
+    /**
+     * @brief Keep the compiler from optimizing a value away
+     *
+     * Pass the result of the measured operation, if it is not used otherwise.
+     */
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * Timings depend on the machine and its load, operation counts do not.
+     * Report the work a call does, like the bus transfers counted by the
+     * @ref HeadlessDisplayController, and the runner compares it exactly
+     * with the baseline.
+     *
+     * @brief Count operations done by one call of the benchmark
+     */
+    void countOperations(uint64_t operations);
+
+    /** @brief Keep the compiler from assuming memory is unchanged */
+    inline void clobberMemory()
+    {
+        asm volatile("" : : : "memory");
+    }
+}
+
+#define BENCH_CONCAT2(a, b) a ## b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT2(a, b)
+
+/**
+ * Define a benchmark. The body is one run of the measured operation, the
+ * runner calls it many times and reports the time per call.
+ *
+ * @code
+ * BENCHMARK("String", "copy short")
+ * {
+ *     String copy(shortString);
+ *     bench::doNotOptimize(copy);
+ * }
+ * @endcode
+ */
+#define BENCHMARK(suite, name) \
+    static void BENCH_CONCAT(benchFunction, __LINE__)(); \
+    static bench::Registration BENCH_CONCAT(benchRegistration, __LINE__)( \
+        suite, name, &BENCH_CONCAT(benchFunction, __LINE__)); \
+    static void BENCH_CONCAT(benchFunction, __LINE__)()
+
+#endif /* bench_h */
@@ -0,0 +1,86 @@
+# This software is part of OpenMono, see http://developer.openmono.com
+# Released under the MIT license, see LICENSE.txt
+
+##
+## List all (implementation) source files to be benchmarked here
+##
+BENCH_SOURCES := \
+	queue.cpp \
+	deferred_call_queue.cpp \
+	mn_string.cpp \
+	ref_count.cpp \
+	string_builder.cpp \
+	date_time.cpp \
+	regex.cpp \
+	slre.c \
+	point.cpp \
+	size.cpp \
+	rect.cpp \
+	circle.cpp \
+	display/color.cpp \
+	display/text_render.cpp \
+	display/display_painter.cpp \
+	display/sprite_cache.cpp \
+	display/headless/headless_display_controller.cpp \
+	display/ui/view.cpp \
+	display/ui/animation.cpp \
+	display/ui/easing.cpp \
+	display/ui/frame_scheduler.cpp \
+	display/ui/image_view.cpp \
+	media/bmp_image.cpp \
+	media/rgb565_image.cpp
+
+BENCH_PATH := $(FRAMEWORK_PATH)/benchmarks
+BENCH_BASELINE ?= $(BENCH_PATH)/baseline.json
+# The committed baseline is from another machine, so only its operation
+# counts are compared by default. Timings are compared by bench-ci, against a
+# baseline it records on this machine.
+BENCH_COMPARE ?= operations
+BENCH_ARGS ?=
+# The revision whose timings bench-ci compares with, e.g. the pull request's
+# target branch
+BENCH_CI_BASE ?= HEAD^
+BENCH_CI_DIR := $(BUILD_DIR)/bench-ci
+
+# The views paint on the headless display of the unit tests' host context
+bench-libsources := $(FRAMEWORK_PATH)/unittests/lib/host_context.cpp $(wildcard $(BENCH_PATH)/lib/*.cpp)
+bench-libheaders := $(wildcard $(BENCH_PATH)/lib/*.h)
+bench-sources := $(wildcard $(BENCH_PATH)/*.cpp) $(wildcard $(BENCH_PATH)/*.h)
+
+## Run the benchmarks, and fail if they do more work than the stored baseline
+bench: $(BUILD_DIR)/bench
+	$< --json $(BUILD_DIR)/bench.json --baseline $(BENCH_BASELINE) --compare $(BENCH_COMPARE) $(BENCH_ARGS)
+
+## Run the benchmarks, and store the results as the new baseline
+bench-baseline: $(BUILD_DIR)/bench
+	$< --json $(BENCH_BASELINE) $(BENCH_ARGS)
+
+## Run the benchmarks of BENCH_CI_BASE and then of this tree, and fail if this
+## tree is slower or does more work than the stored baseline
+bench-ci: bench
+	$(RM) -r $(BENCH_CI_DIR)
+	mkdir -p $(BENCH_CI_DIR)/base
+	git archive $(BENCH_CI_BASE) | tar -x -C $(BENCH_CI_DIR)/base
+	$(MAKE) -C $(BENCH_CI_DIR)/base bench-baseline \
+		BENCH_BASELINE=$(abspath $(BENCH_CI_DIR))/baseline.json BENCH_ARGS="$(BENCH_ARGS)"
+	$(BUILD_DIR)/bench --json $(BENCH_CI_DIR)/bench.json \
+		--baseline $(BENCH_CI_DIR)/baseline.json --compare time $(BENCH_ARGS)
+
+# The CMSIS headers, reached through the mbed headers, use the register
+# keyword that C++17 removed. They are vendor headers, so they are included
+# as system headers, without warnings.
+$(BUILD_DIR)/bench: $(bench-libsources) $(bench-sources) $(bench-libheaders) \
+		$(foreach SOURCE,$(BENCH_SOURCES),$(FRAMEWORK_PATH)/$(SOURCE))
+	-mkdir -p $(BUILD_DIR)
+	g++ -O2 -Wall -Wno-unused-result -DEMUNO \
+		-isystem $(FRAMEWORK_PATH)/cypress/psoc5 \
+		-I $(BENCH_PATH) \
+		-I $(FRAMEWORK_PATH)/unittests/lib \
+		$(INCS) \
+		-o $@ \
+		$(filter %.cpp,$^) \
+		-x c $(filter %.c,$^) -x none
+
+.PHONY: bench bench-baseline bench-ci bench-clean
+bench-clean:
+	$(RM) -r $(BUILD_DIR)/bench $(BUILD_DIR)/bench.json $(BENCH_CI_DIR)
@@ -0,0 +1,107 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "../display/color.h"
+
+using namespace mono::display;
+
+namespace {
+
+    // a scanline of the display, with varying colors
+    struct Scanline
+    {
+        Color pixels[176];
+        uint16_t raw[176];
+        uint16_t target[176];
+
+        /** An anti-aliased edge, like in icons and glyphs */
+        uint8_t mask[176];
+
+        Scanline()
+        {
+            for (int i=0; i<176; i++)
+            {
+                pixels[i] = Color(i, 255-i, i*3);
+                raw[i] = pixels[i].value;
+                target[i] = Color(255-i, i, 128).value;
+                mask[i] = (i*37) & 0xFF;
+            }
+        }
+    };
+
+    Scanline &scanline()
+    {
+        static Scanline instance;
+        return instance;
+    }
+}
+
+BENCHMARK("Color", "alphaBlend scanline")
+{
+    Color *pixels = scanline().pixels;
+    Color overlay(255, 0, 0);
+    for (int i=0; i<176; i++)
+        bench::doNotOptimize(pixels[i].alphaBlend(128, overlay));
+}
+
+BENCHMARK("Color", "alphaBlend mask scanline")
+{
+    Scanline &line = scanline();
+    Color foreground(255, 255, 255), background(44, 62, 80);
+    for (int i=0; i<176; i++)
+        line.target[i] = foreground.alphaBlend(line.mask[i], background).value;
+    bench::doNotOptimize(line.target[175]);
+}
+
+BENCHMARK("Color", "blendMask scanline")
+{
+    Scanline &line = scanline();
+    Color::blendMask(line.target, line.mask, Color(255, 255, 255), Color(44, 62, 80), 176);
+    bench::doNotOptimize(line.target[175]);
+}
+
+BENCHMARK("Color", "blendMask gamma scanline")
+{
+    Scanline &line = scanline();
+    Color::blendMask(line.target, line.mask, Color(255, 255, 255), Color(44, 62, 80), 176,
+                     Color::GammaAlphaTable);
+    bench::doNotOptimize(line.target[175]);
+}
+
+BENCHMARK("Color", "blendSpan scanline")
+{
+    Scanline &line = scanline();
+    Color::blendSpan(line.target, line.raw, 128, 176);
+    bench::doNotOptimize(line.target[175]);
+}
+
+BENCHMARK("Color", "fillBlend scanline")
+{
+    Scanline &line = scanline();
+    Color::fillBlend(line.target, Color(255, 0, 0), 128, 176);
+    bench::doNotOptimize(line.target[175]);
+}
+
+BENCHMARK("Color", "blendMultiply scanline")
+{
+    Color *pixels = scanline().pixels;
+    Color tint(200, 200, 255);
+    for (int i=0; i<176; i++)
+        bench::doNotOptimize(pixels[i].blendMultiply(tint));
+}
+
+BENCHMARK("Color", "blendAdditive scanline")
+{
+    Color *pixels = scanline().pixels;
+    Color glow(16, 16, 16);
+    for (int i=0; i<176; i++)
+        bench::doNotOptimize(pixels[i].blendAdditive(glow));
+}
+
+BENCHMARK("Color", "scale scanline")
+{
+    Color *pixels = scanline().pixels;
+    for (int i=0; i<176; i++)
+        bench::doNotOptimize(pixels[i].scale(100));
+}
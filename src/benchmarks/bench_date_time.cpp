@@ -0,0 +1,33 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "../date_time.h"
+
+using namespace mono;
+
+static DateTime timestamp(2017, 6, 14, 13, 37, 42, DateTime::UTC_TIME_ZONE);
+
+BENCHMARK("DateTime", "toISO8601")
+{
+    String str = timestamp.toISO8601();
+    bench::doNotOptimize(str);
+}
+
+BENCHMARK("DateTime", "toString format")
+{
+    String str = timestamp.toString("%H:%M:%S");
+    bench::doNotOptimize(str);
+}
+
+BENCHMARK("DateTime", "fromISO8601")
+{
+    DateTime parsed = DateTime::fromISO8601("2017-06-14T13:37:42Z");
+    bench::doNotOptimize(parsed);
+}
+
+BENCHMARK("DateTime", "addSeconds")
+{
+    DateTime later = timestamp.addSeconds(3600);
+    bench::doNotOptimize(later);
+}
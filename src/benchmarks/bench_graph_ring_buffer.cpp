@@ -0,0 +1,68 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "../display/ui/graph_ring_buffer.h"
+
+using namespace mono::ui;
+
+namespace {
+
+    GraphRingBuffer<1024> &filledBuffer()
+    {
+        static GraphRingBuffer<1024> buffer(2048);
+        static bool filled = false;
+        if (!filled)
+        {
+            for (int i=0; i<1024; i++)
+                buffer.append((i * 37) % 4096 - 2048);
+            filled = true;
+        }
+        return buffer;
+    }
+
+    // the same data behind the default IGraphViewDataSource::SampleRange
+    class ScanningSource : public IGraphViewDataSource
+    {
+    public:
+        int DataPoint(int index) { return filledBuffer().DataPoint(index); }
+        int BufferLength() { return 1024; }
+        int MaxSampleValueSpan() { return 2048; }
+    };
+}
+
+BENCHMARK("GraphView", "GraphRingBuffer<1024> append")
+{
+    static GraphRingBuffer<1024> buffer(2048);
+    static int sample = 0;
+    buffer.append(sample = (sample + 97) & 0x7FF);
+    bench::clobberMemory();
+}
+
+// the columns of a 174 pixel wide graph, each covers 5 or 6 samples
+BENCHMARK("GraphView", "GraphRingBuffer<1024> 174 columns")
+{
+    GraphRingBuffer<1024> &buffer = filledBuffer();
+    int min, max;
+    for (int c=0; c<174; c++)
+    {
+        int start = c * 1024 / 174;
+        buffer.SampleRange(start, (c+1) * 1024 / 174 - start, min, max);
+        bench::doNotOptimize(min);
+        bench::doNotOptimize(max);
+    }
+}
+
+BENCHMARK("GraphView", "DataPoint scan 174 columns")
+{
+    static ScanningSource source;
+    IGraphViewDataSource &dataSource = source;
+    int min, max;
+    for (int c=0; c<174; c++)
+    {
+        int start = c * 1024 / 174;
+        dataSource.SampleRange(start, (c+1) * 1024 / 174 - start, min, max);
+        bench::doNotOptimize(min);
+        bench::doNotOptimize(max);
+    }
+}
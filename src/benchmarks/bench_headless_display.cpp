@@ -0,0 +1,63 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "../display/headless/headless_display_controller.h"
+#include "../display/text_render.h"
+#include "../display/Fonts/FreeSans9pt7b.h"
+
+using namespace mono;
+using namespace mono::display;
+
+namespace {
+
+    HeadlessDisplayController &headless()
+    {
+        static HeadlessDisplayController display;
+        return display;
+    }
+
+    const geo::Rect textRect(10, 20, 156, 60);
+    const char *label = "Temperature 22.5 C";
+
+    // the bus transfers do not vary with the machine, unlike the timings
+    HeadlessDisplayController &startCounting()
+    {
+        headless().resetCounters();
+        return headless();
+    }
+}
+
+BENCHMARK("Headless", "writeFill full screen")
+{
+    HeadlessDisplayController &display = startCounting();
+    display.setWindow(0, 0, 176, 220);
+    display.writeFill(Color(0, 0, 0), 176*220);
+    bench::countOperations(display.BusTransfers());
+}
+
+BENCHMARK("Headless", "TextRender drawInRect label")
+{
+    HeadlessDisplayController &display = startCounting();
+    TextRender render(&display, Color(255, 255, 255), Color(0, 0, 0));
+    render.drawInRect(textRect, label, FreeSans9pt7b, false);
+    bench::countOperations(display.BusTransfers());
+}
+
+BENCHMARK("Headless", "TextRender drawOpaqueInRect label")
+{
+    HeadlessDisplayController &display = startCounting();
+    TextRender render(&display, Color(255, 255, 255), Color(0, 0, 0));
+    render.drawOpaqueInRect(textRect, label, FreeSans9pt7b, false);
+    bench::countOperations(display.BusTransfers());
+}
+
+BENCHMARK("Headless", "TextRender clear and drawInRect label")
+{
+    HeadlessDisplayController &display = startCounting();
+    TextRender render(&display, Color(255, 255, 255), Color(0, 0, 0));
+    display.setWindow(textRect.X(), textRect.Y(), textRect.Width(), textRect.Height());
+    display.writeFill(Color(0, 0, 0), textRect.Width()*textRect.Height());
+    render.drawInRect(textRect, label, FreeSans9pt7b, false);
+    bench::countOperations(display.BusTransfers());
+}
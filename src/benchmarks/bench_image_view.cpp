@@ -0,0 +1,149 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "host_context.h"
+#include "../display/ui/image_view.h"
+#include "../media/bmp_image.h"
+#include "../media/rgb565_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace mono;
+
+namespace {
+
+    const int width = 176, height = 220;
+
+    /**
+     * The same full screen picture as a 16-bit BMP and a RGB565 image, in
+     * temporary files that are removed at exit.
+     */
+    class ImageFiles
+    {
+    public:
+        char bmpPath[32], rgb565Path[32];
+
+        ImageFiles()
+        {
+            uint16_t pixels[width];
+
+            // a top-down 16-bit BMP, with the RGB565 bit fields
+            FILE *bmp = create(bmpPath, "/tmp/bench_image_XXXXXX");
+            uint32_t imageSize = width*height*2;
+            put(bmp, 0x4D42, 2);
+            put(bmp, imageSize + 66, 4);
+            put(bmp, 0, 4);
+            put(bmp, 66, 4);
+            put(bmp, 40, 4);
+            put(bmp, width, 4);
+            put(bmp, -height, 4);
+            put(bmp, 1, 2);
+            put(bmp, 16, 2);
+            put(bmp, 3, 4);
+            put(bmp, imageSize, 4);
+            put(bmp, 0, 16);
+            put(bmp, 0xF800, 4);
+            put(bmp, 0x07E0, 4);
+            put(bmp, 0x001F, 4);
+
+            FILE *rgb565 = create(rgb565Path, "/tmp/bench_image_XXXXXX");
+            uint16_t size[2] = { width, height };
+            fwrite("M565", 1, 4, rgb565);
+            fwrite(size, sizeof(size), 1, rgb565);
+
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                    pixels[x] = (uint16_t) (((x >> 3) << 11) | ((y >> 2) << 5) | ((x + y) & 0x1F));
+                fwrite(pixels, sizeof(pixels), 1, bmp);
+                fwrite(pixels, sizeof(pixels), 1, rgb565);
+            }
+
+            fclose(bmp);
+            fclose(rgb565);
+        }
+
+        ~ImageFiles()
+        {
+            remove(bmpPath);
+            remove(rgb565Path);
+        }
+
+        /** Write a little endian value of 2 or 4 bytes, or zeros */
+        static void put(FILE *file, int32_t value, int bytes)
+        {
+            for (int i = 0; i < bytes; i++)
+                fputc(i < 4 ? (value >> (i*8)) & 0xFF : 0, file);
+        }
+
+        static FILE *create(char *path, const char *pattern)
+        {
+            strcpy(path, pattern);
+            return fdopen(mkstemp(path), "wb");
+        }
+    };
+
+    /** Counts the calls the view makes to the image source */
+    class CountingImage : public media::Image
+    {
+    public:
+        media::Image &source;
+        uint32_t calls;
+
+        CountingImage(media::Image &img) : source(img), calls(0) {}
+
+        int Width() { return source.Width(); }
+        int Height() { return source.Height(); }
+        int PixelByteSize() { return source.PixelByteSize(); }
+        bool IsValid() { return source.IsValid(); }
+        bool HasContiguousLines() { return source.HasContiguousLines(); }
+
+        int ReadPixelData(void *target, int pixelsToRead)
+        {
+            calls++;
+            return source.ReadPixelData(target, pixelsToRead);
+        }
+
+        int SkipPixelData(int pixelsToSkip)
+        {
+            calls++;
+            return source.SkipPixelData(pixelsToSkip);
+        }
+
+        void SeekToHLine(int vertPos)
+        {
+            calls++;
+            source.SeekToHLine(vertPos);
+        }
+    };
+
+    ImageFiles &files()
+    {
+        static ImageFiles imageFiles;
+        return imageFiles;
+    }
+
+    // the file reads and seeks do not vary with the machine, unlike the timings
+    void repaintAndCount(media::Image &image)
+    {
+        CountingImage counting(image);
+        ui::ImageView view(&counting);
+        view.repaint();
+        bench::countOperations(counting.calls);
+    }
+}
+
+BENCHMARK("ImageView", "repaint BMPImage full screen")
+{
+    static media::BMPImage image(files().bmpPath);
+    repaintAndCount(image);
+}
+
+BENCHMARK("ImageView", "repaint RGB565Image full screen")
+{
+    static media::RGB565Image image(files().rgb565Path);
+    repaintAndCount(image);
+}
@@ -0,0 +1,61 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "../queue.h"
+
+using namespace mono;
+
+namespace {
+
+    class Item : public IQueueItem
+    {
+    public:
+        int value;
+    };
+
+    Item items[32];
+
+    struct FilledQueue
+    {
+        GenericQueue<Item> queue;
+
+        FilledQueue()
+        {
+            for (int i=0; i<32; i++)
+                queue.enqueue(&items[i]);
+        }
+    };
+
+    FilledQueue &filled()
+    {
+        static FilledQueue instance;
+        return instance;
+    }
+}
+
+BENCHMARK("Queue", "enqueue and dequeue 8 items")
+{
+    GenericQueue<Item> queue;
+    for (int i=0; i<8; i++)
+        queue.enqueue(&items[i]);
+
+    while (queue.dequeue() != 0) {}
+}
+
+BENCHMARK("Queue", "exists, last of 32 items")
+{
+    bench::doNotOptimize(filled().queue.exists(&items[31]));
+}
+
+BENCHMARK("Queue", "length of 32 items")
+{
+    bench::doNotOptimize(filled().queue.Length());
+}
+
+BENCHMARK("Queue", "remove and append middle item")
+{
+    GenericQueue<Item> &queue = filled().queue;
+    queue.remove(&items[16]);
+    queue.enqueue(&items[16]);
+}
@@ -0,0 +1,28 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "../regex.h"
+
+using namespace mono;
+
+static const char *statusLine = "HTTP/1.1 200 OK";
+
+BENCHMARK("Regex", "IsMatch status line")
+{
+    static Regex regex("^HTTP/1\\.\\d \\d+");
+    bench::doNotOptimize(regex.IsMatch(statusLine));
+}
+
+BENCHMARK("Regex", "Match status code capture")
+{
+    static Regex regex("^HTTP/1\\.\\d (\\d+)");
+    Regex::Capture capture;
+    bench::doNotOptimize(regex.Match(statusLine, &capture, 1));
+}
+
+BENCHMARK("Regex", "IsMatch no match")
+{
+    static Regex regex("Content-Length: (\\d+)");
+    bench::doNotOptimize(regex.IsMatch(statusLine));
+}
@@ -0,0 +1,28 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include <string.h>
+#include "../io/running_average_filter.h"
+
+using namespace mono::io;
+
+BENCHMARK("Filter", "RunningAverageFilter<16> append")
+{
+    static RunningAverageFilter<16> filter;
+    static uint16_t sample = 0;
+    bench::doNotOptimize(filter.append(sample += 97));
+}
+
+BENCHMARK("Filter", "RunningAverageFilter<64> append")
+{
+    static RunningAverageFilter<64> filter;
+    static uint16_t sample = 0;
+    bench::doNotOptimize(filter.append(sample += 97));
+}
+
+BENCHMARK("Filter", "RunningAverageFilter<16> variance")
+{
+    static RunningAverageFilter<16> filter(512);
+    bench::doNotOptimize(filter.variance());
+}
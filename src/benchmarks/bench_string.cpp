@@ -0,0 +1,61 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "../mn_string.h"
+#include "../string_builder.h"
+
+using namespace mono;
+
+static const char *shortText = "Hello mono";
+static const char *longText = "GET /api/v1/sensors/temperature HTTP/1.1\r\nHost: example.com";
+
+BENCHMARK("String", "construct short")
+{
+    String str(shortText);
+    bench::doNotOptimize(str);
+}
+
+BENCHMARK("String", "construct long")
+{
+    String str(longText);
+    bench::doNotOptimize(str);
+}
+
+BENCHMARK("String", "copy long")
+{
+    static String source(longText);
+    String copy(source);
+    bench::doNotOptimize(copy);
+}
+
+BENCHMARK("String", "length long")
+{
+    static String source(longText);
+    bench::doNotOptimize(source.Length());
+}
+
+BENCHMARK("String", "compare equal")
+{
+    static String a(longText), b(longText);
+    bench::doNotOptimize(a == b);
+}
+
+BENCHMARK("String", "Format integer")
+{
+    String str = String::Format("Temp: %i.%02i C", 22, 53);
+    bench::doNotOptimize(str);
+}
+
+BENCHMARK("String", "StringBuilder integer")
+{
+    StackStringBuilder<32> str;
+    str.append("Temp: ").appendFixed(2253, 2).append(" C");
+    bench::doNotOptimize(str);
+}
+
+BENCHMARK("String", "slice indexOf")
+{
+    static String source(longText);
+    bench::doNotOptimize(source.slice(0).indexOf(':'));
+}
@@ -0,0 +1,76 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "bench.h"
+#include "lib/fake_display_controller.h"
+#include "lib/aa_bench_font.h"
+#include "../display/text_render.h"
+#include "../display/Fonts/FreeSans9pt7b.h"
+
+using namespace mono;
+using namespace mono::display;
+
+static FakeDisplayController fakeDisplay;
+static const geo::Rect textRect(10, 20, 156, 60);
+static const char *label = "Temperature 22.5 C";
+static const char *paragraph = "The quick brown fox\njumps over the lazy dog";
+
+static FakeDisplayController &startCounting()
+{
+    fakeDisplay.pixelsWritten = fakeDisplay.windowChanges = fakeDisplay.cursorChanges = 0;
+    return fakeDisplay;
+}
+
+static void countDisplayCalls()
+{
+    bench::countOperations(fakeDisplay.pixelsWritten + fakeDisplay.windowChanges + fakeDisplay.cursorChanges);
+}
+
+BENCHMARK("TextRender", "renderDimension label")
+{
+    TextRender render(&fakeDisplay, Color(255, 255, 255), Color(0, 0, 0));
+    bench::doNotOptimize(render.renderDimension(label, FreeSans9pt7b, false));
+}
+
+BENCHMARK("TextRender", "drawInRect label")
+{
+    TextRender render(&startCounting(), Color(255, 255, 255), Color(0, 0, 0));
+    render.drawInRect(textRect, label, FreeSans9pt7b, false);
+    countDisplayCalls();
+}
+
+BENCHMARK("TextRender", "drawOpaqueInRect label")
+{
+    TextRender render(&startCounting(), Color(255, 255, 255), Color(0, 0, 0));
+    render.drawOpaqueInRect(textRect, label, FreeSans9pt7b, false);
+    countDisplayCalls();
+}
+
+BENCHMARK("TextRender", "drawInRect centered paragraph")
+{
+    TextRender render(&startCounting(), Color(255, 255, 255), Color(0, 0, 0));
+    render.setAlignment(TextRender::ALIGN_CENTER);
+    render.drawInRect(textRect, paragraph, FreeSans9pt7b, true);
+    countDisplayCalls();
+}
+
+static const AAFont &aaFont()
+{
+    static AABenchFont font(FreeSans9pt7b);
+    return font.font;
+}
+
+BENCHMARK("TextRender", "AAFont drawInRect label")
+{
+    TextRender render(&startCounting(), Color(255, 255, 255), Color(0, 0, 0));
+    render.drawInRect(textRect, label, aaFont());
+    countDisplayCalls();
+}
+
+BENCHMARK("TextRender", "AAFont drawInRect centered paragraph")
+{
+    TextRender render(&startCounting(), Color(255, 255, 255), Color(0, 0, 0));
+    render.setAlignment(TextRender::ALIGN_CENTER);
+    render.drawInRect(textRect, paragraph, aaFont());
+    countDisplayCalls();
+}
@@ -0,0 +1,72 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef aa_bench_font_h
+#define aa_bench_font_h
+
+#include <aafont.h>
+#include <gfxfont.h>
+#include <vector>
+
+/**
+ * @brief An anti-aliased font made from a GFXfont, for the benchmarks
+ *
+ * No AAFont is in the repository, and the font tool needs Pillow. This
+ * converts the 1-bit glyphs to 4-bit coverage, with soft edges, and adds
+ * a kerning pair for every uppercase and lowercase letter pair. The glyph
+ * and kerning counts are like a converted TrueType font.
+ */
+class AABenchFont
+{
+public:
+    AAFont font;
+
+    AABenchFont(const GFXfont &source)
+    {
+        int count = source.last - source.first + 1;
+        for (int i=0; i<count; i++)
+        {
+            const GFXglyph &g = source.glyph[i];
+            AAGlyph glyph = { (uint32_t) bitmap.size(), g.width, g.height,
+                              g.xAdvance, g.xOffset, g.yOffset };
+            glyphs.push_back(glyph);
+
+            int pixels = g.width*g.height;
+            std::vector<uint8_t> coverage(pixels + 1, 0);
+            for (int p=0; p<pixels; p++)
+            {
+                bool on = source.bitmap[g.bitmapOffset + (p >> 3)] & (0x80 >> (p & 7));
+                coverage[p] = on ? 15 : (p % 3 == 0 ? 4 : 0);
+            }
+
+            for (int p=0; p<pixels; p += 2)
+                bitmap.push_back((coverage[p] << 4) | coverage[p+1]);
+        }
+
+        for (int left='A'; left<='z'; left++)
+        {
+            for (int right='A'; right<='z'; right++)
+            {
+                AAKernPair pair = { (uint8_t) left, (uint8_t) right, (int8_t) -((left + right) % 2) };
+                kerning.push_back(pair);
+            }
+        }
+
+        font.bitmap = &bitmap[0];
+        font.glyph = &glyphs[0];
+        font.kerning = &kerning[0];
+        font.kerningCount = kerning.size();
+        font.first = source.first;
+        font.last = source.last;
+        font.yAdvance = source.yAdvance;
+        font.ascent = source.yAdvance*3/4;
+    }
+
+protected:
+
+    std::vector<uint8_t> bitmap;
+    std::vector<AAGlyph> glyphs;
+    std::vector<AAKernPair> kerning;
+};
+
+#endif /* aa_bench_font_h */
@@ -0,0 +1,40 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef fake_display_controller_h
+#define fake_display_controller_h
+
+#include <display_controller_interface.h>
+
+/**
+ * @brief Display controller that only counts the calls made to it
+ *
+ * Lets the benchmarks measure the cost of layout and rendering, without
+ * the cost of storing pixels.
+ */
+class FakeDisplayController : public mono::display::IDisplayController
+{
+public:
+    int cursorX, cursorY;
+    uint32_t pixelsWritten, windowChanges, cursorChanges;
+
+    FakeDisplayController() : IDisplayController(176, 220)
+    {
+        cursorX = cursorY = 0;
+        pixelsWritten = windowChanges = cursorChanges = 0;
+    }
+
+    void init() {}
+    void setWindow(int x, int y, int, int) { cursorX = x; cursorY = y; windowChanges++; }
+    uint16_t ScreenWidth() const { return 176; }
+    uint16_t ScreenHeight() const { return 220; }
+    void setCursor(int x, int y) { cursorX = x; cursorY = y; cursorChanges++; }
+    int getCursorX() { return cursorX; }
+    int getCursorY() { return cursorY; }
+    void write(mono::display::Color) { pixelsWritten++; }
+    void setBrightness(uint8_t) {}
+    uint8_t Brightness() const { return 255; }
+    uint16_t read() { return 0; }
+};
+
+#endif /* fake_display_controller_h */
@@ -0,0 +1,178 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "block_pool.h"
+#include <stdlib.h>
+#include <mbed_debug.h>
+
+using namespace mono;
+
+// MARK: Block Pool
+
+BlockPool::BlockPool(uint32_t size, uint32_t count)
+{
+    blockSize = (size + 7) & ~7;
+    blockCount = count;
+    arena = 0;
+    freeList = 0;
+    ownsArena = true;
+    inUse = peakInUse = exhaustions = 0;
+}
+
+BlockPool::BlockPool(uint32_t size, uint32_t count, void *arenaBuffer)
+{
+    blockSize = (size + 7) & ~7;
+    blockCount = count;
+    arena = (uint8_t*) arenaBuffer;
+    freeList = 0;
+    ownsArena = false;
+    inUse = peakInUse = exhaustions = 0;
+    setupArena();
+}
+
+BlockPool::~BlockPool()
+{
+    if (ownsArena && arena != 0)
+        free(arena);
+}
+
+void BlockPool::setupArena()
+{
+    if (arena == 0)
+    {
+        arena = (uint8_t*) malloc(blockSize * blockCount);
+        if (arena == 0)
+        {
+            debug("BlockPool: could not allocate arena of %u bytes!\r\n", blockSize * blockCount);
+            return;
+        }
+    }
+
+    freeList = 0;
+    for (int i=blockCount-1; i>=0; i--)
+    {
+        FreeBlock *block = (FreeBlock*) (arena + i*blockSize);
+        block->next = freeList;
+        freeList = block;
+    }
+}
+
+void *BlockPool::allocate(uint32_t size)
+{
+    if (size > blockSize)
+        return 0;
+
+    if (arena == 0)
+        setupArena();
+
+    if (freeList == 0)
+    {
+        exhaustions++;
+        return 0;
+    }
+
+    FreeBlock *block = freeList;
+    freeList = block->next;
+
+    inUse++;
+    if (inUse > peakInUse)
+        peakInUse = inUse;
+
+    return block;
+}
+
+void BlockPool::deallocate(void *ptr)
+{
+    if (ptr == 0)
+        return;
+
+    FreeBlock *block = (FreeBlock*) ptr;
+    block->next = freeList;
+    freeList = block;
+    inUse--;
+}
+
+bool BlockPool::owns(const void *block) const
+{
+    const uint8_t *ptr = (const uint8_t*) block;
+    return arena != 0 && ptr >= arena && ptr < arena + blockSize*blockCount;
+}
+
+uint32_t BlockPool::BlockSize() const
+{
+    return blockSize;
+}
+
+uint32_t BlockPool::BlockCount() const
+{
+    return blockCount;
+}
+
+uint32_t BlockPool::BlocksInUse() const
+{
+    return inUse;
+}
+
+uint32_t BlockPool::PeakBlocksInUse() const
+{
+    return peakInUse;
+}
+
+uint32_t BlockPool::Exhaustions() const
+{
+    return exhaustions;
+}
+
+// MARK: Size Class Pool
+
+SizeClassPool::SizeClassPool(BlockPool **poolArray, int count)
+{
+    pools = poolArray;
+    poolCount = count;
+    fallbacks = 0;
+}
+
+void *SizeClassPool::allocate(uint32_t size)
+{
+    for (int i=0; i<poolCount; i++)
+    {
+        if (size > pools[i]->BlockSize())
+            continue;
+
+        void *block = pools[i]->allocate(size);
+        if (block != 0)
+            return block;
+    }
+
+    fallbacks++;
+    return malloc(size);
+}
+
+void SizeClassPool::deallocate(void *block)
+{
+    for (int i=0; i<poolCount; i++)
+    {
+        if (pools[i]->owns(block))
+        {
+            pools[i]->deallocate(block);
+            return;
+        }
+    }
+
+    free(block);
+}
+
+uint32_t SizeClassPool::Fallbacks() const
+{
+    return fallbacks;
+}
+
+int SizeClassPool::PoolCount() const
+{
+    return poolCount;
+}
+
+const BlockPool &SizeClassPool::Pool(int index) const
+{
+    return *pools[index];
+}
@@ -0,0 +1,144 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef block_pool_h
+#define block_pool_h
+
+#include <stdint.h>
+#include "allocator_interface.h"
+
+namespace mono {
+
+    /**
+     * @brief Allocator of fixed size memory blocks, from a single arena
+     *
+     * All blocks in a pool have the same size. The arena is allocated once,
+     * the first time a block is requested, or you can provide a static buffer.
+     * Free blocks are kept in a list, so allocating and freeing takes constant
+     * time and never fragments the HEAP.
+     *
+     * When all blocks are in use, @ref allocate returns `NULL` and the
+     * exhaustion is counted. Use @ref SizeClassPool to fall back to the HEAP.
+     */
+    class BlockPool : public IAllocator
+    {
+    protected:
+
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        uint8_t *arena;
+        FreeBlock *freeList;
+        uint32_t blockSize, blockCount;
+        bool ownsArena;
+
+        uint32_t inUse, peakInUse, exhaustions;
+
+        void setupArena();
+
+        BlockPool(const BlockPool &);
+        BlockPool &operator=(const BlockPool &);
+
+    public:
+
+        /**
+         * @brief Create a pool, its arena is allocated on first use
+         *
+         * @param blockSize The size of each block, rounded up to 8 bytes
+         * @param blockCount The number of blocks in the pool
+         */
+        BlockPool(uint32_t blockSize, uint32_t blockCount);
+
+        /**
+         * @brief Create a pool that uses a buffer you provide as arena
+         *
+         * The buffer must be 8 byte aligned, and hold `blockCount` blocks of
+         * `blockSize` rounded up to 8 bytes.
+         *
+         * @param blockSize The size of each block
+         * @param blockCount The number of blocks in the pool
+         * @param arenaBuffer The arena buffer
+         */
+        BlockPool(uint32_t blockSize, uint32_t blockCount, void *arenaBuffer);
+
+        ~BlockPool();
+
+        /**
+         * @brief Get a free block
+         * @param size The requested size, must not exceed the block size
+         * @return A block, or `NULL` if the pool is exhausted or `size` too large
+         */
+        void *allocate(uint32_t size);
+
+        /** @brief Return a block to the pool */
+        void deallocate(void *block);
+
+        /** @brief `true` if the pointer is a block in this pool */
+        bool owns(const void *block) const;
+
+        /** @brief The size of each block in bytes */
+        uint32_t BlockSize() const;
+
+        /** @brief The total number of blocks */
+        uint32_t BlockCount() const;
+
+        /** @brief The number of blocks currently allocated */
+        uint32_t BlocksInUse() const;
+
+        /** @brief The highest number of blocks allocated at the same time */
+        uint32_t PeakBlocksInUse() const;
+
+        /** @brief The number of allocations that failed because all blocks were in use */
+        uint32_t Exhaustions() const;
+    };
+
+    /**
+     * @brief Allocator with pools of different block sizes, and HEAP fallback
+     *
+     * Allocations are served from the smallest pool, whose blocks are large
+     * enough and has a free block. If no pool can serve the allocation, it
+     * falls back to `malloc` and the fallback is counted.
+     *
+     * The pools must be ordered by block size, smallest first.
+     *
+     * @code
+     * static BlockPool small(32, 8), large(128, 4);
+     * static BlockPool *classes[] = { &small, &large };
+     * static SizeClassPool allocator(classes, 2);
+     * @endcode
+     */
+    class SizeClassPool : public IAllocator
+    {
+    protected:
+
+        BlockPool **pools;
+        int poolCount;
+        uint32_t fallbacks;
+
+    public:
+
+        /**
+         * @brief Create an allocator of existing pools
+         * @param pools Array of pools, ordered by block size
+         * @param poolCount The number of pools in the array
+         */
+        SizeClassPool(BlockPool **pools, int poolCount);
+
+        void *allocate(uint32_t size);
+
+        void deallocate(void *block);
+
+        /** @brief The number of allocations that fell back to the HEAP */
+        uint32_t Fallbacks() const;
+
+        /** @brief The number of pools */
+        int PoolCount() const;
+
+        /** @brief Get a pool to read its statistics */
+        const BlockPool &Pool(int index) const;
+    };
+}
+
+#endif /* block_pool_h */
@@ -3,6 +3,7 @@
 
 #include "date_time.h"
 #include "regex.h"
+#include "string_builder.h"
 #include "application_context_interface.h"
 #include <stdio.h>
 
@@ -104,7 +105,9 @@ DateTime &DateTime::operator=(const DateTime &other)
 
 String DateTime::toString() const
 {
-    return String::Format("%04d-%02d-%02d %02d:%02d:%02d",year,month,day,hours,mins,secs);
+    StackStringBuilder<20> str;
+    str.appendDate(year, month, day).append(' ').appendTime(hours, mins, secs);
+    return str.toString();
 }
 
 String DateTime::toISO8601() const
@@ -121,7 +124,9 @@ String DateTime::toISO8601() const
             break;
     }
 
-    return String::Format("%04d-%02d-%02dT%02d:%02d:%02d%s",year,month,day,hours,mins,secs,timeZone);
+    StackStringBuilder<21> str;
+    str.appendDate(year, month, day).append('T').appendTime(hours, mins, secs).append(timeZone);
+    return str.toString();
 }
 
 String DateTime::toRFC1123() const
@@ -131,12 +136,16 @@ String DateTime::toRFC1123() const
 
 String DateTime::toTimeString() const
 {
-    return String::Format("%02d:%02d:%02d",hours,mins,secs);
+    StackStringBuilder<9> str;
+    str.appendTime(hours, mins, secs);
+    return str.toString();
 }
 
 String DateTime::toDateString() const
 {
-    return String::Format("%04d-%02d-%02d",year,month,day);
+    StackStringBuilder<11> str;
+    str.appendDate(year, month, day);
+    return str.toString();
 }
 
 uint32_t DateTime::toJulianDayNumber() const
@@ -191,10 +200,8 @@ String DateTime::toString(const char *format) const
     localtime_r(&ut, &comps);
     char buffer[80];
     size_t len = strftime(buffer, 80, format, &comps);
-    String result(len+1);
-    strftime(result.stringData, len, format, &comps);
 
-    return result;
+    return String(buffer, len);
 }
 
 bool DateTime::isValid() const
@@ -0,0 +1,274 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "deferred_call_queue.h"
+
+#ifndef EMUNO
+#include <cmsis.h>
+#endif
+
+using namespace mono;
+
+// true if time stamp a is at or after b, with wrap around
+static inline bool timeReached(uint32_t a, uint32_t b)
+{
+    return (int32_t) (a - b) >= 0;
+}
+
+DeferredCallQueue::DeferredCallQueue()
+{
+    head = tail = 0;
+    delayedCount = 0;
+    resetStatistics();
+}
+
+// MARK: Posting
+
+bool DeferredCallQueue::post(const mbed::FunctionPointer &handler, const void *owner, uint32_t now)
+{
+    uint32_t state = enterCritical();
+
+    posted++;
+    for (uint32_t i=head; i != tail; i++)
+    {
+        if (sameCall(ring[i % Capacity], handler, owner))
+        {
+            coalesced++;
+            exitCritical(state);
+            return true;
+        }
+    }
+
+    uint32_t depth = tail - head;
+    if (depth >= Capacity)
+    {
+        overflows++;
+        exitCritical(state);
+        return false;
+    }
+
+    Call &call = ring[tail % Capacity];
+    call.handler = handler;
+    call.owner = owner;
+    call.time = now;
+    tail++;
+
+    if (depth + 1 > peakDepth)
+        peakDepth = depth + 1;
+
+    exitCritical(state);
+    return true;
+}
+
+bool DeferredCallQueue::postDelayed(const mbed::FunctionPointer &handler, const void *owner,
+                                    uint32_t delayUs, uint32_t now)
+{
+    uint32_t state = enterCritical();
+
+    posted++;
+    if (delayedCount >= DelayedCapacity)
+    {
+        overflows++;
+        exitCritical(state);
+        return false;
+    }
+
+    Call call;
+    call.handler = handler;
+    call.owner = owner;
+    call.time = now + delayUs;
+    heapPush(call);
+
+    exitCritical(state);
+    return true;
+}
+
+int DeferredCallQueue::cancel(const void *owner)
+{
+    int removed = 0;
+    uint32_t state = enterCritical();
+
+    // ring slots cannot be removed, only emptied
+    for (uint32_t i=head; i != tail; i++)
+    {
+        Call &call = ring[i % Capacity];
+        if (call.owner == owner && call.handler)
+        {
+            call.handler.attach(0);
+            removed++;
+        }
+    }
+
+    uint32_t i = 0;
+    while (i < delayedCount)
+    {
+        if (delayed[i].owner == owner)
+        {
+            delayed[i] = delayed[--delayedCount];
+            removed++;
+        }
+        else
+            i++;
+    }
+
+    // restore the heap order, after moving entries
+    for (int j=(int)delayedCount/2-1; j>=0; j--)
+        heapSiftDown(j);
+
+    exitCritical(state);
+    return removed;
+}
+
+bool DeferredCallQueue::sameCall(const Call &call, const mbed::FunctionPointer &handler, const void *owner)
+{
+    // cancelled calls are empty, and never match
+    return call.owner == owner && call.handler &&
+           memcmp(&call.handler, &handler, sizeof(handler)) == 0;
+}
+
+// MARK: Dispatching
+
+void DeferredCallQueue::process(uint32_t now)
+{
+    // only dispatch calls that are queued now, calls posted by the
+    // callbacks wait for the next run loop iteration
+    uint32_t end = tail;
+    while (head != end)
+    {
+        Call call = ring[head % Capacity];
+        head++;
+
+        if (!call.handler)
+            continue;
+
+        uint32_t latency = now - call.time;
+        if (latency > maxLatency)
+            maxLatency = latency;
+
+        call.handler.call();
+    }
+
+    while (delayedCount > 0 && timeReached(now, delayed[0].time))
+    {
+        Call call;
+        uint32_t state = enterCritical();
+        heapPop(call);
+        exitCritical(state);
+
+        uint32_t latency = now - call.time;
+        if (latency > maxLatency)
+            maxLatency = latency;
+
+        call.handler.call();
+    }
+}
+
+// MARK: Timer heap
+
+void DeferredCallQueue::heapPush(const Call &call)
+{
+    uint32_t index = delayedCount++;
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1) / 2;
+        if (timeReached(call.time, delayed[parent].time))
+            break;
+
+        delayed[index] = delayed[parent];
+        index = parent;
+    }
+
+    delayed[index] = call;
+}
+
+void DeferredCallQueue::heapPop(Call &call)
+{
+    call = delayed[0];
+    delayed[0] = delayed[--delayedCount];
+    heapSiftDown(0);
+}
+
+void DeferredCallQueue::heapSiftDown(uint32_t index)
+{
+    while (true)
+    {
+        uint32_t smallest = index;
+        uint32_t left = 2*index + 1, right = left + 1;
+
+        if (left < delayedCount && !timeReached(delayed[left].time, delayed[smallest].time))
+            smallest = left;
+        if (right < delayedCount && !timeReached(delayed[right].time, delayed[smallest].time))
+            smallest = right;
+
+        if (smallest == index)
+            return;
+
+        Call tmp = delayed[index];
+        delayed[index] = delayed[smallest];
+        delayed[smallest] = tmp;
+        index = smallest;
+    }
+}
+
+// MARK: Critical sections
+
+uint32_t DeferredCallQueue::enterCritical()
+{
+#ifndef EMUNO
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+#else
+    return 0;
+#endif
+}
+
+void DeferredCallQueue::exitCritical(uint32_t state)
+{
+#ifndef EMUNO
+    __set_PRIMASK(state);
+#else
+    (void) state;
+#endif
+}
+
+// MARK: Statistics
+
+uint32_t DeferredCallQueue::Pending() const
+{
+    return (tail - head) + delayedCount;
+}
+
+uint32_t DeferredCallQueue::Posted() const
+{
+    return posted;
+}
+
+uint32_t DeferredCallQueue::Coalesced() const
+{
+    return coalesced;
+}
+
+uint32_t DeferredCallQueue::Overflows() const
+{
+    return overflows;
+}
+
+uint32_t DeferredCallQueue::MaxLatency() const
+{
+    return maxLatency;
+}
+
+uint32_t DeferredCallQueue::PeakDepth() const
+{
+    return peakDepth;
+}
+
+void DeferredCallQueue::resetStatistics()
+{
+    posted = 0;
+    coalesced = 0;
+    overflows = 0;
+    maxLatency = 0;
+    peakDepth = 0;
+}
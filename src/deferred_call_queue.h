@@ -0,0 +1,176 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef deferred_call_queue_h
+#define deferred_call_queue_h
+
+#include <stdint.h>
+#include <string.h>
+#include <platform.h>
+#include <FunctionPointer.h>
+
+namespace mono {
+
+    /**
+     * @brief Fixed capacity queue of callbacks, to be called by the run loop
+     *
+     * This is the queue behind @ref async and @ref asyncAfter. It holds the
+     * pending callbacks inline, so deferring a call does not allocate any
+     * memory. You should not need to use it directly, it is owned by the
+     * @ref AppRunLoop.
+     *
+     * Callbacks without delay go into a ring buffer, that can be filled from
+     * interrupt routines. Delayed callbacks go into a timer heap, ordered by
+     * their due time. The run loop calls @ref process in every iteration, that
+     * dispatches all queued callbacks and the delayed callbacks that are due.
+     *
+     * Posting a callback that is already waiting in the ring does not queue
+     * it again, the pending call is enough. Producers like the wireless
+     * module post an event handler per frame, and the handler processes
+     * whatever is queued. When the ring or heap is full, posting fails and
+     * the overflow is counted. The queue also records the worst latency from a callback is
+     * posted, until it is dispatched.
+     *
+     * All times are in microseconds, as read from the `us_ticker`. Time stamps
+     * are compared with wrap around, so delays must be less than 35 minutes.
+     */
+    class DeferredCallQueue
+    {
+    public:
+
+        /** The number of callbacks without delay, that can be pending */
+        static const uint32_t Capacity = 16;
+
+        /** The number of delayed callbacks, that can be pending */
+        static const uint32_t DelayedCapacity = 16;
+
+    protected:
+
+        struct Call
+        {
+            mbed::FunctionPointer handler;
+            const void *owner;
+            uint32_t time;  // post time in the ring, due time in the heap
+        };
+
+        Call ring[Capacity];
+        volatile uint32_t head, tail;
+
+        Call delayed[DelayedCapacity];
+        volatile uint32_t delayedCount;
+
+        uint32_t posted, coalesced, overflows, maxLatency, peakDepth;
+
+        static bool sameCall(const Call &call, const mbed::FunctionPointer &handler, const void *owner);
+
+        static uint32_t enterCritical();
+        static void exitCritical(uint32_t state);
+
+        void heapPush(const Call &call);
+        void heapPop(Call &call);
+        void heapSiftDown(uint32_t index);
+
+        DeferredCallQueue(const DeferredCallQueue &);
+        DeferredCallQueue &operator=(const DeferredCallQueue &);
+
+    public:
+
+        DeferredCallQueue();
+
+        /**
+         * The unused part of a member function pointer is not initialized by
+         * `FunctionPointer`. Handlers created by this method compare equal,
+         * such that the ring can skip a call that is already pending.
+         *
+         * @brief Create a handler for a member function, that can be coalesced
+         * @param obj The context object, the `this` pointer
+         * @param method The member function
+         */
+        template <typename Owner>
+        static mbed::FunctionPointer handler(Owner *obj, void (Owner::*method)(void))
+        {
+            mbed::FunctionPointer handler;
+            memset((void*) &handler, 0, sizeof(handler));
+            handler.attach(obj, method);
+            return handler;
+        }
+
+        /** @brief Create a handler for a C function, that can be coalesced */
+        static mbed::FunctionPointer handler(void (*function)(void))
+        {
+            mbed::FunctionPointer handler;
+            memset((void*) &handler, 0, sizeof(handler));
+            handler.attach(function);
+            return handler;
+        }
+
+        /**
+         * @brief Queue a callback for the next run loop iteration
+         *
+         * Safe to call from interrupt routines. If the same handler and owner
+         * is already waiting, it is not queued again.
+         *
+         * @param handler The callback
+         * @param owner The object the callback belongs to, used by @ref cancel
+         * @param now The current time
+         * @return `false` if the queue is full
+         */
+        bool post(const mbed::FunctionPointer &handler, const void *owner, uint32_t now);
+
+        /**
+         * @brief Queue a callback to be called after a delay
+         *
+         * Safe to call from interrupt routines.
+         *
+         * @param handler The callback
+         * @param owner The object the callback belongs to, used by @ref cancel
+         * @param delayUs The minimum delay before the callback, in microseconds
+         * @param now The current time
+         * @return `false` if the timer heap is full
+         */
+        bool postDelayed(const mbed::FunctionPointer &handler, const void *owner,
+                         uint32_t delayUs, uint32_t now);
+
+        /**
+         * @brief Remove all pending callbacks that belong to an object
+         *
+         * Call this from the destructor of objects that might have pending
+         * callbacks.
+         *
+         * @param owner The object given when posting
+         * @return The number of callbacks removed
+         */
+        int cancel(const void *owner);
+
+        /**
+         * @brief Dispatch queued callbacks, and delayed callbacks that are due
+         *
+         * Callbacks posted while dispatching wait for the next call.
+         * @param now The current time
+         */
+        void process(uint32_t now);
+
+        /** @brief The number of callbacks waiting in the ring and the heap */
+        uint32_t Pending() const;
+
+        /** @brief The total number of posted callbacks */
+        uint32_t Posted() const;
+
+        /** @brief The number of posted callbacks, that were already pending */
+        uint32_t Coalesced() const;
+
+        /** @brief The number of callbacks rejected because the queue was full */
+        uint32_t Overflows() const;
+
+        /** @brief The longest time from post to dispatch, in microseconds */
+        uint32_t MaxLatency() const;
+
+        /** @brief The highest number of callbacks, that were waiting in the ring */
+        uint32_t PeakDepth() const;
+
+        /** @brief Reset the counters */
+        void resetStatistics();
+    };
+}
+
+#endif /* deferred_call_queue_h */
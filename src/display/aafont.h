@@ -0,0 +1,63 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef aafont_h
+#define aafont_h
+
+#include <stdint.h>
+
+/**
+ * @brief A single glyph in an anti-aliased @ref AAFont
+ *
+ * The glyph bitmap has 4 bits per pixel, two pixels per byte with the left
+ * pixel in the high nibble. Rows are packed without padding, like the 1-bit
+ * GFXfont bitmaps. A pixel value is the glyph coverage: 0 is background and
+ * 15 is foreground.
+ */
+typedef struct {
+    uint32_t bitmapOffset;  /**< Byte offset of the glyph into @ref AAFont::bitmap */
+    uint8_t  width;         /**< Bitmap width in pixels */
+    uint8_t  height;        /**< Bitmap height in pixels */
+    uint8_t  xAdvance;      /**< Distance to advance the cursor, before kerning */
+    int8_t   xOffset;       /**< Distance from the cursor to the left of the bitmap */
+    int8_t   yOffset;       /**< Distance from the baseline to the top of the bitmap */
+} AAGlyph;
+
+/**
+ * @brief Kerning adjustment between two characters in an @ref AAFont
+ *
+ * The adjustment is added to the advance of the `left` character, when it is
+ * followed by the `right` character. Usually negative, e.g. for "AV".
+ */
+typedef struct {
+    uint8_t left;           /**< The first character of the pair */
+    uint8_t right;          /**< The second character of the pair */
+    int8_t  adjust;         /**< Advance adjustment in pixels */
+} AAKernPair;
+
+/**
+ * @brief Anti-aliased, proportional bitmap font with kerning
+ *
+ * Glyphs use 4 bits per pixel, see @ref AAGlyph. The kerning pairs must be
+ * sorted by `left` and then `right` character, such that they can be binary
+ * searched.
+ *
+ * Create these fonts from TrueType or BDF files with the host side tool
+ * `resources/font2aafont.py`, and render them with
+ * @ref mono::display::TextRender.
+ *
+ * All members are `const`, such that the compiler can place the font in
+ * flash memory.
+ */
+typedef struct {
+    const uint8_t *bitmap;          /**< All glyph bitmaps, concatenated */
+    const AAGlyph *glyph;           /**< Glyph array, from `first` to `last` */
+    const AAKernPair *kerning;      /**< Sorted kerning pairs, can be `0` */
+    uint16_t kerningCount;          /**< The number of kerning pairs */
+    uint8_t  first;                 /**< The first ASCII character in the font */
+    uint8_t  last;                  /**< The last ASCII character in the font */
+    uint8_t  yAdvance;              /**< Newline distance */
+    uint8_t  ascent;                /**< Distance from a line top to its baseline */
+} AAFont;
+
+#endif /* aafont_h */
@@ -2,6 +2,8 @@
 // Released under the MIT license, see LICENSE.txt
 
 #include <color.h>
+#include <string_builder.h>
+#include <string.h>
 
 using namespace mono::display;
 
@@ -108,9 +110,108 @@ Color Color::alphaBlend(uint8_t intensity, Color const &other) const
     return blend;
 }
 
+// MARK: Packed blending
+
+const uint32_t Color::SpreadMask;
+const uint8_t Color::AlphaMax;
+
+const uint8_t Color::GammaAlphaTable[256] = {
+     0,  3,  4,  4,  5,  5,  6,  6,  7,  7,  7,  8,  8,  8,  9,  9,
+     9,  9, 10, 10, 10, 10, 11, 11, 11, 11, 11, 12, 12, 12, 12, 12,
+    12, 13, 13, 13, 13, 13, 13, 14, 14, 14, 14, 14, 14, 15, 15, 15,
+    15, 15, 15, 15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17,
+    17, 17, 17, 17, 18, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+    21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22,
+    22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+    23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+    25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26, 26,
+    26, 26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27,
+    27, 27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    28, 28, 28, 28, 28, 28, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+    29, 29, 29, 29, 29, 29, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31,
+    31, 31, 31, 31, 31, 31, 31, 32, 32, 32, 32, 32, 32, 32, 32, 32
+};
+
+namespace {
+
+    inline uint32_t spread(uint16_t value)
+    {
+        return (value | ((uint32_t) value << 16)) & Color::SpreadMask;
+    }
+
+    inline uint16_t pack(uint32_t spreadValue)
+    {
+        spreadValue &= Color::SpreadMask;
+        return (uint16_t) (spreadValue | (spreadValue >> 16));
+    }
+}
+
+void Color::blendSpan(uint16_t *target, const uint16_t *source, uint8_t intensity, int length)
+{
+    uint32_t alpha = Alpha(intensity);
+    if (alpha == 0 || length <= 0)
+        return;
+
+    if (alpha == AlphaMax)
+    {
+        memcpy(target, source, length*sizeof(uint16_t));
+        return;
+    }
+
+    for (int i=0; i<length; i++)
+    {
+        uint32_t bg = spread(target[i]);
+        target[i] = pack(((bg << 5) + (spread(source[i]) - bg)*alpha) >> 5);
+    }
+}
+
+void Color::fillBlend(uint16_t *target, Color color, uint8_t intensity, int length)
+{
+    uint32_t alpha = Alpha(intensity);
+    if (alpha == 0)
+        return;
+
+    if (alpha == AlphaMax)
+    {
+        for (int i=0; i<length; i++)
+            target[i] = color.value;
+        return;
+    }
+
+    // the foreground term is the same for all pixels
+    uint32_t fg = spread(color.value)*alpha;
+    uint32_t inverse = AlphaMax - alpha;
+
+    for (int i=0; i<length; i++)
+        target[i] = pack((fg + spread(target[i])*inverse) >> 5);
+}
+
+void Color::blendMask(uint16_t *target, const uint8_t *mask, Color foreground, Color background,
+                      int length, const uint8_t *alphaTable)
+{
+    uint32_t bg = spread(background.value);
+    uint32_t difference = spread(foreground.value) - bg;
+    bg <<= 5;
+
+    if (alphaTable == 0)
+    {
+        for (int i=0; i<length; i++)
+            target[i] = pack((bg + difference*Alpha(mask[i])) >> 5);
+        return;
+    }
+
+    for (int i=0; i<length; i++)
+        target[i] = pack((bg + difference*alphaTable[mask[i]]) >> 5);
+}
+
 mono::String Color::toString() const
 {
-    return String::Format("(%u, %u, %u)", Red(), Green(), Blue());
+    mono::StackStringBuilder<16> str;
+    str.append('(').appendUInt(Red()).append(", ").appendUInt(Green())
+       .append(", ").appendUInt(Blue()).append(')');
+    return str.toString();
 }
 
 // MARK: Operator overloads
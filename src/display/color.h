@@ -119,6 +119,92 @@ namespace mono { namespace display {
          */
         Color alphaBlend(uint8_t intensity, Color const &other) const;
 
+        // MARK: Packed blending
+
+        /** The channel mask of a 5-6-5 color spread over 32 bits, see @ref blend */
+        static const uint32_t SpreadMask = 0x07E0F81F;
+
+        /** The opaque blend alpha, see @ref Alpha */
+        static const uint8_t AlphaMax = 32;
+
+        /**
+         * Alpha for the packed blend methods has 5 bits of precision, from 0
+         * (transparent) to @ref AlphaMax (opaque).
+         *
+         * @brief Convert an intensity 0-255 to a packed blend alpha 0-32
+         */
+        static uint8_t Alpha(uint8_t intensity)
+        {
+            return (intensity + 4) >> 3;
+        }
+
+        /**
+         * This blends all three channels at once, without unpacking them. The
+         * 5-6-5 color is spread to 32 bits as `00000GGGGGG00000RRRRR000000BBBBB`,
+         * so each channel has room for its product with the alpha. This costs
+         * a single multiplication per pixel on the Cortex-M3.
+         *
+         * The result is within two steps of @ref alphaBlend in each channel.
+         *
+         * @brief Blend two raw 5-6-5 values with a packed alpha
+         * @param foreground The color in front
+         * @param background The color behind
+         * @param alpha The foreground alpha, 0 to @ref AlphaMax
+         * @return The blended raw 5-6-5 value
+         */
+        static uint16_t blend(uint16_t foreground, uint16_t background, uint8_t alpha)
+        {
+            uint32_t fg = (foreground | ((uint32_t) foreground << 16)) & SpreadMask;
+            uint32_t bg = (background | ((uint32_t) background << 16)) & SpreadMask;
+            // fg*alpha + bg*(32-alpha), the wrapped difference is exact in the sum
+            uint32_t mix = (((bg << 5) + (fg - bg)*alpha) >> 5) & SpreadMask;
+            return (uint16_t) (mix | (mix >> 16));
+        }
+
+        /**
+         * @brief Blend a span of pixels on top of another, with one intensity
+         * @param target The pixels behind, overwritten with the result
+         * @param source The pixels in front
+         * @param intensity The intensity of the source, 0 to 255
+         * @param length The number of pixels
+         */
+        static void blendSpan(uint16_t *target, const uint16_t *source, uint8_t intensity, int length);
+
+        /**
+         * @brief Blend one color on top of a span of pixels
+         * @param target The pixels behind, overwritten with the result
+         * @param color The color in front
+         * @param intensity The intensity of the color, 0 to 255
+         * @param length The number of pixels
+         */
+        static void fillBlend(uint16_t *target, Color color, uint8_t intensity, int length);
+
+        /**
+         * Paints an 8-bit alpha mask, like an anti-aliased glyph or icon, in
+         * a foreground and background color. By default the mask values are
+         * linear intensities. Pass an @ref GammaAlphaTable (or a table of your
+         * own, from mask value to alpha 0-32) to correct for the display gamma.
+         *
+         * @brief Blend two colors by an alpha mask, into a span of pixels
+         * @param target The pixels to write
+         * @param mask The foreground intensity of each pixel, 0 to 255
+         * @param foreground The color where the mask is 255
+         * @param background The color where the mask is 0
+         * @param length The number of pixels
+         * @param alphaTable Optional table from mask value to alpha
+         */
+        static void blendMask(uint16_t *target, const uint8_t *mask, Color foreground, Color background,
+                              int length, const uint8_t *alphaTable = 0);
+
+        /**
+         * Maps mask intensities to alpha with a gamma of 2.2. This lifts the
+         * partly covered edge pixels, so thin anti-aliased strokes do not
+         * look faint on the display. For use with @ref blendMask.
+         *
+         * @brief Gamma corrected alpha table for @ref blendMask
+         */
+        static const uint8_t GammaAlphaTable[256];
+
         uint8_t* BytePointer();
 
         /**
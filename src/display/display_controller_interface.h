@@ -27,6 +27,20 @@ namespace mono { namespace display
      */
     class IDisplayController
     {
+    public:
+
+        /**
+         * The rotation of the coordinate system. The values match
+         * @ref mono::ui::View::Orientation.
+         */
+        enum Orientation
+        {
+            PORTRAIT = 0,       /**< The native orientation, the thick edge is at the bottom */
+            PORTRAIT_BOTTOMUP,  /**< Rotated 180 degrees */
+            LANDSCAPE_RIGHT,    /**< Rotated 90 degrees clock-wise */
+            LANDSCAPE_LEFT      /**< Rotated 90 degrees counter clock-wise */
+        };
+
     protected:
         //ActionQueue<10> tearingQueue;
         mbed::FunctionPointer *refreshHandler;
@@ -89,8 +103,32 @@ namespace mono { namespace display
          */
         virtual void setWindow(int x, int y, int width, int height) = 0;
         
+        /**
+         * @brief The width of the screen in the current orientation
+         */
         virtual uint16_t ScreenWidth() const = 0;
+
+        /**
+         * @brief The height of the screen in the current orientation
+         */
         virtual uint16_t ScreenHeight() const = 0;
+
+        /**
+         * Rotate the coordinate system of all drawing functions. Windows,
+         * cursors and the screen size are in rotated coordinates, and pixels
+         * are still written left to right, top to bottom inside the window.
+         *
+         * Pixels already on the screen are not moved, you must repaint them.
+         * The default implementation supports only @ref PORTRAIT.
+         *
+         * @brief Set the display orientation
+         * @param orientation The new orientation
+         * @return `false` if the orientation is not supported
+         */
+        virtual bool setOrientation(Orientation orientation) { return orientation == PORTRAIT; }
+
+        /** @brief Get the current display orientation */
+        virtual Orientation DisplayOrientation() const { return PORTRAIT; }
         
         /**
          * Set the callback function, that is called whenever the display has
@@ -148,6 +186,40 @@ namespace mono { namespace display
          * @param pixelColor The 16-bit 5-6-5 RGB color to draw
          */
         virtual void write(Color pixelColor) = 0;
+
+        /**
+         * Write a block of raw RGB565 pixels to the display, starting at the
+         * cursor position. This is equivalent to calling @ref write for each
+         * pixel, but implementations should override it to stream the pixels
+         * without the per-pixel call overhead.
+         *
+         * All pixels are sent when the method returns, so the caller can
+         * reuse the buffer right away.
+         *
+         * @brief Draw a buffer of pixels, starting at cursor position
+         * @param pixels Array of 16-bit 5-6-5 RGB pixel values
+         * @param length The number of pixels in the array
+         */
+        virtual void writeBuffer(const uint16_t *pixels, int length)
+        {
+            for (int i=0; i<length; i++)
+                write(Color((int) pixels[i]));
+        }
+
+        /**
+         * Write the same color to a run of pixels, starting at the cursor
+         * position. This is equivalent to calling @ref write `length` times,
+         * and implementations should override it with a tight loop.
+         *
+         * @brief Fill a span of pixels with one color, from cursor position
+         * @param pixelColor The 16-bit 5-6-5 RGB color to draw
+         * @param length The number of pixels to draw
+         */
+        virtual void writeFill(Color pixelColor, int length)
+        {
+            for (int i=0; i<length; i++)
+                write(pixelColor);
+        }
         
         
         /**
@@ -175,10 +247,40 @@ namespace mono { namespace display
          * @returns The current brightness level in 8-bit format: 0: off, 255: max brightness
          */
         virtual uint8_t Brightness() const = 0;
-        
-        
-        
-        
+
+        /**
+         * Controllers that can shift the displayed rows in hardware, without
+         * rewriting the pixel memory, return `true`. The default is `false`,
+         * and the other vertical scroll methods do nothing.
+         *
+         * @brief Get if the controller supports hardware vertical scrolling
+         */
+        virtual bool SupportsVerticalScroll() const { return false; }
+
+        /**
+         * Rows outside the scroll area are displayed as they are stored. Inside
+         * the area, screen row `top + r` displays the stored row
+         * `top + (r + offset) % height`.
+         *
+         * Note that the rows are shifted in their full screen width. The
+         * rows are always in the @ref PORTRAIT orientation.
+         *
+         * @brief Set the rows affected by @ref setVerticalScrollOffset
+         * @param top The first row (screen coordinates) of the scroll area
+         * @param height The number of rows in the scroll area
+         */
+        virtual void setVerticalScrollArea(int /*top*/, int /*height*/) {}
+
+        /**
+         * Shift the rows inside the scroll area up by `offset` rows. Pixels
+         * are still written to their stored (unscrolled) position. Set the
+         * offset to 0 to display the stored rows unshifted again.
+         *
+         * @brief Set the number of rows the scroll area is shifted up
+         * @param offset The shift in rows, less than the scroll area height
+         */
+        virtual void setVerticalScrollOffset(int /*offset*/) {}
+
         virtual uint16_t read() = 0;
     };
 } }
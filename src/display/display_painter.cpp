@@ -119,13 +119,11 @@ void DisplayPainter::drawPixel(geo::Point const &pos, bool background)
 void DisplayPainter::drawPixel(uint16_t x, uint16_t y, uint8_t intensity, bool bg)
 {
     displayCtrl->setWindow(x, y, 1, 1);
-    Color c;
+    uint8_t alpha = Color::Alpha(intensity);
     if (bg)
-        c = backgroundColor.alphaBlend(intensity, foregroundColor);
+        displayCtrl->write(Color::blend(backgroundColor.value, foregroundColor.value, alpha));
     else
-        c = foregroundColor.alphaBlend(intensity, backgroundColor);
-
-    displayCtrl->write(c);
+        displayCtrl->write(Color::blend(foregroundColor.value, backgroundColor.value, alpha));
 }
 
 // MARK: Rects
@@ -362,6 +360,11 @@ void DisplayPainter::drawChar(uint16_t x, uint16_t y, char character)
     }
 }
 
+const unsigned char *DisplayPainter::glyph(char character)
+{
+    return font + ((unsigned char) character)*5;
+}
+
 // MARK: Circles
 
 void DisplayPainter::drawCircle(uint16_t x0, uint16_t y0, uint16_t r, bool color)
@@ -290,6 +290,17 @@ namespace mono { namespace display {
          */
         void drawChar(uint16_t x, uint16_t y, char character);
 
+        /**
+         * Get the 5 pixel columns of a character in the font used by
+         * @ref drawChar. Bit `j` of a column is pixel row `j`, from the top.
+         * Views that render their own scanlines use this to paint text.
+         *
+         * @brief Get the font bitmap of a character
+         * @param character The text character
+         * @return Pointer to the 5 column bytes of the character
+         */
+        static const unsigned char *glyph(char character);
+
         /**
          * Helper function to draw a vertical line very fast. This method uses
          * much less communication with the display.
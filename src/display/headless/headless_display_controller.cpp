@@ -0,0 +1,385 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "headless_display_controller.h"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace mono::display;
+
+const int HeadlessDisplayController::Width;
+const int HeadlessDisplayController::Height;
+const uint32_t HeadlessDisplayController::DefaultSpiClockHz;
+const uint32_t HeadlessDisplayController::BitsPerTransfer;
+
+// SPI transfers, as the ILI9225G sends them: a register index is 1
+// transfer, register data and pixels are 2 transfers each
+static const uint32_t RegisterTransfers = 1;
+static const uint32_t DataTransfers = 2;
+
+HeadlessDisplayController::HeadlessDisplayController(uint32_t spiClock) :
+    IDisplayController(Width, Height)
+{
+    framebuffer = (uint16_t*) malloc(Width * Height * sizeof(uint16_t));
+    spiClockHz = spiClock;
+    brightness = 0;
+    LastTearningEffectTime = 0;
+
+    orientation = PORTRAIT;
+    clear(Color(0, 0, 0));
+    init();
+    resetCounters();
+}
+
+HeadlessDisplayController::~HeadlessDisplayController()
+{
+    free(framebuffer);
+}
+
+// MARK: Bus emulation
+
+void HeadlessDisplayController::writeCommand()
+{
+    commands++;
+    busTransfers += RegisterTransfers + DataTransfers;
+}
+
+int HeadlessDisplayController::panelIndex(int x, int y) const
+{
+    int panelX = x, panelY = y;
+    switch (orientation)
+    {
+        case PORTRAIT_BOTTOMUP:
+            panelX = Width - 1 - x;
+            panelY = Height - 1 - y;
+            break;
+        case LANDSCAPE_RIGHT:
+            panelX = Width - 1 - y;
+            panelY = x;
+            break;
+        case LANDSCAPE_LEFT:
+            panelX = y;
+            panelY = Height - 1 - x;
+            break;
+        case PORTRAIT:
+        default:
+            break;
+    }
+
+    if (panelX < 0 || panelX >= Width || panelY < 0 || panelY >= Height)
+        return -1;
+
+    return panelY * Width + panelX;
+}
+
+void HeadlessDisplayController::writePixel(uint16_t value)
+{
+    int index = panelIndex(cursorX, cursorY);
+    if (index >= 0)
+        framebuffer[index] = value;
+
+    pixelWrites++;
+    busTransfers += DataTransfers;
+
+    // the address counter moves right, then down, and wraps inside the window
+    if (++cursorX > windowX2)
+    {
+        cursorX = windowX1;
+        if (++cursorY > windowY2)
+            cursorY = windowY1;
+    }
+}
+
+// MARK: IDisplayController
+
+void HeadlessDisplayController::init()
+{
+    windowX1 = 0;
+    windowY1 = 0;
+    windowX2 = Width - 1;
+    windowY2 = Height - 1;
+    cursorX = cursorY = 0;
+    scrollTop = 0;
+    scrollHeight = Height;
+    scrollOffset = 0;
+    brightness = 255;
+}
+
+void HeadlessDisplayController::setWindow(int x, int y, int width, int height)
+{
+    // end points, start points and address counter, then the GRAM register
+    for (int i=0; i<6; i++)
+        writeCommand();
+
+    commands++;
+    busTransfers += RegisterTransfers;
+    windowChanges++;
+
+    windowX1 = x;
+    windowY1 = y;
+    windowX2 = x + width - 1;
+    windowY2 = y + height - 1;
+    cursorX = x;
+    cursorY = y;
+}
+
+uint16_t HeadlessDisplayController::ScreenWidth() const
+{
+    if (orientation == LANDSCAPE_RIGHT || orientation == LANDSCAPE_LEFT)
+        return Height;
+
+    return Width;
+}
+
+uint16_t HeadlessDisplayController::ScreenHeight() const
+{
+    if (orientation == LANDSCAPE_RIGHT || orientation == LANDSCAPE_LEFT)
+        return Width;
+
+    return Height;
+}
+
+bool HeadlessDisplayController::setOrientation(Orientation newOrientation)
+{
+    // the entry mode register, then the GRAM register
+    writeCommand();
+    commands++;
+    busTransfers += RegisterTransfers;
+
+    orientation = newOrientation;
+    return true;
+}
+
+IDisplayController::Orientation HeadlessDisplayController::DisplayOrientation() const
+{
+    return orientation;
+}
+
+void HeadlessDisplayController::setCursor(int x, int y)
+{
+    // address counter x and y, then the GRAM register
+    writeCommand();
+    writeCommand();
+    commands++;
+    busTransfers += RegisterTransfers;
+    cursorChanges++;
+
+    cursorX = x;
+    cursorY = y;
+}
+
+int HeadlessDisplayController::getCursorX()
+{
+    return cursorX;
+}
+
+int HeadlessDisplayController::getCursorY()
+{
+    return cursorY;
+}
+
+void HeadlessDisplayController::write(Color pixelColor)
+{
+    writePixel(pixelColor.value);
+}
+
+void HeadlessDisplayController::writeBuffer(const uint16_t *pixels, int length)
+{
+    for (int i=0; i<length; i++)
+        writePixel(pixels[i]);
+}
+
+void HeadlessDisplayController::writeFill(Color pixelColor, int length)
+{
+    for (int i=0; i<length; i++)
+        writePixel(pixelColor.value);
+}
+
+void HeadlessDisplayController::setBrightness(uint8_t value)
+{
+    brightness = value;
+}
+
+uint8_t HeadlessDisplayController::Brightness() const
+{
+    return brightness;
+}
+
+bool HeadlessDisplayController::SupportsVerticalScroll() const
+{
+    return orientation == PORTRAIT;
+}
+
+void HeadlessDisplayController::setVerticalScrollArea(int top, int height)
+{
+    // scroll end and start address, then the GRAM register
+    writeCommand();
+    writeCommand();
+    commands++;
+    busTransfers += RegisterTransfers;
+
+    scrollTop = top;
+    scrollHeight = height;
+}
+
+void HeadlessDisplayController::setVerticalScrollOffset(int offset)
+{
+    // scroll step, then the GRAM register
+    writeCommand();
+    commands++;
+    busTransfers += RegisterTransfers;
+
+    scrollOffset = offset;
+}
+
+uint16_t HeadlessDisplayController::read()
+{
+    int index = panelIndex(cursorX, cursorY);
+    return index >= 0 ? framebuffer[index] : 0;
+}
+
+// MARK: Framebuffer
+
+uint16_t HeadlessDisplayController::pixel(int x, int y) const
+{
+    if (x < 0 || x >= Width || y < 0 || y >= Height)
+        return 0;
+
+    // rows inside the scroll area show a stored row further down
+    if (scrollHeight > 0 && y >= scrollTop && y < scrollTop + scrollHeight)
+        y = scrollTop + (y - scrollTop + scrollOffset) % scrollHeight;
+
+    return framebuffer[y * Width + x];
+}
+
+const uint16_t *HeadlessDisplayController::Framebuffer() const
+{
+    return framebuffer;
+}
+
+void HeadlessDisplayController::clear(Color color)
+{
+    for (int i=0; i<Width*Height; i++)
+        framebuffer[i] = color.value;
+}
+
+uint32_t HeadlessDisplayController::countDifferences(const uint16_t *pixels) const
+{
+    uint32_t differences = 0;
+    for (int y=0; y<Height; y++)
+    {
+        for (int x=0; x<Width; x++)
+        {
+            if (pixel(x, y) != pixels[y * Width + x])
+                differences++;
+        }
+    }
+
+    return differences;
+}
+
+// MARK: Bus statistics
+
+uint32_t HeadlessDisplayController::Commands() const
+{
+    return commands;
+}
+
+uint32_t HeadlessDisplayController::PixelWrites() const
+{
+    return pixelWrites;
+}
+
+uint32_t HeadlessDisplayController::WindowChanges() const
+{
+    return windowChanges;
+}
+
+uint32_t HeadlessDisplayController::CursorChanges() const
+{
+    return cursorChanges;
+}
+
+uint32_t HeadlessDisplayController::BusTransfers() const
+{
+    return busTransfers;
+}
+
+uint32_t HeadlessDisplayController::BusTimeUs() const
+{
+    uint64_t bits = (uint64_t) busTransfers * BitsPerTransfer;
+    return (uint32_t) (bits * 1000000 / spiClockHz);
+}
+
+void HeadlessDisplayController::resetCounters()
+{
+    commands = 0;
+    pixelWrites = 0;
+    windowChanges = 0;
+    cursorChanges = 0;
+    busTransfers = 0;
+}
+
+// MARK: Images
+
+bool HeadlessDisplayController::writePPM(FILE *file) const
+{
+    if (file == 0)
+        return false;
+
+    fprintf(file, "P6\n%i %i\n255\n", Width, Height);
+
+    uint8_t row[Width * 3];
+    for (int y=0; y<Height; y++)
+    {
+        for (int x=0; x<Width; x++)
+        {
+            uint16_t value = pixel(x, y);
+            uint8_t r = (value >> 11) & 0x1F, g = (value >> 5) & 0x3F, b = value & 0x1F;
+
+            // expand to 8 bits, so white is 255
+            row[x*3] = (r << 3) | (r >> 2);
+            row[x*3+1] = (g << 2) | (g >> 4);
+            row[x*3+2] = (b << 3) | (b >> 2);
+        }
+
+        if (fwrite(row, 1, sizeof(row), file) != sizeof(row))
+            return false;
+    }
+
+    return true;
+}
+
+bool HeadlessDisplayController::savePPM(const char *path) const
+{
+    FILE *file = fopen(path, "wb");
+    if (file == 0)
+        return false;
+
+    bool success = writePPM(file);
+    fclose(file);
+    return success;
+}
+
+bool HeadlessDisplayController::readPPM(FILE *file, uint16_t *pixels)
+{
+    int width = 0, height = 0, maxValue = 0;
+    if (file == 0 || fscanf(file, "P6 %i %i %i", &width, &height, &maxValue) != 3)
+        return false;
+
+    if (width != Width || height != Height || maxValue != 255)
+        return false;
+
+    fgetc(file); // the single white space after the header
+
+    uint8_t rgb[3];
+    for (int i=0; i<Width*Height; i++)
+    {
+        if (fread(rgb, 1, 3, file) != 3)
+            return false;
+
+        pixels[i] = ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3);
+    }
+
+    return true;
+}
@@ -0,0 +1,172 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef headless_display_controller_h
+#define headless_display_controller_h
+
+#include "../display_controller_interface.h"
+#include <stdio.h>
+
+namespace mono { namespace display {
+
+    /**
+     * @brief Display controller that draws into a framebuffer in memory
+     *
+     * This controller is for the host, where there is no display. It keeps
+     * a 176x220 RGB565 framebuffer and follows the window and cursor rules
+     * of the @ref ILI9225G: pixels are written left to right from the
+     * cursor, and wrap to the start of the next line at the right edge of
+     * the window. After the last pixel in the window, the cursor wraps to
+     * the top left corner.
+     *
+     * Like the ILI9225G, it supports vertical scrolling: the framebuffer
+     * holds the stored pixels, and @ref pixel returns what the screen shows.
+     * It also supports rotation. Windows and cursors are then in rotated
+     * coordinates, while the framebuffer and @ref pixel stay in the
+     * portrait orientation of the panel.
+     *
+     * It also counts the commands and pixels, that the ILI9225G would send
+     * over its 9-bit SPI bus, and computes the time that would take at a
+     * given SPI clock. Use it to benchmark drawing code, and to compare the
+     * rendered pixels with golden images.
+     *
+     * @code
+     * HeadlessDisplayController display;
+     * TextRender tr(&display);
+     * tr.drawInRect(rect, "Hello", FreeSans9pt7b);
+     * display.savePPM("hello.ppm");
+     * @endcode
+     */
+    class HeadlessDisplayController : public IDisplayController
+    {
+    public:
+
+        static const int Width = 176;
+        static const int Height = 220;
+
+        /** The default SPI clock, used to compute the bus time */
+        static const uint32_t DefaultSpiClockHz = 16000000;
+
+        /** The number of bits in each SPI transfer, 8 data bits and data/command bit */
+        static const uint32_t BitsPerTransfer = 9;
+
+    protected:
+
+        uint16_t *framebuffer;
+        int windowX1, windowY1, windowX2, windowY2;
+        int cursorX, cursorY;
+        int scrollTop, scrollHeight, scrollOffset;
+        Orientation orientation;
+        uint8_t brightness;
+        uint32_t spiClockHz;
+
+        uint32_t commands, pixelWrites, windowChanges, cursorChanges, busTransfers;
+
+        void writeCommand();
+        void writePixel(uint16_t value);
+
+        /** The framebuffer index of a point in rotated coordinates, -1 outside */
+        int panelIndex(int x, int y) const;
+
+        HeadlessDisplayController(const HeadlessDisplayController &);
+        HeadlessDisplayController &operator=(const HeadlessDisplayController &);
+
+    public:
+
+        /**
+         * @brief Create a controller with a black framebuffer
+         * @param spiClockHz The SPI clock used to compute @ref BusTimeUs
+         */
+        HeadlessDisplayController(uint32_t spiClockHz = DefaultSpiClockHz);
+
+        ~HeadlessDisplayController();
+
+        // MARK: IDisplayController
+
+        void init();
+        void setWindow(int x, int y, int width, int height);
+        uint16_t ScreenWidth() const;
+        uint16_t ScreenHeight() const;
+        bool setOrientation(Orientation orientation);
+        Orientation DisplayOrientation() const;
+        void setCursor(int x, int y);
+        int getCursorX();
+        int getCursorY();
+        void write(Color pixelColor);
+        void writeBuffer(const uint16_t *pixels, int length);
+        void writeFill(Color pixelColor, int length);
+        void setBrightness(uint8_t value);
+        uint8_t Brightness() const;
+        bool SupportsVerticalScroll() const;
+        void setVerticalScrollArea(int top, int height);
+        void setVerticalScrollOffset(int offset);
+
+        /** @brief Read the stored pixel at the cursor, the cursor is not moved */
+        uint16_t read();
+
+        // MARK: Framebuffer
+
+        /** @brief The RGB565 value a screen pixel shows, 0 outside the screen */
+        uint16_t pixel(int x, int y) const;
+
+        /** @brief The stored pixels, `Width * Height` row by row, not scrolled */
+        const uint16_t *Framebuffer() const;
+
+        /** @brief Set all pixels to a color, this is not counted as bus traffic */
+        void clear(Color color);
+
+        /**
+         * @brief Count the screen pixels that differ from another framebuffer
+         * @param pixels `Width * Height` RGB565 pixels, like from @ref readPPM
+         */
+        uint32_t countDifferences(const uint16_t *pixels) const;
+
+        // MARK: Bus statistics
+
+        /** @brief The number of register commands, a pixel write is not a command */
+        uint32_t Commands() const;
+
+        /** @brief The number of pixels written */
+        uint32_t PixelWrites() const;
+
+        /** @brief The number of calls to @ref setWindow */
+        uint32_t WindowChanges() const;
+
+        /** @brief The number of calls to @ref setCursor */
+        uint32_t CursorChanges() const;
+
+        /** @brief The number of 9-bit SPI transfers */
+        uint32_t BusTransfers() const;
+
+        /** @brief The time the SPI transfers would take, in microseconds */
+        uint32_t BusTimeUs() const;
+
+        /** @brief Set all counters to zero */
+        void resetCounters();
+
+        // MARK: Images
+
+        /**
+         * @brief Write the screen pixels as a binary PPM (P6) image
+         * @return `false` if the file could not be written
+         */
+        bool writePPM(FILE *file) const;
+
+        /** @brief Save the screen pixels as a PPM image file */
+        bool savePPM(const char *path) const;
+
+        /**
+         * @brief Read a 176x220 binary PPM image into RGB565 pixels
+         *
+         * Use it to load golden images, saved with @ref savePPM.
+         *
+         * @param file The image file
+         * @param pixels Buffer for `Width * Height` pixels
+         * @return `false` if the file is not a 176x220 P6 image
+         */
+        static bool readPPM(FILE *file, uint16_t *pixels);
+    };
+
+} }
+
+#endif /* headless_display_controller_h */
@@ -11,6 +11,7 @@ extern "C" {
 
 #include <ili9225g.h>
 #include <consoles.h>
+#include <tracer.h>
 #include <application_context_interface.h>
 #include "act8600_power_system.h"
 
@@ -18,14 +19,20 @@ extern "C" {
 
 using namespace mono::display;
 
+// the native (portrait) size of the panel
+static const int PanelWidth = 176;
+static const int PanelHeight = 220;
+
 ILI9225G::ILI9225G() : IDisplayController(176,220),
     spi(TFT_SPI_MOSI, TFT_SPI_MISO, TFT_SPI_CLK, TFT_SPI_CS),
     Reset(TFT_RESET, 0),
     RegisterSelect(TFT_REGISTER_SELECT, 1),
     IM0(TFT_IM0, 1),
     tearingEffect(TFT_TEARING_EFFECT),
-    curWindow(0,0,ScreenWidth(), ScreenHeight())
+    curWindow(0,0,PanelWidth, PanelHeight)
 {
+    orientation = PORTRAIT;
+
     setBrightness(0);
 
     tearingEffect.mode(PullNone);
@@ -55,7 +62,7 @@ void ILI9225G::init()
     writeCommand(0xc7, 0x030f);
     writeCommand(0x01, 0x011C);
     writeCommand(0x02, 0x0100);
-    writeCommand(0x03, 0x1030);
+    writeEntryMode();
     writeCommand(0x07, 0x0000);
     writeCommand(0x08, 0x0808);
     writeCommand(0x0F, 0x0601);
@@ -101,13 +108,11 @@ void ILI9225G::init()
 
     RegisterSelect = 1;
 
-    int start = us_ticker_read();
-
+    MONO_TRACE_BEGIN("ILI9225G clear");
     for (int i=0; i<176*220; i++) {
         this->write(ui::View::StandardBackgroundColor);
     }
-    int end = us_ticker_read();
-    debug("\r\ndisplay full paint time: %i\r\n",end-start);
+    MONO_TRACE_END("ILI9225G clear");
 
     PWM_Start();
     setBrightness(255);
@@ -129,18 +134,104 @@ void ILI9225G::setWindow(int x, int y, int width, int height)
 //        0x21, 0, y,
 //        0x22
 //    };
-    writeCommand(0x36, x + width - 1); 					//x end point
-    writeCommand(0x37, x);							//x start point
-    writeCommand(0x38, y + height - 1); 					    //y end point
-    writeCommand(0x39, y);	                        //y start point
+    int x1, y1, x2, y2, startX, startY;
+    toPanelWindow(x, y, width, height, x1, y1, x2, y2, startX, startY);
+
+    writeCommand(0x36, x2); 					//x end point
+    writeCommand(0x37, x1);							//x start point
+    writeCommand(0x38, y2); 					    //y end point
+    writeCommand(0x39, y1);	                        //y start point
 
     // Set the initial value of address Counter
-    writeCommand(0x20, x);
-    writeCommand(0x21, y);
+    writeCommand(0x20, startX);
+    writeCommand(0x21, startY);
     writeRegister(0x22);
     RegisterSelect = 1;
 }
 
+void ILI9225G::toPanelWindow(int x, int y, int width, int height,
+                             int &panelX1, int &panelY1, int &panelX2, int &panelY2,
+                             int &startX, int &startY) const
+{
+    // the entry mode makes the address counter start in the corner, that
+    // is the upper left corner in the rotated coordinates
+    switch (orientation)
+    {
+        case PORTRAIT_BOTTOMUP:
+            panelX1 = PanelWidth - x - width;
+            panelY1 = PanelHeight - y - height;
+            panelX2 = PanelWidth - 1 - x;
+            panelY2 = PanelHeight - 1 - y;
+            startX = panelX2;
+            startY = panelY2;
+            break;
+        case LANDSCAPE_RIGHT:
+            panelX1 = PanelWidth - y - height;
+            panelY1 = x;
+            panelX2 = PanelWidth - 1 - y;
+            panelY2 = x + width - 1;
+            startX = panelX2;
+            startY = panelY1;
+            break;
+        case LANDSCAPE_LEFT:
+            panelX1 = y;
+            panelY1 = PanelHeight - x - width;
+            panelX2 = y + height - 1;
+            panelY2 = PanelHeight - 1 - x;
+            startX = panelX1;
+            startY = panelY2;
+            break;
+        case PORTRAIT:
+        default:
+            panelX1 = x;
+            panelY1 = y;
+            panelX2 = x + width - 1;
+            panelY2 = y + height - 1;
+            startX = panelX1;
+            startY = panelY1;
+            break;
+    }
+}
+
+void ILI9225G::writeEntryMode()
+{
+    // BGR, then the address counter direction: ID0 is horizontal increment,
+    // ID1 vertical increment and AM updates vertically first
+    uint16_t mode;
+    switch (orientation)
+    {
+        case PORTRAIT_BOTTOMUP:
+            mode = 0x1000;                          // ID = 00, AM = 0
+            break;
+        case LANDSCAPE_RIGHT:
+            mode = 0x1028;                          // ID = 10, AM = 1
+            break;
+        case LANDSCAPE_LEFT:
+            mode = 0x1018;                          // ID = 01, AM = 1
+            break;
+        case PORTRAIT:
+        default:
+            mode = 0x1030;                          // ID = 11, AM = 0
+            break;
+    }
+
+    writeCommand(0x03, mode);
+}
+
+bool ILI9225G::setOrientation(Orientation newOrientation)
+{
+    orientation = newOrientation;
+    writeEntryMode();
+    writeRegister(0x22);
+    RegisterSelect = 1;
+    return true;
+}
+
+IDisplayController::Orientation ILI9225G::DisplayOrientation() const
+{
+    return orientation;
+}
+
 void ILI9225G::tearingEffectHandler()
 {
     LastTearningEffectTime = us_ticker_read();
@@ -165,20 +256,29 @@ void ILI9225G::tearingWatchdogHandler()
 
 uint16_t ILI9225G::ScreenWidth() const
 {
-    return 176;
+    if (orientation == LANDSCAPE_RIGHT || orientation == LANDSCAPE_LEFT)
+        return PanelHeight;
+
+    return PanelWidth;
 }
 
 uint16_t ILI9225G::ScreenHeight() const
 {
-    return 220;
+    if (orientation == LANDSCAPE_RIGHT || orientation == LANDSCAPE_LEFT)
+        return PanelWidth;
+
+    return PanelHeight;
 }
 
 
 void ILI9225G::setCursor(int x, int y)
 {
+    int x1, y1, x2, y2, startX, startY;
+    toPanelWindow(x, y, 1, 1, x1, y1, x2, y2, startX, startY);
+
     // Set the initial value of address Counter
-    writeCommand(0x20, x);
-    writeCommand(0x21, y);
+    writeCommand(0x20, startX);
+    writeCommand(0x21, startY);
     writeRegister(0x22);
     RegisterSelect = 1;
 }
@@ -201,6 +301,30 @@ void ILI9225G::write(Color pixelColor)
     SPI1_WriteTxData(0x0100 | pixelColor.value);
 }
 
+void ILI9225G::writeBuffer(const uint16_t *pixels, int length)
+{
+    // SPI1 is CPU fed (no DMA), so all pixels are pushed before we return.
+    // Pushing from a tight loop avoids the virtual call per pixel.
+    const uint16_t *end = pixels + length;
+    while (pixels < end)
+    {
+        uint16_t pixel = *pixels++;
+        SPI1_WriteTxData(0x0100 | (pixel >> 8));
+        SPI1_WriteTxData(0x0100 | (pixel & 0xFF));
+    }
+}
+
+void ILI9225G::writeFill(Color pixelColor, int length)
+{
+    uint16_t high = 0x0100 | (pixelColor.value >> 8);
+    uint16_t low = 0x0100 | (pixelColor.value & 0xFF);
+    while (length-- > 0)
+    {
+        SPI1_WriteTxData(high);
+        SPI1_WriteTxData(low);
+    }
+}
+
 void ILI9225G::writeData(uint16_t data)
 {
 
@@ -238,6 +362,28 @@ uint8_t ILI9225G::Brightness() const
     return PWM_ReadCompare1();
 }
 
+bool ILI9225G::SupportsVerticalScroll() const
+{
+    // the scroll area is panel rows, only rows in portrait
+    return orientation == PORTRAIT;
+}
+
+void ILI9225G::setVerticalScrollArea(int top, int height)
+{
+    writeCommand(0x31, top + height - 1);           //scroll end address
+    writeCommand(0x32, top);                        //scroll start address
+
+    // back to GRAM, so following pixel writes are not lost
+    writeRegister(0x22);
+    RegisterSelect = 1;
+}
+
+void ILI9225G::setVerticalScrollOffset(int offset)
+{
+    writeCommand(0x33, offset);                     //scroll step
+    writeRegister(0x22);
+    RegisterSelect = 1;
+}
 
 /// Power Aware protocol
 
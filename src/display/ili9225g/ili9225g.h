@@ -34,6 +34,20 @@ namespace mono { namespace display {
         
         mono::geo::Rect curWindow;
         
+        Orientation orientation;
+        
+        /** Write the entry mode register, for the current orientation */
+        void writeEntryMode();
+        
+        /**
+         * Map a window in rotated coordinates to the panel's native
+         * (portrait) coordinates, and find the corner where the address
+         * counter starts.
+         */
+        void toPanelWindow(int x, int y, int width, int height,
+                           int &panelX1, int &panelY1, int &panelX2, int &panelY2,
+                           int &startX, int &startY) const;
+        
         void writeData(uint16_t data);
         
         void writeRegister(uint16_t regData);
@@ -56,6 +70,8 @@ namespace mono { namespace display {
         
         void taskHandler();
         
+        const char *taskName() const { return "display"; }
+        
     public:
         
         ILI9225G();
@@ -67,16 +83,25 @@ namespace mono { namespace display {
         uint16_t ScreenWidth() const;
         uint16_t ScreenHeight() const;
         
+        bool setOrientation(Orientation orientation);
+        Orientation DisplayOrientation() const;
+        
         void setCursor(int x, int y);
         
         int getCursorX();
         int getCursorY();
         
         void write(Color pixelColor);
+        void writeBuffer(const uint16_t *pixels, int length);
+        void writeFill(Color pixelColor, int length);
         uint16_t read();
         
         void setBrightness(uint8_t value);
         uint8_t Brightness() const;
+
+        bool SupportsVerticalScroll() const;
+        void setVerticalScrollArea(int top, int height);
+        void setVerticalScrollOffset(int offset);
     };
     
     
@@ -19,6 +19,41 @@ namespace mono { namespace display {
         uint16_t height;    /**< The icons height in pixels */
         uint8_t *bitmap;    /**< The raw icon pixel data */
     } MonoIcon;
+
+    /**
+     * @brief Run types in a run-length compressed icon, see @ref MonoRleIcon
+     */
+    enum MonoRleRunType
+    {
+        RLE_RUN_BACKGROUND = 0x00,  /**< Run of pixels with blend value 0 */
+        RLE_RUN_FOREGROUND = 0x40,  /**< Run of pixels with blend value 255 */
+        RLE_RUN_BLENDED = 0x80,     /**< Run followed by one blend value per pixel */
+        RLE_RUN_TYPE_MASK = 0xC0,
+        RLE_RUN_LENGTH_MASK = 0x3F
+    };
+
+    /**
+     * @brief A run-length compressed icon for the Mono's icon system
+     *
+     * Most pixels in an icon are either fully background or fully foreground,
+     * only the edges are blended. This format stores the icon as a row-first
+     * sequence of runs, and runs may continue across line ends.
+     *
+     * Each run starts with a header byte. The upper 2 bits are the
+     * @ref MonoRleRunType and the lower 6 bits are the run length minus one
+     * (1 to 64 pixels). A `RLE_RUN_BLENDED` header is followed by the blend
+     * values of its pixels, the two other run types have no payload.
+     *
+     * Create these icons with the `resources/img2rleicon.py` tool.
+     *
+     * @see mono::ui::IconView
+     */
+    typedef struct {
+        uint16_t width;         /**< The icons width in pixels */
+        uint16_t height;        /**< The icons height in pixels */
+        uint16_t length;        /**< The length of the run data in bytes */
+        const uint8_t *runs;    /**< The compressed run data */
+    } MonoRleIcon;
     
 } }
 
@@ -0,0 +1,191 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "sprite_cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace mono::display;
+
+// MARK: Key
+
+SpriteCache::Key::Key() : source(0), variant(0), width(0), height(0)
+{
+}
+
+SpriteCache::Key::Key(const void *src, uint32_t vari, uint16_t w, uint16_t h) :
+    source(src), variant(vari), width(w), height(h)
+{
+}
+
+bool SpriteCache::Key::operator==(const Key &other) const
+{
+    return source == other.source && variant == other.variant &&
+           width == other.width && height == other.height;
+}
+
+// MARK: Constructors
+
+SpriteCache::SpriteCache(uint32_t arenaBytes)
+{
+    arena = (uint8_t*) malloc(arenaBytes);
+    arenaSize = arena != 0 ? arenaBytes : 0;
+    ownsArena = true;
+    used = 0;
+    entryCount = 0;
+    useClock = 0;
+    resetStatistics();
+}
+
+SpriteCache::SpriteCache(void *arenaBuffer, uint32_t arenaBytes)
+{
+    arena = (uint8_t*) arenaBuffer;
+    arenaSize = arena != 0 ? arenaBytes : 0;
+    ownsArena = false;
+    used = 0;
+    entryCount = 0;
+    useClock = 0;
+    resetStatistics();
+}
+
+SpriteCache::~SpriteCache()
+{
+    if (ownsArena && arena != 0)
+        free(arena);
+}
+
+// MARK: Cache
+
+const uint16_t *SpriteCache::lookup(const Key &key)
+{
+    int index = find(key);
+    if (index < 0)
+    {
+        misses++;
+        return 0;
+    }
+
+    hits++;
+    entries[index].lastUse = ++useClock;
+    return (const uint16_t*) (arena + entries[index].offset);
+}
+
+uint16_t *SpriteCache::insert(const Key &key)
+{
+    uint32_t size = (uint32_t) key.width * key.height * sizeof(uint16_t);
+    if (size == 0 || size > arenaSize)
+        return 0;
+
+    int existing = find(key);
+    if (existing >= 0)
+        evict(existing);
+
+    while (entryCount > 0 && (used + size > arenaSize || entryCount == MaxEntries))
+    {
+        int lru = 0;
+        for (int i=1; i<entryCount; i++)
+        {
+            if (entries[i].lastUse < entries[lru].lastUse)
+                lru = i;
+        }
+
+        evict(lru);
+        evictions++;
+    }
+
+    Entry &entry = entries[entryCount++];
+    entry.key = key;
+    entry.offset = used;
+    entry.size = size;
+    entry.lastUse = ++useClock;
+    used += size;
+
+    return (uint16_t*) (arena + entry.offset);
+}
+
+void SpriteCache::invalidate(const void *source)
+{
+    for (int i=entryCount-1; i>=0; i--)
+    {
+        if (entries[i].key.source == source)
+            evict(i);
+    }
+}
+
+void SpriteCache::clear()
+{
+    entryCount = 0;
+    used = 0;
+}
+
+// MARK: Protected
+
+int SpriteCache::find(const Key &key) const
+{
+    for (int i=0; i<entryCount; i++)
+    {
+        if (entries[i].key == key)
+            return i;
+    }
+
+    return -1;
+}
+
+void SpriteCache::evict(int index)
+{
+    Entry removed = entries[index];
+    uint32_t tail = removed.offset + removed.size;
+
+    // compact the arena, by moving all sprites after the removed one down
+    memmove(arena + removed.offset, arena + tail, used - tail);
+    used -= removed.size;
+
+    for (int i=index; i<entryCount-1; i++)
+        entries[i] = entries[i+1];
+    entryCount--;
+
+    for (int i=0; i<entryCount; i++)
+    {
+        if (entries[i].offset > removed.offset)
+            entries[i].offset -= removed.size;
+    }
+}
+
+// MARK: Statistics
+
+void SpriteCache::resetStatistics()
+{
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
+
+uint32_t SpriteCache::Hits() const
+{
+    return hits;
+}
+
+uint32_t SpriteCache::Misses() const
+{
+    return misses;
+}
+
+uint32_t SpriteCache::Evictions() const
+{
+    return evictions;
+}
+
+int SpriteCache::Count() const
+{
+    return entryCount;
+}
+
+uint32_t SpriteCache::BytesUsed() const
+{
+    return used;
+}
+
+uint32_t SpriteCache::Capacity() const
+{
+    return arenaSize;
+}
@@ -0,0 +1,164 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef sprite_cache_h
+#define sprite_cache_h
+
+#include <stdint.h>
+
+namespace mono { namespace display {
+
+    /**
+     * @brief A bounded LRU cache of pre-rendered RGB565 sprites in RAM
+     *
+     * Views that repeatedly draw the same content, like status icons or small
+     * images from the SD card, can keep the rendered pixels here. On a cache
+     * hit the pixels are written straight to the display, with no file reads
+     * or color blending.
+     *
+     * The cache stores sprites in one arena of a fixed byte size. The arena is
+     * allocated once, or you can provide a static buffer. When a new sprite
+     * does not fit, the least recently used sprites are evicted. The arena is
+     * kept compact: eviction moves the remaining sprites together, so there is
+     * no fragmentation.
+     *
+     * Sprites are identified by a @ref Key: the source object (the icon or
+     * image), a variant (like the colors an icon is blended with) and the
+     * pixel size. The cache does not know when a source changes, call
+     * @ref invalidate if you change an image file or icon data.
+     *
+     * Views opt in with `setSpriteCache`, see @ref mono::ui::ImageView and
+     * @ref mono::ui::IconView. One cache can be shared by many views.
+     *
+     * @code
+     * static SpriteCache iconCache(4096); // 4 KB arena
+     * wifiIcon.setSpriteCache(&iconCache);
+     * batteryIcon.setSpriteCache(&iconCache);
+     * @endcode
+     */
+    class SpriteCache
+    {
+    public:
+
+        /** @brief Identifies a rendered sprite */
+        struct Key
+        {
+            const void *source;     /**< The object the sprite is rendered from */
+            uint32_t variant;       /**< Render parameters, like colors or crop offset */
+            uint16_t width;         /**< Sprite width in pixels */
+            uint16_t height;        /**< Sprite height in pixels */
+
+            Key();
+            Key(const void *source, uint32_t variant, uint16_t width, uint16_t height);
+
+            bool operator==(const Key &other) const;
+        };
+
+        /** The maximum number of sprites in a cache, regardless of size */
+        static const int MaxEntries = 16;
+
+    protected:
+
+        struct Entry
+        {
+            Key key;
+            uint32_t offset;
+            uint32_t size;
+            uint32_t lastUse;
+        };
+
+        uint8_t *arena;
+        uint32_t arenaSize;
+        uint32_t used;
+        bool ownsArena;
+
+        Entry entries[MaxEntries];
+        int entryCount;
+        uint32_t useClock;
+
+        uint32_t hits, misses, evictions;
+
+        int find(const Key &key) const;
+        void evict(int index);
+
+        SpriteCache(const SpriteCache &);
+        SpriteCache &operator=(const SpriteCache &);
+
+    public:
+
+        /**
+         * @brief Create a cache, and allocate an arena of the given size
+         * @param arenaBytes The arena size in bytes
+         */
+        SpriteCache(uint32_t arenaBytes);
+
+        /**
+         * @brief Create a cache that uses a buffer you provide as arena
+         *
+         * The buffer must be 16-bit aligned and stay around for as long as
+         * the cache.
+         *
+         * @param arenaBuffer The arena buffer
+         * @param arenaBytes The size of the buffer in bytes
+         */
+        SpriteCache(void *arenaBuffer, uint32_t arenaBytes);
+
+        ~SpriteCache();
+
+        /**
+         * @brief Get the pixels of a cached sprite
+         *
+         * A hit marks the sprite as most recently used.
+         *
+         * @param key The sprite to look up
+         * @returns The `width*height` RGB565 pixels, or `NULL` on a miss
+         */
+        const uint16_t *lookup(const Key &key);
+
+        /**
+         * @brief Reserve space for a new sprite
+         *
+         * Evicts least recently used sprites until the new one fits. An
+         * existing sprite with the same key is replaced. You must fill the
+         * returned buffer with the rendered pixels, before the next call to
+         * any method on the cache.
+         *
+         * @param key The sprite to add
+         * @returns A buffer for `width*height` pixels, or `NULL` if the sprite is larger than the arena
+         */
+        uint16_t *insert(const Key &key);
+
+        /**
+         * @brief Remove all sprites rendered from a source
+         * @param source The source object, as given in the @ref Key
+         */
+        void invalidate(const void *source);
+
+        /** @brief Remove all sprites, statistics are kept */
+        void clear();
+
+        /** @brief Reset the hit, miss and eviction counters */
+        void resetStatistics();
+
+        /** @brief The number of successful lookups */
+        uint32_t Hits() const;
+
+        /** @brief The number of lookups that did not find a sprite */
+        uint32_t Misses() const;
+
+        /** @brief The number of sprites evicted to make room for new ones */
+        uint32_t Evictions() const;
+
+        /** @brief The number of sprites in the cache */
+        int Count() const;
+
+        /** @brief The number of arena bytes used by sprites */
+        uint32_t BytesUsed() const;
+
+        /** @brief The arena size in bytes */
+        uint32_t Capacity() const;
+    };
+
+} }
+
+#endif /* sprite_cache_h */
@@ -4,6 +4,7 @@
 #include "text_render.h"
 #include <view.h>
 #include <mbed_debug.h>
+#include <string.h>
 
 using namespace mono::display;
 
@@ -160,6 +161,126 @@ void TextRender::drawInRect(const geo::Rect &rect, const String text, const GFXf
                                    this, &TextRender::drawChar, lineLayout);
 }
 
+void TextRender::drawOpaqueInRect(const geo::Rect &rect, String text, const GFXfont &fontFace, bool lineLayout)
+{
+    if (dispCtrl == 0 || rect.Width() <= 0 || rect.Height() <= 0)
+        return;
+
+    int width = rect.Width() < ScanlineLength ? rect.Width() : ScanlineLength;
+    dispCtrl->setWindow(rect.X(), rect.Y(), width, rect.Height());
+
+    if (text.Length() == 0)
+    {
+        dispCtrl->writeFill(backgroundColor, width*rect.Height());
+        return;
+    }
+
+    geo::Rect offset = renderInRect(rect, text, fontFace, lineLayout);
+    int lineHeight;
+    if (lineLayout)
+        lineHeight = fontFace.yAdvance;
+    else
+        lineHeight = offset.Height() - calcUnderBaseline(text, fontFace);
+
+    // Glyphs never reach further than one line advance from the baseline,
+    // and the lines are one advance apart, so at most two lines reach a
+    // scanline. Each line is laid out once, when it comes into reach.
+    struct LineLayout
+    {
+        const char *text;
+        int x, baseline;
+        bool first;
+    };
+    LineLayout reach[2];
+    int reachCount = 0;
+
+    const char *nextLine = text();
+    int nextBaseline = offset.Y() + lineHeight;
+    uint16_t scanline[ScanlineLength];
+
+    for (int y=rect.Y(); y<rect.Y2(); y++)
+    {
+        for (int x=0; x<width; x++)
+            scanline[x] = backgroundColor.value;
+
+        while (reachCount > 0 && y >= reach[0].baseline + fontFace.yAdvance)
+        {
+            reach[0] = reach[1];
+            reachCount--;
+        }
+
+        while (nextLine != 0 && y >= nextBaseline - fontFace.yAdvance && reachCount < 2)
+        {
+            if (y < nextBaseline + fontFace.yAdvance)
+            {
+                LineLayout &line = reach[reachCount++];
+                line.text = nextLine;
+                line.baseline = nextBaseline;
+                line.first = nextLine == text();
+                // the first line is aligned by renderInRect, like layoutInRect does
+                line.x = line.first ? offset.X() : alignedX(rect, remainingTextlineWidth(fontFace, nextLine));
+            }
+
+            nextLine = strchr(nextLine, '\n');
+            if (nextLine != 0)
+            {
+                nextLine++;
+                nextBaseline += fontFace.yAdvance;
+            }
+        }
+
+        for (int i=0; i<reachCount; i++)
+            rasterizeLineRow(scanline, width, rect, reach[i].text, reach[i].x,
+                             reach[i].baseline, y, fontFace, reach[i].first);
+
+        dispCtrl->writeBuffer(scanline, width);
+    }
+}
+
+void TextRender::rasterizeLineRow(uint16_t *scanline, int length, const geo::Rect &bounds,
+                                  const char *text, int x, int baseline, int y,
+                                  const GFXfont &font, bool firstLine)
+{
+    bool firstChar = firstLine;
+
+    while (*text != '\0' && *text != '\n')
+    {
+        const GFXglyph *glyph = &font.glyph[*text - font.first];
+
+        if (x + glyph->width <= bounds.X2())
+        {
+            if (firstChar)
+                x -= glyph->xOffset;
+
+            int glyphX = x + glyph->xOffset;
+            int glyphY = baseline + glyph->yOffset;
+            int row = y - glyphY;
+
+            // same clipping as drawChar: only glyphs fully inside bounds
+            if (row >= 0 && row < glyph->height &&
+                glyphX >= bounds.X() && glyphY >= bounds.Y() &&
+                glyphX + glyph->width <= bounds.X2() &&
+                glyphY + glyph->height <= bounds.Y2())
+            {
+                const uint8_t *bitmap = font.bitmap + glyph->bitmapOffset;
+                uint32_t bit = row * glyph->width;
+                int pixel = glyphX - bounds.X();
+
+                for (int xx=0; xx<glyph->width; xx++, bit++, pixel++)
+                {
+                    if ((bitmap[bit >> 3] & (0x80 >> (bit & 7))) && pixel < length)
+                        scanline[pixel] = foregroundColor.value;
+                }
+            }
+
+            x += glyph->xAdvance;
+        }
+
+        firstChar = false;
+        text++;
+    }
+}
+
 void TextRender::drawChar(const geo::Point &position, const GFXfont &gfxFont, const GFXglyph *glyph, geo::Rect const &bounds, int lineHeight)
 {
     uint8_t  *bitmap = (uint8_t *)gfxFont.bitmap;
@@ -297,21 +418,282 @@ mono::geo::Rect TextRender::renderInRect(const geo::Rect &rect, mono::String tex
         }
     }
     
-    //uint32_t textWidth = remainingTextlineWidth(fontFace, text.stringData);
-    if (dim.Width() < rect.Width())
+    offset.setX(alignedX(rect, dim.Width()));
+    
+    return geo::Rect(offset, dim);
+}
+
+// MARK: Anti-aliased Fonts
+
+void TextRender::drawInRect(const geo::Rect &rect, String text, const AAFont &fontFace)
+{
+    if (dispCtrl == 0 || rect.Width() <= 0 || rect.Height() <= 0)
+        return;
+
+    int width = rect.Width() < ScanlineLength ? rect.Width() : ScanlineLength;
+    dispCtrl->setWindow(rect.X(), rect.Y(), width, rect.Height());
+
+    if (text.Length() == 0)
+    {
+        dispCtrl->writeFill(backgroundColor, width*rect.Height());
+        return;
+    }
+
+    // blend once per draw call, not once per pixel
+    uint16_t palette[16];
+    for (int i=0; i<16; i++)
+        palette[i] = foregroundColor.alphaBlend(i*17, backgroundColor).value;
+
+    geo::Rect offset = renderInRect(rect, text, fontFace);
+
+    // Glyphs are assumed to reach no further than one line advance above
+    // their line, and two below, and the lines are one advance apart. So at
+    // most three lines reach a scanline. Each is laid out when it comes into
+    // reach, and dropped below its last pixel row.
+    AALineLayout reach[3];
+    int reachCount = 0;
+
+    const char *nextLine = text();
+    int nextLineY = offset.Y();
+    uint16_t scanline[ScanlineLength];
+
+    for (int y=rect.Y(); y<rect.Y2(); y++)
+    {
+        for (int x=0; x<width; x++)
+            scanline[x] = palette[0];
+
+        for (int i=0; i<reachCount; i++)
+        {
+            if (y >= reach[i].bottom)
+            {
+                for (int j=i+1; j<reachCount; j++)
+                    reach[j-1] = reach[j];
+                reachCount--;
+                i--;
+            }
+        }
+
+        while (nextLine != 0 && y >= nextLineY - fontFace.yAdvance && reachCount < 3)
+        {
+            AALineLayout &line = reach[reachCount];
+            layoutLine(line, rect, width, nextLine, nextLineY, fontFace);
+            if (y < line.bottom)
+                reachCount++;
+
+            nextLine = strchr(nextLine, '\n');
+            if (nextLine != 0)
+            {
+                nextLine++;
+                nextLineY += fontFace.yAdvance;
+            }
+        }
+
+        for (int i=0; i<reachCount; i++)
+        {
+            const AALineLayout &line = reach[i];
+            if (y < line.top)
+                continue;
+
+            if (line.glyphCount >= 0)
+                rasterizeLineRow(scanline, width, rect, line, y, fontFace, palette);
+            else
+                rasterizeLineRow(scanline, width, rect, line.text, line.x, line.baseline, y, fontFace, palette);
+        }
+
+        dispCtrl->writeBuffer(scanline, width);
+    }
+}
+
+void TextRender::layoutLine(AALineLayout &line, const geo::Rect &bounds, int length,
+                            const char *text, int lineY, const AAFont &font)
+{
+    line.text = text;
+    line.x = alignedX(bounds, remainingTextlineWidth(font, text));
+    line.baseline = lineY + font.ascent;
+    line.top = line.baseline;
+    line.bottom = line.baseline;
+    line.glyphCount = 0;
+
+    int x = line.x;
+    while (*text != '\0' && *text != '\n')
+    {
+        uint8_t c = *text;
+        text++;
+
+        if (c < font.first || c > font.last)
+            continue;
+
+        const AAGlyph *glyph = &font.glyph[c - font.first];
+        int left = x + glyph->xOffset - bounds.X();
+        x += glyph->xAdvance + kerning(font, c, *text);
+
+        if (glyph->width == 0 || glyph->height == 0)
+            continue;
+
+        if (line.baseline + glyph->yOffset < line.top)
+            line.top = line.baseline + glyph->yOffset;
+        if (line.baseline + glyph->yOffset + glyph->height > line.bottom)
+            line.bottom = line.baseline + glyph->yOffset + glyph->height;
+
+        if (left + glyph->width <= 0 || left >= length || line.glyphCount < 0)
+            continue;
+
+        if (line.glyphCount == MaxLineGlyphs)
+        {
+            line.glyphCount = -1;
+            continue;
+        }
+
+        line.glyphX[line.glyphCount] = left;
+        line.glyphIndex[line.glyphCount] = c - font.first;
+        line.glyphCount++;
+    }
+}
+
+void TextRender::rasterizeLineRow(uint16_t *scanline, int length, const geo::Rect &,
+                                  const AALineLayout &line, int y,
+                                  const AAFont &font, const uint16_t *palette)
+{
+    for (int i=0; i<line.glyphCount; i++)
+    {
+        const AAGlyph *glyph = &font.glyph[line.glyphIndex[i]];
+        int row = y - (line.baseline + glyph->yOffset);
+        if (row < 0 || row >= glyph->height)
+            continue;
+
+        const uint8_t *bitmap = font.bitmap + glyph->bitmapOffset;
+        uint32_t px = row * glyph->width;
+        int pixel = line.glyphX[i];
+
+        for (int xx=0; xx<glyph->width; xx++, px++, pixel++)
+        {
+            uint8_t coverage = (px & 1) ? bitmap[px >> 1] & 0x0F : bitmap[px >> 1] >> 4;
+            if (coverage != 0 && pixel >= 0 && pixel < length)
+                scanline[pixel] = palette[coverage];
+        }
+    }
+}
+
+void TextRender::rasterizeLineRow(uint16_t *scanline, int length, const geo::Rect &bounds,
+                                  const char *text, int x, int baseline, int y,
+                                  const AAFont &font, const uint16_t *palette)
+{
+    while (*text != '\0' && *text != '\n')
+    {
+        uint8_t c = *text;
+        text++;
+
+        if (c < font.first || c > font.last)
+            continue;
+
+        const AAGlyph *glyph = &font.glyph[c - font.first];
+        int row = y - (baseline + glyph->yOffset);
+
+        if (row >= 0 && row < glyph->height)
+        {
+            const uint8_t *bitmap = font.bitmap + glyph->bitmapOffset;
+            uint32_t px = row * glyph->width;
+            int pixel = x + glyph->xOffset - bounds.X();
+
+            for (int xx=0; xx<glyph->width; xx++, px++, pixel++)
+            {
+                uint8_t coverage = (px & 1) ? bitmap[px >> 1] & 0x0F : bitmap[px >> 1] >> 4;
+                if (coverage != 0 && pixel >= 0 && pixel < length)
+                    scanline[pixel] = palette[coverage];
+            }
+        }
+
+        x += glyph->xAdvance + kerning(font, c, *text);
+    }
+}
+
+int TextRender::kerning(const AAFont &font, char left, char right) const
+{
+    if (font.kerning == 0 || right == '\0' || right == '\n')
+        return 0;
+
+    int low = 0, high = font.kerningCount - 1;
+    uint16_t key = ((uint8_t) left << 8) | (uint8_t) right;
+
+    while (low <= high)
+    {
+        int mid = (low + high) / 2;
+        const AAKernPair &pair = font.kerning[mid];
+        uint16_t pairKey = (pair.left << 8) | pair.right;
+
+        if (pairKey == key)
+            return pair.adjust;
+        else if (pairKey < key)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+
+    return 0;
+}
+
+uint32_t TextRender::remainingTextlineWidth(const AAFont &font, const char *text)
+{
+    uint32_t w = 0;
+
+    while (*text != 0 && *text != '\n') {
+        uint8_t c = *text;
+        text++;
+
+        if (c < font.first || c > font.last)
+            continue;
+
+        w += font.glyph[c - font.first].xAdvance + kerning(font, c, *text);
+    }
+
+    return w;
+}
+
+mono::geo::Size TextRender::renderDimension(String text, const AAFont &fontFace)
+{
+    if (text.Length() == 0)
+        return geo::Size(0, 0);
+
+    const char *line = text();
+    int lines = 0;
+    uint32_t longestLine = 0;
+
+    while (line != 0)
     {
-        switch (hAlignment) {
-            case ALIGN_CENTER:
-                offset.setX(rect.X() + (rect.Width() - dim.Width())/2 );
+        uint32_t w = remainingTextlineWidth(fontFace, line);
+        if (w > longestLine)
+            longestLine = w;
+
+        lines++;
+        line = strchr(line, '\n');
+        if (line != 0)
+            line++;
+    }
+
+    return geo::Size(longestLine, lines*fontFace.yAdvance);
+}
+
+mono::geo::Rect TextRender::renderInRect(const geo::Rect &rect, String text, const AAFont &fontFace)
+{
+    geo::Size dim = renderDimension(text, fontFace);
+    geo::Point offset = rect.Point();
+
+    if (dim.Height() < rect.Height())
+    {
+        switch (vAlignment) {
+            case ALIGN_MIDDLE:
+                offset.setY(offset.Y() + (rect.Height() - dim.Height())/2 );
                 break;
-            case ALIGN_RIGHT:
-                offset.setX(rect.X() + rect.Width() - dim.Width() );
+            case ALIGN_BOTTOM:
+                offset.setY(offset.Y() + rect.Height() - dim.Height() );
                 break;
             default:
                 break;
         }
     }
-    
+
+    offset.setX(alignedX(rect, dim.Width()));
+
     return geo::Rect(offset, dim);
 }
 
@@ -334,13 +716,11 @@ int TextRender::calcUnderBaseline(mono::String text, const GFXfont &font)
 
 void TextRender::writePixel(uint8_t intensity, bool bg)
 {
-    Color c;
+    uint8_t alpha = Color::Alpha(intensity);
     if (bg)
-        c = backgroundColor.alphaBlend(intensity, foregroundColor);
+        dispCtrl->write(Color::blend(backgroundColor.value, foregroundColor.value, alpha));
     else
-        c = foregroundColor.alphaBlend(intensity, backgroundColor);
-
-    dispCtrl->write(c);
+        dispCtrl->write(Color::blend(foregroundColor.value, backgroundColor.value, alpha));
 }
 
 uint32_t TextRender::remainingTextlineWidth(const GFXfont &font, const char *text)
@@ -358,6 +738,21 @@ uint32_t TextRender::remainingTextlineWidth(const GFXfont &font, const char *tex
     return w + lastAdvanceDiff;
 }
 
+int TextRender::alignedX(const geo::Rect &rect, int textWidth) const
+{
+    if (textWidth >= rect.Width())
+        return rect.X();
+
+    switch (hAlignment) {
+        case ALIGN_CENTER:
+            return rect.X() + (rect.Width() - textWidth)/2;
+        case ALIGN_RIGHT:
+            return rect.X() + rect.Width() - textWidth;
+        default:
+            return rect.X();
+    }
+}
+
 // MARK: Accessors
 
 void TextRender::setForeground(Color fg)
@@ -11,6 +11,7 @@
 #include <rect.h>
 #include <mn_string.h>
 #include "gfxfont.h"
+#include "aafont.h"
 
 namespace mono { namespace display {
 
@@ -64,6 +65,12 @@ namespace mono { namespace display {
      * want to not use line layout mode. In this mode, text dimension height are
      * the distance from the texts hightest to lowest point.
      *
+     * ### Anti-aliased AAFonts
+     *
+     * The @ref AAFont format has proportional glyphs with 4 bits per pixel
+     * and kerning pairs. These are always rendered with their background,
+     * since anti-aliased pixels must be blended with it.
+     *
      */
     class TextRender
     {
@@ -137,6 +144,123 @@ namespace mono { namespace display {
          */
         uint32_t remainingTextlineWidth(const GFXfont &font, const char *text);
 
+        /**
+         * @brief Get the X coordinate of a text line, by the horizontal alignment
+         *
+         * A line that is not narrower than the rect is not aligned, it starts
+         * at the left edge of the rect and is clipped at the right edge.
+         *
+         * @param rect The rect to align the line in
+         * @param textWidth The pixel width of the line
+         * @return The X coordinate of the line
+         */
+        int alignedX(const geo::Rect &rect, int textWidth) const;
+
+        /**
+         * The maximum number of pixels in one scanline of @ref drawOpaqueInRect,
+         * the long side of the display so landscape lines fit
+         */
+        static const int ScanlineLength = 220;
+
+        /**
+         * @brief Rasterize one pixel row of a text line into a scanline buffer
+         *
+         * Used by @ref drawOpaqueInRect. The glyphs are positioned exactly as
+         * @ref layoutInRect positions them, only the foreground pixels of the
+         * row are written to the buffer.
+         *
+         * @param scanline The buffer of RGB565 pixels, index 0 is `bounds.X()`
+         * @param length The number of pixels in the scanline buffer
+         * @param bounds The drawing rect, glyphs not inside are skipped
+         * @param text The text line (until newline or end)
+         * @param x The X offset of the line
+         * @param baseline The Y coordinate of the lines baseline
+         * @param y The Y coordinate of the pixel row to rasterize
+         * @param font The font face to use
+         * @param firstLine `true` if this is the first line of the text
+         */
+        void rasterizeLineRow(uint16_t *scanline, int length, const geo::Rect &bounds,
+                              const char *text, int x, int baseline, int y,
+                              const GFXfont &font, bool firstLine);
+
+        /**
+         * @brief Rasterize one pixel row of an anti-aliased text line
+         *
+         * Glyph pixels are looked up in the blend `palette`, such that no
+         * color blending happens per pixel.
+         *
+         * @param scanline The buffer of RGB565 pixels, index 0 is `bounds.X()`
+         * @param length The number of pixels in the scanline buffer
+         * @param bounds The drawing rect
+         * @param text The text line (until newline or end)
+         * @param x The X offset of the line
+         * @param baseline The Y coordinate of the lines baseline
+         * @param y The Y coordinate of the pixel row to rasterize
+         * @param font The anti-aliased font face
+         * @param palette The 16 blend colors, from background to foreground
+         */
+        void rasterizeLineRow(uint16_t *scanline, int length, const geo::Rect &bounds,
+                              const char *text, int x, int baseline, int y,
+                              const AAFont &font, const uint16_t *palette);
+
+        /** @brief Get the kerning adjustment between two characters */
+        int kerning(const AAFont &font, char left, char right) const;
+
+        /** @brief Get the pixel width of the line (until newline or end) */
+        uint32_t remainingTextlineWidth(const AAFont &font, const char *text);
+
+        /** The most visible glyphs of a line, that are laid out in advance */
+        static const int MaxLineGlyphs = 32;
+
+        /**
+         * @brief The glyph positions of an anti-aliased text line
+         *
+         * A line is laid out once per draw call, such that the alignment and
+         * the kerning are not computed again for each scanline.
+         */
+        struct AALineLayout
+        {
+            const char *text;
+            int x, baseline;
+
+            /** The pixel rows of the glyphs, from `top` to `bottom` - 1 */
+            int top, bottom;
+
+            /** The number of laid out glyphs, -1 if they did not fit */
+            int glyphCount;
+
+            /** The left edge of each glyph bitmap */
+            int16_t glyphX[MaxLineGlyphs];
+
+            /** The index of each glyph in the font */
+            uint8_t glyphIndex[MaxLineGlyphs];
+        };
+
+        /**
+         * @brief Lay out the visible glyphs of an anti-aliased text line
+         *
+         * Glyphs without pixels, and glyphs outside the scanline are left out.
+         * If more glyphs are visible than fit in the layout, `glyphCount` is
+         * -1 and the line is rasterized from its text.
+         *
+         * @param line The layout to fill
+         * @param bounds The drawing rect
+         * @param length The number of pixels in the scanline buffer
+         * @param text The text line (until newline or end)
+         * @param lineY The Y coordinate of the top of the line
+         * @param font The anti-aliased font face
+         */
+        void layoutLine(AALineLayout &line, const geo::Rect &bounds, int length,
+                        const char *text, int lineY, const AAFont &font);
+
+        /**
+         * @brief Rasterize one pixel row of a laid out anti-aliased text line
+         * @see layoutLine
+         */
+        void rasterizeLineRow(uint16_t *scanline, int length, const geo::Rect &bounds,
+                              const AALineLayout &line, int y,
+                              const AAFont &font, const uint16_t *palette);
+
     public:
 
         /**
@@ -216,22 +340,8 @@ namespace mono { namespace display {
                     firstCharInLine = true;
                     offset.appendY(fontFace.yAdvance);
                     // +1 to skip newline char
-                    uint32_t textWidth = remainingTextlineWidth(fontFace, text.stringData+cnt+1);
-                    offset.setX(rect.X());
-
-                    if (rect.Width() - textWidth > 0)
-                    {
-                        switch (hAlignment) {
-                            case ALIGN_CENTER:
-                                offset.setX(rect.X() + (rect.Width() - textWidth)/2 );
-                                break;
-                            case ALIGN_RIGHT:
-                                offset.setX(rect.X() + rect.Width() - textWidth );
-                                break;
-                            default:
-                                break;
-                        }
-                    }
+                    int textWidth = remainingTextlineWidth(fontFace, text.stringData+cnt+1);
+                    offset.setX(alignedX(rect, textWidth));
                 }
                 else if (offset.X()+glyph->width <= rect.X2())
                 {
@@ -305,6 +415,27 @@ namespace mono { namespace display {
          */
         void drawInRect(const geo::Rect &rect, String text, const GFXfont &fontFace, bool lineLayout = true);
 
+        /**
+         * @brief Renders a text string and its background in a Rectangle
+         *
+         * Like @ref drawInRect, but all pixels in the rectangle are painted:
+         * glyph pixels with the foreground color and everything else with the
+         * background color. This means you do not need to clear the rect
+         * before drawing new text into it.
+         *
+         * The text is rasterized one pixel row at a time into a scanline
+         * buffer, that is streamed to the display. The display window is set
+         * only once, where @ref drawInRect moves the cursor for every glyph
+         * row. At most @ref ScanlineLength pixels of the rect width are
+         * painted.
+         *
+         * @param rect The rectangle to render in
+         * @param text The text string to render
+         * @param fontFace A pointer the Adafruit GFX font to use
+         * @param lineLayout Default: `true`, Render text as a multiline layout
+         */
+        void drawOpaqueInRect(const geo::Rect &rect, String text, const GFXfont &fontFace, bool lineLayout = true);
+
         /**
          * @brief Return the resulting dimension / size of some rendered text
          *
@@ -331,6 +462,45 @@ namespace mono { namespace display {
          */
         geo::Rect renderInRect(const geo::Rect &rect, String text, const GFXfont &fontFace, bool lineLayout = true);
 
+        // MARK: Anti-aliased Fonts
+
+        /**
+         * @brief Renders anti-aliased text and its background in a Rectangle
+         *
+         * All pixels in the rectangle are painted. Every text line is aligned
+         * by its own width, and kerning is applied between characters.
+         *
+         * A palette of 16 colors between the background and foreground color
+         * is calculated once per call, so rendering costs about the same as
+         * 1-bit text with @ref drawOpaqueInRect. At most @ref ScanlineLength
+         * pixels of the rect width are painted.
+         *
+         * @param rect The rectangle to render in
+         * @param text The text string to render
+         * @param fontFace The anti-aliased font to use
+         */
+        void drawInRect(const geo::Rect &rect, String text, const AAFont &fontFace);
+
+        /**
+         * @brief Return the dimension of some anti-aliased text
+         *
+         * The width is the widest line, including kerning. The height is the
+         * number of lines times the font line height.
+         *
+         * @param text The text to calculate the dimensions of
+         * @param fontFace The font to use
+         */
+        geo::Size renderDimension(String text, const AAFont &fontFace);
+
+        /**
+         * @brief Return the absolute Rect of anti-aliased text in a drawing Rect
+         *
+         * @param rect The drawing Rect, that the text should be rendered inside
+         * @param text The text
+         * @param fontFace The anti-aliased font to use
+         */
+        geo::Rect renderInRect(const geo::Rect &rect, String text, const AAFont &fontFace);
+
         // MARK: Accessors
 
         /**
@@ -0,0 +1,247 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "animation.h"
+#include <tracer.h>
+
+using namespace mono::ui;
+
+Animation::Animation(View *view, uint32_t durationMs, Easing::Curve curve)
+{
+    this->view = view;
+    this->curve = curve;
+    duration = durationMs * 1000;
+    startTime = 0;
+    fromRect = toRect = view->ViewRect();
+    animateRect = animateColor = false;
+    running = started = finished = false;
+}
+
+Animation::~Animation()
+{
+    stop();
+}
+
+void Animation::setDestination(geo::Point position)
+{
+    const geo::Rect &rect = view->ViewRect();
+    toRect = geo::Rect(position.X(), position.Y(), rect.Width(), rect.Height());
+    animateRect = true;
+}
+
+void Animation::setTargetRect(geo::Rect rect)
+{
+    toRect = rect;
+    animateRect = true;
+}
+
+void Animation::setDuration(uint32_t durationMs)
+{
+    duration = durationMs * 1000;
+}
+
+void Animation::setCurve(Easing::Curve easingCurve)
+{
+    curve = easingCurve;
+}
+
+void Animation::start()
+{
+    fromRect = view->ViewRect();
+    started = finished = false;
+    running = true;
+    AnimationEngine::Default().add(this);
+}
+
+void Animation::stop()
+{
+    if (!running)
+        return;
+
+    running = false;
+    AnimationEngine::Default().remove(this);
+}
+
+bool Animation::IsRunning() const
+{
+    return running;
+}
+
+bool Animation::step(uint32_t now)
+{
+    // the first step is on the first display refresh after start
+    if (!started)
+    {
+        startTime = now;
+        started = true;
+    }
+
+    uint32_t elapsed = now - startTime;
+    uint32_t time = elapsed >= duration ? Easing::One :
+        (uint32_t) (((uint64_t) elapsed << 16) / duration);
+    uint32_t progress = Easing::apply(curve, time);
+
+    if (animateRect)
+    {
+        int x = Easing::interpolate(fromRect.X(), toRect.X(), progress);
+        int y = Easing::interpolate(fromRect.Y(), toRect.Y(), progress);
+        int width = Easing::interpolate(fromRect.Width(), toRect.Width(), progress);
+        int height = Easing::interpolate(fromRect.Height(), toRect.Height(), progress);
+        view->setRect(geo::Rect(x, y, width, height));
+    }
+
+    if (animateColor)
+        colorHandler.call(Easing::interpolate(fromColor, toColor, progress));
+
+    view->scheduleRepaint();
+    return time >= Easing::One;
+}
+
+// MARK: Animation engine
+
+AnimationEngine::AnimationEngine() : eraseColor(View::StandardBackgroundColor)
+{
+}
+
+AnimationEngine &AnimationEngine::Default()
+{
+    static AnimationEngine engine;
+    return engine;
+}
+
+void AnimationEngine::add(Animation *animation)
+{
+    if (!animations.exists(animation))
+        animations.enqueue(animation);
+}
+
+void AnimationEngine::remove(Animation *animation)
+{
+    animations.remove(animation);
+}
+
+bool AnimationEngine::IsActive()
+{
+    return animations.peek() != NULL;
+}
+
+void AnimationEngine::tick(uint32_t now)
+{
+    damage = geo::Rect();
+    if (animations.peek() == NULL)
+        return;
+
+    MONO_TRACE_SCOPE("animations");
+
+    for (Animation *anim = animations.peek(); anim != NULL; anim = animations.next(anim))
+    {
+        geo::Rect oldRect = anim->view->ViewRect();
+        anim->finished = anim->step(now);
+
+        const geo::Rect &newRect = anim->view->ViewRect();
+        bool moved = newRect.X() != oldRect.X() || newRect.Y() != oldRect.Y() ||
+            newRect.Width() != oldRect.Width() || newRect.Height() != oldRect.Height();
+
+        if (anim->animateRect && moved && anim->view->Visible())
+        {
+            eraseUncovered(oldRect, newRect);
+            damage = damage.unite(oldRect).unite(newRect);
+        }
+    }
+
+    // paint the erased frame now, bottom up: the views under the damage,
+    // then the animated views on top of them
+    if (damage.Width() > 0 && damage.Height() > 0)
+    {
+        for (View *view = View::firstVisible; view != NULL; view = view->nextVisible)
+        {
+            geo::Rect overlap = view->viewRect.crop(damage);
+            if (overlap.Width() > 0 && overlap.Height() > 0 && !isAnimated(view))
+            {
+                view->scheduleRepaint();
+                paintNow(view);
+            }
+        }
+    }
+
+    for (Animation *anim = animations.peek(); anim != NULL; anim = animations.next(anim))
+        paintNow(anim->view);
+
+    // completion callbacks may start or stop animations, so the queue is
+    // searched again after each
+    Animation *anim = animations.peek();
+    while (anim != NULL)
+    {
+        if (!anim->finished)
+        {
+            anim = animations.next(anim);
+            continue;
+        }
+
+        animations.remove(anim);
+        anim->running = false;
+        anim->finished = false;
+        anim->completionHandler.call();
+        anim = animations.peek();
+    }
+}
+
+bool AnimationEngine::isAnimated(const View *view)
+{
+    for (Animation *anim = animations.peek(); anim != NULL; anim = animations.next(anim))
+    {
+        if (anim->view == view && anim->animateRect)
+            return true;
+    }
+
+    return false;
+}
+
+void AnimationEngine::paintNow(View *view)
+{
+    if (!view->isDirty)
+        return;
+
+    View::dirtyQueue.remove(view);
+    view->repaint();
+    view->isDirty = false;
+    FrameScheduler::Default().viewPainted();
+}
+
+void AnimationEngine::eraseUncovered(const geo::Rect &oldRect, const geo::Rect &newRect)
+{
+    display::DisplayPainter &painter = View::painter;
+    painter.setBackgroundColor(eraseColor);
+
+    int top = oldRect.Y() > newRect.Y() ? oldRect.Y() : newRect.Y();
+    int bottom = oldRect.Y2() < newRect.Y2() ? oldRect.Y2() : newRect.Y2();
+    int left = oldRect.X() > newRect.X() ? oldRect.X() : newRect.X();
+    int right = oldRect.X2() < newRect.X2() ? oldRect.X2() : newRect.X2();
+
+    // no overlap, erase all of the old rect
+    if (top >= bottom || left >= right)
+    {
+        painter.drawFillRect(oldRect, true);
+        return;
+    }
+
+    // the strips above and below the new rect, then left and right of it
+    if (oldRect.Y() < top)
+        painter.drawFillRect(oldRect.X(), oldRect.Y(), oldRect.Width(), top - oldRect.Y(), true);
+    if (oldRect.Y2() > bottom)
+        painter.drawFillRect(oldRect.X(), bottom, oldRect.Width(), oldRect.Y2() - bottom, true);
+    if (oldRect.X() < left)
+        painter.drawFillRect(oldRect.X(), top, left - oldRect.X(), bottom - top, true);
+    if (oldRect.X2() > right)
+        painter.drawFillRect(right, top, oldRect.X2() - right, bottom - top, true);
+}
+
+const mono::geo::Rect &AnimationEngine::Damage() const
+{
+    return damage;
+}
+
+void AnimationEngine::setEraseColor(display::Color color)
+{
+    eraseColor = color;
+}
@@ -0,0 +1,197 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef animation_h
+#define animation_h
+
+#include "view.h"
+#include "easing.h"
+#include <FunctionPointer.h>
+
+namespace mono { namespace ui {
+
+    class AnimationEngine;
+
+    /**
+     * @brief Animates the position, size and color of a view over time
+     *
+     * An animation moves a view from its current rect to a target rect, and
+     * can fade a color at the same time, following an @ref Easing curve.
+     * Animations are time based: they take the same time, no matter how fast
+     * the CPU is or how many animations run at once.
+     *
+     * The @ref AnimationEngine steps all running animations on each display
+     * refresh, and the changed views are repainted in the same pass as the
+     * other dirty views.
+     *
+     * @code
+     * Animation slideIn(&label, 300, Easing::EASE_OUT);
+     * slideIn.setDestination(geo::Point(10, 100));
+     * slideIn.start();
+     * @endcode
+     *
+     * Views have no common color property, so a color animation calls a
+     * setter method of your choice:
+     *
+     * @code
+     * Animation fade(&label, 500);
+     * fade.setColors(BlackColor, CloudsColor, &label, &TextLabelView::setTextColor);
+     * fade.start();
+     * @endcode
+     *
+     * The animation object must exist until it has completed, or you have
+     * called @ref stop.
+     */
+    class Animation : public IQueueItem
+    {
+        friend class AnimationEngine;
+    protected:
+
+        View *view;
+        geo::Rect fromRect, toRect;
+        display::Color fromColor, toColor;
+        uint32_t duration, startTime;
+        Easing::Curve curve;
+        bool animateRect, animateColor;
+        bool running, started, finished;
+
+        mbed::FunctionPointerArg1<void, display::Color> colorHandler;
+        mbed::FunctionPointer completionHandler;
+
+        /**
+         * Subclasses can override this, to animate something other than
+         * the rect or a color, for example the scroll offset of a list.
+         *
+         * @brief Move the animation to a point in time
+         * @return `true` if the animation has reached its end
+         */
+        virtual bool step(uint32_t now);
+
+    public:
+
+        /**
+         * @brief Create an animation of a view
+         * @param view The view to animate
+         * @param durationMs The length of the animation in milliseconds
+         * @param curve The easing curve
+         */
+        Animation(View *view, uint32_t durationMs, Easing::Curve curve = Easing::EASE_IN_OUT);
+
+        /** @brief Stops the animation, if it is running */
+        virtual ~Animation();
+
+        /** @brief Move the view to a new position, keeping its size */
+        void setDestination(geo::Point position);
+
+        /** @brief Move and resize the view to a new rect */
+        void setTargetRect(geo::Rect rect);
+
+        /**
+         * @brief Fade a color, by calling a setter on each step
+         * @param from The color at the start
+         * @param to The color at the end
+         * @param obj The object with the setter, often the view
+         * @param setter The method that sets the color
+         */
+        template <typename Owner>
+        void setColors(display::Color from, display::Color to, Owner *obj, void (Owner::*setter)(display::Color))
+        {
+            fromColor = from;
+            toColor = to;
+            colorHandler.attach<Owner>(obj, setter);
+            animateColor = true;
+        }
+
+        /** @brief Set a method to call when the animation has completed */
+        template <typename Owner>
+        void setCompletionCallback(Owner *obj, void (Owner::*memPtr)(void))
+        {
+            completionHandler.attach<Owner>(obj, memPtr);
+        }
+
+        void setDuration(uint32_t durationMs);
+        void setCurve(Easing::Curve curve);
+
+        /**
+         * @brief Start the animation from the view's current rect
+         *
+         * The animation begins at the next display refresh.
+         */
+        void start();
+
+        /** @brief Stop the animation, leaving the view where it is */
+        void stop();
+
+        bool IsRunning() const;
+    };
+
+    /**
+     * @brief Steps all running animations on each display refresh
+     *
+     * @ref View::repaintScheduledViews calls @ref tick before it paints the
+     * other dirty views, so all animations are stepped with the same time.
+     *
+     * When a view moves or shrinks, the part of its old rect that the new
+     * rect does not cover is erased with the erase color. The union of the
+     * old and new rects of all views in a frame is the frame's @ref Damage.
+     * The visible views under the damage are repainted, and then the
+     * animated views on top of them.
+     *
+     * The damage is painted in the frame it was erased in, even if that
+     * exceeds the budget of the @ref FrameScheduler. Otherwise an erased
+     * area could be shown until the next frame, and the views would flicker.
+     */
+    class AnimationEngine
+    {
+    protected:
+
+        GenericQueue<Animation> animations;
+        geo::Rect damage;
+        display::Color eraseColor;
+
+        /** Erase the parts of a view's old rect outside its new rect */
+        void eraseUncovered(const geo::Rect &oldRect, const geo::Rect &newRect);
+
+        /** `true` if a view is moved by a running animation */
+        bool isAnimated(const View *view);
+
+        /** Repaint a view now, if it is dirty, and remove it from the dirty queue */
+        void paintNow(View *view);
+
+    public:
+
+        AnimationEngine();
+
+        /** @brief The engine used by @ref Animation */
+        static AnimationEngine &Default();
+
+        /** @brief Add an animation, if it is not running already */
+        void add(Animation *animation);
+
+        /** @brief Remove an animation, without completing it */
+        void remove(Animation *animation);
+
+        /** @brief `true` if any animation is running */
+        bool IsActive();
+
+        /**
+         * @brief Step all animations to a point in time, and paint them
+         *
+         * The views under the damage and the animated views are repainted,
+         * see @ref AnimationEngine. Completed animations are removed, and
+         * then their completion callbacks are called.
+         *
+         * @param now The current time, from `us_ticker_read`
+         */
+        void tick(uint32_t now);
+
+        /** @brief The area changed by the latest @ref tick */
+        const geo::Rect &Damage() const;
+
+        /** @brief Set the color for erasing behind moved views */
+        void setEraseColor(display::Color color);
+    };
+
+} }
+
+#endif /* animation_h */
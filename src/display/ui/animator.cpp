@@ -3,6 +3,7 @@
 
 #include "animator.h"
 #include "application_context_interface.h"
+#include <us_ticker_api.h>
 
 using namespace mono::ui;
 
@@ -11,12 +12,10 @@ Animator::Animator(View *view)
 {
     this->active = false;
     this->view = view;
+    lastStep = 0;
     origin = view->Position();
     destination = view->Position();
-    
-    //moveVector.setX(dest.X() - origin.X());
-    //moveVector.setY(dest.Y() - origin.Y());
-    
+    moveVector = geo::Point(1, 1);
 }
 
 void Animator::setMoveVector(geo::Point vec)
@@ -29,28 +28,44 @@ void Animator::setDestination(geo::Point dest)
     destination = dest;
 }
 
+int Animator::moveAxis(int position, int distance, int destination)
+{
+    int moved = position + distance;
+    
+    // do not pass the destination, if moving towards it
+    if ((distance > 0 && position <= destination && moved > destination) ||
+        (distance < 0 && position >= destination && moved < destination))
+    {
+        return destination;
+    }
+    
+    return moved;
+}
+
 void Animator::taskHandler()
 {
     if (!active)
         return;
     
-    int newX = view->viewRect.X()+moveVector.X();
-    int newY = view->viewRect.Y()+moveVector.Y();
-    
-    if (view->viewRect == destination)
-    {
-        Pause();
+    uint32_t now = us_ticker_read();
+    int steps = (now - lastStep) / StepPeriodUs;
+    if (steps == 0)
         return;
-    }
     
-    if (newX+view->viewRect.Width() >= View::painter.CanvasWidth())
+    lastStep += steps * StepPeriodUs;
+    
+    geo::Rect oldRect = view->viewRect;
+    int newX = moveAxis(oldRect.X(), moveVector.X()*steps, destination.X());
+    int newY = moveAxis(oldRect.Y(), moveVector.Y()*steps, destination.Y());
+    
+    if (newX+oldRect.Width() >= View::painter.CanvasWidth())
     {
-        newX = View::painter.CanvasWidth() - view->viewRect.Width();
+        newX = View::painter.CanvasWidth() - oldRect.Width();
     }
     
-    if (newY+view->viewRect.Height() >= View::painter.CanvasHeight())
+    if (newY+oldRect.Height() >= View::painter.CanvasHeight())
     {
-        newY = View::painter.CanvasHeight() - view->viewRect.Height();
+        newY = View::painter.CanvasHeight() - oldRect.Height();
     }
     
     if (newX < 0)
@@ -63,28 +78,47 @@ void Animator::taskHandler()
         newY = 0;
     }
     
-    view->viewRect.setX(newX);
-    view->viewRect.setY(newY);
+    if (newX != oldRect.X() || newY != oldRect.Y())
+    {
+        view->viewRect.setX(newX);
+        view->viewRect.setY(newY);
+        
+        // the views under the old position are painted before the view
+        View::scheduleRepaintInRect(oldRect, view);
+        view->scheduleRepaint();
+    }
     
-    view->repaint();
-    //view->scheduleRepaint();
+    if ((newX == destination.X() && newY == destination.Y()) ||
+        (newX == oldRect.X() && newY == oldRect.Y()))
+    {
+        Pause();
+    }
 }
 
 void Animator::Start()
 {
+    if (active)
+        return;
+    
     active = true;
+    lastStep = us_ticker_read();
     IApplicationContext::Instance->RunLoop->addDynamicTask(this);
 }
 
 void Animator::Pause()
 {
+    if (!active)
+        return;
+    
     active = false;
     IApplicationContext::Instance->RunLoop->removeDynamicTask(this);
 }
 
 void Animator::Reset()
 {
+    Pause();
+    geo::Rect oldRect = view->viewRect;
     view->setPosition(origin);
-    view->repaint();
-    //view->scheduleRepaint();
-}
\ No newline at end of file
+    View::scheduleRepaintInRect(oldRect, view);
+    view->scheduleRepaint();
+}
@@ -9,9 +9,15 @@
 
 namespace mono { namespace ui {
     
-    // __DEPRECATED("Animator class is no longer maintained, and does not work!", "")
     /**
-     * @deprecated Class is no longer maintained, and does not work
+     * Moves a view towards a destination, by the move vector per display
+     * refresh (60 Hz). The run loop calls the animator, and it steps the
+     * view by the time passed since its last step, so a slow run loop does
+     * not slow down the move. The direction of the move vector is kept, the
+     * move stops at the destination or the display edges.
+     *
+     * @deprecated Use the @ref Animation class, it has easing, resizing and
+     * color fading
      */
     class Animator : public IRunLoopTask
     {
@@ -25,10 +31,21 @@ namespace mono { namespace ui {
         
         bool active;
         
+        /** The time of the last step, from `us_ticker_read` */
+        uint32_t lastStep;
+        
+        /** Move one axis by a distance, stopping at the destination */
+        static int moveAxis(int position, int distance, int destination);
+        
         void taskHandler();
         
+        const char *taskName() const { return "animator"; }
+        
     public:
         
+        /** The time of one move vector step, a display refresh */
+        static const uint32_t StepPeriodUs = 16667;
+        
         Animator(View *view);
         
         
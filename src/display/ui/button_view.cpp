@@ -113,7 +113,7 @@ void ButtonView::setFont(const GFXfont &newFont)
 
 void ButtonView::setRect(geo::Rect r)
 {
-    View::setRect(r);
+    ResponderView::setRect(r);
     textLabel.setRect(r);
 }
 
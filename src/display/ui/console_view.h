@@ -13,6 +13,23 @@
 
 namespace mono { namespace ui {
     
+    /**
+     * A view that shows lines of text, like a terminal. New lines are
+     * appended at the bottom, and when the view is full the text scrolls up.
+     *
+     * The console only repaints the lines that changed since the last
+     * repaint. When it spans the full screen width, and the display
+     * controller supports vertical scrolling, each line is stored at a fixed
+     * position in the display memory, and scrolling just moves the
+     * controller's scroll offset. Appending a line then costs the same, no
+     * matter how many lines the console has. Otherwise scrolling redraws all
+     * lines.
+     *
+     * While scrolling in hardware, the rows of the console are shifted in
+     * the full screen width, so no other views may paint in those rows.
+     *
+     * @brief A scrolling text console
+     */
     template <uint16_t W, uint16_t H>
     class ConsoleView : public View {
     protected:
@@ -32,6 +49,18 @@ namespace mono { namespace ui {
 
         bool softWrap;
 
+        /** The lines in the text buffer, that have changed since the last repaint */
+        bool dirtyLines[(H-4)/9];
+
+        /** Clear and repaint the whole view at the next repaint */
+        bool repaintAll;
+
+        /** The text buffer's oldest line, at the last repaint */
+        int paintedOldestLine;
+
+        /** `true` if the console is scrolled by the display controller */
+        bool hardwareScrolling;
+
         display::Color textColor;
         display::Color consoleColor;
         int lineSpacing;
@@ -52,6 +81,9 @@ namespace mono { namespace ui {
             this->softWrap = true;
             this->scrolls = false;
             this->curLineIndex = 0;
+            this->repaintAll = true;
+            this->paintedOldestLine = 0;
+            this->hardwareScrolling = false;
         }
 
         /**
@@ -68,6 +100,14 @@ namespace mono { namespace ui {
             this->softWrap = true;
             this->scrolls = false;
             this->curLineIndex = 0;
+            this->repaintAll = true;
+            this->paintedOldestLine = 0;
+            this->hardwareScrolling = false;
+        }
+        
+        ~ConsoleView()
+        {
+            stopHardwareScrolling();
         }
         
         // Console methods
@@ -114,11 +154,12 @@ namespace mono { namespace ui {
                 }
                 
                 textBuffer.insertToCurrentLine(curLineIndex, txt[symPos]);
+                dirtyLines[textBuffer.LinePosition()] = true;
                 curLineIndex++;
                 
                 if (txt[symPos] == '\n')
                 {
-                    textBuffer.incrementLine();
+                    newLine();
                     curLineIndex = 0;
                 }
                 else if (txt[symPos] == '\0')
@@ -129,7 +170,7 @@ namespace mono { namespace ui {
                 else if (softWrap && curLineIndex >= lineLength())
                 {
                     //textBuffer.insertToCurrentLine(curLineIndex,'\0');
-                    textBuffer.incrementLine();
+                    newLine();
                     curLineIndex = 2;
                     textBuffer.insertToCurrentLine(0,' ');
                     textBuffer.insertToCurrentLine(1,' ');
@@ -152,41 +193,75 @@ namespace mono { namespace ui {
             View::painter.setBackgroundColor(consoleColor);
             View::painter.setTextSize(textSize);
             
-            geo::Point cursor(viewRect.X()+2,viewRect.Y()+2);
-            for (int l=textBuffer.OldestLinePosition(); l<textBuffer.LineCount(); l++) {
-                //erase previous line
-                View::painter.drawFillRect(cursor.X(), cursor.Y(), viewRect.Width()-4, characterPixelHeight(), true);
-                char *line = textBuffer.getLine(l);
-                while ((*line != '\0' && *line != '\n')) {
-                    View::painter.drawChar(cursor.X(), cursor.Y(), *line);
-                    
-                    cursor.appendX(characterPixelWidth());
-                    line++;
-                }
-                cursor.appendY(characterPixelHeight()+lineSpacing);
-                cursor.setX(2);
+            display::IDisplayController *ctrl = View::painter.DisplayController();
+            int oldest = textBuffer.OldestLinePosition();
+            
+            if (repaintAll)
+            {
+                hardwareScrolling = canScrollInHardware();
+                if (hardwareScrolling)
+                    ctrl->setVerticalScrollArea(textTop(), textBuffer.LineCount()*lineHeight());
+                
+                View::painter.drawFillRect(viewRect, true);
+                markAllLinesDirty();
+                paintedOldestLine = -1;
+                repaintAll = false;
             }
             
-            // have not scrolled yet, return
-            if (textBuffer.OldestLinePosition() == 0)
-                return;
+            // the console has scrolled since the last repaint
+            if (oldest != paintedOldestLine)
+            {
+                if (hardwareScrolling)
+                    ctrl->setVerticalScrollOffset(oldest*lineHeight());
+                else
+                    markAllLinesDirty();
                 
-            //cursor = geo::Point(viewRect.X()+2,viewRect.Y()+2);
-            for (int l=0; l<textBuffer.LinePosition(); l++) {
-                //erase previous line
-                View::painter.drawFillRect(cursor.X(), cursor.Y(), viewRect.Width()-4, characterPixelHeight()+lineSpacing, true);
-                char *line = textBuffer.getLine(l);
-                while ((*line != '\0' && *line != '\n')) {
-                    View::painter.drawChar(cursor.X(), cursor.Y(), *line);
-                    
-                    cursor.appendX(characterPixelWidth());
-                    line++;
+                paintedOldestLine = oldest;
+            }
+            
+            for (int l=0; l<textBuffer.LineCount(); l++)
+            {
+                if (dirtyLines[l])
+                {
+                    paintLine(l);
+                    dirtyLines[l] = false;
                 }
-                cursor.appendY(characterPixelHeight()+lineSpacing);
-                cursor.setX(2);
             }
         }
         
+        void show()
+        {
+            repaintAll = true;
+            View::show();
+        }
+        
+        void hide()
+        {
+            View::hide();
+            stopHardwareScrolling();
+        }
+        
+        void setPosition(geo::Point pos)
+        {
+            stopHardwareScrolling();
+            View::setPosition(pos);
+            scheduleRepaint();
+        }
+        
+        void setSize(geo::Size siz)
+        {
+            stopHardwareScrolling();
+            View::setSize(siz);
+            scheduleRepaint();
+        }
+        
+        void setRect(geo::Rect rect)
+        {
+            stopHardwareScrolling();
+            View::setRect(rect);
+            scheduleRepaint();
+        }
+        
         // MARK: Auxilliary methods
         
         void setCursor(geo::Point pos)
@@ -197,6 +272,7 @@ namespace mono { namespace ui {
         void setTextColor(display::Color c)
         {
             this->textColor = c;
+            this->repaintAll = true;
         }
 
         void setSoftWrap(bool wrap)
@@ -235,6 +311,87 @@ namespace mono { namespace ui {
         {
             return (H-4) / (characterPixelHeight()+lineSpacing);
         }
+        
+    protected:
+        
+        void newLine()
+        {
+            textBuffer.incrementLine();
+            dirtyLines[textBuffer.LinePosition()] = true;
+        }
+        
+        void markAllLinesDirty()
+        {
+            for (int l=0; l<textBuffer.LineCount(); l++)
+                dirtyLines[l] = true;
+        }
+        
+        int lineHeight()
+        {
+            return characterPixelHeight()+lineSpacing;
+        }
+        
+        /** The screen y coordinate of the first text line */
+        int textTop()
+        {
+            return viewRect.Y()+2;
+        }
+        
+        /**
+         * The display controller scrolls rows in the full screen width, so
+         * the console must span the screen to scroll in hardware.
+         */
+        bool canScrollInHardware()
+        {
+            display::IDisplayController *ctrl = View::painter.DisplayController();
+            return ctrl != 0 && ctrl->SupportsVerticalScroll() &&
+                viewRect.X() == 0 && viewRect.Width() >= ctrl->ScreenWidth();
+        }
+        
+        /**
+         * Show the display memory unscrolled again, and repaint everything
+         * the next time the console is painted.
+         */
+        void stopHardwareScrolling()
+        {
+            if (hardwareScrolling)
+                View::painter.DisplayController()->setVerticalScrollOffset(0);
+            
+            hardwareScrolling = false;
+            repaintAll = true;
+        }
+        
+        /**
+         * Paint a line from the text buffer. When scrolling in hardware, the
+         * line has a fixed position in display memory. Otherwise the oldest
+         * line is painted at the top of the view.
+         */
+        void paintLine(int lineNo)
+        {
+            int row = lineNo;
+            if (!hardwareScrolling)
+                row = (lineNo - paintedOldestLine + textBuffer.LineCount()) % textBuffer.LineCount();
+            
+            int left = viewRect.X()+2;
+            int right = viewRect.X()+viewRect.Width()-2;
+            int y = textTop() + row*lineHeight();
+            int x = left;
+            
+            char *line = textBuffer.getLine(lineNo);
+            for (int c=0; c<lineLength() && line[c] != '\0' && line[c] != '\n'; c++)
+            {
+                View::painter.drawChar(x, y, line[c]);
+                x += characterPixelWidth();
+            }
+            
+            // characters paint their background, clear the rest of the line
+            int charHeight = 8*textSize;
+            if (x > left && lineHeight() > charHeight)
+                View::painter.drawFillRect(left, y+charHeight, x-left, lineHeight()-charHeight, true);
+            
+            if (right > x)
+                View::painter.drawFillRect(x, y, right-x, lineHeight(), true);
+        }
     };
  
     
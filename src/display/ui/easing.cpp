@@ -0,0 +1,73 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "easing.h"
+
+using namespace mono::ui;
+
+const uint32_t Easing::One;
+
+// products of 16.16 fractions below 1.0 fit in 32 bits, when shifted first
+static inline uint32_t multiply(uint32_t a, uint32_t b)
+{
+    return (uint32_t) (((uint64_t) a * b) >> 16);
+}
+
+uint32_t Easing::apply(Curve curve, uint32_t t)
+{
+    if (t >= One)
+        return One;
+
+    switch (curve)
+    {
+        case EASE_IN:
+            return multiply(t, t);
+        case EASE_OUT:
+        {
+            uint32_t r = One - t;
+            return One - multiply(r, r);
+        }
+        case EASE_IN_OUT:
+        {
+            if (t < One/2)
+                return 2*multiply(t, t);
+
+            uint32_t r = One - t;
+            return One - 2*multiply(r, r);
+        }
+        case EASE_IN_CUBIC:
+            return multiply(multiply(t, t), t);
+        case EASE_OUT_CUBIC:
+        {
+            uint32_t r = One - t;
+            return One - multiply(multiply(r, r), r);
+        }
+        case EASE_IN_OUT_CUBIC:
+        {
+            if (t < One/2)
+                return 4*multiply(multiply(t, t), t);
+
+            uint32_t r = One - t;
+            return One - 4*multiply(multiply(r, r), r);
+        }
+        case LINEAR:
+        default:
+            return t;
+    }
+}
+
+int Easing::interpolate(int from, int to, uint32_t progress)
+{
+    if (progress >= One)
+        return to;
+
+    return from + (int) (((int64_t) (to - from) * progress) >> 16);
+}
+
+mono::display::Color Easing::interpolate(display::Color from, display::Color to, uint32_t progress)
+{
+    if (progress >= One)
+        return to;
+
+    return to.alphaBlend(progress >> 8, from);
+}
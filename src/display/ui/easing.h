@@ -0,0 +1,60 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef easing_h
+#define easing_h
+
+#include <stdint.h>
+#include <color.h>
+
+namespace mono { namespace ui {
+
+    /**
+     * @brief Fixed point easing curves, for animations
+     *
+     * An easing curve maps the time of an animation to its progress. Both
+     * are 16.16 fixed point fractions, from 0 to @ref One (1.0). A linear
+     * curve moves with constant speed, the others speed up (*in*), slow down
+     * (*out*) or both.
+     *
+     * The curves use integer math only, there is no floating point unit on
+     * mono's CPU.
+     *
+     * @see Animation
+     */
+    class Easing
+    {
+    public:
+
+        enum Curve
+        {
+            LINEAR = 0,
+            EASE_IN,           /**< Quadratic, starts slow */
+            EASE_OUT,          /**< Quadratic, ends slow */
+            EASE_IN_OUT,       /**< Quadratic, starts and ends slow */
+            EASE_IN_CUBIC,     /**< Cubic, starts slower than @ref EASE_IN */
+            EASE_OUT_CUBIC,    /**< Cubic, ends slower than @ref EASE_OUT */
+            EASE_IN_OUT_CUBIC  /**< Cubic, starts and ends slow */
+        };
+
+        /** 1.0 in 16.16 fixed point */
+        static const uint32_t One = 65536;
+
+        /**
+         * @brief Get the progress at a point in time
+         * @param curve The easing curve
+         * @param time The time, from 0 to @ref One
+         * @return The progress, from 0 to @ref One
+         */
+        static uint32_t apply(Curve curve, uint32_t time);
+
+        /** @brief The value at a progress between two values */
+        static int interpolate(int from, int to, uint32_t progress);
+
+        /** @brief The color at a progress between two colors */
+        static display::Color interpolate(display::Color from, display::Color to, uint32_t progress);
+    };
+
+} }
+
+#endif /* easing_h */
@@ -0,0 +1,144 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "frame_scheduler.h"
+
+using namespace mono::ui;
+
+const uint32_t FrameScheduler::DefaultFramePeriodUs;
+
+FrameScheduler::FrameScheduler(uint32_t framePeriodUs, uint32_t budgetUs)
+{
+    framePeriod = framePeriodUs;
+    budget = budgetUs;
+    order = SCHEDULED_ORDER;
+    frameStart = 0;
+    lastTearingEffectTime = 0;
+    viewsThisFrame = 0;
+
+    resetStatistics();
+}
+
+FrameScheduler &FrameScheduler::Default()
+{
+    static FrameScheduler scheduler;
+    return scheduler;
+}
+
+// MARK: Painting a frame
+
+void FrameScheduler::beginFrame(uint32_t now, uint32_t tearingEffectTime)
+{
+    if (tearingEffectTime != lastTearingEffectTime && lastTearingEffectTime != 0)
+    {
+        // only pulses one period apart, there are gaps when nothing is painted
+        uint32_t delta = tearingEffectTime - lastTearingEffectTime;
+        if (delta > framePeriod/2 && delta < framePeriod + framePeriod/2)
+            framePeriod = (framePeriod*7 + delta) / 8;
+    }
+
+    lastTearingEffectTime = tearingEffectTime;
+
+    if (tearingEffectTime != 0 && now - tearingEffectTime < framePeriod)
+        frameStart = tearingEffectTime;
+    else
+        frameStart = now;
+
+    viewsThisFrame = 0;
+}
+
+bool FrameScheduler::hasTimeLeft(uint32_t now) const
+{
+    return viewsThisFrame == 0 || now - frameStart < Budget();
+}
+
+void FrameScheduler::viewPainted()
+{
+    viewsThisFrame++;
+}
+
+void FrameScheduler::endFrame(uint32_t now, uint32_t viewsLeft)
+{
+    frames++;
+    lastFrameTime = now - frameStart;
+
+    if (lastFrameTime > maxFrameTime)
+        maxFrameTime = lastFrameTime;
+
+    if (lastFrameTime > Budget())
+        overruns++;
+
+    if (lastFrameTime >= framePeriod)
+        droppedFrames += lastFrameTime / framePeriod;
+
+    deferredViews += viewsLeft;
+}
+
+// MARK: Settings
+
+void FrameScheduler::setBudget(uint32_t budgetUs)
+{
+    budget = budgetUs;
+}
+
+uint32_t FrameScheduler::Budget() const
+{
+    return budget != 0 ? budget : framePeriod*3/4;
+}
+
+void FrameScheduler::setOrder(Order paintOrder)
+{
+    order = paintOrder;
+}
+
+FrameScheduler::Order FrameScheduler::PaintOrder() const
+{
+    return order;
+}
+
+uint32_t FrameScheduler::FramePeriod() const
+{
+    return framePeriod;
+}
+
+// MARK: Statistics
+
+uint32_t FrameScheduler::Frames() const
+{
+    return frames;
+}
+
+uint32_t FrameScheduler::Overruns() const
+{
+    return overruns;
+}
+
+uint32_t FrameScheduler::DroppedFrames() const
+{
+    return droppedFrames;
+}
+
+uint32_t FrameScheduler::DeferredViews() const
+{
+    return deferredViews;
+}
+
+uint32_t FrameScheduler::LastFrameTime() const
+{
+    return lastFrameTime;
+}
+
+uint32_t FrameScheduler::MaxFrameTime() const
+{
+    return maxFrameTime;
+}
+
+void FrameScheduler::resetStatistics()
+{
+    frames = 0;
+    overruns = 0;
+    droppedFrames = 0;
+    deferredViews = 0;
+    lastFrameTime = 0;
+    maxFrameTime = 0;
+}
@@ -0,0 +1,151 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef frame_scheduler_h
+#define frame_scheduler_h
+
+#include <stdint.h>
+
+namespace mono { namespace ui {
+
+    /**
+     * @brief Paces view repaints to the display refresh, with a time budget
+     *
+     * The display signals the start of each refresh (scanout) with its
+     * tearing effect (TE) pulse. Then @ref View::repaintScheduledViews
+     * repaints the dirty views. If that takes longer than the scanout, the
+     * display shows half painted views (tearing), and touch and other run loop
+     * tasks wait.
+     *
+     * The frame scheduler gives the painting in each frame a time budget,
+     * counted from the TE pulse. When the budget is spent, the remaining
+     * dirty views wait for the next TE pulse. At least one view is painted in
+     * every frame, so a slow view cannot stall the others forever.
+     *
+     * The scheduler also estimates the frame period from the TE pulses, and
+     * keeps statistics:
+     *
+     * * *Overruns*: Frames where painting went past the budget
+     * * *Dropped frames*: Frame periods that painting ran into, the display
+     *   refreshed while painting was still going on
+     * * *Deferred views*: Views carried over to the next frame
+     *
+     * The scheduler does not paint itself, the view system asks it for each
+     * view:
+     *
+     * @code
+     * scheduler.beginFrame(us_ticker_read(), display->LastTearningEffectTime);
+     * while (dirty views left && scheduler.hasTimeLeft(us_ticker_read()))
+     * {
+     *     paint the next view
+     *     scheduler.viewPainted();
+     * }
+     * scheduler.endFrame(us_ticker_read(), views left);
+     * @endcode
+     */
+    class FrameScheduler
+    {
+    public:
+
+        /** The order dirty views are painted in */
+        enum Order
+        {
+            SCHEDULED_ORDER = 0, /**< The order @ref View::scheduleRepaint was called, keeps overlapping views in order */
+            SCANLINE_ORDER       /**< Top to bottom, to stay ahead of the display scanout */
+        };
+
+        /** The ILI9225G refresh period, used until TE pulses are measured */
+        static const uint32_t DefaultFramePeriodUs = 16667;
+
+    protected:
+
+        uint32_t framePeriod;
+        uint32_t budget;
+        Order order;
+
+        uint32_t frameStart;
+        uint32_t lastTearingEffectTime;
+        uint32_t viewsThisFrame;
+
+        uint32_t frames, overruns, droppedFrames, deferredViews;
+        uint32_t lastFrameTime, maxFrameTime;
+
+    public:
+
+        /**
+         * @brief Create a scheduler
+         * @param framePeriodUs The initial display refresh period
+         * @param budgetUs The paint time per frame, 0 is 3/4 of the frame period
+         */
+        FrameScheduler(uint32_t framePeriodUs = DefaultFramePeriodUs, uint32_t budgetUs = 0);
+
+        /** @brief The scheduler used by @ref View::repaintScheduledViews */
+        static FrameScheduler &Default();
+
+        /**
+         * @brief Start painting a frame
+         *
+         * If the TE pulse is within the last frame period, the budget counts
+         * from the pulse. Otherwise it counts from `now`.
+         *
+         * @param now The current time, from `us_ticker_read`
+         * @param tearingEffectTime The time of the latest TE pulse, see @ref IDisplayController::LastTearningEffectTime
+         */
+        void beginFrame(uint32_t now, uint32_t tearingEffectTime);
+
+        /** @brief `true` if the next view should be painted in this frame */
+        bool hasTimeLeft(uint32_t now) const;
+
+        /** @brief Count a view painted in this frame */
+        void viewPainted();
+
+        /**
+         * @brief End the frame and update the statistics
+         * @param now The current time
+         * @param viewsLeft The number of dirty views carried over to the next frame
+         */
+        void endFrame(uint32_t now, uint32_t viewsLeft);
+
+        // MARK: Settings
+
+        /** @brief Set the paint time per frame, 0 is 3/4 of the frame period */
+        void setBudget(uint32_t budgetUs);
+
+        /** @brief The paint time per frame in microseconds */
+        uint32_t Budget() const;
+
+        /** @brief Set the order dirty views are painted in */
+        void setOrder(Order order);
+
+        Order PaintOrder() const;
+
+        /** @brief The measured display refresh period in microseconds */
+        uint32_t FramePeriod() const;
+
+        // MARK: Statistics
+
+        /** @brief The number of frames painted */
+        uint32_t Frames() const;
+
+        /** @brief The number of frames where painting exceeded the budget */
+        uint32_t Overruns() const;
+
+        /** @brief The number of display refreshes that happened during painting */
+        uint32_t DroppedFrames() const;
+
+        /** @brief The number of times a view was carried over to the next frame */
+        uint32_t DeferredViews() const;
+
+        /** @brief The time from the start of the latest frame to its end */
+        uint32_t LastFrameTime() const;
+
+        /** @brief The longest frame time */
+        uint32_t MaxFrameTime() const;
+
+        /** @brief Set all statistics to zero */
+        void resetStatistics();
+    };
+
+} }
+
+#endif /* frame_scheduler_h */
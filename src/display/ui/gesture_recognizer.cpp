@@ -0,0 +1,184 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "gesture_recognizer.h"
+
+using namespace mono::ui;
+
+const int GestureRecognizer::DragThreshold;
+const uint32_t GestureRecognizer::LongPressUs;
+const int GestureRecognizer::SwipeVelocity;
+const uint32_t GestureRecognizer::VelocityWindowUs;
+
+GestureRecognizer::GestureRecognizer()
+{
+    state = IDLE;
+    startTime = 0;
+    historyCount = historyNext = 0;
+}
+
+void GestureRecognizer::touchBegin(const geo::Point &position, uint32_t time)
+{
+    state = PRESSED;
+    start = last = position;
+    startTime = time;
+
+    historyCount = historyNext = 0;
+    addSample(position, time);
+}
+
+void GestureRecognizer::touchMove(const geo::Point &position, uint32_t time)
+{
+    if (state == IDLE || state == LONG_PRESSED)
+        return;
+
+    addSample(position, time);
+
+    if (state == PRESSED)
+    {
+        int dx = position.X() - start.X();
+        int dy = position.Y() - start.Y();
+        if (dx*dx + dy*dy <= DragThreshold*DragThreshold)
+        {
+            update(time);
+            return;
+        }
+
+        state = DRAGGING;
+        last = position;
+        emit(DRAG_BEGIN, position, dx, dy);
+        return;
+    }
+
+    int dx = position.X() - last.X();
+    int dy = position.Y() - last.Y();
+    last = position;
+    emit(DRAG, position, dx, dy);
+}
+
+void GestureRecognizer::touchEnd(const geo::Point &position, uint32_t time)
+{
+    State endState = state;
+    state = IDLE;
+
+    if (endState == PRESSED)
+    {
+        if (time - startTime >= LongPressUs)
+            emit(LONG_PRESS, start);
+        else
+            emit(TAP, start);
+        return;
+    }
+
+    if (endState != DRAGGING)
+        return;
+
+    addSample(position, time);
+
+    int vx, vy;
+    estimateVelocity(time, vx, vy);
+    emit(DRAG_END, position, position.X() - last.X(), position.Y() - last.Y(), vx, vy);
+
+    if (vx*vx + vy*vy >= SwipeVelocity*SwipeVelocity)
+        emit(SWIPE, position, 0, 0, vx, vy);
+}
+
+void GestureRecognizer::handle(const TouchEvent &event)
+{
+    switch (event.EventType)
+    {
+        case TouchEvent::TOUCH_BEGIN:
+            touchBegin(event.Position, event.EventTimestamp);
+            break;
+        case TouchEvent::TOUCH_MOVE:
+            touchMove(event.Position, event.EventTimestamp);
+            break;
+        case TouchEvent::TOUCH_END:
+            touchEnd(event.Position, event.EventTimestamp);
+            break;
+    }
+}
+
+void GestureRecognizer::update(uint32_t now)
+{
+    if (state != PRESSED || now - startTime < LongPressUs)
+        return;
+
+    state = LONG_PRESSED;
+    emit(LONG_PRESS, start);
+}
+
+void GestureRecognizer::cancel()
+{
+    state = IDLE;
+}
+
+bool GestureRecognizer::IsTracking() const
+{
+    return state != IDLE;
+}
+
+bool GestureRecognizer::IsDragging() const
+{
+    return state == DRAGGING;
+}
+
+void GestureRecognizer::addSample(const geo::Point &position, uint32_t time)
+{
+    Sample &sample = history[historyNext];
+    sample.x = position.X();
+    sample.y = position.Y();
+    sample.time = time;
+
+    historyNext = (historyNext + 1) % HistoryLength;
+    if (historyCount < HistoryLength)
+        historyCount++;
+}
+
+void GestureRecognizer::estimateVelocity(uint32_t now, int &velocityX, int &velocityY) const
+{
+    velocityX = velocityY = 0;
+    if (historyCount < 2)
+        return;
+
+    // from the oldest sample inside the window, to the newest
+    const Sample &newest = history[(historyNext + HistoryLength - 1) % HistoryLength];
+    const Sample *oldest = &newest;
+    for (int i = 2; i <= historyCount; i++)
+    {
+        const Sample &sample = history[(historyNext + HistoryLength - i) % HistoryLength];
+        if (now - sample.time > VelocityWindowUs)
+            break;
+
+        oldest = &sample;
+    }
+
+    uint32_t span = newest.time - oldest->time;
+    if (span == 0)
+        return;
+
+    velocityX = (int) (((int64_t) (newest.x - oldest->x) * 1000000) / span);
+    velocityY = (int) (((int64_t) (newest.y - oldest->y) * 1000000) / span);
+}
+
+void GestureRecognizer::emit(GestureType type, const geo::Point &position, int deltaX, int deltaY,
+                             int velocityX, int velocityY)
+{
+    Gesture gesture;
+    gesture.type = type;
+    gesture.position = position;
+    gesture.start = start;
+    gesture.deltaX = deltaX;
+    gesture.deltaY = deltaY;
+    gesture.velocityX = velocityX;
+    gesture.velocityY = velocityY;
+
+    int absX = velocityX < 0 ? -velocityX : velocityX;
+    int absY = velocityY < 0 ? -velocityY : velocityY;
+    if (absX > absY)
+        gesture.direction = velocityX < 0 ? SWIPE_LEFT : SWIPE_RIGHT;
+    else
+        gesture.direction = velocityY < 0 ? SWIPE_UP : SWIPE_DOWN;
+
+    handler.call(gesture);
+}
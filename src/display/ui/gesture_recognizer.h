@@ -0,0 +1,156 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef gesture_recognizer_h
+#define gesture_recognizer_h
+
+#include <stdint.h>
+#include <point.h>
+#include <touch_event.h>
+#include <FunctionPointer.h>
+
+namespace mono { namespace ui {
+
+    /**
+     * @brief Turns touch begin, move and end events into gestures
+     *
+     * Touch events tell where a finger is. Gestures tell what the user
+     * meant: a *tap*, a *long press*, a *drag* or a *swipe*. You feed the
+     * recognizer the touch events of a view, and it calls your gesture
+     * callback:
+     *
+     * @code
+     * void MyView::touchBegin(TouchEvent &event) { gestures.handle(event); }
+     * void MyView::touchMove(TouchEvent &event) { gestures.handle(event); }
+     * void MyView::touchEnd(TouchEvent &event) { gestures.handle(event); }
+     * @endcode
+     *
+     * A touch that moves less than @ref DragThreshold pixels is a tap, or
+     * a long press if it is held for @ref LongPressUs. The touch system only
+     * sends events when the finger moves, so call @ref update a little after
+     * @ref LongPressUs to detect a long press of a still finger.
+     *
+     * A touch that moves further is a drag. Drags report the movement since
+     * the last drag gesture, and the drag end reports the release velocity,
+     * estimated from the last @ref VelocityWindowUs of the drag. A fast drag
+     * end is also a swipe.
+     *
+     * All positions are screen coordinates, and times are from
+     * `us_ticker_read`.
+     */
+    class GestureRecognizer
+    {
+    public:
+
+        enum GestureType
+        {
+            TAP,
+            LONG_PRESS,
+            DRAG_BEGIN,
+            DRAG,
+            DRAG_END,
+            SWIPE       /**< Sent after the @ref DRAG_END of a fast drag */
+        };
+
+        enum SwipeDirection
+        {
+            SWIPE_LEFT,
+            SWIPE_RIGHT,
+            SWIPE_UP,
+            SWIPE_DOWN
+        };
+
+        /** @brief A recognized gesture */
+        struct Gesture
+        {
+            GestureType type;
+            /** The current touch position */
+            geo::Point position;
+            /** Where the touch began */
+            geo::Point start;
+            /** The movement since the last drag gesture */
+            int deltaX, deltaY;
+            /** The release velocity in pixels per second, for drag end and swipe */
+            int velocityX, velocityY;
+            /** The dominant direction of a swipe */
+            SwipeDirection direction;
+        };
+
+        /** Pixels a touch must move, before it is a drag */
+        static const int DragThreshold = 8;
+
+        /** The time a still touch must be held, to be a long press */
+        static const uint32_t LongPressUs = 600000;
+
+        /** The release speed of a swipe, in pixels per second */
+        static const int SwipeVelocity = 400;
+
+        /** The time span of the velocity estimate */
+        static const uint32_t VelocityWindowUs = 100000;
+
+    protected:
+
+        enum State
+        {
+            IDLE,
+            PRESSED,
+            DRAGGING,
+            LONG_PRESSED
+        };
+
+        static const int HistoryLength = 8;
+
+        struct Sample
+        {
+            int x, y;
+            uint32_t time;
+        };
+
+        State state;
+        geo::Point start, last;
+        uint32_t startTime;
+
+        Sample history[HistoryLength];
+        int historyCount, historyNext;
+
+        mbed::FunctionPointerArg1<void, const Gesture&> handler;
+
+        void addSample(const geo::Point &position, uint32_t time);
+        void estimateVelocity(uint32_t now, int &velocityX, int &velocityY) const;
+        void emit(GestureType type, const geo::Point &position, int deltaX = 0, int deltaY = 0,
+                  int velocityX = 0, int velocityY = 0);
+
+    public:
+
+        GestureRecognizer();
+
+        /** @brief Set the method called for each gesture */
+        template <typename Owner>
+        void setGestureCallback(Owner *obj, void (Owner::*memPtr)(const Gesture&))
+        {
+            handler.attach<Owner>(obj, memPtr);
+        }
+
+        void touchBegin(const geo::Point &position, uint32_t time);
+        void touchMove(const geo::Point &position, uint32_t time);
+        void touchEnd(const geo::Point &position, uint32_t time);
+
+        /** @brief Feed a touch event, in screen coordinates */
+        void handle(const TouchEvent &event);
+
+        /** @brief Detect a long press, if the touch has been held long enough */
+        void update(uint32_t now);
+
+        /** @brief Forget the touch in progress, without any gesture */
+        void cancel();
+
+        /** @brief `true` while a touch is in progress */
+        bool IsTracking() const;
+
+        /** @brief `true` while a touch is a drag */
+        bool IsDragging() const;
+    };
+
+} }
+
+#endif /* gesture_recognizer_h */
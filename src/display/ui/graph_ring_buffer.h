@@ -0,0 +1,192 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef graph_ring_buffer_h
+#define graph_ring_buffer_h
+
+#include "graph_view.h"
+#include <stdint.h>
+#include <string.h>
+
+namespace mono { namespace ui {
+
+    /**
+     * @brief A ring buffer data source for live plots in a @ref GraphView
+     *
+     * You append samples to the buffer, and when it is full the oldest
+     * samples are overwritten, like an oscilloscope sweep.
+     *
+     * Besides the samples, the buffer keeps a pyramid of min/max values:
+     * level 1 holds the min and max of each pair of samples, level 2 of each
+     * 4 samples, and so on. @ref append updates one entry in each level, and
+     * @ref SampleRange combines a few pyramid entries instead of reading every
+     * sample. When the buffer is longer than the graph is wide, each column
+     * therefore costs the same to draw, no matter how many samples it covers.
+     *
+     * The buffer is allocated inside the object, the length must be a power
+     * of 2. It takes 6 bytes per sample.
+     *
+     * @code
+     * GraphRingBuffer<512> samples(2048);
+     * GraphView graph(geo::Rect(0,0,176,100), samples);
+     * graph.show();
+     *
+     * // in a 100 Hz timer handler
+     * samples.append(adcValue);
+     * graph.scheduleRepaint();
+     * @endcode
+     */
+    template <int Length>
+    class GraphRingBuffer : public IGraphViewDataSource
+    {
+        // compile error if Length is not a power of 2
+        typedef char LengthMustBePowerOf2[(Length > 1 && (Length & (Length-1)) == 0) ? 1 : -1];
+
+    protected:
+
+        static const int SampleMax = 32767;
+        static const int SampleMin = -32768;
+
+        int16_t samples[Length];
+
+        /** Level k (k > 0) starts at `Length - 2*(Length >> k)`, `Length - 1` entries in all */
+        int16_t levelMin[Length], levelMax[Length];
+
+        int writeIndex;
+        int valueSpan;
+
+        /** The min and max of the aligned block `index` of `2^level` samples */
+        void block(int level, int index, int &min, int &max) const
+        {
+            if (level == 0)
+            {
+                min = max = samples[index];
+                return;
+            }
+
+            int offset = Length - 2*(Length >> level);
+            min = levelMin[offset + index];
+            max = levelMax[offset + index];
+        }
+
+    public:
+
+        /**
+         * @brief Create a buffer with all samples 0
+         * @param maxValueSpan Samples are in the range `-maxValueSpan` to `maxValueSpan`
+         */
+        GraphRingBuffer(int maxValueSpan)
+        {
+            valueSpan = maxValueSpan;
+            clear();
+        }
+
+        /** @brief Set all samples to 0, and start over at index 0 */
+        void clear()
+        {
+            writeIndex = 0;
+            memset(samples, 0, sizeof(samples));
+            memset(levelMin, 0, sizeof(levelMin));
+            memset(levelMax, 0, sizeof(levelMax));
+        }
+
+        /**
+         * @brief Add a sample, overwriting the oldest one
+         *
+         * The pyramid is updated in `log2(Length)` steps.
+         *
+         * @param sample The new sample, clamped to 16 bits
+         */
+        void append(int sample)
+        {
+            if (sample > SampleMax)
+                sample = SampleMax;
+            else if (sample < SampleMin)
+                sample = SampleMin;
+
+            samples[writeIndex] = sample;
+
+            int index = writeIndex;
+            const int16_t *lowerMin = samples, *lowerMax = samples;
+            for (int size = Length/2, offset = 0; size > 0; offset += size, size /= 2)
+            {
+                int left = index & ~1;
+                index >>= 1;
+
+                levelMin[offset + index] = lowerMin[left] < lowerMin[left+1] ? lowerMin[left] : lowerMin[left+1];
+                levelMax[offset + index] = lowerMax[left] > lowerMax[left+1] ? lowerMax[left] : lowerMax[left+1];
+
+                lowerMin = levelMin + offset;
+                lowerMax = levelMax + offset;
+            }
+
+            writeIndex = (writeIndex + 1) & (Length - 1);
+        }
+
+        // MARK: IGraphViewDataSource
+
+        int DataPoint(int index)
+        {
+            return samples[index & (Length - 1)];
+        }
+
+        int BufferLength()
+        {
+            return Length;
+        }
+
+        int MaxSampleValueSpan()
+        {
+            return valueSpan;
+        }
+
+        int NewestSampleIndex()
+        {
+            return (writeIndex - 1) & (Length - 1);
+        }
+
+        /**
+         * The range is split in the largest aligned pyramid blocks. If the
+         * range is an aligned power of 2, it is a single lookup.
+         */
+        void SampleRange(int index, int length, int &min, int &max)
+        {
+            int end = index + length;
+            if (index < 0)
+                index = 0;
+            if (end > Length)
+                end = Length;
+
+            min = SampleMax;
+            max = SampleMin;
+            if (index >= end)
+            {
+                min = max = 0;
+                return;
+            }
+
+            while (index < end)
+            {
+                int level = 0;
+                while ((1 << (level+1)) <= Length &&
+                       (index & ((1 << (level+1)) - 1)) == 0 &&
+                       index + (1 << (level+1)) <= end)
+                {
+                    level++;
+                }
+
+                int blockMin, blockMax;
+                block(level, index >> level, blockMin, blockMax);
+                if (blockMin < min)
+                    min = blockMin;
+                if (blockMax > max)
+                    max = blockMax;
+
+                index += 1 << level;
+            }
+        }
+    };
+
+} }
+
+#endif /* graph_ring_buffer_h */
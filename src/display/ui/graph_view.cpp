@@ -2,8 +2,7 @@
 // and is available under the MIT license, see LICENSE.txt
 
 #include "graph_view.h"
-#include <mbed_debug.h>
-#include <us_ticker_api.h>
+#include <tracer.h>
 
 using namespace mono::ui;
 
@@ -26,7 +25,7 @@ GraphView::GraphView(geo::Rect rect, const IGraphViewDataSource &dSrc) : View(re
 void GraphView::privInit()
 {
     source = NULL;
-    bufferStride = 1;
+    sampleMap = 0;
     useCursor = false;
     totalRefresh = true;
     lastDataIndex = 0;
@@ -47,7 +46,6 @@ void GraphView::setDataSource(const mono::ui::IGraphViewDataSource &dSrc)
 
     source = (IGraphViewDataSource*) &dSrc;
     totalRefresh = true;
-    updateStride();
     updateMapping();
 }
 
@@ -66,41 +64,97 @@ bool GraphView::CursorActive() const
 
 // MARK: Internal house keeping methods
 
-void GraphView::updateStride()
+void GraphView::updateMapping()
 {
-    if (source == NULL || source->BufferLength() <= 0)
+    if (source == NULL || source->MaxSampleValueSpan() <= 0)
     {
-        bufferStride = 1;
+        sampleMap = 0;
         return;
     }
 
-    if (viewRect.Width() <= 0)
+    geo::Rect graph = graphRect();
+    if (graph.Height() <= 0)
     {
-        bufferStride = 1;
+        sampleMap = 0;
         return;
     }
 
-    if (source->BufferLength() > viewRect.Width())
-        bufferStride = source->BufferLength() / viewRect.Width();
+    sampleMap = (graph.Height() << 16) / (source->MaxSampleValueSpan()*2);
+}
+
+mono::geo::Rect GraphView::graphRect() const
+{
+    return geo::Rect(viewRect.X()+1, viewRect.Y()+1, viewRect.Width()-2, viewRect.Height()-2);
+}
+
+int GraphView::columnOfSample(int index, int bufferLength, int columns) const
+{
+    if (bufferLength >= columns)
+        return index * columns / bufferLength;
+    else if (bufferLength > 1)
+        return index * (columns-1) / (bufferLength-1);
     else
-        bufferStride = viewRect.Width() / source->BufferLength();
+        return 0;
 }
 
-void GraphView::updateMapping()
+int GraphView::sampleToY(int value, const geo::Rect &graph) const
 {
-    if (source == NULL || source->MaxSampleValueSpan() <= 0)
+    int y = graph.Y() + graph.Height()/2 - (int) (((int64_t) value * sampleMap) >> 16);
+
+    if (y < graph.Y())
+        return graph.Y();
+    else if (y >= graph.Y2())
+        return graph.Y2()-1;
+    else
+        return y;
+}
+
+void GraphView::paintColumns(const geo::Rect &graph, int first, int last, int bufferLength)
+{
+    if (first > last)
+        return;
+
+    painter.drawFillRect(graph.X()+first, graph.Y(), last-first+1, graph.Height(), true);
+    painter.setForegroundColor(StandardHighlightColor);
+
+    int columns = graph.Width();
+    if (bufferLength >= columns)
     {
-        sampleMap = 0.0;
+        // each column shows the min and max of the samples it covers
+        for (int c=first; c<=last; c++)
+        {
+            int start = c * bufferLength / columns;
+            int end = (c+1) * bufferLength / columns;
+
+            int min, max;
+            source->SampleRange(start, end - start, min, max);
+            painter.drawVLine(graph.X()+c, sampleToY(max, graph), sampleToY(min, graph)+1);
+        }
         return;
     }
 
-    if (viewRect.Height() <= 0)
+    // fewer samples than columns: interpolate, 16.16 fixed point sample position
+    int step = bufferLength > 1 ? ((bufferLength-1) << 16) / (columns-1) : 0;
+    int y = 0;
+    for (int c=first; c<=last+1 && c<columns; c++)
     {
-        sampleMap = 0.0;
-        return;
+        int position = c * step;
+        int index = position >> 16;
+        int fraction = position & 0xFFFF;
+
+        int y1 = sampleToY(source->DataPoint(index), graph);
+        int y2 = index+1 < bufferLength ? sampleToY(source->DataPoint(index+1), graph) : y1;
+        int next = y1 + (((y2 - y1) * fraction) >> 16);
+
+        // connect each column to the next
+        if (c > first)
+            painter.drawVLine(graph.X()+c-1, y < next ? y : next, (y < next ? next : y)+1);
+
+        y = next;
     }
 
-    sampleMap = viewRect.Height() / (source->MaxSampleValueSpan()*2.0);
+    if (last == columns-1)
+        painter.drawVLine(graph.X()+last, y, y+1);
 }
 
 void GraphView::repaint()
@@ -108,116 +162,47 @@ void GraphView::repaint()
     if (source == NULL)
         return;
 
-    geo::Rect updateView(viewRect);
-    int newestIndex = source->NewestSampleIndex();
+    int bufferLength = source->BufferLength();
+    geo::Rect graph = graphRect();
+    if (bufferLength <= 0 || graph.Width() <= 0 || graph.Height() <= 0)
+        return;
 
-    if (!totalRefresh && lastDataIndex <= newestIndex)
-    {
-        updateView.appendY(1);
-        updateView.setHeight(updateView.Height()-2);
+    MONO_TRACE_SCOPE("GraphView::repaint");
 
-        updateView.appendX(lastDataIndexMapped);
-        int diff = (newestIndex - lastDataIndex) / bufferStride ;
-        updateView.setWidth(diff < bufferStride ? bufferStride : diff );
-    }
-    else if (!totalRefresh)
-    {
-        updateView.appendY(1);
-        updateView.setHeight(updateView.Height()-2);
+    updateMapping();
 
-        int diff = newestIndex / bufferStride ;
-        updateView.setWidth(newestIndex < bufferStride ? bufferStride : diff);
-    }
+    int columns = graph.Width();
+    int newestIndex = source->NewestSampleIndex();
+    int newestColumn = columnOfSample(newestIndex, bufferLength, columns);
 
-    //clear graph area
     painter.setBackgroundColor(StandardBackgroundColor);
 
-    int start = us_ticker_read();
-    painter.drawFillRect(updateView, true);
-    int fillRect = us_ticker_read();
-
     if (totalRefresh)
     {
         painter.setForegroundColor(StandardBorderColor);
         painter.drawRect(viewRect);
+        paintColumns(graph, 0, columns-1, bufferLength);
         totalRefresh = false;
     }
-
-    int outRect = us_ticker_read();
-
-    // draw graph line
-    bool viewSmallerThanBuffer = source->BufferLength() > viewRect.Width();
-
-
-    int newestIndexMapped = 0;
-
-    int graphTime = 0;
-
-    painter.setForegroundColor(StandardHighlightColor);
-    for (int x=updateView.X(); x<updateView.X2(); x++)
+    else if (lastDataIndex <= newestIndex)
     {
-        if (viewSmallerThanBuffer)
-        {
-            int min, max;
-            int xBuf = x*bufferStride;
-            min = max = source->DataPoint(xBuf);
-
-            if (newestIndex == xBuf)
-                newestIndexMapped = x;
-
-            for (int s=1; s<bufferStride; s++)
-            {
-                int sample = source->DataPoint(xBuf+s);
-                if (sample < min)
-                {
-                    min = sample;
-                }
-                if (sample > max)
-                    max = sample;
-
-                if (newestIndex != 0 && newestIndex == xBuf+s)
-                {
-                    newestIndexMapped = x;
-                }
-            }
-
-            int mapMax = sampleMap*max;
-            int mapMin = sampleMap*min;
-
-            if (mapMin == mapMax)
-                mapMax++;
-
-            int offset = updateView.Y()+updateView.Height()/2;
-
-            int gBegin = us_ticker_read();
-            painter.drawVLine(x, offset-mapMax, offset-mapMin);
-            graphTime += us_ticker_read() - gBegin;
-        }
-        else
-        {
-            debug("buffers smaller than view length not yet supported!\r\n");
-            return;
-        }
+        // only the columns with new samples, and the old cursor position
+        paintColumns(graph, lastDataIndexMapped, newestColumn, bufferLength);
     }
-    int cursor = 0;
+    else
+    {
+        // the data source has wrapped around
+        paintColumns(graph, lastDataIndexMapped, columns-1, bufferLength);
+        paintColumns(graph, 0, newestColumn, bufferLength);
+    }
+
     //draw newest index position
-    if (useCursor && newestIndex != 0 && newestIndexMapped != 0)
+    if (useCursor && newestIndex != 0)
     {
         painter.setForegroundColor(StandardTextColor);
-
-        int begin = us_ticker_read();
-        if (bufferStride > 1)
-            painter.drawVLine(viewRect.X()+newestIndexMapped, viewRect.Y(), viewRect.Y2());
-        else
-            painter.drawVLine(newestIndex, viewRect.Y(), viewRect.Y2());
-
-        cursor = us_ticker_read() - begin;
+        painter.drawVLine(graph.X()+newestColumn, graph.Y(), graph.Y2());
     }
 
     lastDataIndex = newestIndex;
-    lastDataIndexMapped = newestIndexMapped;
-
-    int fill = fillRect - start;
-    int out = outRect - fillRect;
-    debug("Fill: %i, Outline: %i, graph: %i, cursor: %i, total: %i\r\n",fill,out,graphTime,cursor,fill+out+graphTime+cursor);
+    lastDataIndexMapped = newestColumn;
 }
@@ -41,6 +41,15 @@ namespace mono { namespace ui {
      * This enables the @ref GraphView to display a scrolling cursor, that moves
      * as the buffer data gets updates.
      *
+     * When the buffer is longer than the view is wide, each column in the
+     * graph shows the min and max of several samples. If your data source
+     * can find those faster than by reading every sample, override:
+     *
+     * * @ref SampleRange(int, int, int&, int&)
+     *
+     * The @ref GraphRingBuffer class does that, and is a ready-made data
+     * source for live plots.
+     *
      * **Note**: You are in charge of notifying the associated @ref GraphView's
      * when the data source content changes.
      *
@@ -88,6 +97,29 @@ namespace mono { namespace ui {
          * @returns Position of newest sample
          */
         virtual int NewestSampleIndex() { return 0; };
+
+        /*!
+         * @brief Get the smallest and largest sample in a range of the buffer
+         *
+         * The default implementation reads every sample with @ref DataPoint.
+         *
+         * @param index The first sample in the range
+         * @param length The number of samples in the range, at least 1
+         * @param min Set to the smallest sample
+         * @param max Set to the largest sample
+         */
+        virtual void SampleRange(int index, int length, int &min, int &max)
+        {
+            min = max = DataPoint(index);
+            for (int i=index+1; i<index+length; i++)
+            {
+                int sample = DataPoint(i);
+                if (sample < min)
+                    min = sample;
+                if (sample > max)
+                    max = sample;
+            }
+        }
     };
 
     
@@ -176,6 +208,10 @@ namespace mono { namespace ui {
      * display inside its graph area. It displays the complete data set from the
      * data source, and does not support displaying ranges of the data set.
      *
+     * If the data set is longer than the view is wide, each column shows the
+     * min and max of the samples it covers. If it is shorter, the graph
+     * interpolates between the samples.
+     *
      * If you wish to apply zooming (either on x or Y axis), you must do that by
      * scaling transforming the data in the data source. You can use an 
      * intermediate data source object, that scales the data samples, before
@@ -187,8 +223,8 @@ namespace mono { namespace ui {
     {
     protected:
 
-        int bufferStride;
-        float sampleMap;
+        /** Sample to pixel scale, in 16.16 fixed point */
+        int sampleMap;
         void privInit();
         bool useCursor;
         bool totalRefresh;
@@ -199,9 +235,20 @@ namespace mono { namespace ui {
 
         void repaint();
 
-        void updateStride();
         void updateMapping();
 
+        /** The area inside the border, where the graph is drawn */
+        geo::Rect graphRect() const;
+
+        /** The graph column (0 is the leftmost) that shows a sample */
+        int columnOfSample(int index, int bufferLength, int columns) const;
+
+        /** The y coordinate of a sample value */
+        int sampleToY(int value, const geo::Rect &graph) const;
+
+        /** Draw the columns from `first` to `last`, both included */
+        void paintColumns(const geo::Rect &graph, int first, int last, int bufferLength);
+
     public:
         
         /*!
@@ -0,0 +1,157 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "hit_test_grid.h"
+#include <string.h>
+
+using namespace mono::ui;
+
+const int HitTestGrid::CellSize;
+const int HitTestGrid::Columns;
+const int HitTestGrid::Rows;
+const int HitTestGrid::MaxItems;
+
+HitTestGrid::HitTestGrid()
+{
+    memset(items, 0, sizeof(items));
+    memset(stackOrder, 0, sizeof(stackOrder));
+    memset(cells, 0, sizeof(cells));
+    usedSlots = 0;
+    nextOrder = 0;
+}
+
+int HitTestGrid::slotOf(const void *item) const
+{
+    for (int slot = 0; slot < MaxItems; slot++)
+    {
+        if ((usedSlots & (1u << slot)) && items[slot] == item)
+            return slot;
+    }
+
+    return -1;
+}
+
+int HitTestGrid::cellIndex(int coordinate, int count)
+{
+    int index = coordinate / CellSize;
+    if (index < 0)
+        return 0;
+    if (index >= count)
+        return count-1;
+    return index;
+}
+
+void HitTestGrid::markCells(int slot, const geo::Rect &rect, bool set)
+{
+    // Rect::contains includes the X2 and Y2 edges
+    int firstColumn = cellIndex(rect.X(), Columns);
+    int lastColumn = cellIndex(rect.X2(), Columns);
+    int firstRow = cellIndex(rect.Y(), Rows);
+    int lastRow = cellIndex(rect.Y2(), Rows);
+    uint32_t bit = 1u << slot;
+
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+        for (int column = firstColumn; column <= lastColumn; column++)
+        {
+            if (set)
+                cells[row*Columns + column] |= bit;
+            else
+                cells[row*Columns + column] &= ~bit;
+        }
+    }
+}
+
+bool HitTestGrid::insert(void *item, const geo::Rect &rect)
+{
+    int slot = slotOf(item);
+    if (slot >= 0)
+        markCells(slot, rects[slot], false);
+    else
+    {
+        for (slot = 0; slot < MaxItems; slot++)
+        {
+            if ((usedSlots & (1u << slot)) == 0)
+                break;
+        }
+
+        if (slot == MaxItems)
+            return false;
+    }
+
+    items[slot] = item;
+    rects[slot] = rect;
+    stackOrder[slot] = ++nextOrder;
+    usedSlots |= 1u << slot;
+    markCells(slot, rect, true);
+    return true;
+}
+
+bool HitTestGrid::update(void *item, const geo::Rect &rect)
+{
+    int slot = slotOf(item);
+    if (slot < 0)
+        return false;
+
+    markCells(slot, rects[slot], false);
+    rects[slot] = rect;
+    markCells(slot, rect, true);
+    return true;
+}
+
+void HitTestGrid::remove(void *item)
+{
+    int slot = slotOf(item);
+    if (slot < 0)
+        return;
+
+    markCells(slot, rects[slot], false);
+    items[slot] = 0;
+    usedSlots &= ~(1u << slot);
+}
+
+bool HitTestGrid::contains(const void *item) const
+{
+    return slotOf(item) >= 0;
+}
+
+void *HitTestGrid::hitTest(const geo::Point &point, const void *above) const
+{
+    uint32_t orderLimit = nextOrder + 1;
+    if (above != 0)
+    {
+        int aboveSlot = slotOf(above);
+        if (aboveSlot < 0)
+            return 0;
+
+        orderLimit = stackOrder[aboveSlot];
+    }
+
+    geo::Point p = point;
+    uint32_t mask = cells[cellIndex(p.Y(), Rows)*Columns + cellIndex(p.X(), Columns)];
+    void *hit = 0;
+    uint32_t hitOrder = 0;
+
+    for (int slot = 0; mask != 0; slot++, mask >>= 1)
+    {
+        if ((mask & 1) == 0 || stackOrder[slot] < hitOrder || stackOrder[slot] >= orderLimit)
+            continue;
+
+        if (rects[slot].contains(p))
+        {
+            hit = items[slot];
+            hitOrder = stackOrder[slot];
+        }
+    }
+
+    return hit;
+}
+
+int HitTestGrid::Count() const
+{
+    int count = 0;
+    for (uint32_t used = usedSlots; used != 0; used >>= 1)
+        count += used & 1;
+
+    return count;
+}
@@ -0,0 +1,101 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef hit_test_grid_h
+#define hit_test_grid_h
+
+#include <stdint.h>
+#include <rect.h>
+
+namespace mono { namespace ui {
+
+    /**
+     * @brief A coarse spatial index of rects, for finding the one at a point
+     *
+     * The screen is divided into cells of @ref CellSize pixels. Each cell has
+     * a bit mask of the rects that overlap it, so a hit test only checks the
+     * few rects in one cell, no matter how many rects there are in total.
+     *
+     * Rects are stacked in the order they are inserted: the latest inserted
+     * rect is on top, and wins when rects overlap.
+     *
+     * The grid holds at most @ref MaxItems rects and does not allocate
+     * memory.
+     *
+     * @see ResponderView
+     */
+    class HitTestGrid
+    {
+    public:
+
+        /** The width and height of a grid cell, in pixels */
+        static const int CellSize = 32;
+
+        /** The grid covers the long side of the display in both orientations */
+        static const int Columns = 7;
+        static const int Rows = 7;
+
+        /** The maximum number of rects, the number of bits in a cell mask */
+        static const int MaxItems = 32;
+
+    protected:
+
+        void *items[MaxItems];
+        geo::Rect rects[MaxItems];
+        uint32_t stackOrder[MaxItems];
+        uint32_t usedSlots;
+        uint32_t nextOrder;
+        uint32_t cells[Rows*Columns];
+
+        /** @brief The slot holding an item, or -1 */
+        int slotOf(const void *item) const;
+
+        /** @brief Set or clear a slot's bit in the cells a rect overlaps */
+        void markCells(int slot, const geo::Rect &rect, bool set);
+
+        /** @brief The cell column or row of a coordinate, clamped to the grid */
+        static int cellIndex(int coordinate, int count);
+
+    public:
+
+        HitTestGrid();
+
+        /**
+         * @brief Add an item on top of all other items
+         * @param item The item returned by @ref hitTest
+         * @param rect The area of the item
+         * @return `false` if the grid is full
+         */
+        bool insert(void *item, const geo::Rect &rect);
+
+        /**
+         * @brief Change the area of an item, keeping its stack order
+         * @return `false` if the item is not in the grid
+         */
+        bool update(void *item, const geo::Rect &rect);
+
+        /** @brief Remove an item, does nothing if the item is not in the grid */
+        void remove(void *item);
+
+        /** @brief `true` if an item is in the grid */
+        bool contains(const void *item) const;
+
+        /**
+         * Pass the previous hit as `above`, to find the items under a point
+         * one by one, from the top.
+         *
+         * @brief Find the top-most item at a point
+         * @param point The point to test
+         * @param above Optional: Only find items below this item
+         * @return The item, or `NULL` if no rect contains the point, or if
+         * `above` is not in the grid
+         */
+        void *hitTest(const geo::Point &point, const void *above = 0) const;
+
+        /** @brief The number of items in the grid */
+        int Count() const;
+    };
+
+} }
+
+#endif /* hit_test_grid_h */
@@ -8,14 +8,28 @@ using namespace mono::ui;
 IconView::IconView() : View()
 {
     icon = 0;
+    rleIcon = 0;
+    spriteCache = 0;
 }
 
 IconView::IconView(const geo::Point &pos, const display::MonoIcon &icon) :
     View(geo::Rect(pos, geo::Size(icon.width, icon.height)))
 {
     this->icon = &icon;
+    rleIcon = 0;
     foreground = View::StandardTextColor;
     background = View::StandardBackgroundColor;
+    spriteCache = 0;
+}
+
+IconView::IconView(const geo::Point &pos, const display::MonoRleIcon &icon) :
+    View(geo::Rect(pos, geo::Size(icon.width, icon.height)))
+{
+    this->icon = 0;
+    rleIcon = &icon;
+    foreground = View::StandardTextColor;
+    background = View::StandardBackgroundColor;
+    spriteCache = 0;
 }
 
 // MARK: Accessors
@@ -33,6 +47,18 @@ void IconView::setBackground(Color c)
 void IconView::setIcon(const MonoIcon *icon)
 {
     this->icon = icon;
+    rleIcon = 0;
+}
+
+void IconView::setRleIcon(const MonoRleIcon *icon)
+{
+    this->icon = 0;
+    rleIcon = icon;
+}
+
+void IconView::setSpriteCache(display::SpriteCache *cache)
+{
+    spriteCache = cache;
 }
 
 Color IconView::Foreground() const
@@ -47,6 +73,15 @@ Color IconView::Background() const
 
 void IconView::repaint()
 {
+    if (spriteCache != 0 && repaintCached())
+        return;
+
+    if (rleIcon != 0)
+    {
+        repaintRle();
+        return;
+    }
+
     if (icon == 0)
         return;
 
@@ -58,8 +93,130 @@ void IconView::repaint()
     {
         for (int x=0; x<icon->width; x++)
         {
-            ctrl->write(foreground.alphaBlend(icon->bitmap[cnt], background));
+            uint8_t alpha = icon->bitmap[cnt];
+            if (alpha == 0)
+                ctrl->write(background);
+            else if (alpha == 0xFF)
+                ctrl->write(foreground);
+            else
+                ctrl->write(display::Color::blend(foreground.value, background.value, display::Color::Alpha(alpha)));
             cnt++;
         }
     }
 }
+
+void IconView::repaintRle()
+{
+    display::IDisplayController *ctrl = painter.DisplayController();
+    ctrl->setWindow(viewRect.X(), viewRect.Y(), viewRect.Width(), viewRect.Height());
+
+    const uint8_t *run = rleIcon->runs;
+    const uint8_t *end = run + rleIcon->length;
+    int remaining = rleIcon->width * rleIcon->height;
+
+    while (run < end && remaining > 0)
+    {
+        uint8_t header = *run++;
+        int length = (header & display::RLE_RUN_LENGTH_MASK) + 1;
+
+        if (length > remaining)
+            length = remaining;
+
+        switch (header & display::RLE_RUN_TYPE_MASK)
+        {
+            case display::RLE_RUN_BACKGROUND:
+                ctrl->writeFill(background, length);
+                break;
+            case display::RLE_RUN_FOREGROUND:
+                ctrl->writeFill(foreground, length);
+                break;
+            default:
+                if (length > end - run)
+                    length = end - run;
+
+                for (int i=0; i<length; i++)
+                    ctrl->write(display::Color::blend(foreground.value, background.value, display::Color::Alpha(*run++)));
+                break;
+        }
+
+        remaining -= length;
+    }
+
+    // pad truncated icon data
+    if (remaining > 0)
+        ctrl->writeFill(background, remaining);
+}
+
+bool IconView::repaintCached()
+{
+    const void *source = rleIcon != 0 ? (const void*) rleIcon : (const void*) icon;
+    if (source == 0)
+        return false;
+
+    int width = rleIcon != 0 ? rleIcon->width : icon->width;
+    int height = rleIcon != 0 ? rleIcon->height : icon->height;
+    display::SpriteCache::Key key(source, (foreground.value << 16) | background.value, width, height);
+
+    const uint16_t *pixels = spriteCache->lookup(key);
+    if (pixels == 0)
+    {
+        uint16_t *sprite = spriteCache->insert(key);
+        if (sprite == 0)
+            return false;
+
+        renderPixels(sprite);
+        pixels = sprite;
+    }
+
+    display::IDisplayController *ctrl = painter.DisplayController();
+    ctrl->setWindow(viewRect.X(), viewRect.Y(), width, height);
+    ctrl->writeBuffer(pixels, width*height);
+    return true;
+}
+
+void IconView::renderPixels(uint16_t *target) const
+{
+    int count = rleIcon != 0 ? rleIcon->width * rleIcon->height : icon->width * icon->height;
+    int cnt = 0;
+
+    if (rleIcon != 0)
+    {
+        const uint8_t *run = rleIcon->runs;
+        const uint8_t *end = run + rleIcon->length;
+
+        while (run < end && cnt < count)
+        {
+            uint8_t header = *run++;
+            int length = (header & display::RLE_RUN_LENGTH_MASK) + 1;
+            uint8_t type = header & display::RLE_RUN_TYPE_MASK;
+
+            if (length > count - cnt)
+                length = count - cnt;
+
+            if (type == display::RLE_RUN_BACKGROUND || type == display::RLE_RUN_FOREGROUND)
+            {
+                uint16_t value = type == display::RLE_RUN_BACKGROUND ? background.value : foreground.value;
+                for (int i=0; i<length; i++)
+                    target[cnt++] = value;
+            }
+            else
+            {
+                if (length > end - run)
+                    length = end - run;
+
+                display::Color::blendMask(target + cnt, run, foreground, background, length);
+                run += length;
+                cnt += length;
+            }
+        }
+    }
+    else
+    {
+        display::Color::blendMask(target, icon->bitmap, foreground, background, count);
+        cnt = count;
+    }
+
+    // pad truncated icon data
+    for (; cnt < count; cnt++)
+        target[cnt] = background.value;
+}
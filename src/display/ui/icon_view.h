@@ -6,9 +6,11 @@
 
 #include <view.h>
 #include <mono_icon.h>
+#include <sprite_cache.h>
 
 using mono::display::Color;
 using mono::display::MonoIcon;
+using mono::display::MonoRleIcon;
 
 namespace mono { namespace ui {
 
@@ -85,13 +87,36 @@ namespace mono { namespace ui {
      *
      * [img2icon on Github](https://github.com/getopenmono/img2icon)
      *
+     * ## Compressed icons
+     *
+     * Icons can also be run-length compressed, see @ref MonoRleIcon. These
+     * take up less flash and draw faster, since only the edge pixels are
+     * blended. The fully transparent and opaque runs are drawn as single
+     * color fills. Convert PNG files to compressed icons with the
+     * `resources/img2rleicon.py` tool, or run `make rle` in `resources`
+     * with the icons makefile.
+     *
+     * @code
+     * #include <speaker-16-rle.h>
+     * #include <mute-16-rle.h>
+     *
+     * IconView icn(geo::Point(20,20), speaker16Rle);
+     * icn.setRleIcon(&mute16Rle); // replace it later
+     * @endcode
+     *
      * @see mono::display::MonoIcon
      */
     class IconView : public View {
 
         const MonoIcon *icon;
+        const MonoRleIcon *rleIcon;
         Color foreground;
         Color background;
+        display::SpriteCache *spriteCache;
+
+        void repaintRle();
+        void renderPixels(uint16_t *target) const;
+        bool repaintCached();
 
     public:
 
@@ -116,6 +141,17 @@ namespace mono { namespace ui {
          */
         IconView(const geo::Point &position, const MonoIcon &icon);
 
+        /**
+         * @brief Construct an icon view with a compressed icon
+         *
+         * Like the uncompressed variant, the views rect is calculated from
+         * the icon.
+         *
+         * @param position The offset where the view is positioned
+         * @param icon The reference to the global compressed icon object
+         */
+        IconView(const geo::Point &position, const MonoRleIcon &icon);
+
         // MARK: Accessors
 
         /**
@@ -136,6 +172,26 @@ namespace mono { namespace ui {
          */
         void setIcon(const MonoIcon *icon);
 
+        /**
+         * @brief Replace the existing icon with a compressed one
+         *
+         * This has its own name, so `setIcon(NULL)` is not ambiguous.
+         *
+         * @param icon replacement
+         */
+        void setRleIcon(const MonoRleIcon *icon);
+
+        /**
+         * @brief Keep the blended icon pixels in a sprite cache
+         *
+         * When a cache is set, the repaint writes the cached pixels for the
+         * icon and its current colors. The icon is only blended on a miss.
+         * Many icon views can share the same cache.
+         *
+         * @param cache The cache to use, or `NULL` to disable caching
+         */
+        void setSpriteCache(display::SpriteCache *cache);
+
         /**
          * @brief Get the current foreground color
          */
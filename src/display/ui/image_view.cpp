@@ -3,17 +3,21 @@
 
 #include "image_view.h"
 #include <mbed_debug.h>
+#include <tracer.h>
+#include <string.h>
 
 using namespace mono::ui;
 
 ImageView::ImageView() : crop(0,0,0,0)
 {
     image = NULL;
+    spriteCache = NULL;
 }
 
 ImageView::ImageView(media::Image *img) : crop(0,0, img->Width(), img->Height())
 {
     image = img;
+    spriteCache = NULL;
 
     //crop within display canvas
     if (img->Width() > View::painter.CanvasWidth())
@@ -53,6 +57,8 @@ void ImageView::repaint()
         return;
     }
 
+    MONO_TRACE_SCOPE("ImageView::repaint");
+
     //copy the image crop/select rect
     geo::Rect dispRect = crop;
     //zero the offset
@@ -61,29 +67,100 @@ void ImageView::repaint()
     dispRect = dispRect.crop(viewRect);
 
     display::IDisplayController *ctrl = View::painter.DisplayController();
-    uint16_t pixels[176];
     ctrl->setWindow(viewRect.X(), viewRect.Y(), dispRect.Width(), dispRect.Height());
 
-    int iy = 0;
+    if (spriteCache == NULL || !repaintCached(ctrl, dispRect))
+        repaintStreamed(ctrl, dispRect);
+}
 
-    for(int16_t y=crop.Y(); y<crop.Y()+dispRect.Height(); y++)
-    {
-        image->SeekToHLine(y);
+void ImageView::repaintStreamed(display::IDisplayController *ctrl, const geo::Rect &dispRect)
+{
+    // writeBuffer is done with the block when it returns, so one is enough
+    uint16_t block[StreamBlockPixels];
 
-        if (crop.X() > 0)
-            image->SkipPixelData(crop.X());
+    if (image->HasContiguousLines() && crop.X() == 0 && dispRect.Width() == image->Width())
+    {
+        // Stream the entire window with sequential reads
+        int remaining = dispRect.Width() * dispRect.Height();
+        image->SeekToHLine(crop.Y());
+
+        while (remaining > 0)
+        {
+            int read = image->ReadPixelData(block, remaining < StreamBlockPixels ? remaining : StreamBlockPixels);
+            if (read <= 0)
+                break;
+
+            ctrl->writeBuffer(block, read);
+            remaining -= read;
+        }
+    }
+    else
+    {
+        for(int16_t y=crop.Y(); y<crop.Y()+dispRect.Height(); y++)
+        {
+            image->SeekToHLine(y);
+
+            if (crop.X() > 0)
+                image->SkipPixelData(crop.X());
+
+            // fill the whole window line, or the following lines are sheared
+            int remaining = dispRect.Width();
+            while (remaining > 0)
+            {
+                int read = image->ReadPixelData(block, remaining < StreamBlockPixels ? remaining : StreamBlockPixels);
+                if (read <= 0)
+                    break;
+
+                ctrl->writeBuffer(block, read);
+                remaining -= read;
+            }
+
+            // pad a short line, like the sprite cache does
+            if (remaining > 0)
+                ctrl->writeFill(display::Color(0), remaining);
+        }
+    }
+}
 
-        image->ReadPixelData(pixels, dispRect.Width());
+bool ImageView::repaintCached(display::IDisplayController *ctrl, const geo::Rect &dispRect)
+{
+    int width = dispRect.Width(), height = dispRect.Height();
+    display::SpriteCache::Key key(image, (crop.X() << 16) | (crop.Y() & 0xFFFF), width, height);
 
-        for (int16_t x=0; x<dispRect.Width(); x++) {
-                ctrl->write(pixels[x]);
+    const uint16_t *pixels = spriteCache->lookup(key);
+    if (pixels == NULL)
+    {
+        uint16_t *sprite = spriteCache->insert(key);
+        if (sprite == NULL)
+            return false;
+
+        for (int y=0; y<height; y++)
+        {
+            image->SeekToHLine(crop.Y()+y);
+
+            if (crop.X() > 0)
+                image->SkipPixelData(crop.X());
+
+            int read = image->ReadPixelData(sprite + y*width, width);
+            if (read < 0)
+                read = 0;
+            if (read < width)
+                memset(sprite + y*width + read, 0, (width - read)*sizeof(uint16_t));
         }
 
-        iy++;
+        pixels = sprite;
     }
+
+    ctrl->writeBuffer(pixels, width*height);
+    return true;
 }
 
 const mono::geo::Rect &ImageView::Crop() const
 {
     return crop;
+}
+
+void ImageView::setSpriteCache(display::SpriteCache *cache)
+{
+    spriteCache = cache;
 }
\ No newline at end of file
@@ -6,12 +6,14 @@
 
 #include "view.h"
 #include "../../media/image.h"
+#include "sprite_cache.h"
 
 namespace mono { namespace ui {
     
     /**
      * The ImageView can render a bitmap image on the display. It needs a image
-     * data source, that delivers the actual bitmap. (See @ref BMPImage)
+     * data source, that delivers the actual bitmap. (See @ref BMPImage and
+     * @ref RGB565Image)
      *
      * You provide the image data and a bounding rect where the ImageView is
      * painted.
@@ -62,8 +64,21 @@ namespace mono { namespace ui {
          * (non destructive).
          */
         geo::Rect crop;
+
+        /** The optional cache of decoded images, see @ref setSpriteCache */
+        display::SpriteCache *spriteCache;
+
+        void repaintStreamed(display::IDisplayController *ctrl, const geo::Rect &dispRect);
+        bool repaintCached(display::IDisplayController *ctrl, const geo::Rect &dispRect);
         
     public:
+
+        /**
+         * The number of pixels read from the image source in one block, and
+         * then written to the display. One block equals the width of the
+         * display in landscape, its longest side.
+         */
+        static const int StreamBlockPixels = 220;
         
         /**
          * Construct an empty image view, where no image is displayed
@@ -74,7 +89,9 @@ namespace mono { namespace ui {
         /**
          * Construct an UI image from an image file
          * 
-         * At the moment only BMP images are supported!
+         * BMP images and native RGB565 images are supported. RGB565 images
+         * draw fastest, since they need no decoding and can be streamed with
+         * sequential reads. (See @ref RGB565Image)
          * *Remember to initialize the mbed class `SDFileSystem` object before calling this
          * consructor!*
          *
@@ -118,6 +135,21 @@ namespace mono { namespace ui {
          */
         const geo::Rect &Crop() const;
 
+        /**
+         * @brief Keep the decoded image in a sprite cache
+         *
+         * When a cache is set, the repaint first looks for the decoded pixels
+         * in the cache. Only on a miss the image source is read, and the
+         * pixels are stored in the cache. Use this for small images that are
+         * redrawn often. Images larger than the cache arena are not cached.
+         *
+         * The cache is keyed by the image object and the crop offset. If you
+         * change the image source data, you must invalidate it in the cache.
+         *
+         * @param cache The cache to use, or `NULL` to disable caching
+         */
+        void setSpriteCache(display::SpriteCache *cache);
+
         void repaint();
     };
     
@@ -0,0 +1,389 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "layout.h"
+
+using namespace mono::ui;
+
+Layout::Layout(const geo::Rect &rect) : viewRect(rect)
+{
+    padding = spacing = 0;
+    visible = false;
+    needsLayout = true;
+    measureCount = 0;
+}
+
+Layout::~Layout()
+{
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+        it->view->parentLayout = 0;
+}
+
+// MARK: Children
+
+void Layout::addView(const IViewALike &child)
+{
+    Item item;
+    item.view = (IViewALike*) &child;
+    item.measured = false;
+    item.changed = true;
+    item.view->parentLayout = this;
+    items.push_back(item);
+    needsLayout = true;
+}
+
+void Layout::removeView(const IViewALike &child)
+{
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        if (it->view == &child)
+        {
+            it->view->parentLayout = 0;
+            items.erase(it);
+            needsLayout = true;
+            return;
+        }
+    }
+}
+
+void Layout::invalidate(const IViewALike &child)
+{
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        if (it->view == &child)
+        {
+            it->measured = false;
+            it->changed = true;
+            needsLayout = true;
+
+            if (parentLayout != 0)
+                parentLayout->invalidate(*this);
+            return;
+        }
+    }
+}
+
+void Layout::invalidate()
+{
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        it->measured = false;
+        it->changed = true;
+    }
+
+    needsLayout = true;
+}
+
+void Layout::childChanged(const IViewALike &child)
+{
+    invalidate(child);
+
+    Layout *root = this;
+    while (root->parentLayout != 0)
+        root = root->parentLayout;
+
+    if (root->visible)
+        root->layoutIfNeeded();
+}
+
+void Layout::setSpacing(int spacing)
+{
+    this->spacing = spacing;
+    needsLayout = true;
+}
+
+void Layout::setPadding(int padding)
+{
+    this->padding = padding;
+    needsLayout = true;
+}
+
+bool Layout::NeedsLayout() const
+{
+    return needsLayout;
+}
+
+uint32_t Layout::MeasureCount() const
+{
+    return measureCount;
+}
+
+void Layout::layoutIfNeeded()
+{
+    if (!needsLayout)
+        return;
+
+    measure();
+    arrange();
+    needsLayout = false;
+
+    // only the children that moved or changed, a nested layout does its own
+    // layout pass and repaints its changed children
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        if (it->changed && visible)
+            it->view->scheduleRepaint();
+
+        it->changed = false;
+    }
+}
+
+void Layout::measure() const
+{
+    for (ConstItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        if (it->measured)
+            continue;
+
+        it->size = it->view->PreferredSize();
+        it->measured = true;
+        measureCount++;
+    }
+}
+
+mono::geo::Rect Layout::contentRect() const
+{
+    int width = viewRect.Width() - 2*padding;
+    int height = viewRect.Height() - 2*padding;
+    return geo::Rect(viewRect.X() + padding, viewRect.Y() + padding,
+                     width > 0 ? width : 0, height > 0 ? height : 0);
+}
+
+void Layout::place(Item &item, const geo::Rect &rect)
+{
+    const geo::Rect &current = item.view->ViewRect();
+    if (current.X() == rect.X() && current.Y() == rect.Y() &&
+        current.Width() == rect.Width() && current.Height() == rect.Height())
+    {
+        return;
+    }
+
+    item.view->setRect(rect);
+    item.changed = true;
+}
+
+// MARK: ViewALike
+
+bool Layout::Visible() const
+{
+    return visible;
+}
+
+void Layout::show()
+{
+    if (visible)
+        return;
+
+    layoutIfNeeded();
+    visible = true;
+
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+        it->view->show();
+}
+
+void Layout::hide()
+{
+    if (!visible)
+        return;
+
+    visible = false;
+
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+        it->view->hide();
+}
+
+void Layout::scheduleRepaint()
+{
+    if (needsLayout)
+    {
+        layoutIfNeeded();
+        return;
+    }
+
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+        it->view->scheduleRepaint();
+}
+
+void Layout::setRect(geo::Rect rect)
+{
+    viewRect = rect;
+    needsLayout = true;
+}
+
+mono::geo::Point &Layout::Position()
+{
+    return viewRect;
+}
+
+mono::geo::Size &Layout::Size()
+{
+    return viewRect;
+}
+
+const mono::geo::Rect &Layout::ViewRect() const
+{
+    return viewRect;
+}
+
+mono::geo::Size Layout::PreferredSize() const
+{
+    measure();
+    geo::Size content = contentSize();
+    return geo::Size(content.Width() + 2*padding, content.Height() + 2*padding);
+}
+
+// MARK: Stack layout
+
+StackLayout::StackLayout(Direction direction, const geo::Rect &rect) : Layout(rect)
+{
+    this->direction = direction;
+    alignment = ALIGN_FILL;
+}
+
+void StackLayout::setDirection(Direction direction)
+{
+    this->direction = direction;
+    needsLayout = true;
+}
+
+void StackLayout::setAlignment(Alignment alignment)
+{
+    this->alignment = alignment;
+    needsLayout = true;
+}
+
+void StackLayout::arrange()
+{
+    geo::Rect content = contentRect();
+    bool vertical = direction == VERTICAL;
+    int position = vertical ? content.Y() : content.X();
+    int crossStart = vertical ? content.X() : content.Y();
+    int crossSpace = vertical ? content.Width() : content.Height();
+
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        int length = vertical ? it->size.Height() : it->size.Width();
+        int cross = vertical ? it->size.Width() : it->size.Height();
+        if (alignment == ALIGN_FILL || cross > crossSpace)
+            cross = crossSpace;
+
+        int offset = crossStart;
+        if (alignment == ALIGN_CENTER)
+            offset += (crossSpace - cross) / 2;
+        else if (alignment == ALIGN_END)
+            offset += crossSpace - cross;
+
+        if (vertical)
+            place(*it, geo::Rect(offset, position, cross, length));
+        else
+            place(*it, geo::Rect(position, offset, length, cross));
+
+        position += length + spacing;
+    }
+}
+
+mono::geo::Size StackLayout::contentSize() const
+{
+    int length = 0, cross = 0;
+    for (ConstItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        int itemLength = direction == VERTICAL ? it->size.Height() : it->size.Width();
+        int itemCross = direction == VERTICAL ? it->size.Width() : it->size.Height();
+
+        if (it != items.begin())
+            length += spacing;
+        length += itemLength;
+        if (itemCross > cross)
+            cross = itemCross;
+    }
+
+    return direction == VERTICAL ? geo::Size(cross, length) : geo::Size(length, cross);
+}
+
+// MARK: Grid layout
+
+GridLayout::GridLayout(int columns, const geo::Rect &rect) : Layout(rect)
+{
+    this->columns = columns > 0 ? columns : 1;
+    rowHeight = 0;
+}
+
+void GridLayout::setColumns(int columns)
+{
+    this->columns = columns > 0 ? columns : 1;
+    needsLayout = true;
+}
+
+void GridLayout::setRowHeight(int height)
+{
+    rowHeight = height;
+    needsLayout = true;
+}
+
+int GridLayout::heightOfRow(ConstItemIterator it) const
+{
+    if (rowHeight > 0)
+        return rowHeight;
+
+    int height = 0;
+    for (int column = 0; column < columns && it != items.end(); ++column, ++it)
+    {
+        if (it->size.Height() > height)
+            height = it->size.Height();
+    }
+
+    return height;
+}
+
+void GridLayout::arrange()
+{
+    geo::Rect content = contentRect();
+    int cellWidth = (content.Width() - (columns-1)*spacing) / columns;
+    if (cellWidth < 0)
+        cellWidth = 0;
+
+    int y = content.Y();
+    int column = 0;
+    int height = 0;
+    for (ItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        if (column == 0)
+            height = heightOfRow(it);
+
+        int x = content.X() + column*(cellWidth + spacing);
+        place(*it, geo::Rect(x, y, cellWidth, height));
+
+        if (++column == columns)
+        {
+            column = 0;
+            y += height + spacing;
+        }
+    }
+}
+
+mono::geo::Size GridLayout::contentSize() const
+{
+    int cellWidth = 0, height = 0, rows = 0;
+    int column = 0;
+    for (ConstItemIterator it = items.begin(); it != items.end(); ++it)
+    {
+        if (column == 0)
+        {
+            height += heightOfRow(it);
+            rows++;
+        }
+
+        if (it->size.Width() > cellWidth)
+            cellWidth = it->size.Width();
+
+        if (++column == columns)
+            column = 0;
+    }
+
+    if (rows == 0)
+        return geo::Size();
+
+    int usedColumns = (int) items.size() < columns ? (int) items.size() : columns;
+    return geo::Size(usedColumns*cellWidth + (usedColumns-1)*spacing,
+                     height + (rows-1)*spacing);
+}
@@ -0,0 +1,241 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef layout_h
+#define layout_h
+
+#include <view_alike.h>
+#include <rect.h>
+#include <list>
+
+namespace mono { namespace ui {
+
+    /**
+     * @brief Base class for containers that position their child views
+     *
+     * A layout owns the rects of its children. It asks each child for its
+     * @ref IViewALike::PreferredSize once, caches the result, and computes
+     * the child rects from the cached sizes. A layout pass repaints only the
+     * children that moved, or whose content changed.
+     *
+     * The layout is retained: nothing is measured again, until a child's
+     * content has changed. A @ref TextLabelView tells its layout itself,
+     * when its text changes. For other views, you tell the layout:
+     *
+     * @code
+     * icon.setIcon(&wifiIcon);
+     * stack.childChanged(icon);
+     * @endcode
+     *
+     * Then only the changed children are measured again. Use
+     * @ref invalidate to mark children as changed, without a layout pass.
+     *
+     * A layout is a *ViewALike* itself, so you can add it to a
+     * @ref SceneController or nest it inside another layout. Changes of a
+     * nested layout's children are passed on to its parent.
+     *
+     * @see StackLayout
+     * @see GridLayout
+     */
+    class Layout : public IViewALike
+    {
+    protected:
+
+        struct Item
+        {
+            IViewALike *view;
+            mutable geo::Size size;
+            mutable bool measured;
+
+            /** Moved or changed since the last layout pass */
+            bool changed;
+        };
+
+        typedef std::list<Item>::iterator ItemIterator;
+        typedef std::list<Item>::const_iterator ConstItemIterator;
+
+        std::list<Item> items;
+        geo::Rect viewRect;
+        int padding, spacing;
+        bool visible, needsLayout;
+        mutable uint32_t measureCount;
+
+        /** @brief Measure the children that are not measured */
+        void measure() const;
+
+        /** @brief The view rect minus the padding */
+        geo::Rect contentRect() const;
+
+        /** @brief Set a child's rect, if it has changed, and mark it changed */
+        void place(Item &item, const geo::Rect &rect);
+
+        /** @brief Set the rects of all children, from their cached sizes */
+        virtual void arrange() = 0;
+
+        /** @brief The size of the children, excluding padding */
+        virtual geo::Size contentSize() const = 0;
+
+    public:
+
+        /**
+         * @brief Construct an empty layout
+         * @param rect The area to lay out the children in
+         */
+        Layout(const geo::Rect &rect = geo::Rect());
+
+        ~Layout();
+
+        // MARK: Children
+
+        /** @brief Add a view to the end of the layout */
+        void addView(const IViewALike &child);
+
+        /** @brief Remove a view from the layout */
+        void removeView(const IViewALike &child);
+
+        /**
+         * @brief Mark a child's content as changed
+         *
+         * The child is measured and repainted on the next layout pass. The
+         * parent layout of a nested layout is invalidated too.
+         */
+        void invalidate(const IViewALike &child);
+
+        /**
+         * @brief Lay out and repaint a child, whose content has changed
+         *
+         * The child is invalidated, and if the layout is visible, the
+         * outermost layout does a layout pass. That repaints the child, and
+         * the children it moves.
+         */
+        void childChanged(const IViewALike &child);
+
+        /** @brief Mark all children as changed */
+        void invalidate();
+
+        /** @brief The space between the children, in pixels */
+        void setSpacing(int spacing);
+
+        /** @brief The space between the view rect and the children, in pixels */
+        void setPadding(int padding);
+
+        /** @brief `true` if a layout pass is pending */
+        bool NeedsLayout() const;
+
+        /**
+         * @brief Update the child rects, if anything has changed
+         *
+         * If the layout is visible, the children that moved or changed are
+         * repainted.
+         */
+        void layoutIfNeeded();
+
+        /** @brief The number of child measurements since construction */
+        uint32_t MeasureCount() const;
+
+        // MARK: ViewALike
+
+        virtual bool Visible() const;
+        virtual void show();
+        virtual void hide();
+
+        /**
+         * @brief Do a pending layout pass, or repaint all children
+         *
+         * If children have changed, only the layout pass is done, and it
+         * repaints the changed children. Otherwise all children are
+         * repainted.
+         */
+        virtual void scheduleRepaint();
+        virtual void setRect(geo::Rect rect);
+        virtual geo::Point &Position();
+        virtual geo::Size &Size();
+        virtual const geo::Rect &ViewRect() const;
+
+        /** @brief The size of the children, including padding */
+        virtual geo::Size PreferredSize() const;
+    };
+
+    /**
+     * @brief Places its children in a row or a column
+     *
+     * Each child gets its preferred size along the stack direction. Across
+     * it, children either keep their preferred size and are aligned, or fill
+     * the layout.
+     *
+     * @code
+     * StackLayout stack(StackLayout::VERTICAL, geo::Rect(0, 0, 176, 220));
+     * stack.setSpacing(4);
+     * stack.addView(title);
+     * stack.addView(value);
+     * stack.addView(button);
+     * stack.show();
+     * @endcode
+     */
+    class StackLayout : public Layout
+    {
+    public:
+
+        enum Direction
+        {
+            VERTICAL,       /**< Top to bottom */
+            HORIZONTAL      /**< Left to right */
+        };
+
+        /** @brief The placement of children across the stack direction */
+        enum Alignment
+        {
+            ALIGN_START,    /**< Left or top */
+            ALIGN_CENTER,
+            ALIGN_END,      /**< Right or bottom */
+            ALIGN_FILL      /**< Use all of the layouts width or height */
+        };
+
+    protected:
+
+        Direction direction;
+        Alignment alignment;
+
+        void arrange();
+        geo::Size contentSize() const;
+
+    public:
+
+        StackLayout(Direction direction = VERTICAL, const geo::Rect &rect = geo::Rect());
+
+        void setDirection(Direction direction);
+        void setAlignment(Alignment alignment);
+    };
+
+    /**
+     * @brief Places its children in equally wide columns
+     *
+     * Children are added row by row. Each child fills its cell. A row is as
+     * high as its tallest child, unless you set a fixed row height.
+     */
+    class GridLayout : public Layout
+    {
+    protected:
+
+        int columns;
+        int rowHeight;
+
+        void arrange();
+        geo::Size contentSize() const;
+
+        /** @brief The height of the row starting at an item */
+        int heightOfRow(ConstItemIterator it) const;
+
+    public:
+
+        GridLayout(int columns, const geo::Rect &rect = geo::Rect());
+
+        void setColumns(int columns);
+
+        /** @brief Set a fixed height of all rows, 0 sizes rows to their children */
+        void setRowHeight(int height);
+    };
+
+} }
+
+#endif /* layout_h */
@@ -0,0 +1,511 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "list_view.h"
+#include <async.h>
+#include <us_ticker_api.h>
+
+using namespace mono::ui;
+
+const int ListView::MaxLineWidth;
+const int ListView::TextInset;
+const int ListView::KineticStartVelocity;
+const int ListView::KineticStopVelocity;
+const uint32_t ListView::KineticTimeConstantUs;
+const uint32_t ListView::KineticScroll::MaxStepUs;
+
+// MARK: Kinetic scroll
+
+ListView::KineticScroll::KineticScroll(ListView *list) : Animation(list, 0, Easing::LINEAR)
+{
+    this->list = list;
+    velocity = 0;
+    remainder = 0;
+    lastTime = 0;
+}
+
+void ListView::KineticScroll::fling(int velocity)
+{
+    this->velocity = velocity;
+    remainder = 0;
+    start();
+}
+
+bool ListView::KineticScroll::step(uint32_t now)
+{
+    // the first step is on the first display refresh after start
+    if (!started)
+    {
+        lastTime = now;
+        started = true;
+        return false;
+    }
+
+    uint32_t elapsed = now - lastTime;
+    lastTime = now;
+    if (elapsed > MaxStepUs)
+        elapsed = MaxStepUs;
+
+    // keep the sub-pixel travel, so slow scrolls do not stall
+    int64_t travel = (int64_t) velocity * elapsed + remainder;
+    int pixels = (int) (travel / 1000000);
+    remainder = (int) (travel - (int64_t) pixels * 1000000);
+
+    // friction, exponential decay of the speed
+    velocity -= (int) (((int64_t) velocity * elapsed) / KineticTimeConstantUs);
+
+    if (pixels != 0 && !list->scrollBy(pixels))
+        return true;
+
+    return velocity < KineticStopVelocity && velocity > -KineticStopVelocity;
+}
+
+// MARK: List view
+
+ListView::ListView(geo::Rect rect) : ResponderView(rect),
+    textColor(StandardTextColor),
+    backgroundColor(StandardBackgroundColor),
+    selectionColor(StandardHighlightColor),
+    separatorColor(StandardBorderColor),
+    kinetic(this)
+{
+    dataSource = 0;
+    rowHeight = 24;
+    textSize = 2;
+    contentOffset = paintedOffset = 0;
+    repaintAll = true;
+    hardwareScrolling = false;
+    selectedRow = -1;
+    dirtyRows[0] = dirtyRows[1] = -1;
+    touchStoppedScroll = false;
+    cachedRow = -1;
+
+    gestures.setGestureCallback(this, &ListView::handleGesture);
+}
+
+ListView::~ListView()
+{
+    cancelAsync(this);
+    stopHardwareScrolling();
+}
+
+void ListView::setDataSource(IListViewDataSource *source)
+{
+    dataSource = source;
+    reloadData();
+}
+
+void ListView::reloadData()
+{
+    cachedRow = -1;
+    if (selectedRow >= rowCount())
+        selectedRow = -1;
+
+    int max = maxContentOffset();
+    if (contentOffset > max)
+        contentOffset = max;
+
+    repaintAll = true;
+    scheduleRepaint();
+}
+
+void ListView::setSelectedRow(int row)
+{
+    if (row == selectedRow)
+        return;
+
+    markRowDirty(selectedRow);
+    markRowDirty(row);
+    selectedRow = row;
+    scheduleRepaint();
+}
+
+int ListView::SelectedRow() const
+{
+    return selectedRow;
+}
+
+void ListView::scrollToRow(int row)
+{
+    int top = row*rowHeight;
+    if (top < contentOffset)
+        scrollTo(top);
+    else if (top + rowHeight > contentOffset + viewRect.Height())
+        scrollTo(top + rowHeight - viewRect.Height());
+}
+
+void ListView::scrollTo(int offset)
+{
+    scrollBy(offset - contentOffset);
+}
+
+int ListView::ContentOffset() const
+{
+    return contentOffset;
+}
+
+bool ListView::IsScrolling() const
+{
+    return kinetic.IsRunning();
+}
+
+void ListView::setRowHeight(int height)
+{
+    rowHeight = height > 0 ? height : 1;
+    reloadData();
+}
+
+void ListView::setTextSize(int size)
+{
+    textSize = size;
+    repaintAll = true;
+    scheduleRepaint();
+}
+
+void ListView::setTextColor(display::Color color)
+{
+    textColor = color;
+    repaintAll = true;
+    scheduleRepaint();
+}
+
+void ListView::setBackgroundColor(display::Color color)
+{
+    backgroundColor = color;
+    repaintAll = true;
+    scheduleRepaint();
+}
+
+void ListView::setSelectionColor(display::Color color)
+{
+    selectionColor = color;
+    markRowDirty(selectedRow);
+    scheduleRepaint();
+}
+
+void ListView::setSeparatorColor(display::Color color)
+{
+    separatorColor = color;
+    repaintAll = true;
+    scheduleRepaint();
+}
+
+// MARK: Touch input
+
+void ListView::touchBegin(TouchEvent &event)
+{
+    // a touch stops the list, it does not select a row
+    touchStoppedScroll = kinetic.IsRunning();
+    kinetic.stop();
+
+    gestures.handle(event);
+
+    // the touch system only reports moves, so check a still finger later
+    cancelAsync(this);
+    asyncAfter(GestureRecognizer::LongPressUs/1000 + 1, this, &ListView::checkLongPress);
+}
+
+void ListView::touchMove(TouchEvent &event)
+{
+    gestures.handle(event);
+}
+
+void ListView::touchEnd(TouchEvent &event)
+{
+    cancelAsync(this);
+    gestures.handle(event);
+}
+
+void ListView::checkLongPress()
+{
+    gestures.update(us_ticker_read());
+}
+
+void ListView::handleGesture(const GestureRecognizer::Gesture &gesture)
+{
+    int row;
+
+    switch (gesture.type)
+    {
+        case GestureRecognizer::DRAG_BEGIN:
+        case GestureRecognizer::DRAG:
+            // the content follows the finger
+            scrollBy(-gesture.deltaY);
+            break;
+        case GestureRecognizer::DRAG_END:
+            scrollBy(-gesture.deltaY);
+            if (gesture.velocityY >= KineticStartVelocity || gesture.velocityY <= -KineticStartVelocity)
+                kinetic.fling(-gesture.velocityY);
+            break;
+        case GestureRecognizer::TAP:
+            row = rowAt(gesture.start);
+            if (touchStoppedScroll || row < 0)
+                break;
+
+            setSelectedRow(row);
+            selectionHandler.call(row);
+            break;
+        case GestureRecognizer::LONG_PRESS:
+            row = rowAt(gesture.start);
+            if (!touchStoppedScroll && row >= 0)
+                longPressHandler.call(row);
+            break;
+        default:
+            break;
+    }
+}
+
+// MARK: Content geometry
+
+int ListView::rowCount() const
+{
+    return dataSource != 0 ? dataSource->NumberOfRows() : 0;
+}
+
+int ListView::maxContentOffset() const
+{
+    int max = rowCount()*rowHeight - viewRect.Height();
+    return max > 0 ? max : 0;
+}
+
+int ListView::rowAt(const geo::Point &position) const
+{
+    geo::Point p = position;
+    if (!viewRect.contains(p))
+        return -1;
+
+    int row = (p.Y() - viewRect.Y() + contentOffset) / rowHeight;
+    return row < rowCount() ? row : -1;
+}
+
+const mono::String &ListView::rowText(int row)
+{
+    if (row != cachedRow)
+    {
+        cachedText = dataSource->TextForRow(row);
+        cachedRow = row;
+    }
+
+    return cachedText;
+}
+
+bool ListView::scrollBy(int pixels)
+{
+    int offset = contentOffset + pixels;
+    int max = maxContentOffset();
+    bool clamped = offset < 0 || offset > max;
+
+    if (offset < 0)
+        offset = 0;
+    else if (offset > max)
+        offset = max;
+
+    if (offset != contentOffset)
+    {
+        contentOffset = offset;
+        scheduleRepaint();
+    }
+
+    return !clamped;
+}
+
+void ListView::markRowDirty(int row)
+{
+    if (row < 0 || row == dirtyRows[0] || row == dirtyRows[1])
+        return;
+
+    if (dirtyRows[0] < 0)
+        dirtyRows[0] = row;
+    else if (dirtyRows[1] < 0)
+        dirtyRows[1] = row;
+    else
+        repaintAll = true;
+}
+
+// MARK: Painting
+
+bool ListView::canScrollInHardware() const
+{
+    display::IDisplayController *ctrl = View::painter.DisplayController();
+    return ctrl != 0 && ctrl->SupportsVerticalScroll() &&
+        viewRect.X() == 0 && viewRect.Width() >= ctrl->ScreenWidth();
+}
+
+void ListView::stopHardwareScrolling()
+{
+    if (hardwareScrolling)
+        View::painter.DisplayController()->setVerticalScrollOffset(0);
+
+    hardwareScrolling = false;
+    repaintAll = true;
+}
+
+void ListView::repaint()
+{
+    display::IDisplayController *ctrl = View::painter.DisplayController();
+    int height = viewRect.Height();
+    if (height <= 0 || rowHeight <= 0)
+        return;
+
+    if (repaintAll)
+    {
+        hardwareScrolling = canScrollInHardware();
+        if (hardwareScrolling)
+        {
+            ctrl->setVerticalScrollArea(viewRect.Y(), height);
+            ctrl->setVerticalScrollOffset(contentOffset % height);
+        }
+
+        paintContentLines(contentOffset, height);
+        paintedOffset = contentOffset;
+        dirtyRows[0] = dirtyRows[1] = -1;
+        repaintAll = false;
+        return;
+    }
+
+    int delta = contentOffset - paintedOffset;
+    if (delta != 0)
+    {
+        if (hardwareScrolling)
+            ctrl->setVerticalScrollOffset(contentOffset % height);
+
+        // only the lines that came into view
+        if (!hardwareScrolling || delta >= height || -delta >= height)
+            paintContentLines(contentOffset, height);
+        else if (delta > 0)
+            paintContentLines(paintedOffset + height, delta);
+        else
+            paintContentLines(contentOffset, -delta);
+
+        paintedOffset = contentOffset;
+    }
+
+    for (int i=0; i<2; i++)
+    {
+        int row = dirtyRows[i];
+        dirtyRows[i] = -1;
+        if (row < 0)
+            continue;
+
+        int first = row*rowHeight;
+        int last = first + rowHeight;
+        if (first < contentOffset)
+            first = contentOffset;
+        if (last > contentOffset + height)
+            last = contentOffset + height;
+
+        if (last > first)
+            paintContentLines(first, last - first);
+    }
+}
+
+void ListView::paintContentLines(int first, int count)
+{
+    display::IDisplayController *ctrl = View::painter.DisplayController();
+    int width = viewRect.Width() < MaxLineWidth ? viewRect.Width() : MaxLineWidth;
+    int height = viewRect.Height();
+    int line = first;
+    int end = first + count;
+
+    while (line < end)
+    {
+        // lines are stored in runs, that wrap at the scroll area end
+        int screenY, run;
+        if (hardwareScrolling)
+        {
+            int stored = line % height;
+            screenY = viewRect.Y() + stored;
+            run = height - stored;
+        }
+        else
+        {
+            screenY = viewRect.Y() + line - contentOffset;
+            run = end - line;
+        }
+
+        if (run > end - line)
+            run = end - line;
+
+        ctrl->setWindow(viewRect.X(), screenY, width, run);
+        for (int i=0; i<run; i++, line++)
+        {
+            int row = line / rowHeight;
+            renderLine(row, line - row*rowHeight, lineBuffer, width);
+            ctrl->writeBuffer(lineBuffer, width);
+        }
+    }
+}
+
+void ListView::renderLine(int row, int line, uint16_t *pixels, int width)
+{
+    bool hasRow = row < rowCount();
+    uint16_t background = hasRow && row == selectedRow ? selectionColor.value : backgroundColor.value;
+    if (hasRow && line == rowHeight-1)
+        background = separatorColor.value;
+
+    for (int x=0; x<width; x++)
+        pixels[x] = background;
+
+    // the text is centered vertically in the row
+    int textTop = (rowHeight - 7*textSize) / 2;
+    if (!hasRow || line < textTop || line >= textTop + 7*textSize)
+        return;
+
+    const String &text = rowText(row);
+    uint8_t bit = 1 << ((line - textTop) / textSize);
+    uint16_t foreground = textColor.value;
+    int x = TextInset;
+
+    for (uint32_t c=0; c<text.Length() && x + 5*textSize <= width; c++)
+    {
+        const unsigned char *columns = display::DisplayPainter::glyph(text[c]);
+        for (int col=0; col<5; col++)
+        {
+            if (columns[col] & bit)
+            {
+                for (int s=0; s<textSize; s++)
+                    pixels[x + col*textSize + s] = foreground;
+            }
+        }
+
+        x += 6*textSize;
+    }
+}
+
+// MARK: Visibility and geometry
+
+void ListView::show()
+{
+    repaintAll = true;
+    ResponderView::show();
+}
+
+void ListView::hide()
+{
+    kinetic.stop();
+    gestures.cancel();
+    cancelAsync(this);
+    ResponderView::hide();
+    stopHardwareScrolling();
+}
+
+void ListView::setPosition(geo::Point pos)
+{
+    stopHardwareScrolling();
+    ResponderView::setPosition(pos);
+    scheduleRepaint();
+}
+
+void ListView::setSize(geo::Size siz)
+{
+    stopHardwareScrolling();
+    ResponderView::setSize(siz);
+    reloadData();
+}
+
+void ListView::setRect(geo::Rect rect)
+{
+    stopHardwareScrolling();
+    ResponderView::setRect(rect);
+    reloadData();
+}
@@ -0,0 +1,274 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef list_view_h
+#define list_view_h
+
+#include "responder_view.h"
+#include "animation.h"
+#include "gesture_recognizer.h"
+#include <mn_string.h>
+#include <FunctionPointer.h>
+
+namespace mono { namespace ui {
+
+    /**
+     * @brief Provides the rows of a @ref ListView
+     *
+     * The list asks for the text of a row only when the row is painted, so
+     * the rows need not exist in memory. You can generate them from an
+     * array, a file or a calculation.
+     */
+    class IListViewDataSource
+    {
+    public:
+
+        /** @brief The number of rows in the list */
+        virtual int NumberOfRows() = 0;
+
+        /** @brief The text of a row, from `0` to @ref NumberOfRows - 1 */
+        virtual String TextForRow(int row) = 0;
+    };
+
+    /**
+     * @brief A scrolling list of text rows, for long lists
+     *
+     * The list gets its rows from a @ref IListViewDataSource, and paints only
+     * the visible lines of the visible rows. It does not create a view per
+     * row, and its memory use is the same for 10 or 10000 rows.
+     *
+     * @code
+     * ListView list(geo::Rect(0, 20, 176, 200));
+     * list.setDataSource(&myDataSource);
+     * list.setSelectionCallback(this, &AppController::rowSelected);
+     * list.show();
+     * @endcode
+     *
+     * Drag the list to scroll it. When you release a moving list, it keeps
+     * scrolling and slows down, like a wheel. Touch the list to stop it, and
+     * tap a row to select it.
+     *
+     * When the list spans the full screen width, and the display controller
+     * supports vertical scrolling, each content line is stored at a fixed row
+     * in the display memory, and scrolling just moves the controller's scroll
+     * offset. Then a scroll step only paints the lines that came into view.
+     * While scrolling in hardware, no other views may paint in the rows of
+     * the list. Otherwise, each scroll step paints the whole list.
+     *
+     * Rows are painted line by line, into a line buffer. Subclasses can
+     * override @ref renderLine to paint rows differently.
+     */
+    class ListView : public ResponderView
+    {
+    public:
+
+        /** The widest line the list can paint */
+        static const int MaxLineWidth = 220;
+
+        /** The left margin of the row text */
+        static const int TextInset = 4;
+
+        /** The release speed (pixels per second), that starts kinetic scrolling */
+        static const int KineticStartVelocity = 100;
+
+        /** Kinetic scrolling stops below this speed */
+        static const int KineticStopVelocity = 10;
+
+        /** Kinetic scrolling loses 63% of its speed in this time */
+        static const uint32_t KineticTimeConstantUs = 325000;
+
+    protected:
+
+        /**
+         * @brief Scrolls the list after a drag, until friction stops it
+         *
+         * The @ref AnimationEngine steps the scroll on each display refresh,
+         * so the list scrolls with the display, and is painted with the
+         * other dirty views.
+         */
+        class KineticScroll : public Animation
+        {
+        protected:
+
+            /** Steps are limited to this, after a stall */
+            static const uint32_t MaxStepUs = 50000;
+
+            ListView *list;
+            int velocity;
+            int remainder;
+            uint32_t lastTime;
+
+            bool step(uint32_t now);
+
+        public:
+
+            KineticScroll(ListView *list);
+
+            /** @brief Start scrolling the content at a speed, in pixels per second */
+            void fling(int velocity);
+        };
+
+        friend class KineticScroll;
+
+        IListViewDataSource *dataSource;
+
+        int rowHeight, textSize;
+
+        /** The content line at the top of the view */
+        int contentOffset;
+
+        /** The content offset at the last repaint */
+        int paintedOffset;
+
+        /** Paint the whole list at the next repaint */
+        bool repaintAll;
+
+        /** `true` if the list is scrolled by the display controller */
+        bool hardwareScrolling;
+
+        int selectedRow;
+
+        /** Rows to repaint at the next repaint, -1 if unused */
+        int dirtyRows[2];
+
+        /** The touch stopped a kinetic scroll, it does not select a row */
+        bool touchStoppedScroll;
+
+        display::Color textColor, backgroundColor, selectionColor, separatorColor;
+
+        /** The line being painted, it is sent before the next is rendered */
+        uint16_t lineBuffer[MaxLineWidth];
+
+        /** The text of the row painted last */
+        int cachedRow;
+        String cachedText;
+
+        GestureRecognizer gestures;
+        KineticScroll kinetic;
+
+        mbed::FunctionPointerArg1<void, int> selectionHandler;
+        mbed::FunctionPointerArg1<void, int> longPressHandler;
+
+        void touchBegin(TouchEvent &event);
+        void touchMove(TouchEvent &event);
+        void touchEnd(TouchEvent &event);
+
+        void handleGesture(const GestureRecognizer::Gesture &gesture);
+        void checkLongPress();
+
+        /** @brief The number of rows, 0 without a data source */
+        int rowCount() const;
+
+        /** @brief The largest content offset */
+        int maxContentOffset() const;
+
+        /** @brief The row at a screen position, or -1 */
+        int rowAt(const geo::Point &position) const;
+
+        /** @brief The text of a row, cached while its lines are painted */
+        const String &rowText(int row);
+
+        /**
+         * @brief Scroll the content
+         * @return `false` if the list reached its top or bottom
+         */
+        bool scrollBy(int pixels);
+
+        void markRowDirty(int row);
+
+        /**
+         * The display controller scrolls rows in the full screen width, so
+         * the list must span the screen to scroll in hardware.
+         */
+        bool canScrollInHardware() const;
+
+        /**
+         * Show the display memory unscrolled again, and repaint everything
+         * the next time the list is painted.
+         */
+        void stopHardwareScrolling();
+
+        /**
+         * Paint a range of content lines. When scrolling in hardware, each
+         * line has a fixed row in display memory. Otherwise the line at the
+         * content offset is painted at the top of the view.
+         */
+        void paintContentLines(int first, int count);
+
+        /**
+         * @brief Render one line of a row into a line buffer
+         *
+         * The default renders the row text in the 5x7 font, on the background
+         * or selection color, with a separator on the last line of the row.
+         *
+         * @param row The row, may be past the last row
+         * @param line The line inside the row, from `0` to the row height - 1
+         * @param pixels The line buffer to render into
+         * @param width The number of pixels in the line
+         */
+        virtual void renderLine(int row, int line, uint16_t *pixels, int width);
+
+    public:
+
+        ListView(geo::Rect rect);
+
+        ~ListView();
+
+        /** @brief Set the data source and reload the rows */
+        void setDataSource(IListViewDataSource *source);
+
+        /** @brief Read the number of rows and their text again */
+        void reloadData();
+
+        /** @brief Set the method called when a row is tapped */
+        template <typename Owner>
+        void setSelectionCallback(Owner *obj, void (Owner::*memPtr)(int))
+        {
+            selectionHandler.attach<Owner>(obj, memPtr);
+        }
+
+        /** @brief Set the method called when a row is pressed and held */
+        template <typename Owner>
+        void setLongPressCallback(Owner *obj, void (Owner::*memPtr)(int))
+        {
+            longPressHandler.attach<Owner>(obj, memPtr);
+        }
+
+        /** @brief Highlight a row, -1 for none */
+        void setSelectedRow(int row);
+
+        /** @brief The highlighted row, or -1 */
+        int SelectedRow() const;
+
+        /** @brief Scroll the least amount, that makes a row visible */
+        void scrollToRow(int row);
+
+        /** @brief Scroll to a content line */
+        void scrollTo(int offset);
+
+        /** @brief The content line at the top of the view */
+        int ContentOffset() const;
+
+        /** @brief `true` while the list scrolls after a drag */
+        bool IsScrolling() const;
+
+        void setRowHeight(int height);
+        void setTextSize(int size);
+        void setTextColor(display::Color color);
+        void setBackgroundColor(display::Color color);
+        void setSelectionColor(display::Color color);
+        void setSeparatorColor(display::Color color);
+
+        void repaint();
+
+        void show();
+        void hide();
+
+        void setPosition(geo::Point pos);
+        void setSize(geo::Size siz);
+        void setRect(geo::Rect rect);
+    };
+
+} }
+
+#endif /* list_view_h */
@@ -2,10 +2,118 @@
 // and is available under the MIT license, see LICENSE.txt
 
 #include "responder_view.h"
-#include "consoles.h"
+#include "hit_test_grid.h"
+#include <mbed_debug.h>
 
 using namespace mono::ui;
 
+namespace mono { namespace ui {
+
+    /**
+     * The only responder chain member for all visible responder views. It
+     * hit tests the touch position in a grid of the view rects, and sends
+     * the touch to the top-most view under it. If that view does not
+     * handle the touch, it falls through to the views below, like in the
+     * responder chain. The view that handles the touch begin event captures
+     * the following move and end events.
+     */
+    class ResponderViewDispatcher : public mono::TouchResponder
+    {
+    protected:
+
+        HitTestGrid grid;
+        ResponderView *captured;
+
+    public:
+
+        static ResponderViewDispatcher &Default()
+        {
+            static ResponderViewDispatcher dispatcher;
+            return dispatcher;
+        }
+
+        ResponderViewDispatcher()
+        {
+            deactivate(); // joins the chain with the first view
+            captured = NULL;
+        }
+
+        void add(ResponderView *view)
+        {
+            if (!grid.insert(view, view->ViewRect()))
+            {
+                debug("ResponderView: hit test grid is full, using the responder chain\r\n");
+                view->activate();
+                return;
+            }
+
+            if (grid.Count() == 1)
+                activate();
+        }
+
+        void remove(ResponderView *view)
+        {
+            view->deactivate();
+            if (captured == view)
+                captured = NULL;
+
+            if (!grid.contains(view))
+                return;
+
+            grid.remove(view);
+            if (grid.Count() == 0)
+                deactivate();
+        }
+
+        void move(ResponderView *view)
+        {
+            grid.update(view, view->ViewRect());
+        }
+
+        void respondTouchBegin(TouchEvent &event)
+        {
+            if (!event.IsScreenCoords)
+                ResponderView::convertToScreenCoords(&event);
+
+            ResponderView *view = static_cast<ResponderView*>(grid.hitTest(event.Position));
+            while (view != NULL)
+            {
+                // capture before the call, such that a handler that hides or
+                // deletes the view releases the capture again
+                captured = view;
+                view->respondTouchBegin(event);
+                if (event.handled)
+                    return;
+
+                if (captured == view)
+                    captured = NULL;
+
+                // a removed view has no place in the stack to continue from
+                if (!grid.contains(view))
+                    return;
+
+                view = static_cast<ResponderView*>(grid.hitTest(event.Position, view));
+            }
+        }
+
+        void respondTouchMove(TouchEvent &event)
+        {
+            if (captured != NULL)
+                captured->respondTouchMove(event);
+        }
+
+        void respondTouchEnd(TouchEvent &event)
+        {
+            ResponderView *view = captured;
+            captured = NULL;
+
+            if (view != NULL)
+                view->respondTouchEnd(event);
+        }
+    };
+
+} }
+
 ResponderView::ResponderView()
 {
     deactivate(); // view starts hidden, do not handle touch
@@ -108,13 +216,26 @@ void ResponderView::respondTouchEnd(mono::TouchEvent &event)
     }
 }
 
+ResponderView::~ResponderView()
+{
+    ResponderViewDispatcher::Default().remove(this);
+}
+
 void ResponderView::toScreenCoords(mono::TouchEvent *event)
 {
-    int x = event->TouchController->toScreenCoordsX(event->Position.X(), DisplayWidth());
-    event->Position.setX(x);
+    convertToScreenCoords(event);
+}
+
+void ResponderView::convertToScreenCoords(mono::TouchEvent *event)
+{
+    // the touch panel is calibrated in portrait, then rotate to the display
+    bool landscape = DisplayOrientation() == LANDSCAPE_RIGHT || DisplayOrientation() == LANDSCAPE_LEFT;
+    uint16_t portraitWidth = landscape ? DisplayHeight() : DisplayWidth();
+    uint16_t portraitHeight = landscape ? DisplayWidth() : DisplayHeight();
     
-    int y = event->TouchController->toScreenCoordsY(event->Position.Y(), DisplayHeight());
-    event->Position.setY(y);
+    int x = event->TouchController->toScreenCoordsX(event->Position.X(), portraitWidth);
+    int y = event->TouchController->toScreenCoordsY(event->Position.Y(), portraitHeight);
+    event->Position = fromPortrait(geo::Point(x, y));
     
     event->IsScreenCoords = true;
 }
@@ -122,11 +243,29 @@ void ResponderView::toScreenCoords(mono::TouchEvent *event)
 void ResponderView::show()
 {
     View::show();
-    activate();
+    ResponderViewDispatcher::Default().add(this);
 }
 
 void ResponderView::hide()
 {
-    deactivate();
+    ResponderViewDispatcher::Default().remove(this);
     View::hide();
 }
+
+void ResponderView::setPosition(geo::Point pos)
+{
+    View::setPosition(pos);
+    ResponderViewDispatcher::Default().move(this);
+}
+
+void ResponderView::setSize(geo::Size siz)
+{
+    View::setSize(siz);
+    ResponderViewDispatcher::Default().move(this);
+}
+
+void ResponderView::setRect(geo::Rect rect)
+{
+    View::setRect(rect);
+    ResponderViewDispatcher::Default().move(this);
+}
@@ -8,9 +8,25 @@
 #include "view.h"
 
 namespace mono { namespace ui {
-    
+
+    class ResponderViewDispatcher;
+
+    /**
+     * @brief A view that responds to touch input
+     *
+     * Visible responder views are not in the linear responder chain. They
+     * are kept in a @ref HitTestGrid, and a single dispatcher in the chain
+     * finds the top-most view under a touch. That view then receives the
+     * rest of the touch (move and end events) directly, so touch latency
+     * does not grow with the number of views on the screen.
+     *
+     * The view last shown is on top. If you change a view's rect through
+     * the @ref Position or @ref Size references, call @ref setRect to move
+     * its touch area too.
+     */
     class ResponderView : public View, public mono::TouchResponder
     {
+        friend class ResponderViewDispatcher;
         
     protected:
         
@@ -40,13 +56,19 @@ namespace mono { namespace ui {
         
         virtual void toScreenCoords(TouchEvent *event);
         virtual void ToScreenCoords(TouchEvent *event) __DEPRECATED("Capitalized method calls syntax is being obsoleted","toScreenCoords") { toScreenCoords(event); }
+
+        /** @brief Convert a touch panel position to display coordinates */
+        static void convertToScreenCoords(TouchEvent *event);
         
     public:
+
+        /** @brief Removes the view from touch input */
+        virtual ~ResponderView();
         
         /**
          * 
          *
-         * @brief Shows (repaints) the view and insert into the responder chain
+         * @brief Shows (repaints) the view and starts responding to touch
          * @see View::show
          */
         virtual void show();
@@ -54,10 +76,19 @@ namespace mono { namespace ui {
         /**
          * 
          *
-         * @brief hides the view, and remove from the responder chain
+         * @brief hides the view, and stops responding to touch
          * @see View::hide
          */
         virtual void hide();
+
+        /** @brief Moves the view and its touch area */
+        virtual void setPosition(geo::Point pos);
+
+        /** @brief Resizes the view and its touch area */
+        virtual void setSize(geo::Size siz);
+
+        /** @brief Sets the view rect and touch area */
+        virtual void setRect(geo::Rect rect);
     };
     
 } }
@@ -7,6 +7,7 @@
 #include <Fonts/FreeSans9pt7b.h>
 #include <text_render.h>
 #include <mbed_debug.h>
+#include "layout.h"
 
 using namespace mono::ui;
 
@@ -21,14 +22,16 @@ TextLabelView::TextLabelView(String txt) :
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     currentFont = TextLabelView::StandardTextFont;
+    currentAAFont = 0;
 
     this->text = txt;
     this->textMultiline = isTextMultiline();
     this->setTextSize(2);
 #pragma GCC diagnostic pop
-    viewRect.setSize( geo::Size(TextPixelWidth(), TextPixelHeight()) );
-    prevTextRct = viewRect;
     currentGfxFont = StandardGfxFont;
+    textSizeValid = textDimensionValid = false;
+    viewRect.setSize(measuredTextSize());
+    prevTextRct = viewRect;
 
     alignment = ALIGN_LEFT;
     vAlignment = ALIGN_MIDDLE;
@@ -46,13 +49,15 @@ TextLabelView::TextLabelView(const char *txt) :
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     currentFont = StandardTextFont;
+    currentAAFont = 0;
     this->text = txt;
     this->textMultiline = isTextMultiline();
     this->setTextSize(2);
 #pragma GCC diagnostic pop
-    viewRect.setSize( geo::Size(TextPixelWidth(), TextPixelHeight()) );
-    prevTextRct = viewRect;
     currentGfxFont = StandardGfxFont;
+    textSizeValid = textDimensionValid = false;
+    viewRect.setSize(measuredTextSize());
+    prevTextRct = viewRect;
 
     alignment = ALIGN_LEFT;
     vAlignment = ALIGN_MIDDLE;
@@ -71,12 +76,14 @@ TextLabelView::TextLabelView(geo::Rect rct, String txt) :
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     currentFont = StandardTextFont;
+    currentAAFont = 0;
     this->text = txt;
     this->textMultiline = isTextMultiline();
     textSize = 2;
 #pragma GCC diagnostic pop
     prevTextRct = viewRect;
     currentGfxFont = StandardGfxFont;
+    textSizeValid = textDimensionValid = false;
 
     alignment = ALIGN_LEFT;
     vAlignment = ALIGN_MIDDLE;
@@ -95,12 +102,14 @@ TextLabelView::TextLabelView(geo::Rect rct, const char *txt) :
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     currentFont = StandardTextFont;
+    currentAAFont = 0;
     this->text = txt;
     this->textMultiline = isTextMultiline();
     textSize = 2;
 #pragma GCC diagnostic pop
     prevTextRct = viewRect;
     currentGfxFont = StandardGfxFont;
+    textSizeValid = textDimensionValid = false;
 
     alignment = ALIGN_LEFT;
     vAlignment = ALIGN_MIDDLE;
@@ -134,40 +143,50 @@ TextLabelView::VerticalTextAlignment TextLabelView::VerticalAlignment() const
 
 uint16_t TextLabelView::TextPixelWidth() const
 {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-    if (textSize == 1)
-        return text.Length()*5*TextSize()+TextSize()+1;
-    else
-    {
-        display::TextRender tr(painter);
-        if (currentFont)
-            return tr.renderDimension(text, *currentFont).Width();
-        else if (currentGfxFont)
-            return tr.renderDimension(text, *currentGfxFont, textMultiline).Width();
-        else
-            return 0;
-    }
-#pragma GCC diagnostic pop
+    return measuredTextSize().Width();
 }
 
 uint16_t TextLabelView::TextPixelHeight() const
 {
+    return measuredTextSize().Height();
+}
+
+mono::geo::Size TextLabelView::PreferredSize() const
+{
+    return measuredTextSize();
+}
+
+const mono::geo::Size &TextLabelView::measuredTextSize() const
+{
+    if (textSizeValid)
+        return textSizeCache;
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     if (textSize == 1)
-        return 7*TextSize()+1;
+        textSizeCache = geo::Size(text.Length()*5*TextSize()+TextSize()+1, 7*TextSize()+1);
     else
     {
         display::TextRender tr(painter);
-        if (currentFont)
-            return tr.renderDimension(text, *currentFont).Height();
+        if (currentAAFont)
+            textSizeCache = tr.renderDimension(text, *currentAAFont);
+        else if (currentFont)
+            textSizeCache = tr.renderDimension(text, *currentFont);
         else if (currentGfxFont)
-            return tr.renderDimension(text, *currentGfxFont, textMultiline).Height();
+            textSizeCache = tr.renderDimension(text, *currentGfxFont, textMultiline);
         else
-            return 0;
+            textSizeCache = geo::Size();
     }
 #pragma GCC diagnostic pop
+
+    textSizeValid = true;
+    return textSizeCache;
+}
+
+void TextLabelView::invalidateTextMeasurement()
+{
+    textSizeValid = false;
+    textDimensionValid = false;
 }
 
 const MonoFont* TextLabelView::Font() const
@@ -180,14 +199,37 @@ const GFXfont* TextLabelView::GfxFont() const
     return currentGfxFont;
 }
 
+const AAFont* TextLabelView::AntiAliasedFont() const
+{
+    return currentAAFont;
+}
+
 mono::geo::Rect TextLabelView::TextDimension() const
+{
+    // the text is layed out inside the view rect
+    if (textDimensionValid &&
+        textDimensionRect.X() == viewRect.X() && textDimensionRect.Y() == viewRect.Y() &&
+        textDimensionRect.Width() == viewRect.Width() && textDimensionRect.Height() == viewRect.Height())
+    {
+        return textDimensionCache;
+    }
+
+    textDimensionCache = layoutTextDimension();
+    textDimensionRect = viewRect;
+    textDimensionValid = true;
+    return textDimensionCache;
+}
+
+mono::geo::Rect TextLabelView::layoutTextDimension() const
 {
     display::TextRender tr(painter);
     tr.setAlignment((display::TextRender::HorizontalAlignment) alignment);
     tr.setAlignment((display::TextRender::VerticalAlignmentType) vAlignment);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-    if (currentFont)
+    if (currentAAFont)
+        return tr.renderInRect(viewRect, text, *currentAAFont);
+    else if (currentFont)
         return geo::Rect(geo::Point(0,0), tr.renderDimension(text, *currentFont));
     else if (currentGfxFont)
         return tr.renderInRect(viewRect, text, *currentGfxFont, textMultiline);
@@ -201,6 +243,7 @@ void TextLabelView::setTextSize(uint8_t newSize)
 {
     debug("TextLabelView::setSize is deprecated!\r\n");
     textSize = newSize;
+    invalidateTextMeasurement();
 }
 
 void TextLabelView::setTextColor(display::Color col)
@@ -230,12 +273,14 @@ void TextLabelView::setBackground(display::Color col)
 void TextLabelView::setAlignment(TextAlignment align)
 {
     alignment = align;
+    textDimensionValid = false;
     incrementalRepaint = false;
 }
 
 void TextLabelView::setAlignment(VerticalTextAlignment vAlign)
 {
     vAlignment = vAlign;
+    textDimensionValid = false;
     incrementalRepaint = false;
 }
 
@@ -246,14 +291,31 @@ void TextLabelView::setText(const char *text)
 
 void TextLabelView::setText(mono::String text)
 {
+    bool changed = text != this->text;
+    if (changed)
+        invalidateTextMeasurement();
+
     this->text = text;
     this->textMultiline = isTextMultiline();
 
-    if (isDirty)
-        return;
+    if (!isDirty)
+    {
+        scheduleRepaint();
+        incrementalRepaint = true;
+    }
 
-    scheduleRepaint();
-    incrementalRepaint = true;
+    if (changed && parentLayout != 0)
+    {
+        // the layout may move or resize the label, to fit the new text
+        geo::Rect oldRect = viewRect;
+        parentLayout->childChanged(*this);
+
+        if (viewRect.X() != oldRect.X() || viewRect.Y() != oldRect.Y() ||
+            viewRect.Width() != oldRect.Width() || viewRect.Height() != oldRect.Height())
+        {
+            incrementalRepaint = false;
+        }
+    }
 }
 
 void TextLabelView::setText(const char *txt, bool)
@@ -271,7 +333,9 @@ void TextLabelView::setFont(const MonoFont &newFont)
     debug("TextLabelView::setFont(): MonoFont's are deprecated, use GfxFonts!\r\n");
     currentFont = &newFont;
     currentGfxFont = 0;
+    currentAAFont = 0;
     incrementalRepaint = false;
+    invalidateTextMeasurement();
 
     scheduleRepaint();
 }
@@ -280,7 +344,20 @@ void TextLabelView::setFont(GFXfont const &font)
 {
     currentGfxFont = &font;
     currentFont = 0;
+    currentAAFont = 0;
     incrementalRepaint = false;
+    invalidateTextMeasurement();
+
+    scheduleRepaint();
+}
+
+void TextLabelView::setFont(AAFont const &font)
+{
+    currentAAFont = &font;
+    currentGfxFont = 0;
+    currentFont = 0;
+    incrementalRepaint = false;
+    invalidateTextMeasurement();
 
     scheduleRepaint();
 }
@@ -313,7 +390,11 @@ void TextLabelView::repaint()
     painter.setBackgroundColor(bgColor);
     painter.setForegroundColor(TextColor());
 
-    if (canUseIncrementalRepaint())
+    if (currentAAFont && textSize != 1)
+    {
+        repaintAA(txtRct);
+    }
+    else if (canUseIncrementalRepaint())
     {
         if (currentGfxFont)
             repaintGfxIncremental(txtRct);
@@ -356,10 +437,18 @@ void TextLabelView::repaintGfx(geo::Rect &)
     tr.setAlignment((display::TextRender::HorizontalAlignment)alignment);
     tr.setAlignment((display::TextRender::VerticalAlignmentType) vAlignment);
 
-    if (prevText != text)
-        painter.drawFillRect(prevTextRct, true);
+    // paints the text background as well, no need to clear the old text
+    tr.drawOpaqueInRect(viewRect, text, *currentGfxFont, textMultiline);
+    prevTextRct = TextDimension();
+}
+
+void TextLabelView::repaintAA(geo::Rect &)
+{
+    display::TextRender tr(painter);
+    tr.setAlignment((display::TextRender::HorizontalAlignment)alignment);
+    tr.setAlignment((display::TextRender::VerticalAlignmentType) vAlignment);
 
-    tr.drawInRect(viewRect, text, *currentGfxFont, textMultiline);
+    tr.drawInRect(viewRect, text, *currentAAFont);
     prevTextRct = TextDimension();
 }
 
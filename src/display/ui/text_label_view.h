@@ -9,6 +9,7 @@
 #include "mn_string.h"
 #include <font_interface.h>
 #include <gfxfont.h>
+#include <aafont.h>
 #include <text_render.h>
 
 namespace mono { namespace ui {
@@ -136,6 +137,7 @@ namespace mono { namespace ui {
 
         const MonoFont *currentFont;
         const GFXfont *currentGfxFont;
+        const AAFont *currentAAFont;
         
         uint8_t textSize;
         display::Color textColor;
@@ -144,6 +146,25 @@ namespace mono { namespace ui {
         VerticalTextAlignment vAlignment;
         bool textMultiline;
 
+        /**
+         * Measuring walks the whole text, so the results are cached until the
+         * text, font or view rect changes.
+         */
+        mutable geo::Size textSizeCache;
+        mutable geo::Rect textDimensionCache;
+        mutable geo::Rect textDimensionRect;
+        mutable bool textSizeValid;
+        mutable bool textDimensionValid;
+
+        /** @brief Discard the cached text measurements */
+        void invalidateTextMeasurement();
+
+        /** @brief Measure the text, if it is not cached */
+        const geo::Size &measuredTextSize() const;
+
+        /** @brief Lay out the text in the view rect, without the cache */
+        geo::Rect layoutTextDimension() const;
+
         /**
          * @brief Check if the current text has newline characters
          * 
@@ -153,6 +174,7 @@ namespace mono { namespace ui {
         bool isTextMultiline() const;
 
         void repaintGfx(geo::Rect &txtRct);
+        void repaintAA(geo::Rect &txtRct);
         void repaintLegacy(geo::Rect &txtRct);
         void repaintGfxIncremental(geo::Rect &txtRct);
         void repaintLegacyIncremental(geo::Rect &txtRct);
@@ -260,9 +282,15 @@ namespace mono { namespace ui {
         /** @brief If not NULL, then returns the current selected @ref GFXfont */
         const GFXfont* GfxFont() const;
 
+        /** @brief If not NULL, then returns the current selected @ref AAFont */
+        const AAFont* AntiAliasedFont() const;
+
         /** @brief Returns the dimensions ( @ref Size and offset @ref Point ) of the text. */
         geo::Rect TextDimension() const;
 
+        /** @brief The size of the text, used by layouts */
+        geo::Size PreferredSize() const;
+
         // MARK: Setters
 
         /**
@@ -314,6 +342,9 @@ namespace mono { namespace ui {
          * This method updates the text that is rendered by the textlabel. It
          * automatically schedules an incremental (fast) repaint.
          *
+         * If the label is in a @ref Layout, the layout is told that the text
+         * changed, and lays out the label again.
+         *
          * @param text The Mono string text to render
          */
         void setText(String text);
@@ -350,6 +381,17 @@ namespace mono { namespace ui {
          * to this method.
          */
         void setFont(GFXfont const &font);
+
+        /**
+         * @brief Set an anti-aliased font face on the label
+         *
+         * Anti-aliased fonts are created with the `resources/font2aafont.py`
+         * tool. The label is always repainted fully, including its
+         * background, when it uses an anti-aliased font.
+         *
+         * @param font The anti-aliased font to use
+         */
+        void setFont(AAFont const &font);
         
         // MARK: Getters
         
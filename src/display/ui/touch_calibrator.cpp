@@ -58,7 +58,9 @@ TouchCalibrateView::TouchCalibrateView(geo::Rect rct) : ResponderView(rct), text
 
 void TouchCalibrateView::show()
 {
-    ResponderView::show();
+    // calibration needs the raw touch positions, so it stays first in the
+    // responder chain instead of the hit test grid
+    View::show();
     makeFirstResponder();
 }
 
@@ -2,17 +2,19 @@
 // and is available under the MIT license, see LICENSE.txt
 
 #include "view.h"
+#include "animation.h"
 #include <application_context_interface.h>
-#include "consoles.h"
 
 #include <us_ticker_api.h>
 #include <mbed_debug.h>
+#include <tracer.h>
 
 using namespace mono::ui;
 
 mono::display::DisplayPainter View::painter(mono::IApplicationContext::Instance->DisplayController);
 
 mono::GenericQueue<View> View::dirtyQueue;
+View *View::firstVisible = 0;
 
 mono::display::Color View::StandardTextColor = display::CloudsColor;
 mono::display::Color View::StandardBackgroundColor = display::BlackColor;
@@ -23,40 +25,71 @@ uint32_t View::RepaintScheduledViewsTime = 0;
 
 void View::repaintScheduledViews()
 {
+    AnimationEngine &animations = AnimationEngine::Default();
 
     //early exit if queue is empty
-    if (View::dirtyQueue.peek() == NULL)
+    if (View::dirtyQueue.peek() == NULL && !animations.IsActive())
         return;
 
+    MONO_TRACE_SCOPE("repaint views");
+    FrameScheduler &scheduler = FrameScheduler::Default();
     uint32_t start = us_ticker_read();
-    View *view = View::dirtyQueue.dequeue();
-    while (view != NULL) {
+    scheduler.beginFrame(start, painter.DisplayController()->LastTearningEffectTime);
 
+    // animations paint all of their frame first, outside the budget, as an
+    // erased area must be repainted in the same frame
+    if (animations.IsActive())
+        animations.tick(start);
+
+    // views left when the budget is spent, are painted on the next refresh
+    while (View::dirtyQueue.peek() != NULL && scheduler.hasTimeLeft(us_ticker_read())) {
+
+        View *view = dequeueScheduledView();
         if (view->isDirty)
         {
+            MONO_TRACE_BEGIN("View::repaint");
             view->repaint();
+            MONO_TRACE_END("View::repaint");
             view->isDirty = false;
+            scheduler.viewPainted();
 #ifdef VIEW_BOUNDARY_DEBUG
             painter.setForegroundColor(mono::display::RedColor);
             painter.drawRect(view->ViewRect());
 #endif
         }
-
-
-        view = View::dirtyQueue.dequeue();
     }
     uint32_t end = us_ticker_read();
 
     RepaintScheduledViewsTime = end - start;
+    scheduler.endFrame(end, View::dirtyQueue.Length());
+    MONO_TRACE_COUNTER("deferred views", View::dirtyQueue.Length());
 
     //debug("repaint time: %u, TE Offset: %i\r\n",RepaintScheduledViewsTime,start-painter.DisplayController()->LastTearningEffectTime);
 }
 
+View *View::dequeueScheduledView()
+{
+    if (FrameScheduler::Default().PaintOrder() != FrameScheduler::SCANLINE_ORDER)
+        return View::dirtyQueue.dequeue();
+
+    // the topmost view, the first scheduled if more start at the same line
+    View *topmost = View::dirtyQueue.peek();
+    for (View *view = topmost; view != NULL; view = View::dirtyQueue.next(view))
+    {
+        if (view->viewRect.Y() < topmost->viewRect.Y())
+            topmost = view;
+    }
+
+    View::dirtyQueue.remove(topmost);
+    return topmost;
+}
+
 
 View::View()
 {
     isDirty = false;
     visible = false;
+    nextVisible = 0;
     painter.setRefreshCallback<View>(this, &View::callRepaintScheduledViews);
 }
 
@@ -64,6 +97,7 @@ View::View(geo::Rect rect) : viewRect(rect)
 {
     visible = false;
     isDirty = false;
+    nextVisible = 0;
     painter.setRefreshCallback<View>(this, &View::callRepaintScheduledViews);
 }
 
@@ -71,6 +105,7 @@ View::~View()
 {
     //remove me from the dirty queue, if I am present there
     dirtyQueue.remove(this);
+    updateVisibleList(false);
 }
 
 void View::callRepaintScheduledViews()
@@ -124,17 +159,48 @@ bool View::Visible() const
 
 void View::show()
 {
+    updateVisibleList(true);
     visible = true;
     scheduleRepaint();
 }
 
 void View::hide()
 {
+    updateVisibleList(false);
     visible = false;
     isDirty = false;
     dirtyQueue.remove(this);
 }
 
+void View::updateVisibleList(bool show)
+{
+    View **link = &firstVisible;
+    while (*link != 0 && *link != this)
+        link = &(*link)->nextVisible;
+
+    // shown views are added last, they are on top
+    if (show && *link == 0)
+    {
+        *link = this;
+        nextVisible = 0;
+    }
+    else if (!show && *link == this)
+    {
+        *link = nextVisible;
+        nextVisible = 0;
+    }
+}
+
+void View::scheduleRepaintInRect(const geo::Rect &rect, const View *except)
+{
+    for (View *view = firstVisible; view != 0; view = view->nextVisible)
+    {
+        geo::Rect overlap = view->viewRect.crop(rect);
+        if (view != except && overlap.Width() > 0 && overlap.Height() > 0)
+            view->scheduleRepaint();
+    }
+}
+
 //// Static methods
 
 uint16_t View::DisplayWidth()
@@ -154,6 +220,28 @@ mono::geo::Size View::DisplaySize()
 
 View::Orientation View::DisplayOrientation()
 {
-    //TODO: Implement display orientation!
-    return PORTRAIT;
+    return (Orientation) View::painter.DisplayController()->DisplayOrientation();
+}
+
+bool View::setDisplayOrientation(Orientation orientation)
+{
+    typedef mono::display::IDisplayController Controller;
+    return View::painter.DisplayController()->setOrientation((Controller::Orientation) orientation);
+}
+
+mono::geo::Point View::fromPortrait(const geo::Point &point)
+{
+    // the portrait size is the rotated size with the axes swapped back
+    switch (DisplayOrientation())
+    {
+        case PORTRAIT_BOTTOMUP:
+            return geo::Point(DisplayWidth() - 1 - point.X(), DisplayHeight() - 1 - point.Y());
+        case LANDSCAPE_RIGHT:
+            return geo::Point(point.Y(), DisplayHeight() - 1 - point.X());
+        case LANDSCAPE_LEFT:
+            return geo::Point(DisplayWidth() - 1 - point.Y(), point.X());
+        case PORTRAIT:
+        default:
+            return point;
+    }
 }
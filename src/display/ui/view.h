@@ -9,12 +9,15 @@
 #include "touch_system_interface.h"
 #include "queue.h"
 #include <view_alike.h>
+#include "frame_scheduler.h"
+
 
 namespace mono {
     class IApplicationContext;
     namespace ui {
 
     class Animator;
+    class AnimationEngine;
 
     /**
      * @brief Abstract interface for all UI Views, parent class for all views
@@ -40,6 +43,7 @@ namespace mono {
     {
         friend class mono::IApplicationContext;
         friend class Animator;
+        friend class AnimationEngine;
     public:
 
         /**
@@ -102,6 +106,20 @@ namespace mono {
          */
         bool visible;
 
+        /** @brief The next view in the list of visible views */
+        View *nextVisible;
+
+        /**
+         * @brief The first of the visible views, in the order they were shown
+         *
+         * Views shown later are painted later, so the list is in stacking
+         * order, from the bottom.
+         */
+        static View *firstVisible;
+
+        /** @brief Add or remove the view from the visible list, by @ref visible */
+        void updateVisibleList(bool visible);
+
         /**
          * @brief The global re-paint queue.
          *
@@ -112,13 +130,23 @@ namespace mono {
 
         /**
          * This class method will run through the scheduled re-paints queue and
-         * call the @ref repaint method on all of them.
+         * call the @ref repaint method on them, until the frame time budget of
+         * the @ref FrameScheduler is spent. The views left in the queue are
+         * repainted after the next display refresh.
          *
          * This method is called automatically be the display system, you do not
          * need to call it yourself.
          */
         static void repaintScheduledViews();
 
+        /**
+         * @brief Remove the next view to repaint from the @ref dirtyQueue
+         *
+         * The view is chosen by the @ref FrameScheduler::PaintOrder of the
+         * default frame scheduler.
+         */
+        static View *dequeueScheduledView();
+
         /**
          * @brief A member method to call the static method @ref repaintScheduledViews
          *
@@ -151,6 +179,8 @@ namespace mono {
          * @brief The CPU time used to repaint the latest set of dirty views.
          * This measure includes both the painting algorithms and the transfer
          * time used to comminicate with the disdplay hardware.
+         *
+         * See @ref FrameScheduler::Default for more frame statistics.
          */
         static uint32_t RepaintScheduledViewsTime;
 
@@ -275,6 +305,17 @@ namespace mono {
          */
         virtual void hide();
 
+        /**
+         * Use this when something that was painted over an area is gone, for
+         * example a view that moved. The views under the area are repainted,
+         * in the order they were shown.
+         *
+         * @brief Schedule a repaint of the visible views that overlap a rect
+         * @param rect The area in screen coordinates
+         * @param except Optional: A view to leave out, like the moved view
+         */
+        static void scheduleRepaintInRect(const geo::Rect &rect, const View *except = 0);
+
         /**
          * Returns the horizontal (X-axis) width of the display canvas, in pixels.
          * The width is always defined as perpendicular to gravity
@@ -295,6 +336,28 @@ namespace mono {
          */
         static Orientation DisplayOrientation();
 
+        /**
+         * Rotates the coordinate system of the display, in hardware if the
+         * @ref IDisplayController supports it. @ref DisplayWidth and
+         * @ref DisplayHeight change with the orientation, and touch positions
+         * are mapped to the rotated coordinates.
+         *
+         * Views are not moved or repainted, you must lay them out and repaint
+         * them for the new screen size.
+         *
+         * @param orientation The new orientation
+         * @return `false` if the display controller does not support it
+         */
+        static bool setDisplayOrientation(Orientation orientation);
+
+        /**
+         * @brief Map a point from portrait coordinates to the current orientation
+         *
+         * Use it for input, like touch, that is measured in the native
+         * portrait orientation of the display.
+         */
+        static geo::Point fromPortrait(const geo::Point &point);
+
     };
 
 
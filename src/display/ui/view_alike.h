@@ -8,6 +8,8 @@
 
 namespace mono { namespace ui {
     
+    class Layout;
+    
     /**
      * @brief A viewable interface, something that can act a like a view
      *
@@ -21,8 +23,16 @@ namespace mono { namespace ui {
      * displayed.
      */
     class IViewALike {
+        friend class Layout;
+    protected:
+        
+        /** The layout that positions this *ViewALike*, or `NULL` */
+        Layout *parentLayout;
+        
     public:
         
+        IViewALike() : parentLayout(0) {}
+        
         // MARK: Visibility states
         
         /** @brief Get the current shown / hidden state */
@@ -87,6 +97,19 @@ namespace mono { namespace ui {
          * This method returns a reference to the views current view rect.
          */
         virtual const geo::Rect &ViewRect() const = 0;
+
+        /**
+         * @brief Get the size the *ViewALike* would like to have
+         *
+         * Layouts use this to size their children. The default is the size
+         * of the current view rect, content views like text labels return
+         * the size of their content.
+         */
+        virtual geo::Size PreferredSize() const
+        {
+            const geo::Rect &rect = ViewRect();
+            return geo::Size(rect.Width(), rect.Height());
+        }
     };
     
 } }
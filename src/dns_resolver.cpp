@@ -3,6 +3,7 @@
 #include <mbed.h>
 
 #include "dns_resolver.h"
+#include "string_builder.h"
 
 using namespace mono::network;
 
@@ -39,26 +40,16 @@ mono::String DnsResolver::IpAddress() const
         return String();
 
     if (ipver == IP_v4)
-        return String::Format("%i.%i.%i.%i",ipAddress[0],ipAddress[1],ipAddress[2],ipAddress[3]);
+    {
+        StackStringBuilder<16> str;
+        str.appendIpv4(ipAddress);
+        return str.toString();
+    }
     else if (ipver == IP_v6)
     {
-        return String::Format("%x%x:%x%x:%x%x:%x%x:%x%x:%x%x:%x%x:%x%x:",
-                              ipAddress[0],
-                              ipAddress[1],
-                              ipAddress[2],
-                              ipAddress[3],
-                              ipAddress[4],
-                              ipAddress[5],
-                              ipAddress[6],
-                              ipAddress[7],
-                              ipAddress[8],
-                              ipAddress[9],
-                              ipAddress[10],
-                              ipAddress[11],
-                              ipAddress[12],
-                              ipAddress[13],
-                              ipAddress[14],
-                              ipAddress[15]);
+        StackStringBuilder<40> str;
+        str.appendIpv6(ipAddress);
+        return str.toString();
     }
     else
         return String();
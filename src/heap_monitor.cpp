@@ -0,0 +1,282 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "heap_monitor.h"
+#include <stdlib.h>
+
+using namespace mono;
+
+bool HeapMonitor::active = false;
+uint32_t HeapMonitor::allocations = 0;
+uint32_t HeapMonitor::frees = 0;
+uint32_t HeapMonitor::failures = 0;
+uint32_t HeapMonitor::bytesInUse = 0;
+uint32_t HeapMonitor::peakBytesInUse = 0;
+uint32_t HeapMonitor::blocksInUse = 0;
+uint32_t HeapMonitor::iterationAllocations = 0;
+uint32_t HeapMonitor::lastIterationAllocations = 0;
+uint32_t HeapMonitor::maxIterationAllocations = 0;
+uint32_t HeapMonitor::iterations = 0;
+HeapMonitor::CallSite HeapMonitor::sites[HeapMonitor::MaxCallSites];
+uint32_t HeapMonitor::siteCount = 0;
+
+void *(*HeapMonitor::rawMalloc)(size_t) = 0;
+void (*HeapMonitor::rawFree)(void *) = 0;
+
+const uint32_t HeapMonitor::MaxCallSites;
+const uint16_t HeapMonitor::OtherSites;
+
+// MARK: Recording
+
+void HeapMonitor::activate(void *(*mallocFunc)(size_t), void (*freeFunc)(void *))
+{
+    rawMalloc = mallocFunc;
+    rawFree = freeFunc;
+    active = true;
+}
+
+uint16_t HeapMonitor::recordAllocation(const void *site, uint32_t size)
+{
+    allocations++;
+    iterationAllocations++;
+    blocksInUse++;
+    bytesInUse += size;
+    if (bytesInUse > peakBytesInUse)
+        peakBytesInUse = bytesInUse;
+
+    uint32_t index = 0;
+    while (index < siteCount && sites[index].address != site)
+        index++;
+
+    if (index == siteCount)
+    {
+        if (siteCount == MaxCallSites)
+            return OtherSites;
+
+        sites[index].address = site;
+        sites[index].allocations = 0;
+        sites[index].bytesInUse = 0;
+        sites[index].peakBytesInUse = 0;
+        siteCount++;
+    }
+
+    CallSite &callSite = sites[index];
+    callSite.allocations++;
+    callSite.bytesInUse += size;
+    if (callSite.bytesInUse > callSite.peakBytesInUse)
+        callSite.peakBytesInUse = callSite.bytesInUse;
+
+    return index;
+}
+
+void HeapMonitor::recordFailure()
+{
+    failures++;
+}
+
+void HeapMonitor::recordFree(uint16_t siteIndex, uint32_t size)
+{
+    frees++;
+    blocksInUse--;
+    bytesInUse -= size;
+
+    if (siteIndex < siteCount)
+        sites[siteIndex].bytesInUse -= size;
+}
+
+void HeapMonitor::newIteration()
+{
+    lastIterationAllocations = iterationAllocations;
+    if (iterationAllocations > maxIterationAllocations)
+        maxIterationAllocations = iterationAllocations;
+
+    iterationAllocations = 0;
+    iterations++;
+}
+
+void HeapMonitor::resetPeaks()
+{
+    peakBytesInUse = bytesInUse;
+    maxIterationAllocations = 0;
+    for (uint32_t i=0; i<siteCount; i++)
+        sites[i].peakBytesInUse = sites[i].bytesInUse;
+}
+
+// MARK: Fragmentation probing
+
+void *HeapMonitor::probeAllocate(size_t size)
+{
+    // the probes must not show up in the statistics
+    return rawMalloc != 0 ? rawMalloc(size) : malloc(size);
+}
+
+void HeapMonitor::probeFree(void *ptr)
+{
+    if (rawFree != 0)
+        rawFree(ptr);
+    else
+        free(ptr);
+}
+
+uint32_t HeapMonitor::LargestFreeBlock(uint32_t limit)
+{
+    uint32_t low = 0, high = limit;
+    while (low < high)
+    {
+        uint32_t size = low + (high - low + 1) / 2;
+        void *block = probeAllocate(size);
+        if (block != 0)
+        {
+            probeFree(block);
+            low = size;
+        }
+        else
+            high = size - 1;
+    }
+
+    return low;
+}
+
+uint32_t HeapMonitor::FreeBytes(uint32_t limit)
+{
+    static const int MaxProbes = 8;
+    void *blocks[MaxProbes];
+    int count = 0;
+    uint32_t total = 0;
+
+    while (count < MaxProbes && total < limit)
+    {
+        uint32_t size = LargestFreeBlock(limit - total);
+        if (size == 0)
+            break;
+
+        blocks[count] = probeAllocate(size);
+        if (blocks[count] == 0)
+            break;
+
+        count++;
+        total += size;
+    }
+
+    for (int i=0; i<count; i++)
+        probeFree(blocks[i]);
+
+    return total;
+}
+
+// MARK: Reporting
+
+void HeapMonitor::report(FILE *out)
+{
+    if (!active)
+    {
+        fprintf(out, "Heap monitor: not active, link with the allocation wrappers\r\n");
+        return;
+    }
+
+    uint32_t largest = LargestFreeBlock();
+    uint32_t freeBytes = FreeBytes();
+    uint32_t fragmentation = freeBytes > 0 ? 100 - largest*100/freeBytes : 0;
+
+    fprintf(out, "Heap monitor:\r\n");
+    fprintf(out, "  in use: %u bytes in %u blocks, peak %u bytes\r\n",
+            (unsigned) bytesInUse, (unsigned) blocksInUse, (unsigned) peakBytesInUse);
+    fprintf(out, "  allocations: %u, frees: %u, failed: %u\r\n",
+            (unsigned) allocations, (unsigned) frees, (unsigned) failures);
+    fprintf(out, "  per run loop iteration: last %u, max %u (%u iterations)\r\n",
+            (unsigned) lastIterationAllocations, (unsigned) maxIterationAllocations,
+            (unsigned) iterations);
+    fprintf(out, "  largest free block: %u of %u free bytes, %u%% fragmented\r\n",
+            (unsigned) largest, (unsigned) freeBytes, (unsigned) fragmentation);
+    fprintf(out, "  call site    allocs   in use     peak\r\n");
+
+    for (uint32_t i=0; i<siteCount; i++)
+    {
+        fprintf(out, "  %10p %8u %8u %8u\r\n", sites[i].address,
+                (unsigned) sites[i].allocations, (unsigned) sites[i].bytesInUse,
+                (unsigned) sites[i].peakBytesInUse);
+    }
+
+    if (siteCount == MaxCallSites)
+        fprintf(out, "  (call site table is full, later sites are not listed)\r\n");
+}
+
+// MARK: Getters
+
+bool HeapMonitor::IsActive()
+{
+    return active;
+}
+
+uint32_t HeapMonitor::Allocations()
+{
+    return allocations;
+}
+
+uint32_t HeapMonitor::Frees()
+{
+    return frees;
+}
+
+uint32_t HeapMonitor::Failures()
+{
+    return failures;
+}
+
+uint32_t HeapMonitor::BytesInUse()
+{
+    return bytesInUse;
+}
+
+uint32_t HeapMonitor::BlocksInUse()
+{
+    return blocksInUse;
+}
+
+uint32_t HeapMonitor::PeakBytesInUse()
+{
+    return peakBytesInUse;
+}
+
+uint32_t HeapMonitor::LastIterationAllocations()
+{
+    return lastIterationAllocations;
+}
+
+uint32_t HeapMonitor::MaxIterationAllocations()
+{
+    return maxIterationAllocations;
+}
+
+uint32_t HeapMonitor::Iterations()
+{
+    return iterations;
+}
+
+uint32_t HeapMonitor::CallSiteCount()
+{
+    return siteCount;
+}
+
+const HeapMonitor::CallSite &HeapMonitor::CallSiteAt(uint32_t index)
+{
+    return sites[index];
+}
+
+// MARK: Checkpoint
+
+HeapCheckpoint::HeapCheckpoint()
+{
+    startAllocations = HeapMonitor::Allocations();
+    startBytes = HeapMonitor::BytesInUse();
+}
+
+uint32_t HeapCheckpoint::Allocations() const
+{
+    return HeapMonitor::Allocations() - startAllocations;
+}
+
+int32_t HeapCheckpoint::BytesDelta() const
+{
+    return (int32_t) (HeapMonitor::BytesInUse() - startBytes);
+}
@@ -0,0 +1,227 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef heap_monitor_h
+#define heap_monitor_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace mono {
+
+    /**
+     * @brief Statistics of HEAP allocations, per call site and run loop iteration
+     *
+     * The heap monitor counts allocations, bytes in use and the peak usage. It
+     * groups allocations by the address of the code that called `malloc` or
+     * `new`, so you can find out who is using the memory.
+     *
+     * The monitor is opt-in. The counters are only updated when the firmware
+     * (or test) is linked with the allocation wrappers, by adding these flags
+     * to the link command:
+     *
+     * @code
+     * -Wl,--wrap=malloc,--wrap=free,--wrap=realloc,--wrap=calloc
+     * @endcode
+     *
+     * The application Makefile (see `test/app_makefile`) adds them, and the
+     * `new` wrappers, to the firmware link when you build with
+     * `make HEAP_MONITOR=1`. The framework library itself is not linked, so
+     * the flag has no effect when building the library. Without
+     * the flags the monitor costs nothing, and @ref IsActive returns `false`.
+     * Each monitored allocation has a 16 byte header, so the firmware uses
+     * more memory when monitored.
+     *
+     * The @ref AppRunLoop calls @ref newIteration in every iteration, so
+     * you can see how many allocations the run loop does when idle. Print
+     * the statistics with @ref report:
+     *
+     * @code
+     * HeapMonitor::report(stdout);
+     * @endcode
+     *
+     * Allocations done inside the C library, like `stdio` buffers, are not
+     * counted.
+     */
+    class HeapMonitor
+    {
+    public:
+
+        /** The max number of call sites, that are counted individually */
+#ifdef EMUNO
+        // the host C++ library and the test framework add many sites
+        static const uint32_t MaxCallSites = 256;
+#else
+        static const uint32_t MaxCallSites = 32;
+#endif
+
+        /** @brief The statistics of a single call site */
+        struct CallSite
+        {
+            const void *address;        /**< Return address of the allocating call */
+            uint32_t allocations;       /**< Number of allocations */
+            uint32_t bytesInUse;        /**< Bytes allocated and not yet freed */
+            uint32_t peakBytesInUse;    /**< The highest value of `bytesInUse` */
+        };
+
+        /** Site index for allocations from sites, that did not fit the table */
+        static const uint16_t OtherSites = 0xFFFF;
+
+    protected:
+
+        static bool active;
+        static uint32_t allocations, frees, failures;
+        static uint32_t bytesInUse, peakBytesInUse, blocksInUse;
+        static uint32_t iterationAllocations, lastIterationAllocations, maxIterationAllocations;
+        static uint32_t iterations;
+        static CallSite sites[MaxCallSites];
+        static uint32_t siteCount;
+
+        static void *(*rawMalloc)(size_t);
+        static void (*rawFree)(void *);
+
+        static void *probeAllocate(size_t size);
+        static void probeFree(void *ptr);
+
+    public:
+
+        /**
+         * @brief Set by the allocation wrappers, do not call this yourself
+         *
+         * @param mallocFunc The C library `malloc`, that is not monitored
+         * @param freeFunc The C library `free`, that is not monitored
+         */
+        static void activate(void *(*mallocFunc)(size_t), void (*freeFunc)(void *));
+
+        /**
+         * @brief Record an allocation, called by the allocation wrappers
+         *
+         * @param site The return address of the allocating call
+         * @param size The number of bytes allocated
+         * @return The index of the call site, to be passed to @ref recordFree
+         */
+        static uint16_t recordAllocation(const void *site, uint32_t size);
+
+        /** @brief Record an allocation that failed, called by the wrappers */
+        static void recordFailure();
+
+        /**
+         * @brief Record that memory is freed, called by the allocation wrappers
+         *
+         * @param siteIndex The index returned by @ref recordAllocation
+         * @param size The number of bytes freed
+         */
+        static void recordFree(uint16_t siteIndex, uint32_t size);
+
+        /**
+         * @brief Mark the start of a new run loop iteration
+         *
+         * Called by the @ref AppRunLoop. Remembers the number of allocations
+         * done in the previous iteration.
+         */
+        static void newIteration();
+
+        /** @brief `true` if the firmware is linked with the allocation wrappers */
+        static bool IsActive();
+
+        /** @brief The total number of allocations */
+        static uint32_t Allocations();
+
+        /** @brief The total number of freed blocks */
+        static uint32_t Frees();
+
+        /** @brief The number of allocations that returned `NULL` */
+        static uint32_t Failures();
+
+        /** @brief The number of bytes allocated and not yet freed */
+        static uint32_t BytesInUse();
+
+        /** @brief The number of blocks allocated and not yet freed */
+        static uint32_t BlocksInUse();
+
+        /** @brief The highest number of bytes in use, since start or @ref resetPeaks */
+        static uint32_t PeakBytesInUse();
+
+        /** @brief The number of allocations in the last run loop iteration */
+        static uint32_t LastIterationAllocations();
+
+        /** @brief The highest number of allocations in a run loop iteration */
+        static uint32_t MaxIterationAllocations();
+
+        /** @brief The number of run loop iterations */
+        static uint32_t Iterations();
+
+        /** @brief The number of call sites in the table */
+        static uint32_t CallSiteCount();
+
+        /** @brief Get the statistics of a call site */
+        static const CallSite &CallSiteAt(uint32_t index);
+
+        /**
+         * @brief Find the largest block, that can be allocated now
+         *
+         * The size is found by trying to allocate blocks of different sizes,
+         * so it takes a while. Do not call it in time critical code.
+         *
+         * @param limit Do not probe for blocks larger than this
+         * @return The size of the largest free block in bytes, at most `limit`
+         */
+        static uint32_t LargestFreeBlock(uint32_t limit = 64*1024);
+
+        /**
+         * @brief Estimate the number of free bytes, by allocating all the largest blocks
+         *
+         * Compare it with @ref LargestFreeBlock to see how fragmented the
+         * HEAP is. Like @ref LargestFreeBlock this is slow.
+         *
+         * @param limit Stop probing when this number of free bytes is found
+         */
+        static uint32_t FreeBytes(uint32_t limit = 64*1024);
+
+        /** @brief Set the peak values to the current values */
+        static void resetPeaks();
+
+        /**
+         * @brief Print all statistics and a fragmentation estimate
+         *
+         * Pass `stdout` to print to the serial console, or an open file to
+         * save the report on the SD card.
+         *
+         * @param out The stream to write the report to
+         */
+        static void report(FILE *out);
+    };
+
+    /**
+     * @brief Count the allocations done since the checkpoint was created
+     *
+     * Use it in tests to check that code does not allocate in steady state:
+     *
+     * @code
+     * HeapCheckpoint checkpoint;
+     * queue.process(now);
+     * REQUIRE(checkpoint.Allocations() == 0);
+     * @endcode
+     *
+     * The counts are always zero, if the allocation wrappers are not linked.
+     */
+    class HeapCheckpoint
+    {
+    protected:
+        uint32_t startAllocations;
+        uint32_t startBytes;
+
+    public:
+
+        /** @brief Start counting from now */
+        HeapCheckpoint();
+
+        /** @brief The number of allocations since the checkpoint */
+        uint32_t Allocations() const;
+
+        /** @brief The change in bytes in use since the checkpoint */
+        int32_t BytesDelta() const;
+    };
+}
+
+#endif /* heap_monitor_h */
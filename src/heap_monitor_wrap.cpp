@@ -0,0 +1,210 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+//
+// Allocation wrappers for the heap monitor. This file is only linked when
+// the linker is asked to wrap the allocation functions, see heap_monitor.h.
+// Every monitored block has a header with its size and call site, the
+// pointer returned to the caller is right after the header.
+
+#include "heap_monitor.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef EMUNO
+#include <new>
+#endif
+
+using namespace mono;
+
+extern "C" {
+    void *__real_malloc(size_t size);
+    void __real_free(void *ptr);
+    void *__real_realloc(void *ptr, size_t size);
+
+    void *__wrap_malloc(size_t size);
+    void __wrap_free(void *ptr);
+    void *__wrap_realloc(void *ptr, size_t size);
+    void *__wrap_calloc(size_t count, size_t size);
+    void *__wrap__Znwj(unsigned int size);
+    void *__wrap__Znaj(unsigned int size);
+    void *__wrap__Znwm(unsigned long size);
+    void *__wrap__Znam(unsigned long size);
+}
+
+static const uint32_t BlockMagic = 0x6D4F4E4F; // "mONO"
+
+// 16 bytes, to keep the 8 (or 16 on 64-bit hosts) byte alignment of malloc
+struct BlockHeader
+{
+    uint32_t magic;
+    uint32_t size;
+    uint16_t site;
+    uint16_t reserved;
+    uint32_t padding;
+};
+
+static inline BlockHeader *headerOf(void *ptr)
+{
+    return (BlockHeader*) ((uint8_t*) ptr - sizeof(BlockHeader));
+}
+
+static void *monitoredAllocate(size_t size, const void *site)
+{
+    if (!HeapMonitor::IsActive())
+        HeapMonitor::activate(__real_malloc, __real_free);
+
+    BlockHeader *header = (BlockHeader*) __real_malloc(size + sizeof(BlockHeader));
+    if (header == 0)
+    {
+        HeapMonitor::recordFailure();
+        return 0;
+    }
+
+    header->magic = BlockMagic;
+    header->size = size;
+    header->site = HeapMonitor::recordAllocation(site, size);
+    return header + 1;
+}
+
+void *__wrap_malloc(size_t size)
+{
+    return monitoredAllocate(size, __builtin_return_address(0));
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr == 0)
+        return;
+
+    BlockHeader *header = headerOf(ptr);
+    if (header->magic != BlockMagic)
+    {
+        // allocated inside the C library, not by a monitored call
+        __real_free(ptr);
+        return;
+    }
+
+    header->magic = 0;
+    HeapMonitor::recordFree(header->site, header->size);
+    __real_free(header);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    const void *site = __builtin_return_address(0);
+
+    if (ptr == 0)
+        return monitoredAllocate(size, site);
+
+    BlockHeader *header = headerOf(ptr);
+    if (header->magic != BlockMagic)
+        return __real_realloc(ptr, size);
+
+    uint16_t oldSite = header->site;
+    uint32_t oldSize = header->size;
+
+    BlockHeader *resized = (BlockHeader*) __real_realloc(header, size + sizeof(BlockHeader));
+    if (resized == 0)
+    {
+        HeapMonitor::recordFailure();
+        return 0;
+    }
+
+    HeapMonitor::recordFree(oldSite, oldSize);
+    resized->size = size;
+    resized->site = HeapMonitor::recordAllocation(site, size);
+    return resized + 1;
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    if (size != 0 && count > ((size_t) -1) / size)
+    {
+        HeapMonitor::recordFailure();
+        return 0;
+    }
+
+    void *ptr = monitoredAllocate(count * size, __builtin_return_address(0));
+    if (ptr != 0)
+        memset(ptr, 0, count * size);
+
+    return ptr;
+}
+
+// operator new and new[] (32 and 64 bit size_t), the matching deletes call free
+
+void *__wrap__Znwj(unsigned int size)
+{
+    return monitoredAllocate(size, __builtin_return_address(0));
+}
+
+void *__wrap__Znaj(unsigned int size)
+{
+    return monitoredAllocate(size, __builtin_return_address(0));
+}
+
+void *__wrap__Znwm(unsigned long size)
+{
+    return monitoredAllocate(size, __builtin_return_address(0));
+}
+
+void *__wrap__Znam(unsigned long size)
+{
+    return monitoredAllocate(size, __builtin_return_address(0));
+}
+
+#ifdef EMUNO
+
+// On the host operator new lives in the shared C++ library, where the linker
+// cannot wrap its malloc calls. These replacements route all forms of new
+// and delete through the monitored functions instead.
+
+void *operator new(size_t size)
+{
+    void *ptr = monitoredAllocate(size, __builtin_return_address(0));
+    if (ptr == 0)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    void *ptr = monitoredAllocate(size, __builtin_return_address(0));
+    if (ptr == 0)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) throw()
+{
+    return monitoredAllocate(size, __builtin_return_address(0));
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) throw()
+{
+    return monitoredAllocate(size, __builtin_return_address(0));
+}
+
+void operator delete(void *ptr) throw()
+{
+    __wrap_free(ptr);
+}
+
+void operator delete[](void *ptr) throw()
+{
+    __wrap_free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) throw()
+{
+    __wrap_free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) throw()
+{
+    __wrap_free(ptr);
+}
+
+#endif /* EMUNO */
@@ -161,8 +161,7 @@ bool HttpClient::hasFrameRequest()
 
 void HttpClient::httpData(redpine::HttpGetFrame::CallbackData *data)
 {
-    respData.bodyChunk = String((char*)(data->data), data->dataLength+1);
-    respData.bodyChunk.stringData[data->dataLength] = 0;
+    respData.bodyChunk = String((char*)(data->data), data->dataLength);
     respData.Finished = data->context->lastResponseParsed;
     //respData.HttpHeaderRaw = String();
 
@@ -52,7 +52,12 @@ mono::String File::readFirstLine(mono::String path, int maxLength, char endLineD
     }
     
     rewind(file);
-    String str(scanned);
+    String str;
+    if (!str.preAllocbytes(scanned))
+    {
+        fclose(file);
+        return str; // HEAP is full
+    }
     
     fread(str.stringData, scanned, 1, file);
     fclose(file);
@@ -78,7 +83,20 @@ bool File::appendString(mono::String text, mono::String path)
 
 bool File::appendLine(String text, String path, const char *lineDelimiter)
 {
-    return appendString(String::Format("%s%s",text(),lineDelimiter), path);
+    FILE *file = fopen(path(), "a");
+    if (file == 0)
+        return false;
+
+    // write the line and delimiter in place, instead of joining them first
+    if (fwrite(text(), 1, text.Length(), file) != text.Length() ||
+        fputs(lineDelimiter, file) == EOF)
+    {
+        fclose(file);
+        return false;
+    }
+
+    fclose(file);
+    return true;
 }
 
 // MARK: Protected Static Methods
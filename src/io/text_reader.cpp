@@ -66,7 +66,10 @@ String TextReader::readLine()
     if (c != '\n')
         lineSize++; // add space for the terminator char
 
-    String line(lineSize);
+    String line;
+    if (!line.preAllocbytes(lineSize+1))
+        return line; // HEAP is full
+
     fread(line.stringData, scanned, 1, _filePointer);
     line.stringData[lineSize] = '\0'; // insert terminator
 
@@ -0,0 +1,248 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "log_sink.h"
+#include "string_builder.h"
+#include <string.h>
+
+using namespace mono;
+
+const uint32_t LogSink::Capacity;
+const uint32_t LogSink::MaxArguments;
+const uint32_t LogSink::MaxLineLength;
+const uint8_t LogSink::BinaryRecordMarker;
+
+static const char levelNames[] = { 'E', 'W', 'I', 'D' };
+static const char *categoryNames[] = {
+    "core", "display", "wireless", "network", "sensors", "power", "app"
+};
+
+LogSink::LogSink(FILE *out)
+{
+    head = tail = 0;
+    dropped = reportedDropped = 0;
+    output = out;
+    binaryOutput = false;
+
+    for (uint32_t i=0; i<Capacity; i++)
+        records[i].ready = 0;
+}
+
+LogSink &LogSink::Default()
+{
+    static LogSink sink(stderr);
+    return sink;
+}
+
+// MARK: Writing records
+
+void LogSink::write(uint8_t level, uint8_t category, uint32_t now, const char *format,
+                    const intptr_t *args, uint8_t argCount)
+{
+    // claim a slot, without locking out interrupts that might also log
+    uint32_t slot;
+    do
+    {
+        slot = head;
+        if (slot - tail >= Capacity)
+        {
+            __sync_fetch_and_add(&dropped, 1);
+            return;
+        }
+    } while (!__sync_bool_compare_and_swap(&head, slot, slot + 1));
+
+    Record &record = records[slot % Capacity];
+    record.format = format;
+    record.time = now;
+    record.level = level;
+    record.category = category;
+    record.argCount = argCount > MaxArguments ? MaxArguments : argCount;
+    for (uint8_t i=0; i<record.argCount; i++)
+        record.args[i] = args[i];
+
+    // the reader must see the content before the ready flag
+    __sync_synchronize();
+    record.ready = 1;
+}
+
+// MARK: Draining
+
+uint32_t LogSink::drain(uint32_t maxMessages)
+{
+    uint32_t count = 0;
+
+    if (dropped != reportedDropped && output != 0 && !binaryOutput)
+    {
+        fprintf(output, "(%u log messages dropped)\r\n", (unsigned) (dropped - reportedDropped));
+        reportedDropped = dropped;
+    }
+
+    while (count < maxMessages && tail != head)
+    {
+        Record &record = records[tail % Capacity];
+        if (!record.ready)
+            break; // still being written by an interrupt
+
+        if (output != 0)
+            writeRecord(record);
+
+        record.ready = 0;
+        __sync_synchronize();
+        tail++;
+        count++;
+    }
+
+    return count;
+}
+
+void LogSink::writeRecord(const Record &record)
+{
+    if (binaryOutput)
+    {
+        // marker, level << 4 | category, argument count, time, format, args
+        uint8_t header[3] = {
+            BinaryRecordMarker,
+            (uint8_t) ((record.level << 4) | (record.category & 0x0F)),
+            record.argCount
+        };
+        uint32_t formatAddress = (uint32_t) (intptr_t) record.format;
+        fwrite(header, 1, sizeof(header), output);
+        fwrite(&record.time, sizeof(record.time), 1, output);
+        fwrite(&formatAddress, sizeof(formatAddress), 1, output);
+        for (uint8_t i=0; i<record.argCount; i++)
+        {
+            uint32_t arg = (uint32_t) record.args[i];
+            fwrite(&arg, sizeof(arg), 1, output);
+        }
+        return;
+    }
+
+    char line[MaxLineLength];
+    StringBuilder prefix(line, sizeof(line));
+    prefix.appendUInt(record.time / 1000000).append('.')
+          .appendUInt((record.time / 1000) % 1000, 3).append(' ')
+          .append(record.level <= LOG_DEBUG ? levelNames[record.level] : '?').append(' ');
+
+    if (record.category <= LOG_APP)
+        prefix.append(categoryNames[record.category]).append(": ");
+
+    uint32_t length = prefix.Length();
+    length += format(line + length, sizeof(line) - length, record.format,
+                     record.args, record.argCount);
+
+    fwrite(line, 1, length, output);
+}
+
+void LogSink::setOutput(FILE *out)
+{
+    output = out;
+}
+
+void LogSink::setBinaryOutput(bool binary)
+{
+    binaryOutput = binary;
+}
+
+uint32_t LogSink::Pending() const
+{
+    return head - tail;
+}
+
+uint32_t LogSink::Dropped() const
+{
+    return dropped;
+}
+
+// MARK: Formatting
+
+uint32_t LogSink::format(char *buffer, uint32_t size, const char *format,
+                         const intptr_t *args, uint8_t argCount)
+{
+    StringBuilder out(buffer, size);
+    uint8_t argIndex = 0;
+
+    for (const char *c = format; *c != 0; c++)
+    {
+        if (*c != '%')
+        {
+            out.append(*c);
+            continue;
+        }
+
+        c++;
+        if (*c == '%')
+        {
+            out.append('%');
+            continue;
+        }
+
+        bool zeroPad = *c == '0';
+        if (zeroPad)
+            c++;
+
+        uint8_t width = 0;
+        while (*c >= '0' && *c <= '9')
+            width = width*10 + (*c++ - '0');
+
+        while (*c == 'l' || *c == 'h')
+            c++;
+
+        if (*c == 0)
+            break;
+
+        intptr_t arg = argIndex < argCount ? args[argIndex++] : 0;
+
+        if (*c == 's')
+        {
+            const char *str = arg != 0 ? (const char*) arg : "(null)";
+            for (uint32_t pad = strlen(str); pad < width; pad++)
+                out.append(' ');
+
+            out.append(str);
+            continue;
+        }
+
+        char fieldBuffer[24];
+        StringBuilder field(fieldBuffer, sizeof(fieldBuffer));
+        uint8_t digits = zeroPad && width > 0 ? width : 1;
+
+        switch (*c)
+        {
+            case 'd':
+            case 'i':
+                if (zeroPad && (int32_t) arg < 0 && digits > 1)
+                    digits--; // the sign takes a place
+                field.appendInt((int32_t) arg, digits);
+                break;
+            case 'u':
+                field.appendUInt((uint32_t) arg, digits);
+                break;
+            case 'x':
+            case 'X':
+                field.appendHex((uint32_t) arg, digits);
+                if (*c == 'X')
+                {
+                    for (char *h = fieldBuffer; *h != 0; h++)
+                        if (*h >= 'a' && *h <= 'f')
+                            *h -= 'a' - 'A';
+                }
+                break;
+            case 'p':
+                field.append("0x").appendHex((uint32_t) arg, 8);
+                break;
+            case 'c':
+                field.append((char) arg);
+                break;
+            default:
+                field.append('%').append(*c);
+                break;
+        }
+
+        for (uint32_t pad = field.Length(); pad < width; pad++)
+            out.append(' ');
+
+        out.append(field.CString());
+    }
+
+    return out.Length();
+}
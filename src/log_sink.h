@@ -0,0 +1,234 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef log_sink_h
+#define log_sink_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace mono {
+
+    /** @brief Log message severity, lower is more severe */
+    enum LogLevel
+    {
+        LOG_ERROR = 0,
+        LOG_WARNING,
+        LOG_INFO,
+        LOG_DEBUG
+    };
+
+    /** @brief The part of the system a log message is from */
+    enum LogCategory
+    {
+        LOG_CORE = 0,
+        LOG_DISPLAY,
+        LOG_WIRELESS,
+        LOG_NETWORK,
+        LOG_SENSORS,
+        LOG_POWER,
+        LOG_APP
+    };
+
+    /**
+     * @brief Buffered log, that is written to the console by the run loop
+     *
+     * Logging with `debug()` or the @ref Console writes to the serial port
+     * right away, and waits until the text is sent. That stalls time critical
+     * code, like SPI transfers. The log sink instead stores the message in a
+     * ring of binary records: the format string pointer, up to 4 arguments
+     * and a time stamp. The text is formatted later, when the run loop calls
+     * @ref drain.
+     *
+     * Writing a record does not block or allocate, so you can log from
+     * interrupt routines. If the ring is full, the message is dropped and
+     * counted.
+     *
+     * You should use the `MONO_LOG_` macros:
+     *
+     * @code
+     * MONO_LOG_WARNING(WIRELESS, "Frame 0x%x failed, status: %i\r\n", cmdId, status);
+     * @endcode
+     *
+     * Messages above `MONO_LOG_LEVEL` or outside the `MONO_LOG_CATEGORIES`
+     * bit mask are removed at compile time. By default all categories are
+     * logged at @ref LOG_DEBUG level, or only errors and warnings if `NDEBUG`
+     * is defined.
+     *
+     * Because formatting is deferred, the format string and any `%s`
+     * arguments must be string literals. Arguments are stored as integers, so
+     * only `%d %i %u %x %X %c %s %p` are supported, with an optional zero
+     * flag and width. Floating point values are not.
+     *
+     * For less output, call @ref setBinaryOutput to write the records as
+     * binary data. The format strings are then identified by their address
+     * in the firmware image.
+     */
+    class LogSink
+    {
+    public:
+
+        /** The number of messages that can wait in the ring */
+        static const uint32_t Capacity = 32;
+
+        /** The max number of arguments to a message */
+        static const uint32_t MaxArguments = 4;
+
+        /** The max length of a formatted message, longer messages are truncated */
+        static const uint32_t MaxLineLength = 128;
+
+        /** Marks the start of a binary record */
+        static const uint8_t BinaryRecordMarker = 0xA5;
+
+    protected:
+
+        struct Record
+        {
+            const char *format;
+            intptr_t args[MaxArguments];
+            uint32_t time;
+            uint8_t level;
+            uint8_t category;
+            uint8_t argCount;
+            volatile uint8_t ready;
+        };
+
+        Record records[Capacity];
+        volatile uint32_t head, tail;
+        volatile uint32_t dropped;
+        uint32_t reportedDropped;
+        FILE *output;
+        bool binaryOutput;
+
+        void write(uint8_t level, uint8_t category, uint32_t now, const char *format,
+                   const intptr_t *args, uint8_t argCount);
+        void writeRecord(const Record &record);
+
+        template <typename T>
+        static intptr_t word(T value) { return (intptr_t) value; }
+
+        LogSink(const LogSink &);
+        LogSink &operator=(const LogSink &);
+
+    public:
+
+        /**
+         * @brief Create a log sink
+         * @param output The stream to write to when draining, like `stderr`
+         */
+        LogSink(FILE *output);
+
+        /** @brief The log sink used by the `MONO_LOG_` macros, writes to `stderr` */
+        static LogSink &Default();
+
+        /**
+         * @brief Store a log message, to be written by @ref drain
+         *
+         * @param level The @ref LogLevel
+         * @param category The @ref LogCategory
+         * @param now The time stamp, from `us_ticker_read`
+         * @param format A printf style format string literal
+         */
+        void log(uint8_t level, uint8_t category, uint32_t now, const char *format)
+        {
+            write(level, category, now, format, 0, 0);
+        }
+
+        template <typename A>
+        void log(uint8_t level, uint8_t category, uint32_t now, const char *format, A a)
+        {
+            intptr_t args[] = { word(a) };
+            write(level, category, now, format, args, 1);
+        }
+
+        template <typename A, typename B>
+        void log(uint8_t level, uint8_t category, uint32_t now, const char *format, A a, B b)
+        {
+            intptr_t args[] = { word(a), word(b) };
+            write(level, category, now, format, args, 2);
+        }
+
+        template <typename A, typename B, typename C>
+        void log(uint8_t level, uint8_t category, uint32_t now, const char *format,
+                 A a, B b, C c)
+        {
+            intptr_t args[] = { word(a), word(b), word(c) };
+            write(level, category, now, format, args, 3);
+        }
+
+        template <typename A, typename B, typename C, typename D>
+        void log(uint8_t level, uint8_t category, uint32_t now, const char *format,
+                 A a, B b, C c, D d)
+        {
+            intptr_t args[] = { word(a), word(b), word(c), word(d) };
+            write(level, category, now, format, args, 4);
+        }
+
+        /**
+         * @brief Write waiting messages to the output
+         *
+         * Called by the run loop in every iteration.
+         *
+         * @param maxMessages Stop after writing this number of messages
+         * @return The number of messages written
+         */
+        uint32_t drain(uint32_t maxMessages = Capacity);
+
+        /** @brief Set the stream to write messages to, like a file on the SD card */
+        void setOutput(FILE *output);
+
+        /** @brief Write binary records instead of formatted text */
+        void setBinaryOutput(bool binary);
+
+        /** @brief The number of messages waiting to be written */
+        uint32_t Pending() const;
+
+        /** @brief The number of messages dropped, because the ring was full */
+        uint32_t Dropped() const;
+
+        /**
+         * @brief Format a message the way @ref drain does
+         *
+         * @param buffer The buffer to write to, NULL terminated
+         * @param size The size of the buffer
+         * @param format The format string
+         * @param args The arguments
+         * @param argCount The number of arguments
+         * @return The length of the formatted text
+         */
+        static uint32_t format(char *buffer, uint32_t size, const char *format,
+                               const intptr_t *args, uint8_t argCount);
+    };
+}
+
+#ifndef MONO_LOG_LEVEL
+#ifdef NDEBUG
+#define MONO_LOG_LEVEL 1
+#else
+#define MONO_LOG_LEVEL 3
+#endif
+#endif
+
+#ifndef MONO_LOG_CATEGORIES
+#define MONO_LOG_CATEGORIES 0xFF
+#endif
+
+#include <us_ticker_api.h>
+
+/** `true` if messages of this level and category are compiled in */
+#define MONO_LOG_ENABLED(level, category) \
+    ((level) <= MONO_LOG_LEVEL && ((MONO_LOG_CATEGORIES >> (category)) & 1))
+
+/** Log a message, the category is given without the `LOG_` prefix, like `WIRELESS` */
+#define MONO_LOG(level, category, ...) \
+    do { \
+        if (MONO_LOG_ENABLED(level, mono::LOG_##category)) \
+            mono::LogSink::Default().log(level, mono::LOG_##category, us_ticker_read(), __VA_ARGS__); \
+    } while (0)
+
+#define MONO_LOG_ERROR(category, ...) MONO_LOG(mono::LOG_ERROR, category, __VA_ARGS__)
+#define MONO_LOG_WARNING(category, ...) MONO_LOG(mono::LOG_WARNING, category, __VA_ARGS__)
+#define MONO_LOG_INFO(category, ...) MONO_LOG(mono::LOG_INFO, category, __VA_ARGS__)
+#define MONO_LOG_DEBUG(category, ...) MONO_LOG(mono::LOG_DEBUG, category, __VA_ARGS__)
+
+#endif /* log_sink_h */
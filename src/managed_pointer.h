@@ -7,10 +7,78 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <new>
+
 #include <mbed_debug.h>
+#include "ref_count.h"
+#include "allocator_interface.h"
 
 namespace mono {
 
+    /**
+     * The shared part of @ref ManagedPointer objects: the reference count and
+     * how to free the content. When the content is created with
+     * @ref make_managed the count and the content share one allocation.
+     *
+     * @brief Reference count of managed pointers
+     */
+    class ManagedCount : public RefCount
+    {
+    public:
+
+        /** The allocator that owns the memory, `NULL` if it is `malloc` */
+        IAllocator *allocator;
+
+        /** `true` if the content is placed right after the count */
+        bool sharedAllocation;
+
+        /** The offset from the count to the content in shared allocations, 8 byte aligned */
+        static uint32_t contentOffset()
+        {
+            return (sizeof(ManagedCount) + 7) & ~7;
+        }
+
+        /**
+         * @brief Allocate a count, optionally followed by content storage
+         *
+         * @param alloc The allocator to use, `NULL` for `malloc`
+         * @param contentSize The bytes to reserve for content, `0` for a count only
+         * @param initialCount The initial reference count
+         * @return The new count, or `NULL` if there is no memory
+         */
+        static ManagedCount *create(IAllocator *alloc, uint32_t contentSize, uint32_t initialCount = 1)
+        {
+            uint32_t size = contentSize > 0 ? contentOffset() + contentSize : sizeof(ManagedCount);
+            void *block = alloc != NULL ? alloc->allocate(size) : malloc(size);
+            if (block == NULL)
+            {
+                debug("ManagedPointer: could not allocate %u bytes!\r\n", size);
+                return NULL;
+            }
+
+            ManagedCount *count = (ManagedCount*) block;
+            count->count = initialCount;
+            count->allocator = alloc;
+            count->sharedAllocation = contentSize > 0;
+            return count;
+        }
+
+        /** @brief Pointer to the content storage of a shared allocation */
+        void *contentStorage()
+        {
+            return ((uint8_t*) this) + contentOffset();
+        }
+
+        /** @brief Return the memory of this count (and shared content) */
+        void destroy()
+        {
+            if (allocator != NULL)
+                allocator->deallocate(this);
+            else
+                free(this);
+        }
+    };
+
     /**
      * The managed pointer is an object designed to live on the stack, but point
      * to memory cobntent that live on the heap. The ManagedPointer keeps track
@@ -24,6 +92,14 @@ namespace mono {
      * With ManagedPointer you can prevent memory leaks, by ensuring
      * un-references memory gets freed.
      *
+     * Prefer to create content with @ref make_managed. It places the
+     * reference count and the content object in a single allocation, where
+     * wrapping a `new`'ed object needs a separate allocation for the count:
+     *
+     * @code
+     * ManagedPointer<Rect> rect = make_managed<Rect>(0, 0, 10, 10);
+     * @endcode
+     *
      * @brief Pointer to a heap object, that keeps track of memory references.
      */
     template <typename ContentClass>
@@ -31,9 +107,25 @@ namespace mono {
     {
     protected:
 
-        uint32_t *refCount;
+        ManagedCount *refCount;
         ContentClass *content;
 
+        void release()
+        {
+            if (content != NULL && refCount != NULL && refCount->release())
+            {
+                if (refCount->sharedAllocation)
+                    content->~ContentClass();
+                else
+                    delete content;
+
+                refCount->destroy();
+            }
+
+            content = NULL;
+            refCount = NULL;
+        }
+
     public:
 
         /** Create an empty pointer */
@@ -43,33 +135,74 @@ namespace mono {
         ManagedPointer(ContentClass *contentPtr, uint32_t initialRefCount = 1)
         {
             content = contentPtr;
-            refCount = (uint32_t*) malloc(sizeof(uint32_t));
-            *refCount = initialRefCount;
+            refCount = NULL;
+
+            // an empty pointer needs no count
+            if (content == NULL)
+                return;
+
+            refCount = ManagedCount::create(NULL, 0, initialRefCount);
+
+            // without a count the content can never be freed
+            if (refCount == NULL)
+            {
+                delete content;
+                content = NULL;
+            }
+        }
+
+        /**
+         * @brief Take over content in a shared allocation
+         *
+         * This is used by @ref make_managed, you should not need it directly.
+         * @param count The count, created with content storage
+         * @param contentPtr The content, constructed in the count's storage
+         */
+        ManagedPointer(ManagedCount *count, ContentClass *contentPtr)
+        {
+            refCount = count;
+            content = contentPtr;
         }
 
         ManagedPointer(const ManagedPointer &other)
         {
             content = other.content;
             refCount = other.refCount;
-            *refCount = *refCount + 1;
+            if (refCount != NULL)
+                refCount->retain();
+        }
+
+        /**
+         * Exchange the content and count with another pointer, without
+         * touching the reference counts. Use this to hand over content
+         * without the retain and release of a copy.
+         *
+         * @brief Swap the content of two pointers
+         * @param other The pointer to swap with
+         */
+        void swap(ManagedPointer &other)
+        {
+            ContentClass *otherContent = other.content;
+            ManagedCount *otherCount = other.refCount;
+            other.content = content;
+            other.refCount = refCount;
+            content = otherContent;
+            refCount = otherCount;
         }
 
         ManagedPointer &operator=(const ManagedPointer &other)
         {
             //debug("mgrPtr assigning: 0x%x\r\n",other.content);
-            if (this->content != 0)
-                this->~ManagedPointer();
+            if (this == &other)
+                return *this;
+
+            release();
             
-            if (!other)
-            {
-                content =  0;
-                refCount = 0;
-            }
-            else
+            if (other)
             {
                 content = other.content;
                 refCount = other.refCount;
-                *refCount = *refCount + 1;
+                refCount->retain();
             }
 
             return *this;
@@ -78,15 +211,18 @@ namespace mono {
         ManagedPointer &operator=(ContentClass *contentPtr)
         {
             //debug("raw ptr to mgrPtr: 0x%x\r\n",contentPtr);
-            if (this->content != 0)
-                this->~ManagedPointer();
+            release();
 
             if (contentPtr == NULL)
                 return *this;
 
             content = contentPtr;
-            refCount = (uint32_t*) malloc(sizeof(uint32_t));
-            *refCount = 1;
+            refCount = ManagedCount::create(NULL, 0);
+            if (refCount == NULL)
+            {
+                delete content;
+                content = NULL;
+            }
 
             return *this;
         }
@@ -127,19 +263,32 @@ namespace mono {
          *
          * This means that if the Reference count is 1, this pointer is the only
          * existing, and it will not dealloc the content memory upon deletion of
-         * the ManagedPointer.
+         * the ManagedPointer. The reference count itself is freed.
          *
          * We Reference count is > 1, then other ManagedPointers might dealloc
          * the content memory.
+         *
+         * Content created with @ref make_managed lives in the same allocation
+         * as the count, and cannot be surrendered.
+         *
+         * @return `false` if the content is in a shared allocation, and kept
          */
-        void Surrender()
+        bool Surrender()
         {
+            if (refCount != NULL && refCount->sharedAllocation)
+                return false;
+
+            if (refCount != NULL && refCount->release())
+                refCount->destroy();
+
             content = NULL;
+            refCount = NULL;
+            return true;
         }
 
         uint32_t References() const
         {
-            return refCount != 0 ? *refCount : 0;
+            return refCount != 0 ? refCount->References() : 0;
         }
 
         uint32_t Address() const
@@ -159,23 +308,106 @@ namespace mono {
         
         ~ManagedPointer()
         {
-            if (content != NULL) {
-                (*refCount) = *refCount-1;
-            }
-            else
-                return;
+            release();
+        }
 
-            if (*refCount <= 0)
-            {
-                free(refCount);
+    };
 
-                if (content != NULL)
-                    delete content;
-            }
+    /**
+     * @brief Create an object and its @ref ManagedPointer in one allocation
+     *
+     * The reference count and the object share a single HEAP block, or a
+     * block from the allocator you provide. Overloads take up to 4 constructor
+     * arguments.
+     *
+     * @param allocator The allocator to use, like a pool. `NULL` for `malloc`
+     * @return The managed pointer, empty if there was no memory
+     */
+    template <typename T>
+    ManagedPointer<T> make_managed_in(IAllocator *allocator)
+    {
+        ManagedCount *count = ManagedCount::create(allocator, sizeof(T));
+        if (count == NULL)
+            return ManagedPointer<T>();
 
-        }
+        return ManagedPointer<T>(count, new (count->contentStorage()) T());
+    }
 
-    };
+    template <typename T, typename A1>
+    ManagedPointer<T> make_managed_in(IAllocator *allocator, const A1 &a1)
+    {
+        ManagedCount *count = ManagedCount::create(allocator, sizeof(T));
+        if (count == NULL)
+            return ManagedPointer<T>();
+
+        return ManagedPointer<T>(count, new (count->contentStorage()) T(a1));
+    }
+
+    template <typename T, typename A1, typename A2>
+    ManagedPointer<T> make_managed_in(IAllocator *allocator, const A1 &a1, const A2 &a2)
+    {
+        ManagedCount *count = ManagedCount::create(allocator, sizeof(T));
+        if (count == NULL)
+            return ManagedPointer<T>();
+
+        return ManagedPointer<T>(count, new (count->contentStorage()) T(a1, a2));
+    }
+
+    template <typename T, typename A1, typename A2, typename A3>
+    ManagedPointer<T> make_managed_in(IAllocator *allocator, const A1 &a1, const A2 &a2, const A3 &a3)
+    {
+        ManagedCount *count = ManagedCount::create(allocator, sizeof(T));
+        if (count == NULL)
+            return ManagedPointer<T>();
+
+        return ManagedPointer<T>(count, new (count->contentStorage()) T(a1, a2, a3));
+    }
+
+    template <typename T, typename A1, typename A2, typename A3, typename A4>
+    ManagedPointer<T> make_managed_in(IAllocator *allocator, const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
+    {
+        ManagedCount *count = ManagedCount::create(allocator, sizeof(T));
+        if (count == NULL)
+            return ManagedPointer<T>();
+
+        return ManagedPointer<T>(count, new (count->contentStorage()) T(a1, a2, a3, a4));
+    }
+
+    /**
+     * @brief Create an object and its @ref ManagedPointer in one HEAP allocation
+     *
+     * Overloads take up to 4 constructor arguments.
+     * @see make_managed_in
+     */
+    template <typename T>
+    ManagedPointer<T> make_managed()
+    {
+        return make_managed_in<T>((IAllocator*) NULL);
+    }
+
+    template <typename T, typename A1>
+    ManagedPointer<T> make_managed(const A1 &a1)
+    {
+        return make_managed_in<T>((IAllocator*) NULL, a1);
+    }
+
+    template <typename T, typename A1, typename A2>
+    ManagedPointer<T> make_managed(const A1 &a1, const A2 &a2)
+    {
+        return make_managed_in<T>((IAllocator*) NULL, a1, a2);
+    }
+
+    template <typename T, typename A1, typename A2, typename A3>
+    ManagedPointer<T> make_managed(const A1 &a1, const A2 &a2, const A3 &a3)
+    {
+        return make_managed_in<T>((IAllocator*) NULL, a1, a2, a3);
+    }
+
+    template <typename T, typename A1, typename A2, typename A3, typename A4>
+    ManagedPointer<T> make_managed(const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
+    {
+        return make_managed_in<T>((IAllocator*) NULL, a1, a2, a3, a4);
+    }
 
 }
 
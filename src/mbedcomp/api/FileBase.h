@@ -37,7 +37,11 @@ typedef long off_t;
 #else
 #    include <sys/fcntl.h>
 #    include <sys/types.h>
-#    include <sys/syslimits.h>
+#    if defined(__linux__)
+#        include <limits.h>
+#    else
+#        include <sys/syslimits.h>
+#    endif
 #endif
 
 #include "platform.h"
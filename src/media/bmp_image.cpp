@@ -50,9 +50,7 @@ BMPImage::BMPImage(BMPImage const &img)
     widthMult4 = img.widthMult4;
 
     fPointer = fopen(img.filePath(), "rb");
-    fpos_t pos;
-    fgetpos(img.fPointer, &pos);
-    fseek(fPointer, pos, SEEK_SET);
+    fseek(fPointer, ftell(img.fPointer), SEEK_SET);
 }
 
 
@@ -68,9 +66,7 @@ BMPImage& BMPImage::operator=(const BMPImage &img)
         fclose(fPointer);
 
     fPointer = fopen(img.filePath(), "rb");
-    fpos_t pos;
-    fgetpos(img.fPointer, &pos);
-    fseek(fPointer, pos, SEEK_SET);
+    fseek(fPointer, ftell(img.fPointer), SEEK_SET);
 
     return *this;
 }
@@ -13,7 +13,7 @@ namespace mono { namespace media {
      * for all image formats.
      *
      * Subclasses of this class implement different image formats, that can be
-     * decoded by mono framework. See @ref BMPImage
+     * decoded by mono framework. See @ref BMPImage and @ref RGB565Image
      *
      * The class is an abstract interface that defines 3 methods for reading the
      * raw pixel data from the image, these works like file I/O with a read/write
@@ -82,6 +82,16 @@ namespace mono { namespace media {
          * @returns `true` if you can actually get a proper image, `false` otherwise
          */
         virtual bool IsValid() = 0;
+
+        /**
+         * Returns `true` if the pixel data of a line is immediately followed
+         * by the pixel data of the next line. Consumers (like @ref ImageView)
+         * can then read across line boundaries without calling
+         * @ref SeekToHLine for every line.
+         *
+         * The default implementation returns `false`.
+         */
+        virtual bool HasContiguousLines() { return false; }
     };
 
 } }
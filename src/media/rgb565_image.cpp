@@ -0,0 +1,152 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "rgb565_image.h"
+#include <mbed_debug.h>
+#include <string.h>
+
+using namespace mono::media;
+
+const char RGB565Image::Magic[4] = {'M', '5', '6', '5'};
+
+RGB565Image::RGB565Image()
+{
+    filePath = NULL;
+    fPointer = NULL;
+    imageValid = false;
+    memset(&header, 0, sizeof(header));
+}
+
+// MARK: Rule of 3
+
+RGB565Image::RGB565Image(String path)
+{
+    filePath = path;
+    fPointer = NULL;
+    imageValid = false;
+    memset(&header, 0, sizeof(header));
+    fPointer = fopen(filePath(), "rb");
+
+    if (!fPointer)
+    {
+        debug("RGB565Image: No such file: %s\r\n", path());
+        return;
+    }
+
+    readHeaderData();
+
+    if (memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+    {
+        debug("RGB565Image: File %s is not a RGB565 image!\r\n", path());
+    }
+    else
+    {
+        imageValid = true;
+    }
+}
+
+RGB565Image::RGB565Image(RGB565Image const &img)
+{
+    filePath = img.filePath;
+    imageValid = img.imageValid;
+    header = img.header;
+    fPointer = NULL;
+
+    if (img.fPointer == NULL)
+        return;
+
+    fPointer = fopen(img.filePath(), "rb");
+    if (fPointer != NULL)
+        fseek(fPointer, ftell(img.fPointer), SEEK_SET);
+}
+
+RGB565Image &RGB565Image::operator=(RGB565Image const &img)
+{
+    if (this == &img)
+        return *this;
+
+    filePath = img.filePath;
+    imageValid = img.imageValid;
+    header = img.header;
+
+    if (fPointer != NULL)
+        fclose(fPointer);
+    fPointer = NULL;
+
+    if (img.fPointer == NULL)
+        return *this;
+
+    fPointer = fopen(img.filePath(), "rb");
+    if (fPointer != NULL)
+        fseek(fPointer, ftell(img.fPointer), SEEK_SET);
+
+    return *this;
+}
+
+RGB565Image::~RGB565Image()
+{
+    if (fPointer != NULL)
+    {
+        fclose(fPointer);
+    }
+}
+
+// MARK: Image Interface
+
+int RGB565Image::ReadPixelData(void *target, int pixelsToRead)
+{
+    if (!IsValid())
+        return -1;
+
+    return (int) fread(target, PixelByteSize(), pixelsToRead, fPointer);
+}
+
+int RGB565Image::SkipPixelData(int pixelsToSkip)
+{
+    if (!IsValid())
+        return -1;
+
+    return fseek(fPointer, pixelsToSkip*PixelByteSize(), SEEK_CUR) == 0 ? pixelsToSkip : 0;
+}
+
+int RGB565Image::Width()
+{
+    return header.width;
+}
+
+int RGB565Image::Height()
+{
+    return header.height;
+}
+
+int RGB565Image::PixelByteSize()
+{
+    return 2;
+}
+
+void RGB565Image::SeekToHLine(int vertPos)
+{
+    if (!IsValid())
+        return;
+
+    long pos = sizeof(header) + (long) vertPos * Width() * PixelByteSize();
+    fseek(fPointer, pos, SEEK_SET);
+}
+
+bool RGB565Image::IsValid()
+{
+    return imageValid;
+}
+
+bool RGB565Image::HasContiguousLines()
+{
+    return true;
+}
+
+// MARK: Protected
+
+void RGB565Image::readHeaderData()
+{
+    if (fread(&header, sizeof(header), 1, fPointer) != 1)
+        memset(&header, 0, sizeof(header));
+}
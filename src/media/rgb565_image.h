@@ -0,0 +1,100 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef rgb565_image_h
+#define rgb565_image_h
+
+#include "image.h"
+#include "mn_string.h"
+
+#include <stdint.h>
+
+namespace mono { namespace media {
+
+    /**
+     * Native image format, stored in the exact pixel format that the display
+     * controller consumes. Where a BMP file must be decoded line by line
+     * (bottom-up, padded to 4 bytes), a RGB565 image is just a small header
+     * followed by the raw pixels:
+     *
+     * | Offset | Size | Content                                            |
+     * |--------|------|----------------------------------------------------|
+     * | 0      | 4    | Magic bytes `M565`                                 |
+     * | 4      | 2    | Width in pixels (little endian)                    |
+     * | 6      | 2    | Height in pixels (little endian)                   |
+     * | 8      | w*h*2| Pixels, top-down rows, no padding, 16-bit little endian RGB565 |
+     *
+     * Since the lines are stored top-down and without padding, all lines are
+     * contiguous in the file. This means an @ref ImageView showing the full
+     * image width can stream the entire image with sequential reads, and no
+     * seeks.
+     *
+     * You create `.565` files from PNG or BMP files with the host side tool
+     * `resources/img2rgb565.py`:
+     *
+     * @code
+     * $ python3 resources/img2rgb565.py my_pic.png my_pic.565
+     * @endcode
+     *
+     * Like @ref BMPImage you must initialize the SD card file system before
+     * opening an image.
+     *
+     * @brief A pre-swizzled RGB565 image, that can be streamed directly to the display
+     */
+    class RGB565Image : public Image
+    {
+    protected:
+
+        struct __attribute__ ((__packed__)) FileHeader {
+            uint8_t  magic[4];
+            uint16_t width;
+            uint16_t height;
+        };
+
+        struct FileHeader header;
+
+        String filePath;
+        FILE* fPointer;
+        bool imageValid;
+
+        void readHeaderData();
+
+    public:
+
+        /** The 4 magic bytes that start every RGB565 image file */
+        static const char Magic[4];
+
+        RGB565Image();
+
+        /**
+         * Open a RGB565 image file. If the file does not exist or does not
+         * contain a valid header, @ref IsValid will return `false`.
+         *
+         * @param path The path to the `.565` file
+         */
+        RGB565Image(String path);
+
+        RGB565Image(RGB565Image const &img);
+
+        RGB565Image &operator=(RGB565Image const &img);
+
+        ~RGB565Image();
+
+        int ReadPixelData(void *target, int pixelsToRead);
+        int SkipPixelData(int pixelsToSkip);
+
+        int Width();
+        int Height();
+
+        int PixelByteSize();
+
+        void SeekToHLine(int vertPos);
+
+        bool IsValid();
+
+        bool HasContiguousLines();
+    };
+
+} }
+
+#endif /* rgb565_image_h */
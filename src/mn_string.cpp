@@ -9,12 +9,21 @@
 
 using namespace mono;
 
+const uint32_t String::InlineCapacity;
+const uint32_t String::UnknownLength;
+
 String String::Format(const char *format, ...)
 {
     va_list args;
     va_start(args, format);
     uint32_t size = vsnprintf(NULL, 0, format, args);
-    String str(size+1);
+    String str;
+    if (!str.preAllocbytes(size+1))
+    {
+        // HEAP is full, the string is empty
+        va_end(args);
+        return str;
+    }
 #ifdef __LP64__
     // Workaound for va_start and vsnprintf on 64bit OS X and *nix systems
     // See https://gist.github.com/foobit/4618064
@@ -24,6 +33,7 @@ String String::Format(const char *format, ...)
     vsnprintf(str.stringData,size+1, format, args);
     va_end(args);
 
+    str.length = size;
     return str;
 }
 
@@ -32,6 +42,7 @@ String::String()
     refCount = NULL;
     stringData = NULL;
     malloced = false;
+    length = 0;
 }
 
 String::String(uint32_t preAllocBytes)
@@ -43,20 +54,31 @@ void String::CopyFromCString(const char * cstring)
 {
     // Make room for the string terminator.
     if (0 == cstring)
+    {
         preAllocbytes(1);
+        length = 0;
+    }
     else
     {
-        uint32_t strLen = 1 + strlen(cstring);
-        preAllocbytes(strLen);
-        strcpy(stringData, cstring);
+        uint32_t strLen = strlen(cstring);
+        if (!preAllocbytes(strLen+1))
+            return; // HEAP is full, the string is empty
+
+        memcpy(stringData, cstring, strLen);
+        length = strLen;
     }
 }
 
 String::String(char *str, uint32_t length)
 {
     // Make room for the string terminator.
-    preAllocbytes(length+1);
+    if (!preAllocbytes(length+1))
+        return; // HEAP is full, the string is empty
+
     memcpy(stringData, str, length);
+
+    // the source may contain a NULL terminator before length
+    this->length = strlen(stringData);
 }
 
 String::String(char *str)
@@ -71,57 +93,71 @@ String::String(const char *str)
 
 String::String(const String &str)
 {
-    if (str.malloced)
-    {
-        this->refCount = str.refCount;
-        *(this->refCount) = *(this->refCount)+1;
-    }
-    else
-    {
-        refCount = NULL;
-    }
+    assign(str);
+}
 
-    stringData = str.stringData;
-    this->malloced = str.malloced;
+void String::swap(String &other)
+{
+    if (this == &other)
+        return;
+
+    bool thisInline = isInline();
+    bool otherInline = other.isInline();
+
+    char inlineCopy[sizeof(inlineData)];
+    memcpy(inlineCopy, inlineData, sizeof(inlineData));
+    memcpy(inlineData, other.inlineData, sizeof(inlineData));
+    memcpy(other.inlineData, inlineCopy, sizeof(inlineData));
+
+    char *data = stringData;
+    stringData = otherInline ? inlineData : other.stringData;
+    other.stringData = thisInline ? other.inlineData : data;
+
+    RefCount *count = refCount;
+    refCount = other.refCount;
+    other.refCount = count;
+
+    bool wasMalloced = malloced;
+    malloced = other.malloced;
+    other.malloced = wasMalloced;
+
+    uint32_t len = length;
+    length = other.length;
+    other.length = len;
 }
 
 uint32_t String::Length() const
 {
-    if (stringData != NULL)
+    if (stringData == NULL)
+        return 0;
+    else if (length == UnknownLength)
         return strlen(stringData);
     else
-        return 0;
+        return length;
+}
+
+StringSlice String::slice(uint32_t start, uint32_t count) const
+{
+    return StringSlice(*this).slice(start, count);
 }
 
 String& String::operator=(const char *str)
 {
-    if (this != 0)
-        this->~String();
+    release();
 
     stringData = (char*) str;
-    malloced = false;
-    refCount = NULL;
+    length = str != NULL ? strlen(str) : 0;
 
     return *this;
 }
 
 String& String::operator=(const String &str)
 {
-    if (this != 0)
-        this->~String();
+    if (this == &str)
+        return *this;
 
-    if (str.malloced)
-    {
-        this->refCount = str.refCount;
-        *refCount = (*refCount) +1;
-    }
-    else
-    {
-        refCount = NULL;
-    }
-
-    this->stringData = str.stringData;
-    this->malloced = str.malloced;
+    release();
+    assign(str);
 
     return *this;
 }
@@ -131,6 +167,10 @@ bool String::operator==(const mono::String &other) const
     if (this->stringData == 0 || other.stringData == 0)
         return false;
 
+    if (length != UnknownLength && other.length != UnknownLength &&
+        length != other.length)
+        return false;
+
     return strcmp(this->stringData, other.stringData) == 0 ? true : false;
 }
 
@@ -139,7 +179,7 @@ bool String::operator!=(const mono::String &other) const
     if (this->stringData == 0 || other.stringData == 0)
         return false;
 
-    return strcmp(this->stringData, other.stringData) == 0 ? false : true;
+    return !(*this == other);
 }
 
 bool String::operator==(const char *other) const
@@ -175,25 +215,159 @@ char* String::CString() const
 
 String::~String()
 {
-    if (malloced)
+    release();
+}
+
+///////// PRIVATE METHODS
+
+bool String::preAllocbytes(uint32_t count)
+{
+    length = UnknownLength;
+
+    if (count <= sizeof(inlineData))
     {
-        *refCount = *refCount-1;
+        malloced = false;
+        refCount = NULL;
+        memset(inlineData, 0, sizeof(inlineData));
+        stringData = inlineData;
+        return true;
     }
 
-    if (malloced && *refCount <= 0)
+    stringData = (char*) RefCount::allocateBuffer(count, &refCount);
+    malloced = stringData != NULL;
+    if (stringData == NULL)
     {
-        free(stringData);
+        // HEAP is full, fall back to an empty string
+        memset(inlineData, 0, sizeof(inlineData));
+        stringData = inlineData;
+        length = 0;
+        return false;
     }
 
+    return true;
 }
 
-///////// PRIVATE METHODS
+bool String::isInline() const
+{
+    return stringData == inlineData;
+}
+
+void String::assign(const String &str)
+{
+    if (str.isInline())
+    {
+        memcpy(inlineData, str.inlineData, sizeof(inlineData));
+        stringData = inlineData;
+    }
+    else
+    {
+        stringData = str.stringData;
+    }
+
+    if (str.malloced)
+    {
+        this->refCount = str.refCount;
+        refCount->retain();
+    }
+    else
+    {
+        refCount = NULL;
+    }
+
+    this->malloced = str.malloced;
+    this->length = str.length;
+}
+
+void String::release()
+{
+    if (malloced)
+        RefCount::releaseBuffer(stringData, refCount);
+
+    refCount = NULL;
+    stringData = NULL;
+    malloced = false;
+    length = 0;
+}
+
+// MARK: String Slice
+
+StringSlice::StringSlice() : data(NULL), length(0)
+{
+}
+
+StringSlice::StringSlice(const char *str) :
+    data(str), length(str != NULL ? strlen(str) : 0)
+{
+}
+
+StringSlice::StringSlice(const char *str, uint32_t len) : data(str), length(len)
+{
+}
+
+StringSlice::StringSlice(const String &str) :
+    data(str.CString()), length(str.Length())
+{
+}
+
+uint32_t StringSlice::Length() const
+{
+    return length;
+}
+
+const char *StringSlice::Data() const
+{
+    return data;
+}
+
+char StringSlice::operator[](uint32_t pos) const
+{
+    return data[pos];
+}
+
+StringSlice StringSlice::slice(uint32_t start, uint32_t count) const
+{
+    if (start >= length)
+        return StringSlice(data != NULL ? data + length : NULL, 0);
+
+    if (count > length - start)
+        count = length - start;
+
+    return StringSlice(data + start, count);
+}
+
+int StringSlice::indexOf(char c, uint32_t from) const
+{
+    for (uint32_t i=from; i<length; i++)
+    {
+        if (data[i] == c)
+            return (int) i;
+    }
+
+    return -1;
+}
+
+bool StringSlice::startsWith(const StringSlice &prefix) const
+{
+    if (prefix.length > length)
+        return false;
+
+    return prefix.length == 0 || memcmp(data, prefix.data, prefix.length) == 0;
+}
+
+bool StringSlice::operator==(const StringSlice &other) const
+{
+    if (length != other.length)
+        return false;
+
+    return length == 0 || memcmp(data, other.data, length) == 0;
+}
+
+bool StringSlice::operator!=(const StringSlice &other) const
+{
+    return !(*this == other);
+}
 
-void String::preAllocbytes(uint32_t count)
+String StringSlice::toString() const
 {
-    malloced = true;
-    stringData = (char*) malloc(count+sizeof(uint32_t));
-    memset(stringData, 0, count+sizeof(uint32_t));
-    refCount = (uint32_t*) (stringData+count);
-    *refCount = 1;
+    return String((char*) data, length);
 }
@@ -6,9 +6,12 @@
 
 #include <stdint.h>
 #include <stdarg.h>
+#include "ref_count.h"
 
 namespace mono {
 
+    class StringSlice;
+
     /**
      * The mono framework has it own string class, that either reside on the HEAP
      * or inside the read-only data segment (`.rodata`).
@@ -39,16 +42,50 @@ namespace mono {
      * These features makes the class very lightweight and safe to pass around
      * functions and objects.
      *
+     * ## Short strings
+     *
+     * Strings of up to @ref InlineCapacity characters are stored inside the
+     * string object itself, and never touch the HEAP. Copies of short strings
+     * are copies of the characters, not references.
+     *
+     * The string length is cached, such that @ref Length does not need to
+     * count characters. The exception is buffer-like strings created with
+     * @ref String(uint32_t), whose content you write yourself. Their length
+     * is counted on every call.
+     *
+     * Use @ref StringSlice to refer to parts of a string, without copying.
+     *
      * @brief High level string class
      */
     class String
     {
     public:
-        uint32_t *refCount;
+
+        /** The maximum length of strings stored inside the object, not on the HEAP */
+        static const uint32_t InlineCapacity = 15;
+
+        RefCount *refCount;
         bool malloced;
         char *stringData;
 
-        void preAllocbytes(uint32_t count);
+        /**
+         * @brief Make room for a number of bytes, inline or on the HEAP
+         *
+         * When the HEAP is full the string is empty, and has only room for
+         * @ref InlineCapacity characters.
+         * @return `false` if there is no room for `count` bytes
+         */
+        bool preAllocbytes(uint32_t count);
+
+    protected:
+
+        /** Marks the cached length as unknown, for buffer-like strings */
+        static const uint32_t UnknownLength = 0xFFFFFFFF;
+
+        uint32_t length;
+        char inlineData[InlineCapacity+1];
+
+        bool isInline() const;
 
     public:
         
@@ -70,7 +107,9 @@ namespace mono {
         /**
          * @brief Construct an empty string with a pre-allocated size
          *
-         * Use this constructor to created a buffer-like string object.
+         * Use this constructor to created a buffer-like string object. If
+         * the HEAP is full the string is empty, and only has room for
+         * @ref InlineCapacity characters. Use @ref preAllocbytes to check.
          * @param preAllocBytes The number of bytes to allocate in the string object
          */
         String(uint32_t preAllocBytes);
@@ -115,6 +154,7 @@ namespace mono {
          * @param str A reference to the mono string
          */
         String(const String &str);
+
         
         /**
          * @brief Return the length of the string
@@ -122,15 +162,41 @@ namespace mono {
          * The length of the actual string is returned, not counting the NULL
          * terminator.
          *
-         * This method uses `strlen` which does not support variable byte-length
-         * character encoding. (That means UTF8, 16 and alike.)
+         * The length is counted in bytes, which does not support variable
+         * byte-length character encoding. (That means UTF8, 16 and alike.)
          */
         uint32_t Length() const;
 
+        /**
+         * @brief Get a non-owning slice of the string
+         *
+         * The slice is clamped to the string length. It refers to the string
+         * data, so the string must outlive the slice.
+         *
+         * @param start The index of the first character in the slice
+         * @param count The maximum number of characters in the slice
+         */
+        StringSlice slice(uint32_t start, uint32_t count = UnknownLength) const;
+
         String& operator=(const char *str);
 
         String& operator=(const String &str);
 
+        /**
+         * Exchanging two strings does not touch the reference counts, and
+         * copies no characters from the HEAP. Use it to take over the data
+         * of a string, that is no longer needed:
+         *
+         * @code
+         * String result;
+         * result.swap(temporary);
+         * @endcode
+         *
+         * @brief Exchange the contents of two strings
+         * @param other The string to exchange contents with
+         */
+        void swap(String &other);
+
         bool operator==(String const &other) const;
 
         bool operator!=(String const &other) const;
@@ -164,7 +230,79 @@ namespace mono {
 
     private:
         void CopyFromCString(const char * cstring);
+        void assign(const String &str);
+        void release();
+
+    };
+
+    /**
+     * A slice refers to a range of characters in a string, without owning or
+     * copying them. It works like a `string_view`: the string it refers to
+     * must stay around, as long as the slice is used.
+     *
+     * Slices are not NULL terminated. Use @ref toString to get a terminated
+     * copy.
+     *
+     * @code
+     * String line("Temp: 22.5");
+     * StringSlice value = line.slice(line.slice(0).indexOf(':') + 2);
+     * if (value == "22.5") { ... }
+     * @endcode
+     *
+     * @brief Non-owning view of a range of characters
+     */
+    class StringSlice
+    {
+    protected:
+        const char *data;
+        uint32_t length;
+
+    public:
+
+        /** @brief Construct an empty slice */
+        StringSlice();
+
+        /** @brief Construct a slice of a NULL terminated C string */
+        StringSlice(const char *str);
+
+        /** @brief Construct a slice of a character range */
+        StringSlice(const char *str, uint32_t length);
+
+        /** @brief Construct a slice of an entire mono string */
+        StringSlice(const String &str);
+
+        /** @brief The number of characters in the slice */
+        uint32_t Length() const;
+
+        /** @brief Pointer to the first character, not NULL terminated */
+        const char *Data() const;
+
+        char operator[](uint32_t pos) const;
+
+        /**
+         * @brief Get a sub-slice, clamped to this slice
+         * @param start The index of the first character
+         * @param count The maximum number of characters
+         */
+        StringSlice slice(uint32_t start, uint32_t count = 0xFFFFFFFF) const;
+
+        /**
+         * @brief Find the first occurence of a character
+         * @param c The character to find
+         * @param from The index to start searching from
+         * @returns The index of the character, or -1 if not found
+         */
+        int indexOf(char c, uint32_t from = 0) const;
+
+        /** @brief `true` if the slice begins with the characters of `prefix` */
+        bool startsWith(const StringSlice &prefix) const;
+
+        bool operator==(const StringSlice &other) const;
+
+        bool operator!=(const StringSlice &other) const;
 
+        /** @brief Copy the slice into a new (NULL terminated) mono string */
+        String toString() const;
     };
 }
 
@@ -7,6 +7,7 @@
 #include <deprecated.h>
 #include <mbed.h>
 #include "application_run_loop_task_interface.h"
+#include "async.h"
 
 
 namespace mono {
@@ -49,12 +50,12 @@ namespace mono {
      * If you want to use a single shot callback with a delay, Timer has a
      * convenience static function:
      * @code
-     * Timer delay = Timer::callOnce<MyClass>(100, this, &MyClass::callback);
+     * Timer::callOnce<MyClass>(100, this, &MyClass::callback);
      * @endcode
      *
-     * Now `delay` is a running timer that calls `callback` only one time. *Note*
-     * that the timer object (`delay`) should not be deallocated. Deallocating 
-     * the object will cause the timer to shut down.
+     * Now `callback` is called one time, after 100 ms. The call waits in the
+     * run loop's timer heap, no timer object is created. Remove it with
+     * @ref cancelAsync, if the object is deallocated before the call.
      *
      * ### Time slices
      *
@@ -85,6 +86,7 @@ namespace mono {
         bool autoRelease;
         
         void taskHandler();
+        const char *taskName() const { return "timer"; }
         
         void hwTimerInterrupt();
         
@@ -168,51 +170,37 @@ namespace mono {
         }
         
         /**
-         * @brief Create a single shot timer with a delay and callback function
+         * @brief Call a member function once, after a delay
          * 
-         * The timer object is created on the HEAP, which allows it to exists 
-         * across stack frame contexts. You can safely create a `callOnce(...)`
-         * timer, and return from a function. Even if you do not have a reference
-         * to the timer object, it will still run and fire. The timer deallocates
-         * itself after it has fired. It cannot be reused.
+         * The call is placed in the run loop's timer heap, like
+         * @ref asyncAfter. Nothing is allocated, and you can safely return
+         * from the function that created the call. Remove a pending call with
+         * @ref cancelAsync.
          *
-         * @param delayMs Delay time before the timer fires, in milliseconds.
+         * @param delayMs Delay time before the call, in milliseconds.
          * @param obj A pointer to the callbacks function member context (the `this` pointer)
          * @param memPtr A pointer to the callback member function
-         * @return A pointer to the single shot timer
+         * @return `false` if the timer heap was full and the call is dropped
          */
         template <typename Owner>
-        static Timer* callOnce(uint32_t delayMs, Owner *obj, void (Owner::*memPtr)(void))
+        static bool callOnce(uint32_t delayMs, Owner *obj, void (Owner::*memPtr)(void))
         {
-            Timer *timer = new Timer(delayMs, true);
-            timer->setCallback<Owner>(obj, memPtr);
-            timer->autoRelease = true;
-            timer->start();
-            
-            return timer;
+            return asyncAfter<Owner>(delayMs, obj, memPtr);
         }
 
         /**
-         * @brief Create a single shot timer with a delay and callback function
+         * @brief Call a C function once, after a delay
          *
-         * The timer object is created on the HEAP, which allows it to exists
-         * across stack frame contexts. You can safely create a `callOnce(...)`
-         * timer, and return from a function. Even if you do not have a reference
-         * to the timer object, it will still run and fire. The timer deallocates
-         * itself after it has fired. It cannot be reused.
+         * Like the member function variant, the call is placed in the run
+         * loop's timer heap and nothing is allocated.
          *
-         * @param delayMs Delay time before the timer fires, in milliseconds.
+         * @param delayMs Delay time before the call, in milliseconds.
          * @param memPtr A pointer to the callback C function
-         * @return A pointer to the single shot timer
+         * @return `false` if the timer heap was full and the call is dropped
          */
-        static Timer* callOnce(uint32_t delayMs, void (*memPtr)(void))
+        static bool callOnce(uint32_t delayMs, void (*memPtr)(void))
         {
-            Timer *timer = new Timer(delayMs, true);
-            timer->setCallback(memPtr);
-            timer->autoRelease = true;
-            timer->start();
-
-            return timer;
+            return asyncAfter(delayMs, memPtr);
         }
         
     };
@@ -37,9 +37,12 @@
 #include <display/ui/background_view.h>
 #include <display/ui/button_view.h>
 #include <display/ui/console_view.h>
+#include <display/ui/gesture_recognizer.h>
 #include <display/ui/graph_view.h>
 #include <display/ui/icon_view.h>
 #include <display/ui/image_view.h>
+#include <display/ui/layout.h>
+#include <display/ui/list_view.h>
 #include <display/ui/on_off_button_view.h>
 #include <display/ui/progress_bar_view.h>
 #include <display/ui/responder_view.h>
@@ -2,6 +2,7 @@
 // and is available under the MIT license, see LICENSE.txt
 
 #include "mono_battery.h"
+#include "mono_touch_system.h"
 #include <mbed.h>
 
 using namespace mono::power;
@@ -33,6 +34,9 @@ uint16_t MonoBattery::ReadMilliVolts()
         isStarted = true;
     }
 
+    // the touch system samples with the ADC in the background
+    MonoTouchSystem::pauseSampling();
+
     // Disconnect AMUXBUSL ; Connect AG5 / CMP2 to AG5 / vref to CMP2
     CY_SET_REG8(CYDEV_ANAIF_RT_SAR0_SW3, CY_GET_REG8(CYDEV_ANAIF_RT_SAR0_SW3) & ~0x01);
     CY_SET_REG8(CYDEV_ANAIF_RT_SAR0_SW0, CY_GET_REG8(CYDEV_ANAIF_RT_SAR0_SW0) | 0x20);
@@ -65,6 +69,7 @@ uint16_t MonoBattery::ReadMilliVolts()
     CY_SET_REG8(CYDEV_ANAIF_RT_CMP2_SW3, CY_GET_REG8(CYDEV_ANAIF_RT_CMP2_SW3) & ~0x20);
     CY_SET_REG8(CYDEV_ANAIF_RT_SAR0_SW0, CY_GET_REG8(CYDEV_ANAIF_RT_SAR0_SW0) & ~0x20);
     CY_SET_REG8(CYDEV_ANAIF_RT_SAR0_SW3, CY_GET_REG8(CYDEV_ANAIF_RT_SAR0_SW3) | 0x01);
+    MonoTouchSystem::resumeSampling();
 
     if (gotZero) {
         return 0;
@@ -26,6 +26,8 @@ namespace mono { namespace power {
         
         void taskHandler();
         
+        const char *taskName() const { return "power management"; }
+        
         void processResetAwarenessQueue();
         
         void setupMCUPeripherals();
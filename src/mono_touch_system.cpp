@@ -4,16 +4,19 @@
 #include "mono_touch_system.h"
 #include "application_context_interface.h"
 
-#include <wait_api.h>
 #include <us_ticker_api.h>
 
 #include "consoles.h"
 
 using namespace mono;
 
+volatile int MonoTouchSystem::adcClaims = 0;
+
 MonoTouchSystem::MonoTouchSystem() : CalMinX(370), CalMinY(300), CalMaxX(2980), CalMaxY(3280)
 {
     active = true;
+    sampleTick = 0;
+    sampledX = 0;
 }
 
 void MonoTouchSystem::init()
@@ -24,79 +27,93 @@ void MonoTouchSystem::init()
     CY_SET_REG8(CYREG_PRT1_AMUX, 0x00);
     
     ADC_SAR_1_Start();
-    
-    lastTouchProcess = 0;
+
+    filter.reset();
+    sampleTick = 0;
+    sampleTicker.attach_us<MonoTouchSystem>(this, &MonoTouchSystem::sampleStep, TickPeriodUs);
+
+    IApplicationContext::Instance->PowerManager->AppendToPowerAwareQueue(this);
 }
 
 
 void MonoTouchSystem::processTouchInput()
 {
-    if (!active)
-        return;
-    
-    if (TouchResponder::FirstResponder() == 0)
-        return;
-
-    if ((us_ticker_read() - lastTouchProcess) <= 10000)
-        return;
-    
-    // connect ADC to right AMUXBUS
-    CY_SET_REG8(CYREG_BUS_SW3, 0x01);
-    
-    uint16_t X = sampleX();
-    uint16_t Y = sampleY();
-    
-    // record time before we handle any touch events
-    lastTouchProcess = us_ticker_read();
-    
-    if (X < CalMinX || Y < CalMinY)
+    TouchFilter::Event event;
+    while (filter.next(event))
     {
-        if (touchInProgress)
+        geo::Point position(event.x, event.y);
+
+        switch (event.type)
         {
-            touchInProgress = false;
-            runTouchEnd(lastLastPosition); // use last move position,
-            // since touch input now is outside screen
-            xAvg.clear(lastLastPosition.X());
-            yAvg.clear(lastLastPosition.Y());
+            case TouchEvent::TOUCH_BEGIN:
+                if (!active || TouchResponder::FirstResponder() == 0)
+                    break;
+
+                touchInProgress = true;
+                lastTouchPosition = position;
+                runTouchBegin(position);
+                break;
+            case TouchEvent::TOUCH_MOVE:
+                if (!touchInProgress)
+                    break;
+
+                lastTouchPosition = position;
+                runTouchMove(position);
+                break;
+            case TouchEvent::TOUCH_END:
+                if (!touchInProgress)
+                    break;
+
+                touchInProgress = false;
+                runTouchEnd(position);
+                break;
         }
     }
-    else if (touchInProgress)
+}
+
+void MonoTouchSystem::sampleStep()
+{
+    // another user of the ADC, restart the sequence when it is done
+    if (adcClaims > 0)
     {
-        xAvg.append(X); yAvg.append(Y);
-        geo::Point newPos = geo::Point(xAvg.value(),yAvg.value());
-        geo::Point diff = newPos - lastTouchPosition;
-        uint32_t sqLength = diff.X()*diff.X() + diff.Y()*diff.Y();
+        if (sampleTick == 1 || sampleTick == 2)
+            releasePanel();
 
-        if (sqLength > 2304) //approx 3 pixels move
-        {
-            lastLastPosition = lastTouchPosition;
-            lastTouchPosition = newPos;
-            
-            // wait to pipeline is full
-            if (lastLastPosition != lastTouchPosition)
-                runTouchMove(lastLastPosition);
-        }
+        sampleTick = 0;
+        return;
     }
-    else if (!touchInProgress)
+
+    switch (sampleTick)
     {
-        wait_ms(5);
-        X = sampleX(); Y = sampleY();
-        xAvg.clear(X); yAvg.clear(Y);
-        
-        lastTouchPosition = geo::Point(X,Y);
-        lastLastPosition = lastTouchPosition;
-        
-        touchInProgress = true;
-        runTouchBegin(lastTouchPosition);
+        case 0:
+            driveX();
+            break;
+        case 1:
+            sampledX = convert();
+            driveY();
+            break;
+        case 2:
+        {
+            uint16_t sampledY = convert();
+            releasePanel();
+
+            bool pressed = sampledX >= CalMinX && sampledY >= CalMinY;
+            filter.append(sampledX, sampledY, pressed, us_ticker_read());
+            break;
+        }
+        default:
+            break;
     }
-    
-    //disconnect ADC from right AMUXBUS
-    CY_SET_REG8(CYREG_BUS_SW3, 0x00);
-}
 
+    if (++sampleTick >= SamplePeriodTicks)
+        sampleTick = 0;
+}
 
-uint16_t MonoTouchSystem::sampleX()
+void MonoTouchSystem::driveX()
 {
+    // connect ADC to right AMUXBUS
+    CY_SET_REG8(CYREG_BUS_SW3, 0x01);
+
     CyPins_SetPinDriveMode(TFT_TOUCH_Y1, CY_PINS_DM_ALG_HIZ);
     CyPins_SetPinDriveMode(TFT_TOUCH_Y2, CY_PINS_DM_RES_DWN);
     
@@ -107,25 +124,13 @@ uint16_t MonoTouchSystem::sampleX()
     CyPins_SetPin(TFT_TOUCH_X2);
     
     CY_SET_REG8(CYREG_PRT1_AMUX, 0x80); // PC7
-    
-    uint16_t samples = 0;
-    for (int i=0; i<8; i++) {
-        wait_us(10);
-        
-        ADC_SAR_1_StartConvert();
-        ADC_SAR_1_IsEndConversion(ADC_SAR_1_WAIT_FOR_RESULT);
+}
 
-        samples += ADC_SAR_1_GetResult16();
-    }
-    
+void MonoTouchSystem::driveY()
+{
     CY_SET_REG8(CYREG_PRT1_AMUX, 0x00); // no conn.
     CyPins_ClearPin(TFT_TOUCH_X2);
-    
-    return samples / 8;
-}
 
-uint16_t MonoTouchSystem::sampleY()
-{
     CyPins_SetPinDriveMode(TFT_TOUCH_X1, CY_PINS_DM_ALG_HIZ);
     CyPins_SetPinDriveMode(TFT_TOUCH_X2, CY_PINS_DM_RES_DWN);
     
@@ -136,21 +141,41 @@ uint16_t MonoTouchSystem::sampleY()
     CyPins_SetPin(TFT_TOUCH_Y2);
     
     CY_SET_REG8(CYREG_PRT1_AMUX, 0x40); // PC4
-    
-    uint16_t samples = 0;
-    for (int i=0; i<8; i++) {
-        wait_us(10);
-        
+}
+
+void MonoTouchSystem::releasePanel()
+{
+    CY_SET_REG8(CYREG_PRT1_AMUX, 0x00); // no conn.
+    CyPins_ClearPin(TFT_TOUCH_X2);
+    CyPins_ClearPin(TFT_TOUCH_Y2);
+
+    //disconnect ADC from right AMUXBUS
+    CY_SET_REG8(CYREG_BUS_SW3, 0x00);
+}
+
+uint16_t MonoTouchSystem::convert()
+{
+    // the panel has settled since the last tick, convert back to back
+    uint32_t samples = 0;
+    for (int i=0; i<ConversionsPerAxis; i++) {
         ADC_SAR_1_StartConvert();
         ADC_SAR_1_IsEndConversion(ADC_SAR_1_WAIT_FOR_RESULT);
 
         samples += ADC_SAR_1_GetResult16();
     }
-    
-    CY_SET_REG8(CYREG_PRT1_AMUX, 0x00); // no conn.
-    CyPins_ClearPin(TFT_TOUCH_Y2);
-    
-    return samples / 8;
+
+    return samples / ConversionsPerAxis;
+}
+
+void MonoTouchSystem::pauseSampling()
+{
+    adcClaims++;
+}
+
+void MonoTouchSystem::resumeSampling()
+{
+    if (adcClaims > 0)
+        adcClaims--;
 }
 
 int MonoTouchSystem::toScreenCoordsX(int touchPos, uint16_t screenWidth)
@@ -185,12 +210,22 @@ void MonoTouchSystem::onSystemPowerOnReset()
 
 void MonoTouchSystem::onSystemEnterSleep()
 {
-
+    sampleTicker.detach();
+    releasePanel();
 }
 
 void MonoTouchSystem::onSystemWakeFromSleep()
 {
+    // a touch in progress has ended, while we were sleeping
+    if (touchInProgress)
+    {
+        touchInProgress = false;
+        runTouchEnd(lastTouchPosition);
+    }
 
+    filter.reset();
+    sampleTick = 0;
+    sampleTicker.attach_us<MonoTouchSystem>(this, &MonoTouchSystem::sampleStep, TickPeriodUs);
 }
 
 void MonoTouchSystem::onSystemBatteryLow()
@@ -6,7 +6,8 @@
 
 #include <touch_system_interface.h>
 #include "power_aware_interface.h"
-#include "io/running_average_filter.h"
+#include "touch_filter.h"
+#include <mbed.h>
 
 extern "C" {
 #include <project.h>
@@ -14,12 +15,35 @@ extern "C" {
 
 namespace mono {
     
+    /**
+     * @brief Samples mono's resistive touch panel in the background
+     *
+     * A timer interrupt runs the panel drive sequence: it drives the X
+     * plane, lets the voltage settle until the next tick, samples it with
+     * the ADC, and then does the same for Y. The samples go to a
+     * @ref TouchFilter, that publishes touch events. The run loop only
+     * dispatches the completed events in @ref processTouchInput, and is never
+     * blocked by the sampling.
+     *
+     * Code that uses the ADC from outside the interrupt, like battery
+     * readings, must pause the sampling with @ref pauseSampling and
+     * @ref resumeSampling.
+     */
     class MonoTouchSystem : public ITouchSystem, power::IPowerAware
     {
     protected:
-        
-        /** We try not to sample with more than 100 Hz */
-        uint32_t lastTouchProcess;
+
+        /** The timer interrupt period, also the settle time of the panel */
+        static const uint32_t TickPeriodUs = 1000;
+
+        /** Ticks per panel sample, sample with 100 Hz */
+        static const int SamplePeriodTicks = 10;
+
+        /** ADC conversions averaged per axis */
+        static const int ConversionsPerAxis = 8;
+
+        /** The number of users of the ADC, outside the sampling interrupt */
+        static volatile int adcClaims;
         
         /** Calibration minimum touch input */
         uint16_t CalMinX, CalMinY;
@@ -27,12 +51,18 @@ namespace mono {
         /** Calibration maximum touch input */
         uint16_t CalMaxX, CalMaxY;
 
-        io::RunningAverageFilter<4> xAvg, yAvg;
+        mbed::Ticker sampleTicker;
+        TouchFilter filter;
+        int sampleTick;
+        uint16_t sampledX;
 
-        geo::Point lastLastPosition;
-        
-        uint16_t sampleX();
-        uint16_t sampleY();
+        /** The timer interrupt handler, runs one step of the drive sequence */
+        void sampleStep();
+
+        void driveX();
+        void driveY();
+        void releasePanel();
+        uint16_t convert();
         
         void onSystemPowerOnReset();
         void onSystemEnterSleep();
@@ -45,6 +75,7 @@ namespace mono {
         
         void init();
         
+        /** @brief Dispatch the touch events sampled since the last call */
         void processTouchInput();
         
         void setCalibration(TouchCalibration &cal);
@@ -52,6 +83,12 @@ namespace mono {
         
         int toScreenCoordsX(int touchPos, uint16_t screenWidth);
         int toScreenCoordsY(int touchPos, uint16_t screenHeight);
+
+        /** @brief Stop touch sampling, while you use the ADC */
+        static void pauseSampling();
+
+        /** @brief Restart touch sampling, after @ref pauseSampling */
+        static void resumeSampling();
     };
 }
 
@@ -28,6 +28,17 @@ namespace mono { namespace redpine {
 
             void closeFrameResponse(const CloseSocketFrame::rsi_rsp_socket_close*);
 
+            /** Commands are allocated with their frames, from the frame pools */
+            static void *operator new(size_t size)
+            {
+                return ModuleFrame::FrameAllocator().allocate(size);
+            }
+
+            static void operator delete(void *ptr)
+            {
+                ModuleFrame::FrameAllocator().deallocate(ptr);
+            }
+
         };
 
         // members
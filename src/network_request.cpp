@@ -3,6 +3,7 @@
 
 #include <mbed.h>
 #include "network_request.h"
+#include <async.h>
 
 using namespace mono::network;
 
@@ -52,7 +53,7 @@ void INetworkRequest::triggerDirectErrorHandler()
 
 void INetworkRequest::triggerQueuedErrorHandler()
 {
-    cbTimer = Timer::callOnce<INetworkRequest>(0, this, &INetworkRequest::triggerDirectErrorHandler);
+    async<INetworkRequest>(this, &INetworkRequest::triggerDirectErrorHandler);
 }
 
 /// PUBLIC METHODS
@@ -74,8 +75,7 @@ bool INetworkRequest::HasFailed() const
 
 INetworkRequest::~INetworkRequest()
 {
-    if (cbTimer) {
-        debug("deleting the pending callback trigger timer\r\n");
-        delete cbTimer;
-    }
+    // the error handler callback must not run on a deleted request
+    if (cancelAsync(this) > 0)
+        debug("removed the pending error handler callback\r\n");
 }
@@ -83,9 +83,6 @@ namespace mono { namespace network {
         int lastErrorCode;
         
         
-        /** queued callback timer object */
-        Timer *cbTimer;
-        
         /** set new states and trigger stateCHange callback if state changed */
         void setState(States newState);
         
@@ -99,7 +96,7 @@ namespace mono { namespace network {
         void triggerQueuedErrorHandler();
         
         /** A new network request in SETUP state */
-        INetworkRequest() : state(SETUP_STATE), cbTimer(NULL) {};
+        INetworkRequest() : state(SETUP_STATE) {};
         
     public:
         
@@ -2,6 +2,7 @@
 // and is available under the MIT license, see LICENSE.txt
 
 #include "psoc_battery_voltage.h"
+#include "mono_touch_system.h"
 
 #include <mbed.h>
 
@@ -21,6 +22,9 @@ uint16_t BatteryVoltage::mVoltage()
         isStarted = true;
     }
 
+    // the touch system samples with the ADC in the background
+    MonoTouchSystem::pauseSampling();
+
     // Disconnect AMUXBUSL
     CY_SET_REG8(CYDEV_ANAIF_RT_SAR0_SW3, CY_GET_REG8(CYDEV_ANAIF_RT_SAR0_SW3) & ~0x01);
 
@@ -47,5 +51,8 @@ uint16_t BatteryVoltage::mVoltage()
     // connect ADC to AMUXBUSL
     CY_SET_REG8(CYDEV_ANAIF_RT_SAR0_SW3, CY_GET_REG8(CYDEV_ANAIF_RT_SAR0_SW3) | 0x01);
 
-    return CorrectionScale/ADC_SAR_1_GetResult16() + CorrectionOffset; // scale from 12 bit ADC to mV
+    uint16_t reading = ADC_SAR_1_GetResult16();
+    MonoTouchSystem::resumeSampling();
+
+    return CorrectionScale/reading + CorrectionOffset; // scale from 12 bit ADC to mV
 }
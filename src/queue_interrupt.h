@@ -55,6 +55,7 @@ namespace mono {
         mbed::FunctionPointer _queue_rise, _queue_fall;
 
         void taskHandler();
+        const char *taskName() const { return "queue interrupt"; }
         void activateQueueTaskHandler();
         void deactivateQueueTaskHandler();
 
@@ -134,6 +134,21 @@ Rect Rect::crop(const mono::geo::Rect &other) const
     return Rect(x,y,w,h);
 }
 
+Rect Rect::unite(const mono::geo::Rect &other) const
+{
+    if (other.Width() <= 0 || other.Height() <= 0)
+        return *this;
+    if (this->Width() <= 0 || this->Height() <= 0)
+        return other;
+
+    int x = this->X() < other.X() ? this->X() : other.X();
+    int y = this->Y() < other.Y() ? this->Y() : other.Y();
+    int x2 = this->X2() > other.X2() ? this->X2() : other.X2();
+    int y2 = this->Y2() > other.Y2() ? this->Y2() : other.Y2();
+
+    return Rect(x, y, x2 - x, y2 - y);
+}
+
 mono::String Rect::ToString() const
 {
     return String::Format("Rect( %i, %i, %i, %i )",X(),Y(),Width(),Height());
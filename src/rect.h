@@ -115,6 +115,12 @@ namespace mono { namespace geo {
          */
         Rect crop(Rect const &other) const;
 
+        /**
+         * Return the smallest Rect that contains both this Rect and another.
+         * An empty rect (zero width or height) is ignored.
+         */
+        Rect unite(Rect const &other) const;
+
         int Area();
 
         /**
@@ -0,0 +1,36 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "ref_count.h"
+
+// stdlib.h is kept out of the header, its abs() overloads are ambiguous for
+// unsigned arguments in files that reach the header through mn_string.h
+#include <stdlib.h>
+#include <string.h>
+
+using namespace mono;
+
+uint8_t *RefCount::allocateBuffer(uint32_t size, RefCount **counter)
+{
+    uint32_t aligned = (size + 3) & ~3;
+    uint8_t *buffer = (uint8_t*) malloc(aligned + sizeof(RefCount));
+    if (buffer == NULL)
+    {
+        *counter = NULL;
+        return NULL;
+    }
+
+    memset(buffer, 0, aligned);
+    *counter = (RefCount*) (buffer + aligned);
+    (*counter)->count = 1;
+    return buffer;
+}
+
+bool RefCount::releaseBuffer(void *buffer, RefCount *counter)
+{
+    if (buffer == NULL || counter == NULL || !counter->release())
+        return false;
+
+    free(buffer);
+    return true;
+}
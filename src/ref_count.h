@@ -0,0 +1,80 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef mono_ref_count_h
+#define mono_ref_count_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace mono {
+
+    /**
+     * The reference count used by the framework's shared types: @ref String,
+     * @ref ManagedPointer and the wireless `DataReceiveBuffer`. The count is
+     * intrusive, it is stored in the same allocation as the data it counts.
+     * This means a shared object costs a single HEAP allocation, not two.
+     *
+     * For raw byte buffers, use @ref allocateBuffer to get a buffer with its
+     * count placed after the data.
+     *
+     * @brief Intrusive reference count, placed inside shared allocations
+     */
+    class RefCount
+    {
+    protected:
+
+        uint32_t count;
+
+    public:
+
+        RefCount(uint32_t initialCount = 1) : count(initialCount)
+        {}
+
+        /** @brief Add a reference */
+        void retain()
+        {
+            count++;
+        }
+
+        /**
+         * @brief Remove a reference
+         * @return `true` if this was the last reference, and the data must be freed
+         */
+        bool release()
+        {
+            if (count > 0)
+                count--;
+
+            return count == 0;
+        }
+
+        /** @brief The current number of references */
+        uint32_t References() const
+        {
+            return count;
+        }
+
+        /**
+         * @brief Allocate a zeroed byte buffer, with a reference count of 1
+         *
+         * The count is placed after the buffer data, word aligned, in the
+         * same allocation.
+         *
+         * @param size The number of data bytes
+         * @param counter Set to the reference count of the buffer
+         * @return The buffer, or `NULL` if the HEAP is full
+         */
+        static uint8_t *allocateBuffer(uint32_t size, RefCount **counter);
+
+        /**
+         * @brief Remove a reference to a buffer from @ref allocateBuffer
+         *
+         * The buffer is freed when the last reference is removed.
+         * @return `true` if the buffer was freed
+         */
+        static bool releaseBuffer(void *buffer, RefCount *counter);
+    };
+}
+
+#endif /* mono_ref_count_h */
@@ -0,0 +1,234 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "string_builder.h"
+#include <string.h>
+
+using namespace mono;
+
+static const char HexDigits[] = "0123456789abcdef";
+
+StringBuilder::StringBuilder(char *buf, uint32_t bufSize, OverflowPolicy pol)
+{
+    buffer = buf;
+    size = buf != 0 ? bufSize : 0;
+    policy = pol;
+    clear();
+}
+
+// MARK: Appending
+
+StringBuilder &StringBuilder::append(const char *str)
+{
+    if (str == 0)
+        return *this;
+
+    return write(str, strlen(str));
+}
+
+StringBuilder &StringBuilder::append(const String &str)
+{
+    return write(str.CString(), str.Length());
+}
+
+StringBuilder &StringBuilder::append(const StringSlice &str)
+{
+    return write(str.Data(), str.Length());
+}
+
+StringBuilder &StringBuilder::append(char c)
+{
+    return write(&c, 1);
+}
+
+StringBuilder &StringBuilder::appendInt(int32_t value, uint8_t minDigits)
+{
+    // negate as unsigned, such that INT32_MIN works
+    if (value < 0)
+        return appendDigits(0u - (uint32_t) value, minDigits, true);
+    else
+        return appendDigits((uint32_t) value, minDigits, false);
+}
+
+StringBuilder &StringBuilder::appendUInt(uint32_t value, uint8_t minDigits)
+{
+    return appendDigits(value, minDigits, false);
+}
+
+StringBuilder &StringBuilder::appendFixed(int32_t value, uint8_t decimals)
+{
+    if (decimals == 0)
+        return appendInt(value);
+
+    if (decimals > 9)
+        decimals = 9;
+
+    uint32_t scale = 1;
+    for (int i=0; i<decimals; i++)
+        scale *= 10;
+
+    bool negative = value < 0;
+    uint32_t magnitude = negative ? 0u - (uint32_t) value : (uint32_t) value;
+
+    // format into a temporary buffer, such that the number is one field
+    char tmp[24];
+    StringBuilder field(tmp, sizeof(tmp));
+    field.appendDigits(magnitude / scale, 1, negative);
+    field.append('.');
+    field.appendDigits(magnitude % scale, decimals, false);
+
+    return write(tmp, field.Length());
+}
+
+StringBuilder &StringBuilder::appendHex(uint32_t value, uint8_t minDigits)
+{
+    char tmp[8];
+    int pos = sizeof(tmp);
+
+    if (minDigits > sizeof(tmp))
+        minDigits = sizeof(tmp);
+
+    do {
+        tmp[--pos] = HexDigits[value & 0xF];
+        value >>= 4;
+    } while (value != 0 || (int) sizeof(tmp) - pos < minDigits);
+
+    return write(tmp + pos, sizeof(tmp) - pos);
+}
+
+StringBuilder &StringBuilder::appendIpv4(const uint8_t *address)
+{
+    char tmp[16];
+    StringBuilder field(tmp, sizeof(tmp));
+    for (int i=0; i<4; i++)
+    {
+        if (i > 0)
+            field.append('.');
+        field.appendUInt(address[i]);
+    }
+
+    return write(tmp, field.Length());
+}
+
+StringBuilder &StringBuilder::appendIpv6(const uint8_t *address)
+{
+    char tmp[40];
+    StringBuilder field(tmp, sizeof(tmp));
+    for (int i=0; i<16; i+=2)
+    {
+        if (i > 0)
+            field.append(':');
+        field.appendHex((address[i] << 8) | address[i+1]);
+    }
+
+    return write(tmp, field.Length());
+}
+
+StringBuilder &StringBuilder::appendDate(uint16_t year, uint8_t month, uint8_t day)
+{
+    char tmp[16];
+    StringBuilder field(tmp, sizeof(tmp));
+    field.appendUInt(year, 4).append('-').appendUInt(month, 2).append('-').appendUInt(day, 2);
+
+    return write(tmp, field.Length());
+}
+
+StringBuilder &StringBuilder::appendTime(uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+    char tmp[12];
+    StringBuilder field(tmp, sizeof(tmp));
+    field.appendUInt(hours, 2).append(':').appendUInt(minutes, 2).append(':').appendUInt(seconds, 2);
+
+    return write(tmp, field.Length());
+}
+
+void StringBuilder::clear()
+{
+    length = 0;
+    overflowed = false;
+
+    if (size > 0)
+        buffer[0] = '\0';
+}
+
+// MARK: Getters
+
+uint32_t StringBuilder::Length() const
+{
+    return length;
+}
+
+uint32_t StringBuilder::Capacity() const
+{
+    return size > 0 ? size - 1 : 0;
+}
+
+bool StringBuilder::Overflowed() const
+{
+    return overflowed;
+}
+
+const char *StringBuilder::CString() const
+{
+    return size > 0 ? buffer : "";
+}
+
+StringSlice StringBuilder::slice() const
+{
+    return StringSlice(CString(), length);
+}
+
+String StringBuilder::toString() const
+{
+    return String((char*) CString(), length);
+}
+
+// MARK: Protected
+
+StringBuilder &StringBuilder::write(const char *data, uint32_t count)
+{
+    // no buffer, or no room for the terminator
+    if (size == 0)
+    {
+        if (count > 0)
+            overflowed = true;
+
+        return *this;
+    }
+
+    uint32_t available = Capacity() - length;
+    if (count > available)
+    {
+        overflowed = true;
+        if (policy == DISCARD_ON_OVERFLOW)
+            return *this;
+
+        count = available;
+    }
+
+    memcpy(buffer + length, data, count);
+    length += count;
+    buffer[length] = '\0';
+
+    return *this;
+}
+
+StringBuilder &StringBuilder::appendDigits(uint32_t value, uint8_t minDigits, bool negative)
+{
+    // 10 digits for 2^32 and a sign
+    char tmp[11];
+    int pos = sizeof(tmp);
+
+    if (minDigits > 10)
+        minDigits = 10;
+
+    do {
+        tmp[--pos] = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0 || (int) sizeof(tmp) - pos < minDigits);
+
+    if (negative)
+        tmp[--pos] = '-';
+
+    return write(tmp + pos, sizeof(tmp) - pos);
+}
@@ -0,0 +1,177 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef string_builder_h
+#define string_builder_h
+
+#include <stdint.h>
+#include "mn_string.h"
+
+namespace mono {
+
+    /**
+     * @brief Format text into a fixed buffer, without using the HEAP
+     *
+     * The string builder appends text, integers, fixed-point numbers, hex
+     * values, IP addresses and date/time fields into a buffer you provide. It
+     * formats in a single pass and does not use the C library `printf`
+     * functions, that are large in flash and slow on floating point values.
+     *
+     * The buffer is always NULL terminated. When an append does not fit, the
+     * builder follows its @ref OverflowPolicy and remembers that an overflow
+     * occurred, see @ref Overflowed.
+     *
+     * Use @ref StackStringBuilder to have the buffer on the stack:
+     *
+     * @code
+     * StackStringBuilder<32> line;
+     * line.append("Temp: ").appendFixed(2253, 2).append(" C");
+     * // line.CString() is "Temp: 22.53 C"
+     * @endcode
+     *
+     * If you need a @ref String, @ref toString copies the result. Results up
+     * to @ref String::InlineCapacity characters still do not use the HEAP.
+     */
+    class StringBuilder
+    {
+    public:
+
+        /** @brief What to do with an append that does not fit the buffer */
+        enum OverflowPolicy
+        {
+            TRUNCATE_ON_OVERFLOW,   /**< Append the characters that fit */
+            DISCARD_ON_OVERFLOW     /**< Append nothing, keep whole fields only */
+        };
+
+    protected:
+
+        char *buffer;
+        uint32_t size;
+        uint32_t length;
+        OverflowPolicy policy;
+        bool overflowed;
+
+        StringBuilder &write(const char *data, uint32_t count);
+        StringBuilder &appendDigits(uint32_t value, uint8_t minDigits, bool negative);
+
+        StringBuilder(const StringBuilder &);
+        StringBuilder &operator=(const StringBuilder &);
+
+    public:
+
+        /**
+         * @brief Create a builder that writes into a buffer you provide
+         *
+         * @param buffer The buffer to write into
+         * @param size The size of the buffer in bytes, including the NULL terminator
+         * @param policy How to handle appends that do not fit
+         */
+        StringBuilder(char *buffer, uint32_t size, OverflowPolicy policy = TRUNCATE_ON_OVERFLOW);
+
+        /** @brief Append a NULL terminated C string */
+        StringBuilder &append(const char *str);
+
+        /** @brief Append a mono string */
+        StringBuilder &append(const String &str);
+
+        /** @brief Append a string slice */
+        StringBuilder &append(const StringSlice &str);
+
+        /** @brief Append a single character */
+        StringBuilder &append(char c);
+
+        /**
+         * @brief Append a signed integer in decimal
+         * @param value The integer
+         * @param minDigits Pad with leading zeros up to this number of digits
+         */
+        StringBuilder &appendInt(int32_t value, uint8_t minDigits = 1);
+
+        /**
+         * @brief Append an unsigned integer in decimal
+         * @param value The integer
+         * @param minDigits Pad with leading zeros up to this number of digits
+         */
+        StringBuilder &appendUInt(uint32_t value, uint8_t minDigits = 1);
+
+        /**
+         * @brief Append a fixed-point number
+         *
+         * The value is an integer scaled by 10 to the power of `decimals`. For
+         * example `appendFixed(-2253, 2)` appends `-22.53`.
+         *
+         * @param value The scaled value
+         * @param decimals The number of decimal digits in the value
+         */
+        StringBuilder &appendFixed(int32_t value, uint8_t decimals);
+
+        /**
+         * @brief Append an unsigned integer in lower case hexadecimal
+         * @param value The integer
+         * @param minDigits Pad with leading zeros up to this number of digits
+         */
+        StringBuilder &appendHex(uint32_t value, uint8_t minDigits = 1);
+
+        /**
+         * @brief Append an IPv4 address in dotted decimal, like `192.168.1.1`
+         * @param address The 4 address bytes, most significant first
+         */
+        StringBuilder &appendIpv4(const uint8_t *address);
+
+        /**
+         * @brief Append an IPv6 address as 8 hex groups, like `fe80:0:0:0:1:2:3:4`
+         *
+         * The address is not compressed with `::`.
+         * @param address The 16 address bytes, most significant first
+         */
+        StringBuilder &appendIpv6(const uint8_t *address);
+
+        /** @brief Append a date as `YYYY-MM-DD` */
+        StringBuilder &appendDate(uint16_t year, uint8_t month, uint8_t day);
+
+        /** @brief Append a time of day as `HH:MM:SS` */
+        StringBuilder &appendTime(uint8_t hours, uint8_t minutes, uint8_t seconds);
+
+        /** @brief Empty the buffer and reset the overflow flag */
+        void clear();
+
+        /** @brief The number of characters in the buffer */
+        uint32_t Length() const;
+
+        /** @brief The maximum number of characters the buffer can hold */
+        uint32_t Capacity() const;
+
+        /** @brief `true` if any append did not fit, since creation or @ref clear */
+        bool Overflowed() const;
+
+        /** @brief The NULL terminated buffer content */
+        const char *CString() const;
+
+        /** @brief A slice of the buffer content, without copying */
+        StringSlice slice() const;
+
+        /** @brief Copy the buffer content into a mono string */
+        String toString() const;
+    };
+
+    /**
+     * @brief A @ref StringBuilder with its buffer inside the object
+     *
+     * Declare it as a local variable to format on the stack.
+     * @tparam Size The buffer size in bytes, including the NULL terminator
+     */
+    template <uint32_t Size>
+    class StackStringBuilder : public StringBuilder
+    {
+    protected:
+        char storage[Size];
+
+    public:
+        StackStringBuilder(OverflowPolicy policy = TRUNCATE_ON_OVERFLOW) :
+            StringBuilder(storage, Size, policy)
+        {
+        }
+    };
+}
+
+#endif /* string_builder_h */
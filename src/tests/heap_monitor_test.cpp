@@ -0,0 +1,74 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+#include "../heap_monitor.h"
+#include "../queue.h"
+#include <stdlib.h>
+
+using namespace mono;
+
+class Item : public IQueueItem
+{
+public:
+    int n;
+
+    Item(int num)
+    {
+        n = num;
+    }
+};
+
+SCENARIO("The heap monitor counts allocations", "[heap_monitor]")
+{
+    GIVEN("a checkpoint")
+    {
+        HeapCheckpoint checkpoint;
+
+        WHEN("a block is allocated")
+        {
+            void *block = malloc(64);
+
+            THEN("the monitor is active")
+            {
+                REQUIRE(HeapMonitor::IsActive());
+            }
+
+            THEN("the checkpoint counts one allocation of its size")
+            {
+                REQUIRE(checkpoint.Allocations() == 1);
+                REQUIRE(checkpoint.BytesDelta() == 64);
+            }
+
+            free(block);
+        }
+
+        WHEN("a block is allocated and freed")
+        {
+            free(malloc(32));
+
+            THEN("no bytes are in use since the checkpoint")
+            {
+                REQUIRE(checkpoint.Allocations() == 1);
+                REQUIRE(checkpoint.BytesDelta() == 0);
+            }
+        }
+
+        WHEN("items on the stack are queued and dequeued")
+        {
+            Item a(1), b(2);
+            GenericQueue<Item> queue;
+            queue.enqueue(&a);
+            queue.enqueue(&b);
+            Item *first = queue.dequeue();
+            queue.dequeue();
+
+            THEN("the queue does not allocate")
+            {
+                REQUIRE(first == &a);
+                REQUIRE(checkpoint.Allocations() == 0);
+                REQUIRE(checkpoint.BytesDelta() == 0);
+            }
+        }
+    }
+}
@@ -59,6 +59,9 @@ namespace mono {
                 linePtr = 0;
                 looped = true;
             }
+            
+            // the new line reuses the oldest line, remove its old text
+            memset(buffer[linePtr], 0, lineLength);
         }
         
         //Getters
@@ -89,7 +92,7 @@ namespace mono {
         int OldestLinePosition() const
         {
             if (looped)
-                return LinePosition()+1 % lineCount;
+                return (LinePosition()+1) % lineCount;
             else
                 return 0;
         }
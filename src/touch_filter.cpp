@@ -0,0 +1,182 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "touch_filter.h"
+
+#ifndef EMUNO
+#include <cmsis.h>
+#endif
+
+using namespace mono;
+
+const uint32_t TouchFilter::Capacity;
+const int TouchFilter::PressSamples;
+const int TouchFilter::ReleaseSamples;
+const int TouchFilter::IirShift;
+const uint32_t TouchFilter::MoveThreshold;
+
+TouchFilter::TouchFilter()
+{
+    reset();
+}
+
+void TouchFilter::reset()
+{
+    windowCount = 0;
+    filteredX = filteredY = 0;
+    publishedX = publishedY = 0;
+    pressedCount = releasedCount = 0;
+    touching = false;
+    head = tail = 0;
+    dropped = 0;
+}
+
+uint16_t TouchFilter::median(const uint16_t *window, int count)
+{
+    // the window holds the newest sample first
+    if (count < 3)
+        return window[0];
+
+    uint16_t a = window[0], b = window[1], c = window[2];
+    if (a > b)
+    {
+        uint16_t t = a; a = b; b = t;
+    }
+
+    // a <= b, the median is b clamped to [a, c]
+    if (b > c)
+        b = a > c ? a : c;
+
+    return b;
+}
+
+void TouchFilter::append(uint16_t x, uint16_t y, bool pressed, uint32_t time)
+{
+    if (!pressed)
+    {
+        pressedCount = 0;
+        windowCount = 0;
+
+        if (touching && ++releasedCount >= ReleaseSamples)
+        {
+            touching = false;
+            publish(TouchEvent::TOUCH_END, time);
+        }
+
+        return;
+    }
+
+    releasedCount = 0;
+
+    windowX[2] = windowX[1]; windowX[1] = windowX[0]; windowX[0] = x;
+    windowY[2] = windowY[1]; windowY[1] = windowY[0]; windowY[0] = y;
+    if (windowCount < 3)
+        windowCount++;
+
+    int32_t medianX = median(windowX, windowCount);
+    int32_t medianY = median(windowY, windowCount);
+
+    if (!touching)
+    {
+        // the panel voltage settles over the first samples of a touch
+        if (++pressedCount < PressSamples)
+            return;
+
+        touching = true;
+        filteredX = medianX;
+        filteredY = medianY;
+        publishedX = medianX;
+        publishedY = medianY;
+        publish(TouchEvent::TOUCH_BEGIN, time);
+        return;
+    }
+
+    filteredX += (medianX - filteredX) >> IirShift;
+    filteredY += (medianY - filteredY) >> IirShift;
+
+    int32_t dx = filteredX - publishedX;
+    int32_t dy = filteredY - publishedY;
+    if ((uint32_t) (dx*dx + dy*dy) <= MoveThreshold)
+        return;
+
+    // keep the last slot for the touch end
+    if (tail - head >= Capacity - 1)
+    {
+        dropped++;
+        return;
+    }
+
+    publishedX = filteredX;
+    publishedY = filteredY;
+    publish(TouchEvent::TOUCH_MOVE, time);
+}
+
+void TouchFilter::publish(TouchEvent::TouchEventType type, uint32_t time)
+{
+    if (tail - head >= Capacity)
+    {
+        dropped++;
+        return;
+    }
+
+    Event &event = ring[tail % Capacity];
+    event.type = type;
+    event.x = publishedX;
+    event.y = publishedY;
+    event.time = time;
+    tail++;
+}
+
+bool TouchFilter::next(Event &event)
+{
+    uint32_t state = enterCritical();
+
+    if (head == tail)
+    {
+        exitCritical(state);
+        return false;
+    }
+
+    event = ring[head % Capacity];
+    head++;
+
+    exitCritical(state);
+    return true;
+}
+
+bool TouchFilter::IsTouching() const
+{
+    return touching;
+}
+
+uint32_t TouchFilter::Pending() const
+{
+    return tail - head;
+}
+
+uint32_t TouchFilter::Dropped() const
+{
+    return dropped;
+}
+
+// MARK: Critical sections
+
+uint32_t TouchFilter::enterCritical()
+{
+#ifndef EMUNO
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+#else
+    return 0;
+#endif
+}
+
+void TouchFilter::exitCritical(uint32_t state)
+{
+#ifndef EMUNO
+    __set_PRIMASK(state);
+#else
+    (void) state;
+#endif
+}
@@ -0,0 +1,118 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef touch_filter_h
+#define touch_filter_h
+
+#include <stdint.h>
+#include "touch_event.h"
+
+namespace mono {
+
+    /**
+     * @brief Filters raw touch panel samples into touch events
+     *
+     * The touch system samples the panel in the background, from a timer
+     * interrupt, and appends each sample to this filter. The filter removes
+     * noise and detects touch begin, move and end. The events are queued in
+     * a ring, that the run loop reads with @ref next.
+     *
+     * Filtering has two stages: a median of the last 3 samples removes
+     * single sample spikes, then a first order IIR low pass smooths the
+     * position. A touch begins after @ref PressSamples pressed samples
+     * in a row, and ends after @ref ReleaseSamples released samples, so a
+     * single noisy sample does not end or start a touch.
+     *
+     * Move events are only queued when the position has moved more than
+     * @ref MoveThreshold, and when the ring has room to spare. The last slot
+     * is kept for the touch end, so a full ring drops moves, never the end.
+     *
+     * Positions are in raw touch panel units, not screen pixels.
+     */
+    class TouchFilter
+    {
+    public:
+
+        /** The number of events the ring can hold */
+        static const uint32_t Capacity = 8;
+
+        /** Pressed samples in a row, before a touch begins */
+        static const int PressSamples = 2;
+
+        /** Released samples in a row, before a touch ends */
+        static const int ReleaseSamples = 2;
+
+        /** The IIR filter moves 1/2^IirShift towards each new sample */
+        static const int IirShift = 1;
+
+        /** The squared distance (raw units) a touch must move, approx 3 pixels */
+        static const uint32_t MoveThreshold = 2304;
+
+        /** @brief A filtered touch event */
+        struct Event
+        {
+            TouchEvent::TouchEventType type;
+            uint16_t x, y;
+            uint32_t time;
+        };
+
+    protected:
+
+        uint16_t windowX[3], windowY[3];
+        int windowCount;
+        int32_t filteredX, filteredY;
+        uint16_t publishedX, publishedY;
+        int pressedCount, releasedCount;
+        bool touching;
+
+        Event ring[Capacity];
+        volatile uint32_t head, tail;
+        uint32_t dropped;
+
+        static uint16_t median(const uint16_t *window, int count);
+
+        void publish(TouchEvent::TouchEventType type, uint32_t time);
+
+        static uint32_t enterCritical();
+        static void exitCritical(uint32_t state);
+
+    public:
+
+        TouchFilter();
+
+        /**
+         * @brief Append a raw sample, from the sampling interrupt
+         *
+         * @param x The raw X position
+         * @param y The raw Y position
+         * @param pressed `true` if the panel is touched
+         * @param time The sample time, from `us_ticker_read`
+         */
+        void append(uint16_t x, uint16_t y, bool pressed, uint32_t time);
+
+        /**
+         * @brief Get the next queued event, from the run loop
+         * @return `false` if there are no events
+         */
+        bool next(Event &event);
+
+        /**
+         * @brief Forget any touch in progress and all queued events
+         *
+         * Do not call this while the sampling interrupt runs.
+         */
+        void reset();
+
+        /** @brief `true` if a touch is in progress */
+        bool IsTouching() const;
+
+        /** @brief The number of queued events */
+        uint32_t Pending() const;
+
+        /** @brief The number of move events dropped, because the ring was full */
+        uint32_t Dropped() const;
+    };
+
+}
+
+#endif /* touch_filter_h */
@@ -3,7 +3,6 @@
 
 #include "touch_responder.h"
 #include <stdio.h>
-#include "consoles.h"
 #include <deprecated.h>
 
 #include <mbed_debug.h>
@@ -73,7 +72,7 @@ void TouchResponder::runResponderChainTouchBegin(mono::TouchEvent &event)
 {
     if (ResponderChain.peek() == NULL)
     {
-        defaultSerial.printf("No first touch responder!\r\n");
+        debug("No first touch responder!\r\n");
         return;
     }
 
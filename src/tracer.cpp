@@ -0,0 +1,129 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "tracer.h"
+
+using namespace mono;
+
+const uint32_t Tracer::DefaultCapacity;
+
+Tracer::Tracer(Event *buffer, uint32_t cap)
+{
+    events = buffer;
+    capacity = cap;
+    head = 0;
+    paused = false;
+}
+
+Tracer &Tracer::Default()
+{
+    static Event buffer[DefaultCapacity];
+    static Tracer tracer(buffer, DefaultCapacity);
+    return tracer;
+}
+
+// MARK: Recording
+
+void Tracer::record(uint8_t type, const char *name, int32_t value, uint32_t time)
+{
+    if (paused)
+        return;
+
+    // claim a slot atomically, so interrupts can record while we write
+    uint32_t slot = __sync_fetch_and_add(&head, 1) % capacity;
+
+    Event &event = events[slot];
+    event.name = name;
+    event.time = time;
+    event.value = value;
+    event.type = type;
+}
+
+void Tracer::begin(const char *name, uint32_t now)
+{
+    record(SPAN_BEGIN, name, 0, now);
+}
+
+void Tracer::end(const char *name, uint32_t now)
+{
+    record(SPAN_END, name, 0, now);
+}
+
+void Tracer::counter(const char *name, int32_t value, uint32_t now)
+{
+    record(COUNTER, name, value, now);
+}
+
+void Tracer::setPaused(bool pause)
+{
+    paused = pause;
+}
+
+void Tracer::clear()
+{
+    head = 0;
+}
+
+// MARK: Reading
+
+uint32_t Tracer::Count() const
+{
+    return head < capacity ? head : capacity;
+}
+
+uint32_t Tracer::Overwritten() const
+{
+    return head > capacity ? head - capacity : 0;
+}
+
+const Tracer::Event &Tracer::EventAt(uint32_t index) const
+{
+    uint32_t oldest = head > capacity ? head - capacity : 0;
+    return events[(oldest + index) % capacity];
+}
+
+// MARK: Chrome trace export
+
+void Tracer::writeJsonString(FILE *out, const char *str)
+{
+    fputc('"', out);
+    for (const char *c = str; c != 0 && *c != 0; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            fputc('\\', out);
+
+        if ((uint8_t) *c >= 0x20)
+            fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+void Tracer::exportChromeTrace(FILE *out)
+{
+    bool wasPaused = paused;
+    paused = true;
+
+    static const char phases[] = { 'B', 'E', 'C' };
+    uint32_t count = Count();
+    uint32_t base = count > 0 ? EventAt(0).time : 0;
+
+    fprintf(out, "{\"traceEvents\":[");
+    for (uint32_t i=0; i<count; i++)
+    {
+        const Event &event = EventAt(i);
+        char phase = event.type <= COUNTER ? phases[event.type] : 'i';
+
+        fprintf(out, i == 0 ? "\r\n{\"name\":" : ",\r\n{\"name\":");
+        writeJsonString(out, event.name);
+        fprintf(out, ",\"ph\":\"%c\",\"ts\":%u,\"pid\":1,\"tid\":1",
+                phase, (unsigned) (event.time - base));
+
+        if (event.type == COUNTER)
+            fprintf(out, ",\"args\":{\"value\":%d}", (int) event.value);
+
+        fputc('}', out);
+    }
+    fprintf(out, "\r\n],\"otherData\":{\"overwritten\":%u}}\r\n", (unsigned) Overwritten());
+
+    paused = wasPaused;
+}
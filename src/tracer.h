@@ -0,0 +1,179 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef tracer_h
+#define tracer_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace mono {
+
+    /**
+     * @brief Ring buffer of time stamped trace events, for finding slow code
+     *
+     * The tracer records the begin and end of spans, and counter values, in
+     * a ring of fixed size. When the ring is full the oldest events are
+     * overwritten, so it always holds the most recent history. Recording an
+     * event does not disable interrupts or allocate memory, and it is safe to
+     * record from interrupt routines.
+     *
+     * You should use the `MONO_TRACE_` macros, not the tracer directly. They
+     * record to @ref Default and are removed at compile time, unless
+     * `MONO_TRACE` is defined. Build the framework with `make TRACE=1` to get
+     * spans around run loop tasks, view repaints and module frame commits.
+     *
+     * @code
+     * void MyView::repaint()
+     * {
+     *     MONO_TRACE_SCOPE("MyView::repaint");
+     *     MONO_TRACE_COUNTER("samples", sampleCount);
+     *     // ...
+     * }
+     * @endcode
+     *
+     * Use @ref exportChromeTrace to write the events as JSON, to the serial
+     * port or a file on the SD card. Open the file in Chrome at
+     * `chrome://tracing` to see the spans on a time line.
+     *
+     * Event names must be string literals (or other strings that are never
+     * freed), only the pointer is stored.
+     */
+    class Tracer
+    {
+    public:
+
+        /** @brief The kind of a trace event */
+        enum EventType
+        {
+            SPAN_BEGIN,
+            SPAN_END,
+            COUNTER
+        };
+
+        /** @brief A recorded event */
+        struct Event
+        {
+            const char *name;
+            uint32_t time;      /**< `us_ticker_read` time stamp */
+            int32_t value;      /**< Counter value, 0 for spans */
+            uint8_t type;       /**< The @ref EventType */
+        };
+
+        /** The number of events in the @ref Default tracer */
+        static const uint32_t DefaultCapacity = 128;
+
+    protected:
+
+        Event *events;
+        uint32_t capacity;
+        volatile uint32_t head;
+        volatile bool paused;
+
+        void record(uint8_t type, const char *name, int32_t value, uint32_t time);
+        static void writeJsonString(FILE *out, const char *str);
+
+        Tracer(const Tracer &);
+        Tracer &operator=(const Tracer &);
+
+    public:
+
+        /**
+         * @brief Create a tracer that records into a buffer you provide
+         *
+         * @param buffer Array of events
+         * @param capacity The number of events in the array
+         */
+        Tracer(Event *buffer, uint32_t capacity);
+
+        /** @brief The tracer used by the `MONO_TRACE_` macros */
+        static Tracer &Default();
+
+        /** @brief Record the start of a span */
+        void begin(const char *name, uint32_t now);
+
+        /** @brief Record the end of a span, started with the same name */
+        void end(const char *name, uint32_t now);
+
+        /** @brief Record the value of a counter */
+        void counter(const char *name, int32_t value, uint32_t now);
+
+        /** @brief Stop or resume recording, events are dropped while paused */
+        void setPaused(bool pause);
+
+        /** @brief Remove all events */
+        void clear();
+
+        /** @brief The number of events in the ring */
+        uint32_t Count() const;
+
+        /** @brief The number of events that were overwritten by newer events */
+        uint32_t Overwritten() const;
+
+        /**
+         * @brief Get a recorded event
+         * @param index 0 is the oldest event, `Count()-1` the newest
+         */
+        const Event &EventAt(uint32_t index) const;
+
+        /**
+         * @brief Write the events in Chrome trace JSON format
+         *
+         * Recording is paused while exporting. Time stamps are written
+         * relative to the oldest event.
+         *
+         * @param out The stream to write to, `stdout` for the serial port or
+         * an open file
+         */
+        void exportChromeTrace(FILE *out);
+    };
+
+}
+
+#define MONO_TRACE_CONCAT2(a, b) a ## b
+#define MONO_TRACE_CONCAT(a, b) MONO_TRACE_CONCAT2(a, b)
+
+#ifdef MONO_TRACE
+
+#include <us_ticker_api.h>
+
+namespace mono {
+
+    /** @brief Records a span from construction to destruction, use @ref MONO_TRACE_SCOPE */
+    class TraceScope
+    {
+        const char *name;
+
+    public:
+        TraceScope(const char *spanName) : name(spanName)
+        {
+            Tracer::Default().begin(name, us_ticker_read());
+        }
+
+        ~TraceScope()
+        {
+            Tracer::Default().end(name, us_ticker_read());
+        }
+    };
+}
+
+/** Record the start of a span */
+#define MONO_TRACE_BEGIN(name) mono::Tracer::Default().begin(name, us_ticker_read())
+/** Record the end of a span */
+#define MONO_TRACE_END(name) mono::Tracer::Default().end(name, us_ticker_read())
+/** Record a counter value */
+#define MONO_TRACE_COUNTER(name, value) mono::Tracer::Default().counter(name, value, us_ticker_read())
+/** Record a span until the end of the current scope */
+#define MONO_TRACE_SCOPE(name) mono::TraceScope MONO_TRACE_CONCAT(monoTraceScope, __LINE__)(name)
+
+#else
+
+// the name is not evaluated, but a variable given as name counts as used
+#define MONO_TRACE_BEGIN(name) do { (void) sizeof(name); } while (0)
+#define MONO_TRACE_END(name) do { (void) sizeof(name); } while (0)
+#define MONO_TRACE_COUNTER(name, value) do {} while (0)
+#define MONO_TRACE_SCOPE(name) do {} while (0)
+
+#endif /* MONO_TRACE */
+
+#endif /* tracer_h */
@@ -0,0 +1,54 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+//
+// The application context and clock, that normally come from the device.
+
+#include "host_context.h"
+#include <async.h>
+
+using namespace mono;
+
+IApplicationContext *IApplicationContext::Instance = 0;
+
+static uint32_t hostTime = 0;
+
+// The static View painter reads the display controller from
+// IApplicationContext::Instance, so the context is created before any other
+// static object, whatever order the sources are linked in.
+static struct HostContextSetup
+{
+    HostContextSetup() { HostContext::Default(); }
+} setup __attribute__((init_priority(101)));
+
+extern "C" uint32_t us_ticker_read()
+{
+    return hostTime;
+}
+
+bool mono::asyncCall(const mbed::FunctionPointer &handler, const void *owner, uint32_t delayMs)
+{
+    if (delayMs == 0)
+        return HostContext::Default().DeferredCalls.post(handler, owner, hostTime);
+
+    return HostContext::Default().DeferredCalls.postDelayed(handler, owner, delayMs*1000, hostTime);
+}
+
+int mono::cancelAsync(const void *owner)
+{
+    return HostContext::Default().DeferredCalls.cancel(owner);
+}
+
+HostContext::HostContext() : IApplicationContext(0, 0, &display, 0, 0)
+{
+}
+
+HostContext &HostContext::Default()
+{
+    static HostContext context;
+    return context;
+}
+
+void HostContext::setTime(uint32_t us)
+{
+    hostTime = us;
+}
@@ -0,0 +1,51 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#ifndef host_context_h
+#define host_context_h
+
+#include <application_context_interface.h>
+#include <deferred_call_queue.h>
+#include "../../display/headless/headless_display_controller.h"
+
+/**
+ * @brief The application context of the unit tests and benchmarks
+ *
+ * The views paint on a @ref HeadlessDisplayController, so tests can read
+ * back the pixels and count the bus transfers. The time read by
+ * `us_ticker_read` is set by the tests.
+ *
+ * There is no run loop. Calls made with `mono::asyncCall` are queued in
+ * @ref DeferredCalls, and run when a test processes the queue.
+ */
+class HostContext : public mono::IApplicationContext
+{
+protected:
+
+    void enterSleepMode() {}
+    void sleepForMs(uint32_t) {}
+    void resetOnUserButton() {}
+    void _softwareReset() {}
+    void _softwareResetToApplication() {}
+    void _softwareResetToBootloader() {}
+
+public:
+
+    mono::display::HeadlessDisplayController display;
+
+    /** The calls queued by `mono::asyncCall` */
+    mono::DeferredCallQueue DeferredCalls;
+
+    HostContext();
+
+    int exec() { return 0; }
+    void setMonoApplication(mono::IApplication *) {}
+
+    /** @brief The context of the tests */
+    static HostContext &Default();
+
+    /** @brief Set the time returned by `us_ticker_read` */
+    static void setTime(uint32_t us);
+};
+
+#endif /* host_context_h */
@@ -0,0 +1,175 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "host_context.h"
+#include "../display/ui/animation.h"
+#include "../display/ui/frame_scheduler.h"
+
+using namespace mono;
+using namespace mono::ui;
+using namespace mono::display;
+
+static const Color eraseColor(0, 0, 128), backColor(200, 0, 0), boxColor(255, 255, 255);
+
+// a filled rect, that counts its repaints
+class BoxView : public View
+{
+public:
+    Color color;
+    int paints;
+
+    BoxView(geo::Rect rect, Color col) : View(rect), color(col), paints(0) {}
+
+    void repaint()
+    {
+        painter.setForegroundColor(color);
+        painter.drawFillRect(viewRect);
+        paints++;
+    }
+
+    /** Paint the dirty views, like a display refresh */
+    static void refresh()
+    {
+        repaintScheduledViews();
+    }
+};
+
+class CompletionCounter
+{
+public:
+    int count;
+
+    CompletionCounter() : count(0) {}
+    void completed() { count++; }
+};
+
+TEST_CASE("Animation", "[animation]")
+{
+    HeadlessDisplayController &display = HostContext::Default().display;
+    AnimationEngine &engine = AnimationEngine::Default();
+    engine.setEraseColor(eraseColor);
+    display.clear(eraseColor);
+    HostContext::setTime(1000000);
+
+    BoxView box(geo::Rect(10, 10, 20, 20), boxColor);
+    Animation move(&box, 100, Easing::LINEAR);
+    move.setDestination(geo::Point(50, 10));
+
+    SECTION("steps the view over its duration, from the first refresh")
+    {
+        CompletionCounter counter;
+        move.setCompletionCallback(&counter, &CompletionCounter::completed);
+        box.show();
+        move.start();
+        REQUIRE(engine.IsActive());
+
+        engine.tick(1000000);
+        REQUIRE(box.ViewRect().X() == 10);
+
+        engine.tick(1050000);
+        REQUIRE(box.ViewRect().X() == 30);
+        REQUIRE(box.ViewRect().Width() == 20);
+        REQUIRE(move.IsRunning());
+        REQUIRE(counter.count == 0);
+
+        engine.tick(1200000);
+        REQUIRE(box.ViewRect().X() == 50);
+        REQUIRE_FALSE(move.IsRunning());
+        REQUIRE_FALSE(engine.IsActive());
+        REQUIRE(counter.count == 1);
+    }
+
+    SECTION("damage is the union of the old and new rects")
+    {
+        box.show();
+        move.start();
+        engine.tick(1000000);
+        REQUIRE(engine.Damage().Width() == 0);
+
+        engine.tick(1025000);
+        REQUIRE(box.ViewRect().X() == 20);
+        const geo::Rect &damage = engine.Damage();
+        REQUIRE(damage.X() == 10);
+        REQUIRE(damage.Y() == 10);
+        REQUIRE(damage.Width() == 30);
+        REQUIRE(damage.Height() == 20);
+        move.stop();
+    }
+
+    SECTION("erases the uncovered part of the old rect, and paints the view")
+    {
+        box.show();
+        BoxView::refresh();
+        REQUIRE(display.pixel(15, 15) == boxColor.value);
+
+        move.start();
+        engine.tick(1000000);
+        engine.tick(1050000);
+
+        REQUIRE(display.pixel(15, 15) == eraseColor.value);
+        REQUIRE(display.pixel(35, 15) == boxColor.value);
+        REQUIRE(display.pixel(45, 15) == boxColor.value);
+        move.stop();
+    }
+
+    SECTION("repaints the views under the damage in the same tick, below the animated view")
+    {
+        BoxView back(geo::Rect(0, 0, 40, 40), backColor);
+        BoxView away(geo::Rect(100, 100, 20, 20), backColor);
+        back.show();
+        away.show();
+        box.show();
+        BoxView::refresh();
+        REQUIRE(back.paints == 1);
+        REQUIRE(away.paints == 1);
+        REQUIRE(box.paints == 1);
+
+        move.start();
+        engine.tick(1000000);
+        engine.tick(1050000);
+
+        // the animated view is painted on each tick, the views below it when it moves
+        REQUIRE(back.paints == 2);
+        REQUIRE(away.paints == 1);
+        REQUIRE(box.paints == 3);
+        REQUIRE(display.pixel(15, 15) == backColor.value);
+        REQUIRE(display.pixel(35, 15) == boxColor.value);
+        REQUIRE(display.pixel(45, 15) == boxColor.value);
+
+        // a refresh without movement leaves the views below alone
+        HostContext::setTime(1050000);
+        BoxView::refresh();
+        REQUIRE(back.paints == 2);
+        move.stop();
+    }
+
+    SECTION("the animation frame is painted even when the budget is spent")
+    {
+        BoxView back(geo::Rect(0, 0, 40, 40), backColor);
+        BoxView other(geo::Rect(100, 100, 20, 20), backColor);
+        back.show();
+        box.show();
+        BoxView::refresh();
+        other.show();
+
+        move.start();
+        engine.tick(1000000);
+
+        // the refresh starts after the budget of the frame
+        display.LastTearningEffectTime = 1035000;
+        HostContext::setTime(1050000);
+        BoxView::refresh();
+
+        REQUIRE(back.paints == 2);
+        REQUIRE(box.paints == 3);
+        REQUIRE(other.paints == 0);
+        REQUIRE(display.pixel(15, 15) == backColor.value);
+
+        display.LastTearningEffectTime = 0;
+        BoxView::refresh();
+        REQUIRE(other.paints == 1);
+        move.stop();
+    }
+}
@@ -0,0 +1,61 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+#include "catch.hpp"
+#include "../block_pool.h"
+
+using namespace mono;
+
+TEST_CASE("Block pool")
+{
+    BlockPool pool(20, 3);
+
+    SECTION("blocks are 8 byte aligned and distinct")
+    {
+        void *a = pool.allocate(20), *b = pool.allocate(1);
+        REQUIRE( pool.BlockSize() == 24 );
+        REQUIRE( a != b );
+        REQUIRE( ((uintptr_t) a) % 8 == 0 );
+        REQUIRE( pool.owns(a) );
+        REQUIRE( pool.BlocksInUse() == 2 );
+    }
+    SECTION("exhaustion and reuse")
+    {
+        void *a = pool.allocate(8);
+        pool.allocate(8);
+        pool.allocate(8);
+        REQUIRE( pool.allocate(8) == NULL );
+        REQUIRE( pool.Exhaustions() == 1 );
+
+        pool.deallocate(a);
+        REQUIRE( pool.allocate(8) == a );
+        REQUIRE( pool.PeakBlocksInUse() == 3 );
+    }
+    SECTION("reject oversized requests")
+    {
+        REQUIRE( pool.allocate(25) == NULL );
+        REQUIRE( pool.Exhaustions() == 0 );
+    }
+}
+
+TEST_CASE("Size class pool")
+{
+    BlockPool small(16, 1), large(64, 1);
+    BlockPool *classes[] = { &small, &large };
+    SizeClassPool allocator(classes, 2);
+
+    void *a = allocator.allocate(10);
+    void *b = allocator.allocate(10);
+    void *c = allocator.allocate(10);
+
+    REQUIRE( small.owns(a) );
+    REQUIRE( large.owns(b) );
+    REQUIRE( !small.owns(c) );
+    REQUIRE( !large.owns(c) );
+    REQUIRE( allocator.Fallbacks() == 1 );
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    allocator.deallocate(c);
+    REQUIRE( small.BlocksInUse() == 0 );
+    REQUIRE( large.BlocksInUse() == 0 );
+}
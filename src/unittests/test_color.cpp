@@ -0,0 +1,136 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+#include "../display/color.h"
+
+using namespace mono::display;
+
+namespace {
+
+    // blend each channel on its own, as the packed blend should
+    uint16_t referenceBlend(uint16_t fg, uint16_t bg, int alpha)
+    {
+        int r = (((fg >> 11) & 0x1F)*alpha + ((bg >> 11) & 0x1F)*(32-alpha)) >> 5;
+        int g = (((fg >> 5) & 0x3F)*alpha + ((bg >> 5) & 0x3F)*(32-alpha)) >> 5;
+        int b = ((fg & 0x1F)*alpha + (bg & 0x1F)*(32-alpha)) >> 5;
+        return (uint16_t) ((r << 11) | (g << 5) | b);
+    }
+
+    int channelDistance(uint16_t a, uint16_t b)
+    {
+        int dr = ((a >> 11) & 0x1F) - ((b >> 11) & 0x1F);
+        int dg = ((a >> 5) & 0x3F) - ((b >> 5) & 0x3F);
+        int db = (a & 0x1F) - (b & 0x1F);
+        int distance = dr < 0 ? -dr : dr;
+        if ((dg < 0 ? -dg : dg) > distance)
+            distance = dg < 0 ? -dg : dg;
+        if ((db < 0 ? -db : db) > distance)
+            distance = db < 0 ? -db : db;
+        return distance;
+    }
+
+    uint16_t pseudoRandom(uint32_t &seed)
+    {
+        seed = seed*1664525 + 1013904223;
+        return (uint16_t) (seed >> 16);
+    }
+}
+
+TEST_CASE("Color packed blending", "[color]")
+{
+    SECTION("blend matches per channel blending")
+    {
+        uint32_t seed = 1;
+        for (int i=0; i<2000; i++)
+        {
+            uint16_t fg = pseudoRandom(seed), bg = pseudoRandom(seed);
+            for (int alpha=0; alpha<=Color::AlphaMax; alpha++)
+                REQUIRE(Color::blend(fg, bg, alpha) == referenceBlend(fg, bg, alpha));
+        }
+
+        REQUIRE(Color::blend(0xFFFF, 0x0000, 32) == 0xFFFF);
+        REQUIRE(Color::blend(0xFFFF, 0x0000, 0) == 0x0000);
+        REQUIRE(Color::blend(0x0000, 0xFFFF, 16) == 0x7BEF);
+    }
+
+    SECTION("blend is close to alphaBlend")
+    {
+        uint32_t seed = 7;
+        for (int i=0; i<500; i++)
+        {
+            Color fg(pseudoRandom(seed)), bg(pseudoRandom(seed));
+            for (int intensity=0; intensity<256; intensity+=5)
+            {
+                uint16_t packed = Color::blend(fg.value, bg.value, Color::Alpha(intensity));
+                REQUIRE(channelDistance(packed, fg.alphaBlend(intensity, bg).value) <= 2);
+            }
+        }
+    }
+
+    SECTION("alpha has 5 bits")
+    {
+        REQUIRE(Color::Alpha(0) == 0);
+        REQUIRE(Color::Alpha(3) == 0);
+        REQUIRE(Color::Alpha(128) == 16);
+        REQUIRE(Color::Alpha(255) == Color::AlphaMax);
+    }
+
+    SECTION("blendSpan blends a source span over the target")
+    {
+        uint16_t target[4] = { 0x0000, 0xFFFF, 0x1234, 0xF800 };
+        uint16_t source[4] = { 0xFFFF, 0x0000, 0x4321, 0x001F };
+        uint16_t expected[4];
+        for (int i=0; i<4; i++)
+            expected[i] = referenceBlend(source[i], target[i], 12);
+
+        Color::blendSpan(target, source, 96, 4);
+        for (int i=0; i<4; i++)
+            REQUIRE(target[i] == expected[i]);
+
+        Color::blendSpan(target, source, 0, 4);
+        for (int i=0; i<4; i++)
+            REQUIRE(target[i] == expected[i]);
+
+        Color::blendSpan(target, source, 255, 4);
+        for (int i=0; i<4; i++)
+            REQUIRE(target[i] == source[i]);
+    }
+
+    SECTION("fillBlend blends one color over the target")
+    {
+        uint16_t target[3] = { 0x0000, 0x07E0, 0xFFFF };
+        uint16_t original[3] = { 0x0000, 0x07E0, 0xFFFF };
+        Color::fillBlend(target, RedColor, 200, 3);
+
+        for (int i=0; i<3; i++)
+            REQUIRE(target[i] == referenceBlend(RedColor.value, original[i], Color::Alpha(200)));
+
+        Color::fillBlend(target, BlueColor, 255, 3);
+        for (int i=0; i<3; i++)
+            REQUIRE(target[i] == BlueColor.value);
+    }
+
+    SECTION("blendMask paints a mask in two colors")
+    {
+        uint8_t mask[5] = { 0, 255, 128, 10, 200 };
+        uint16_t target[5];
+        Color fg = WhiteColor, bg = MidnightBlueColor;
+
+        Color::blendMask(target, mask, fg, bg, 5);
+        REQUIRE(target[0] == bg.value);
+        REQUIRE(target[1] == fg.value);
+        REQUIRE(target[2] == referenceBlend(fg.value, bg.value, 16));
+        REQUIRE(target[3] == referenceBlend(fg.value, bg.value, Color::Alpha(10)));
+        REQUIRE(target[4] == referenceBlend(fg.value, bg.value, Color::Alpha(200)));
+
+        // the gamma table lifts partly covered pixels
+        Color::blendMask(target, mask, fg, bg, 5, Color::GammaAlphaTable);
+        REQUIRE(target[0] == bg.value);
+        REQUIRE(target[1] == fg.value);
+        REQUIRE(target[2] == referenceBlend(fg.value, bg.value, Color::GammaAlphaTable[128]));
+        REQUIRE(Color::GammaAlphaTable[128] > Color::Alpha(128));
+        REQUIRE(Color::GammaAlphaTable[0] == 0);
+        REQUIRE(Color::GammaAlphaTable[255] == Color::AlphaMax);
+    }
+}
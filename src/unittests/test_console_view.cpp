@@ -0,0 +1,90 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "host_context.h"
+#include "../display/ui/console_view.h"
+
+using namespace mono;
+using namespace mono::ui;
+using namespace mono::display;
+
+// the bus transfers to append a line to a console, and repaint it
+template <uint16_t W, uint16_t H>
+static uint32_t appendCost(ConsoleView<W, H> &console, int line)
+{
+    HeadlessDisplayController &display = HostContext::Default().display;
+    display.resetCounters();
+    console.WriteLine(String::Format("line %02i", line));
+    console.repaint();
+    return display.BusTransfers();
+}
+
+// `true` if the screen shows the display memory unscrolled
+static bool isUnscrolled(const HeadlessDisplayController &display)
+{
+    const uint16_t *memory = display.Framebuffer();
+    for (int y=0; y<HeadlessDisplayController::Height; y++)
+        for (int x=0; x<HeadlessDisplayController::Width; x++)
+            if (display.pixel(x, y) != memory[y*HeadlessDisplayController::Width + x])
+                return false;
+    return true;
+}
+
+TEST_CASE("ConsoleView", "[console_view]")
+{
+    HeadlessDisplayController &display = HostContext::Default().display;
+    display.clear(Color(0, 0, 0));
+
+    SECTION("appending a line to a full console costs the same as to an empty one")
+    {
+        ConsoleView<176, 110> console;
+        console.repaint();
+        display.resetCounters();
+        console.repaint();
+        REQUIRE(display.BusTransfers() == 0);
+
+        uint32_t firstCost = appendCost(console, 0);
+        for (int l=1; l<30; l++)
+            appendCost(console, l);
+
+        // the full console scrolls in hardware, only the scroll offset is extra
+        REQUIRE_FALSE(isUnscrolled(display));
+        uint32_t scrollCost = appendCost(console, 30);
+        REQUIRE(scrollCost <= firstCost + 16);
+
+        // a repaint of the whole view costs many lines
+        display.resetCounters();
+        console.setTextColor(Color(255, 255, 255));
+        console.repaint();
+        REQUIRE(scrollCost*5 < display.BusTransfers());
+    }
+
+    SECTION("the cost of a line does not grow with the console height")
+    {
+        ConsoleView<176, 110> small;
+        ConsoleView<176, 200> large;
+        small.repaint();
+        large.repaint();
+        for (int l=0; l<40; l++)
+        {
+            appendCost(small, l);
+            appendCost(large, l);
+        }
+
+        REQUIRE(appendCost(small, 40) == appendCost(large, 40));
+    }
+
+    SECTION("resizing stops the hardware scrolling")
+    {
+        ConsoleView<176, 110> console;
+        console.repaint();
+        for (int l=0; l<30; l++)
+            appendCost(console, l);
+        REQUIRE_FALSE(isUnscrolled(display));
+
+        console.setSize(geo::Size(176, 100));
+        REQUIRE(isUnscrolled(display));
+    }
+}
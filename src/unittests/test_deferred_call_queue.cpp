@@ -0,0 +1,118 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+#include "catch.hpp"
+#include "../deferred_call_queue.h"
+
+using namespace mono;
+
+class Recorder
+{
+public:
+    int calls[32];
+    int count;
+    Recorder() : count(0) {}
+    void first() { calls[count++] = 1; }
+    void second() { calls[count++] = 2; }
+    void third() { calls[count++] = 3; }
+};
+
+TEST_CASE("Deferred call queue")
+{
+    DeferredCallQueue queue;
+    Recorder rec;
+    mbed::FunctionPointer first(&rec, &Recorder::first);
+    mbed::FunctionPointer second(&rec, &Recorder::second);
+    mbed::FunctionPointer third(&rec, &Recorder::third);
+
+    SECTION("calls in post order")
+    {
+        queue.post(first, &rec, 100);
+        queue.post(second, &rec, 150);
+        REQUIRE( queue.Pending() == 2 );
+
+        queue.process(400);
+        REQUIRE( rec.count == 2 );
+        REQUIRE( rec.calls[0] == 1 );
+        REQUIRE( rec.calls[1] == 2 );
+        REQUIRE( queue.Pending() == 0 );
+        REQUIRE( queue.MaxLatency() == 300 );
+        REQUIRE( queue.PeakDepth() == 2 );
+    }
+    SECTION("count overflows")
+    {
+        // a different owner for each call, so they are not coalesced
+        for (uint32_t i=0; i<DeferredCallQueue::Capacity; i++)
+            REQUIRE( queue.post(first, &rec.calls[i+1], 0) );
+
+        REQUIRE( queue.post(first, &rec, 0) == false );
+        REQUIRE( queue.Overflows() == 1 );
+
+        queue.process(0);
+        REQUIRE( rec.count == (int) DeferredCallQueue::Capacity );
+        REQUIRE( queue.post(first, &rec, 0) );
+    }
+    SECTION("coalesce a call that is already pending")
+    {
+        mbed::FunctionPointer handler = DeferredCallQueue::handler(&rec, &Recorder::first);
+        for (int i=0; i<3*(int)DeferredCallQueue::Capacity; i++)
+            REQUIRE( queue.post(DeferredCallQueue::handler(&rec, &Recorder::first), &rec, 0) );
+
+        REQUIRE( queue.post(DeferredCallQueue::handler(&rec, &Recorder::second), &rec, 0) );
+        REQUIRE( queue.Pending() == 2 );
+        REQUIRE( queue.Coalesced() == 3*DeferredCallQueue::Capacity - 1 );
+        REQUIRE( queue.Overflows() == 0 );
+
+        queue.process(0);
+        REQUIRE( rec.count == 2 );
+
+        // a dispatched or cancelled call can be posted again
+        REQUIRE( queue.post(handler, &rec, 0) );
+        queue.cancel(&rec);
+        REQUIRE( queue.post(handler, &rec, 0) );
+        REQUIRE( queue.Coalesced() == 3*DeferredCallQueue::Capacity - 1 );
+        queue.process(0);
+        REQUIRE( rec.count == 3 );
+    }
+    SECTION("delayed calls fire in due order")
+    {
+        queue.postDelayed(third, &rec, 3000, 0);
+        queue.postDelayed(first, &rec, 1000, 0);
+        queue.postDelayed(second, &rec, 2000, 0);
+
+        queue.process(999);
+        REQUIRE( rec.count == 0 );
+
+        queue.process(2500);
+        REQUIRE( rec.count == 2 );
+        REQUIRE( rec.calls[0] == 1 );
+        REQUIRE( rec.calls[1] == 2 );
+
+        queue.process(3000);
+        REQUIRE( rec.calls[2] == 3 );
+        REQUIRE( queue.Pending() == 0 );
+    }
+    SECTION("delays wrap around the timer")
+    {
+        queue.postDelayed(first, &rec, 0x200, 0xFFFFFF00);
+        queue.process(0xFFFFFFF0);
+        queue.process(0x00000010);
+        REQUIRE( rec.count == 0 );
+        queue.process(0x00000100);
+        REQUIRE( rec.count == 1 );
+    }
+    SECTION("cancel pending calls of an object")
+    {
+        Recorder other;
+        mbed::FunctionPointer otherCall(&other, &Recorder::first);
+
+        queue.post(first, &rec, 0);
+        queue.post(otherCall, &other, 0);
+        queue.postDelayed(second, &rec, 10, 0);
+        queue.postDelayed(otherCall, &other, 20, 0);
+
+        REQUIRE( queue.cancel(&rec) == 2 );
+        queue.process(100);
+        REQUIRE( rec.count == 0 );
+        REQUIRE( other.count == 2 );
+    }
+}
@@ -0,0 +1,66 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../display/ui/easing.h"
+
+using namespace mono::ui;
+using mono::display::Color;
+
+TEST_CASE("Easing", "[easing]")
+{
+    const Easing::Curve curves[] = {
+        Easing::LINEAR, Easing::EASE_IN, Easing::EASE_OUT, Easing::EASE_IN_OUT,
+        Easing::EASE_IN_CUBIC, Easing::EASE_OUT_CUBIC, Easing::EASE_IN_OUT_CUBIC
+    };
+
+    SECTION("all curves start at 0, end at 1 and never go back")
+    {
+        for (unsigned c=0; c<sizeof(curves)/sizeof(curves[0]); c++)
+        {
+            INFO("curve " << c);
+            REQUIRE(Easing::apply(curves[c], 0) == 0);
+            REQUIRE(Easing::apply(curves[c], Easing::One) == Easing::One);
+            REQUIRE(Easing::apply(curves[c], 2*Easing::One) == Easing::One);
+
+            uint32_t previous = 0;
+            for (uint32_t t=0; t<=Easing::One; t+=256)
+            {
+                uint32_t progress = Easing::apply(curves[c], t);
+                REQUIRE(progress >= previous);
+                REQUIRE(progress <= Easing::One);
+                previous = progress;
+            }
+        }
+    }
+
+    SECTION("ease in is slow at the start, ease out at the end")
+    {
+        uint32_t quarter = Easing::One/4;
+        REQUIRE(Easing::apply(Easing::LINEAR, quarter) == quarter);
+        REQUIRE(Easing::apply(Easing::EASE_IN, quarter) == Easing::One/16);
+        REQUIRE(Easing::apply(Easing::EASE_OUT, quarter) > quarter);
+        REQUIRE(Easing::apply(Easing::EASE_IN_CUBIC, quarter) < Easing::apply(Easing::EASE_IN, quarter));
+        REQUIRE(Easing::apply(Easing::EASE_IN_OUT, Easing::One/2) == Easing::One/2);
+    }
+
+    SECTION("interpolate values")
+    {
+        REQUIRE(Easing::interpolate(10, 20, 0) == 10);
+        REQUIRE(Easing::interpolate(10, 20, Easing::One/2) == 15);
+        REQUIRE(Easing::interpolate(10, 20, Easing::One) == 20);
+        REQUIRE(Easing::interpolate(20, -20, Easing::One/4) == 10);
+    }
+
+    SECTION("interpolate colors")
+    {
+        Color black(0, 0, 0), white(255, 255, 255);
+        REQUIRE(Easing::interpolate(black, white, 0).value == black.value);
+        REQUIRE(Easing::interpolate(black, white, Easing::One).value == white.value);
+
+        Color middle = Easing::interpolate(black, white, Easing::One/2);
+        REQUIRE(middle.Red() > 100);
+        REQUIRE(middle.Red() < 160);
+    }
+}
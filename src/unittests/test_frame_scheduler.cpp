@@ -0,0 +1,92 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../display/ui/frame_scheduler.h"
+
+using namespace mono::ui;
+
+TEST_CASE("FrameScheduler", "[frame_scheduler]")
+{
+    FrameScheduler scheduler(16000, 10000);
+
+    SECTION("budget defaults to 3/4 of the frame period")
+    {
+        FrameScheduler defaultScheduler;
+        REQUIRE(defaultScheduler.FramePeriod() == FrameScheduler::DefaultFramePeriodUs);
+        REQUIRE(defaultScheduler.Budget() == FrameScheduler::DefaultFramePeriodUs*3/4);
+        REQUIRE(defaultScheduler.PaintOrder() == FrameScheduler::SCHEDULED_ORDER);
+
+        scheduler.setBudget(0);
+        REQUIRE(scheduler.Budget() == 12000);
+    }
+
+    SECTION("budget counts from the TE pulse")
+    {
+        scheduler.beginFrame(103000, 100000);
+        REQUIRE(scheduler.hasTimeLeft(103000));
+        scheduler.viewPainted();
+        REQUIRE(scheduler.hasTimeLeft(109999));
+        REQUIRE_FALSE(scheduler.hasTimeLeft(110000));
+
+        scheduler.endFrame(108000, 0);
+        REQUIRE(scheduler.LastFrameTime() == 8000);
+        REQUIRE(scheduler.Overruns() == 0);
+        REQUIRE(scheduler.DroppedFrames() == 0);
+    }
+
+    SECTION("an old TE pulse is ignored")
+    {
+        scheduler.beginFrame(200000, 100000);
+        scheduler.viewPainted();
+        REQUIRE(scheduler.hasTimeLeft(209999));
+        REQUIRE_FALSE(scheduler.hasTimeLeft(210000));
+    }
+
+    SECTION("the first view is always painted")
+    {
+        scheduler.beginFrame(115000, 100000);
+        REQUIRE(scheduler.hasTimeLeft(115000));
+        scheduler.viewPainted();
+        REQUIRE_FALSE(scheduler.hasTimeLeft(115000));
+    }
+
+    SECTION("statistics count overruns, dropped frames and deferred views")
+    {
+        scheduler.beginFrame(100000, 100000);
+        scheduler.endFrame(111000, 2);
+        REQUIRE(scheduler.Frames() == 1);
+        REQUIRE(scheduler.Overruns() == 1);
+        REQUIRE(scheduler.DroppedFrames() == 0);
+        REQUIRE(scheduler.DeferredViews() == 2);
+
+        scheduler.beginFrame(116000, 116000);
+        scheduler.endFrame(150000, 1);
+        REQUIRE(scheduler.Overruns() == 2);
+        REQUIRE(scheduler.DroppedFrames() == 2);
+        REQUIRE(scheduler.DeferredViews() == 3);
+        REQUIRE(scheduler.MaxFrameTime() == 34000);
+
+        scheduler.resetStatistics();
+        REQUIRE(scheduler.Frames() == 0);
+        REQUIRE(scheduler.MaxFrameTime() == 0);
+    }
+
+    SECTION("frame period follows the TE pulses")
+    {
+        uint32_t te = 1000;
+        for (int i=0; i<100; i++)
+        {
+            scheduler.beginFrame(te, te);
+            scheduler.endFrame(te + 1000, 0);
+            te += 17000;
+        }
+        REQUIRE(scheduler.FramePeriod() > 16900);
+        REQUIRE(scheduler.FramePeriod() <= 17000);
+
+        // a pause in painting is not a frame period
+        scheduler.beginFrame(te + 1000000, te + 1000000);
+        REQUIRE(scheduler.FramePeriod() > 16900);
+    }
+}
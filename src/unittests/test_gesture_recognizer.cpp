@@ -0,0 +1,139 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+#include "../display/ui/gesture_recognizer.h"
+#include <vector>
+
+using namespace mono::ui;
+using namespace mono::geo;
+
+class GestureLog
+{
+public:
+    std::vector<GestureRecognizer::Gesture> gestures;
+
+    void record(const GestureRecognizer::Gesture &gesture)
+    {
+        gestures.push_back(gesture);
+    }
+
+    GestureRecognizer::GestureType last() const
+    {
+        return gestures.back().type;
+    }
+};
+
+TEST_CASE("GestureRecognizer", "[gesture_recognizer]")
+{
+    GestureRecognizer recognizer;
+    GestureLog log;
+    recognizer.setGestureCallback(&log, &GestureLog::record);
+
+    SECTION("a short still touch is a tap")
+    {
+        recognizer.touchBegin(Point(50, 60), 1000);
+        recognizer.touchMove(Point(53, 62), 50000);
+        recognizer.touchEnd(Point(53, 62), 150000);
+
+        REQUIRE(log.gestures.size() == 1);
+        REQUIRE(log.last() == GestureRecognizer::TAP);
+        REQUIRE(log.gestures[0].position.X() == 50);
+        REQUIRE(log.gestures[0].position.Y() == 60);
+        REQUIRE_FALSE(recognizer.IsTracking());
+    }
+
+    SECTION("a held touch is a long press, detected by update")
+    {
+        recognizer.touchBegin(Point(50, 60), 0);
+        recognizer.update(GestureRecognizer::LongPressUs - 1);
+        REQUIRE(log.gestures.empty());
+
+        recognizer.update(GestureRecognizer::LongPressUs);
+        REQUIRE(log.gestures.size() == 1);
+        REQUIRE(log.last() == GestureRecognizer::LONG_PRESS);
+
+        // the rest of the touch is ignored
+        recognizer.touchMove(Point(100, 60), GestureRecognizer::LongPressUs + 1000);
+        recognizer.touchEnd(Point(100, 60), GestureRecognizer::LongPressUs + 2000);
+        REQUIRE(log.gestures.size() == 1);
+    }
+
+    SECTION("a long touch without update is a long press at the end")
+    {
+        recognizer.touchBegin(Point(50, 60), 0);
+        recognizer.touchEnd(Point(50, 60), GestureRecognizer::LongPressUs + 10);
+
+        REQUIRE(log.gestures.size() == 1);
+        REQUIRE(log.last() == GestureRecognizer::LONG_PRESS);
+    }
+
+    SECTION("a moving touch is a drag with deltas")
+    {
+        recognizer.touchBegin(Point(50, 100), 0);
+        recognizer.touchMove(Point(50, 90), 20000);
+
+        REQUIRE(recognizer.IsDragging());
+        REQUIRE(log.last() == GestureRecognizer::DRAG_BEGIN);
+        REQUIRE(log.gestures.back().deltaY == -10);
+
+        recognizer.touchMove(Point(52, 84), 40000);
+        REQUIRE(log.last() == GestureRecognizer::DRAG);
+        REQUIRE(log.gestures.back().deltaX == 2);
+        REQUIRE(log.gestures.back().deltaY == -6);
+        REQUIRE(log.gestures.back().start.Y() == 100);
+    }
+
+    SECTION("a slow drag ends without a swipe")
+    {
+        recognizer.touchBegin(Point(50, 100), 0);
+        recognizer.touchMove(Point(50, 120), 200000);
+        recognizer.touchMove(Point(50, 130), 400000);
+        recognizer.touchEnd(Point(50, 135), 500000);
+
+        REQUIRE(log.last() == GestureRecognizer::DRAG_END);
+        REQUIRE(log.gestures.back().velocityY == 50);
+        REQUIRE(log.gestures.back().deltaY == 5);
+    }
+
+    SECTION("a fast drag ends with a swipe")
+    {
+        recognizer.touchBegin(Point(100, 50), 0);
+        recognizer.touchMove(Point(80, 50), 10000);
+        recognizer.touchMove(Point(60, 50), 20000);
+        recognizer.touchMove(Point(40, 50), 30000);
+        recognizer.touchEnd(Point(20, 50), 40000);
+
+        size_t count = log.gestures.size();
+        REQUIRE(count >= 2);
+        REQUIRE(log.gestures[count-2].type == GestureRecognizer::DRAG_END);
+        REQUIRE(log.last() == GestureRecognizer::SWIPE);
+        REQUIRE(log.gestures.back().velocityX == -2000);
+        REQUIRE(log.gestures.back().velocityY == 0);
+        REQUIRE(log.gestures.back().direction == GestureRecognizer::SWIPE_LEFT);
+    }
+
+    SECTION("the velocity is from the latest samples")
+    {
+        // a fast start, then the finger stops before release
+        recognizer.touchBegin(Point(50, 0), 0);
+        recognizer.touchMove(Point(50, 100), 50000);
+        recognizer.touchMove(Point(50, 200), 100000);
+        recognizer.touchMove(Point(50, 202), 300000);
+        recognizer.touchMove(Point(50, 204), 350000);
+        recognizer.touchEnd(Point(50, 206), 400000);
+
+        REQUIRE(log.last() == GestureRecognizer::DRAG_END);
+        REQUIRE(log.gestures.back().velocityY == 40);
+    }
+
+    SECTION("cancel forgets the touch")
+    {
+        recognizer.touchBegin(Point(50, 60), 0);
+        recognizer.cancel();
+        recognizer.touchEnd(Point(50, 60), 1000);
+
+        REQUIRE(log.gestures.empty());
+        REQUIRE_FALSE(recognizer.IsTracking());
+    }
+}
@@ -0,0 +1,99 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../display/ui/graph_ring_buffer.h"
+
+using namespace mono::ui;
+
+namespace {
+
+    // reads every sample, like the default IGraphViewDataSource::SampleRange
+    void scanRange(GraphRingBuffer<64> &buffer, int index, int length, int &min, int &max)
+    {
+        min = max = buffer.DataPoint(index);
+        for (int i=index+1; i<index+length; i++)
+        {
+            if (buffer.DataPoint(i) < min)
+                min = buffer.DataPoint(i);
+            if (buffer.DataPoint(i) > max)
+                max = buffer.DataPoint(i);
+        }
+    }
+}
+
+TEST_CASE("GraphRingBuffer", "[graph_ring_buffer]")
+{
+    GraphRingBuffer<64> buffer(1000);
+
+    SECTION("starts with zero samples")
+    {
+        REQUIRE(buffer.BufferLength() == 64);
+        REQUIRE(buffer.MaxSampleValueSpan() == 1000);
+
+        int min = 1, max = -1;
+        buffer.SampleRange(0, 64, min, max);
+        REQUIRE(min == 0);
+        REQUIRE(max == 0);
+    }
+
+    SECTION("append writes samples in a ring")
+    {
+        for (int i=0; i<70; i++)
+            buffer.append(i);
+
+        REQUIRE(buffer.NewestSampleIndex() == 5);
+        REQUIRE(buffer.DataPoint(5) == 69);
+        REQUIRE(buffer.DataPoint(6) == 6);
+        REQUIRE(buffer.DataPoint(63) == 63);
+    }
+
+    SECTION("samples are clamped to 16 bits")
+    {
+        buffer.append(100000);
+        buffer.append(-100000);
+        REQUIRE(buffer.DataPoint(0) == 32767);
+        REQUIRE(buffer.DataPoint(1) == -32768);
+    }
+
+    SECTION("SampleRange matches a scan of all samples")
+    {
+        // a pseudo random signal, written more than once around the ring
+        uint32_t seed = 1;
+        for (int i=0; i<150; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            buffer.append((int) ((seed >> 16) % 2001) - 1000);
+        }
+
+        for (int index=0; index<64; index++)
+        {
+            for (int length=1; index+length<=64; length++)
+            {
+                int min, max, scanMin, scanMax;
+                buffer.SampleRange(index, length, min, max);
+                scanRange(buffer, index, length, scanMin, scanMax);
+
+                INFO("index " << index << ", length " << length);
+                REQUIRE(min == scanMin);
+                REQUIRE(max == scanMax);
+            }
+        }
+    }
+
+    SECTION("SampleRange clips to the buffer")
+    {
+        buffer.append(-5);
+        buffer.append(7);
+
+        int min, max;
+        buffer.SampleRange(-10, 12, min, max);
+        REQUIRE(min == -5);
+        REQUIRE(max == 7);
+
+        buffer.SampleRange(64, 4, min, max);
+        REQUIRE(min == 0);
+        REQUIRE(max == 0);
+    }
+}
@@ -0,0 +1,164 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../display/headless/headless_display_controller.h"
+
+using namespace mono::display;
+
+TEST_CASE("HeadlessDisplayController", "[headless_display]")
+{
+    HeadlessDisplayController display;
+    Color red(255, 0, 0), blue(0, 0, 255);
+
+    SECTION("starts black with a full screen window")
+    {
+        REQUIRE(display.ScreenWidth() == 176);
+        REQUIRE(display.ScreenHeight() == 220);
+        REQUIRE(display.pixel(0, 0) == 0);
+        REQUIRE(display.pixel(175, 219) == 0);
+        REQUIRE(display.Commands() == 0);
+    }
+
+    SECTION("writes wrap inside the window")
+    {
+        display.setWindow(10, 20, 3, 2);
+        display.writeFill(red, 4);
+        REQUIRE(display.pixel(10, 20) == red.value);
+        REQUIRE(display.pixel(12, 20) == red.value);
+        REQUIRE(display.pixel(13, 20) == 0);
+        REQUIRE(display.pixel(10, 21) == red.value);
+        REQUIRE(display.pixel(11, 21) == 0);
+        REQUIRE(display.getCursorX() == 11);
+        REQUIRE(display.getCursorY() == 21);
+
+        // after the last pixel the cursor returns to the window origin
+        display.writeFill(blue, 3);
+        REQUIRE(display.getCursorX() == 11);
+        REQUIRE(display.getCursorY() == 20);
+        REQUIRE(display.pixel(10, 20) == blue.value);
+    }
+
+    SECTION("setCursor keeps the window")
+    {
+        display.setWindow(10, 20, 3, 2);
+        display.setCursor(12, 21);
+        display.write(red);
+        display.write(blue);
+        REQUIRE(display.pixel(12, 21) == red.value);
+        REQUIRE(display.pixel(10, 20) == blue.value);
+    }
+
+    SECTION("writeBuffer draws raw pixels")
+    {
+        const uint16_t pixels[] = { 0x1234, 0xABCD };
+        display.setWindow(0, 0, 2, 1);
+        display.writeBuffer(pixels, 2);
+        REQUIRE(display.pixel(0, 0) == 0x1234);
+        REQUIRE(display.pixel(1, 0) == 0xABCD);
+    }
+
+    SECTION("counts bus traffic like the ILI9225G")
+    {
+        display.setWindow(0, 0, 10, 10);
+        display.setCursor(5, 5);
+        display.writeFill(red, 100);
+
+        REQUIRE(display.WindowChanges() == 1);
+        REQUIRE(display.CursorChanges() == 1);
+        REQUIRE(display.Commands() == 7 + 3);
+        REQUIRE(display.PixelWrites() == 100);
+        REQUIRE(display.BusTransfers() == 19 + 7 + 200);
+
+        // 226 transfers of 9 bits at 16 MHz
+        REQUIRE(display.BusTimeUs() == 226 * 9 / 16);
+
+        display.resetCounters();
+        REQUIRE(display.BusTransfers() == 0);
+    }
+
+    SECTION("vertical scroll shifts rows inside the scroll area")
+    {
+        REQUIRE(display.SupportsVerticalScroll());
+
+        // rows 10, 11 and 12 are red, green and blue
+        display.setWindow(0, 10, 176, 3);
+        display.writeFill(red, 176);
+        display.writeFill(Color(0, 255, 0), 176);
+        display.writeFill(blue, 176);
+
+        display.setVerticalScrollArea(10, 3);
+        display.resetCounters();
+        display.setVerticalScrollOffset(1);
+        REQUIRE(display.PixelWrites() == 0);
+        REQUIRE(display.pixel(5, 10) == Color(0, 255, 0).value);
+        REQUIRE(display.pixel(5, 11) == blue.value);
+        REQUIRE(display.pixel(5, 12) == red.value);
+        REQUIRE(display.pixel(5, 13) == 0);
+
+        // writes go to the stored rows
+        display.setWindow(0, 10, 1, 1);
+        display.write(blue);
+        REQUIRE(display.pixel(0, 12) == blue.value);
+        REQUIRE(display.read() == blue.value);
+
+        display.setVerticalScrollOffset(0);
+        REQUIRE(display.pixel(5, 10) == red.value);
+        REQUIRE(display.pixel(0, 10) == blue.value);
+    }
+
+    SECTION("rotation maps windows to the panel")
+    {
+        REQUIRE(display.setOrientation(IDisplayController::LANDSCAPE_RIGHT));
+        REQUIRE(display.ScreenWidth() == 220);
+        REQUIRE(display.ScreenHeight() == 176);
+        REQUIRE_FALSE(display.SupportsVerticalScroll());
+
+        // the top left corner is at the panel's top right corner
+        display.setWindow(0, 0, 2, 2);
+        display.write(red);
+        display.write(blue);
+        display.write(blue);
+        REQUIRE(display.pixel(175, 0) == red.value);
+        REQUIRE(display.pixel(175, 1) == blue.value);
+        REQUIRE(display.pixel(174, 0) == blue.value);
+
+        REQUIRE(display.setOrientation(IDisplayController::PORTRAIT_BOTTOMUP));
+        REQUIRE(display.ScreenWidth() == 176);
+        display.setWindow(0, 0, 1, 1);
+        display.write(red);
+        REQUIRE(display.pixel(175, 219) == red.value);
+
+        REQUIRE(display.setOrientation(IDisplayController::LANDSCAPE_LEFT));
+        display.setWindow(0, 0, 1, 1);
+        display.write(blue);
+        REQUIRE(display.pixel(0, 219) == blue.value);
+        REQUIRE(display.read() == blue.value);
+
+        REQUIRE(display.setOrientation(IDisplayController::PORTRAIT));
+        REQUIRE(display.SupportsVerticalScroll());
+    }
+
+    SECTION("PPM images round trip")
+    {
+        display.setWindow(100, 100, 2, 2);
+        display.writeFill(red, 2);
+        display.writeFill(Color(0x07E0), 2);
+
+        FILE *file = tmpfile();
+        REQUIRE(file != 0);
+        REQUIRE(display.writePPM(file));
+        rewind(file);
+
+        static uint16_t golden[HeadlessDisplayController::Width * HeadlessDisplayController::Height];
+        REQUIRE(HeadlessDisplayController::readPPM(file, golden));
+        fclose(file);
+
+        REQUIRE(display.countDifferences(golden) == 0);
+
+        display.setCursor(0, 0);
+        display.write(blue);
+        REQUIRE(display.countDifferences(golden) == 1);
+    }
+}
@@ -0,0 +1,188 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../heap_monitor.h"
+#include "../string_builder.h"
+#include "../deferred_call_queue.h"
+#include "../mn_string.h"
+#include <stdlib.h>
+#include <new>
+
+using namespace mono;
+
+class Ticker
+{
+public:
+    int ticks;
+    Ticker() : ticks(0) {}
+    void tick() { ticks++; }
+};
+
+TEST_CASE("HeapMonitor", "[heap_monitor]")
+{
+    SECTION("is active when linked with the wrappers")
+    {
+        void *block = malloc(1);
+        free(block);
+        REQUIRE(HeapMonitor::IsActive());
+    }
+
+    // Catch allocates in its assertions, so the counters are read before
+    // the assertions
+
+    SECTION("counts allocations and bytes in use")
+    {
+        HeapCheckpoint checkpoint;
+        uint32_t blocks = HeapMonitor::BlocksInUse();
+
+        void *a = malloc(100);
+        void *b = calloc(10, 5);
+        uint32_t allocated = checkpoint.Allocations();
+        int32_t allocatedBytes = checkpoint.BytesDelta();
+        uint32_t allocatedBlocks = HeapMonitor::BlocksInUse();
+        bool peak = HeapMonitor::PeakBytesInUse() >= HeapMonitor::BytesInUse();
+
+        a = realloc(a, 200);
+        uint32_t resized = checkpoint.Allocations();
+        int32_t resizedBytes = checkpoint.BytesDelta();
+
+        free(a);
+        free(b);
+        int32_t freedBytes = checkpoint.BytesDelta();
+        uint32_t freedBlocks = HeapMonitor::BlocksInUse();
+
+        REQUIRE(allocated == 2);
+        REQUIRE(allocatedBytes == 150);
+        REQUIRE(allocatedBlocks == blocks + 2);
+        REQUIRE(peak);
+        REQUIRE(resized == 3);
+        REQUIRE(resizedBytes == 250);
+        REQUIRE(freedBytes == 0);
+        REQUIRE(freedBlocks == blocks);
+    }
+
+    SECTION("counts new and delete")
+    {
+        HeapCheckpoint checkpoint;
+        int *value = new int(1);
+        char *array = new char[100];
+        char *failsafe = new (std::nothrow) char[50];
+        uint32_t allocated = checkpoint.Allocations();
+        int32_t allocatedBytes = checkpoint.BytesDelta();
+
+        delete value;
+        delete[] array;
+        delete[] failsafe;
+        int32_t freedBytes = checkpoint.BytesDelta();
+
+        REQUIRE(allocated == 3);
+        REQUIRE(allocatedBytes == (int32_t) sizeof(int) + 150);
+        REQUIRE(freedBytes == 0);
+    }
+
+    SECTION("counts a HEAP string")
+    {
+        HeapCheckpoint checkpoint;
+        String *str = new String("This string is too long for inline storage");
+        uint32_t allocated = checkpoint.Allocations();
+        delete str;
+        int32_t freedBytes = checkpoint.BytesDelta();
+
+        String shortStr("short");
+        uint32_t inlined = checkpoint.Allocations();
+
+        REQUIRE(allocated == 2); // the object and its characters
+        REQUIRE(freedBytes == 0);
+        REQUIRE(inlined == 2);
+    }
+
+    SECTION("groups allocations by call site")
+    {
+        void *blocks[3];
+        for (int i=0; i<3; i++)
+            blocks[i] = malloc(8);
+
+        bool found = false;
+        for (uint32_t i=0; i<HeapMonitor::CallSiteCount(); i++)
+        {
+            const HeapMonitor::CallSite &site = HeapMonitor::CallSiteAt(i);
+            if (site.bytesInUse == 24 && site.allocations >= 3)
+                found = true;
+        }
+
+        for (int i=0; i<3; i++)
+            free(blocks[i]);
+
+        REQUIRE(found);
+    }
+
+    SECTION("counts allocations per run loop iteration")
+    {
+        HeapMonitor::newIteration();
+        void *a = malloc(4);
+        void *b = malloc(4);
+        HeapMonitor::newIteration();
+        uint32_t last = HeapMonitor::LastIterationAllocations();
+        uint32_t max = HeapMonitor::MaxIterationAllocations();
+
+        free(a);
+        free(b);
+        HeapMonitor::newIteration();
+        uint32_t idle = HeapMonitor::LastIterationAllocations();
+
+        REQUIRE(last == 2);
+        REQUIRE(max >= 2);
+        REQUIRE(idle == 0);
+    }
+
+    SECTION("probes free blocks without counting them")
+    {
+        HeapCheckpoint checkpoint;
+        uint32_t largest = HeapMonitor::LargestFreeBlock(4096);
+        uint32_t free = HeapMonitor::FreeBytes(4096);
+        uint32_t allocations = checkpoint.Allocations();
+        REQUIRE(largest == 4096);
+        REQUIRE(free == 4096);
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("reports to a stream")
+    {
+        FILE *out = tmpfile();
+        REQUIRE(out != 0);
+        HeapMonitor::report(out);
+        REQUIRE(ftell(out) > 0);
+        fclose(out);
+    }
+}
+
+TEST_CASE("Steady state does not allocate", "[heap_monitor]")
+{
+    SECTION("StringBuilder")
+    {
+        HeapCheckpoint checkpoint;
+        StackStringBuilder<32> line;
+        line.append("Temp: ").appendFixed(2253, 2).append(" C");
+        uint32_t allocations = checkpoint.Allocations();
+        REQUIRE(allocations == 0);
+    }
+
+    SECTION("DeferredCallQueue")
+    {
+        DeferredCallQueue queue;
+        Ticker ticker;
+
+        HeapCheckpoint checkpoint;
+        for (int i=0; i<100; i++)
+        {
+            queue.post(mbed::FunctionPointer(&ticker, &Ticker::tick), &ticker, i);
+            queue.process(i);
+        }
+
+        uint32_t allocations = checkpoint.Allocations();
+        REQUIRE(ticker.ticks == 100);
+        REQUIRE(allocations == 0);
+    }
+}
@@ -0,0 +1,85 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+#include "../display/ui/hit_test_grid.h"
+
+using namespace mono::ui;
+using namespace mono::geo;
+
+TEST_CASE("HitTestGrid", "[hit_test_grid]")
+{
+    HitTestGrid grid;
+    int background, button, overlay;
+
+    REQUIRE(grid.insert(&background, Rect(0, 0, 176, 220)));
+    REQUIRE(grid.insert(&button, Rect(40, 40, 60, 30)));
+
+    SECTION("finds the top-most rect at a point")
+    {
+        REQUIRE(grid.hitTest(Point(50, 50)) == &button);
+        REQUIRE(grid.hitTest(Point(10, 10)) == &background);
+        REQUIRE(grid.hitTest(Point(175, 219)) == &background);
+        REQUIRE(grid.Count() == 2);
+    }
+
+    SECTION("later inserts are on top")
+    {
+        REQUIRE(grid.insert(&overlay, Rect(0, 0, 176, 220)));
+        REQUIRE(grid.hitTest(Point(50, 50)) == &overlay);
+
+        grid.remove(&overlay);
+        REQUIRE(grid.hitTest(Point(50, 50)) == &button);
+
+        // inserting again moves an item to the top
+        REQUIRE(grid.insert(&background, Rect(0, 0, 176, 220)));
+        REQUIRE(grid.hitTest(Point(50, 50)) == &background);
+        REQUIRE(grid.Count() == 2);
+    }
+
+    SECTION("updates keep the stack order")
+    {
+        REQUIRE(grid.update(&button, Rect(120, 180, 40, 30)));
+        REQUIRE(grid.hitTest(Point(50, 50)) == &background);
+        REQUIRE(grid.hitTest(Point(130, 200)) == &button);
+        REQUIRE_FALSE(grid.update(&overlay, Rect(0, 0, 10, 10)));
+    }
+
+    SECTION("finds the items below another item")
+    {
+        REQUIRE(grid.insert(&overlay, Rect(30, 30, 20, 20)));
+        REQUIRE(grid.hitTest(Point(45, 45)) == &overlay);
+        REQUIRE(grid.hitTest(Point(45, 45), &overlay) == &button);
+        REQUIRE(grid.hitTest(Point(45, 45), &button) == &background);
+        REQUIRE(grid.hitTest(Point(45, 45), &background) == 0);
+
+        // the overlay is not under the point, it is skipped
+        REQUIRE(grid.hitTest(Point(90, 60), &overlay) == &button);
+
+        grid.remove(&overlay);
+        REQUIRE(grid.hitTest(Point(45, 45), &overlay) == 0);
+    }
+
+    SECTION("points outside all rects hit nothing")
+    {
+        grid.remove(&background);
+        REQUIRE(grid.hitTest(Point(10, 10)) == 0);
+        REQUIRE(grid.hitTest(Point(300, 300)) == 0);
+        REQUIRE(grid.hitTest(Point(-5, 50)) == 0);
+        REQUIRE_FALSE(grid.contains(&background));
+    }
+
+    SECTION("holds a limited number of rects")
+    {
+        static int views[HitTestGrid::MaxItems];
+        for (int i = 2; i < HitTestGrid::MaxItems; i++)
+            REQUIRE(grid.insert(&views[i], Rect(i*5, i*6, 5, 6)));
+
+        REQUIRE_FALSE(grid.insert(&overlay, Rect(0, 0, 10, 10)));
+        REQUIRE(grid.hitTest(Point(31*5 + 2, 31*6 + 2)) == &views[31]);
+
+        grid.remove(&views[5]);
+        REQUIRE(grid.insert(&overlay, Rect(0, 0, 10, 10)));
+        REQUIRE(grid.hitTest(Point(5, 5)) == &overlay);
+    }
+}
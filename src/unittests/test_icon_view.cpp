@@ -0,0 +1,125 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "host_context.h"
+#include "../display/ui/icon_view.h"
+#include <vector>
+
+using namespace mono;
+using namespace mono::ui;
+using namespace mono::display;
+
+static const Color foreColor(255, 255, 255), backColor(0, 0, 128), screenColor(200, 0, 0);
+
+// the 4x3 icon pixels, that an icon view shows at (10, 10)
+static std::vector<uint16_t> iconPixels(const HeadlessDisplayController &display)
+{
+    std::vector<uint16_t> pixels;
+    for (int y=10; y<13; y++)
+        for (int x=10; x<14; x++)
+            pixels.push_back(display.pixel(x, y));
+    return pixels;
+}
+
+static uint16_t blended(uint8_t alpha)
+{
+    return Color::blend(foreColor.value, backColor.value, Color::Alpha(alpha));
+}
+
+TEST_CASE("IconView RLE decoding", "[icon_view]")
+{
+    HeadlessDisplayController &display = HostContext::Default().display;
+    display.clear(screenColor);
+
+    SpriteCache cache(4*3*sizeof(uint16_t));
+    IconView view;
+    view.setForeground(foreColor);
+    view.setBackground(backColor);
+    view.setRect(geo::Rect(10, 10, 4, 3));
+
+    SECTION("decodes each run type, and runs across line ends")
+    {
+        static const uint8_t runs[] = {
+            RLE_RUN_BACKGROUND | 2,
+            RLE_RUN_FOREGROUND | 1,
+            RLE_RUN_BLENDED | 1, 0x80, 0x20,
+            RLE_RUN_FOREGROUND | 4
+        };
+        static const MonoRleIcon icon = { 4, 3, sizeof(runs), runs };
+        uint16_t expected[] = {
+            backColor.value, backColor.value, backColor.value, foreColor.value,
+            foreColor.value, blended(0x80), blended(0x20), foreColor.value,
+            foreColor.value, foreColor.value, foreColor.value, foreColor.value
+        };
+
+        view.setRleIcon(&icon);
+        view.repaint();
+        REQUIRE(iconPixels(display) == std::vector<uint16_t>(expected, expected + 12));
+
+        // the sprite cache renders the same pixels
+        display.clear(screenColor);
+        view.setSpriteCache(&cache);
+        view.repaint();
+        REQUIRE(cache.Misses() == 1);
+        REQUIRE(iconPixels(display) == std::vector<uint16_t>(expected, expected + 12));
+    }
+
+    SECTION("pads truncated run data with the background")
+    {
+        // the blended run is cut short after its first value
+        static const uint8_t runs[] = { RLE_RUN_FOREGROUND | 1, RLE_RUN_BLENDED | 3, 0x80 };
+        static const MonoRleIcon icon = { 4, 3, sizeof(runs), runs };
+        uint16_t expected[12];
+        expected[0] = expected[1] = foreColor.value;
+        expected[2] = blended(0x80);
+        for (int i=3; i<12; i++)
+            expected[i] = backColor.value;
+
+        view.setRleIcon(&icon);
+        view.repaint();
+        REQUIRE(iconPixels(display) == std::vector<uint16_t>(expected, expected + 12));
+
+        display.clear(screenColor);
+        view.setSpriteCache(&cache);
+        view.repaint();
+        REQUIRE(iconPixels(display) == std::vector<uint16_t>(expected, expected + 12));
+    }
+
+    SECTION("an empty icon is all background")
+    {
+        static const MonoRleIcon icon = { 4, 3, 0, 0 };
+        view.setRleIcon(&icon);
+        view.repaint();
+        REQUIRE(iconPixels(display) == std::vector<uint16_t>(12, backColor.value));
+    }
+
+    SECTION("runs past the end of the icon are cut off")
+    {
+        // a 64 pixel run would wrap around the window, and overwrite the first pixels
+        static const uint8_t runs[] = { RLE_RUN_FOREGROUND | 2, RLE_RUN_BACKGROUND | 63, RLE_RUN_FOREGROUND | 63 };
+        static const MonoRleIcon icon = { 4, 3, sizeof(runs), runs };
+
+        display.resetCounters();
+        view.setRleIcon(&icon);
+        view.repaint();
+        std::vector<uint16_t> pixels = iconPixels(display);
+        REQUIRE(pixels[0] == foreColor.value);
+        REQUIRE(pixels[2] == foreColor.value);
+        REQUIRE(pixels[3] == backColor.value);
+        REQUIRE(pixels[11] == backColor.value);
+        REQUIRE(display.PixelWrites() == 12);
+        REQUIRE(display.pixel(10, 13) == screenColor.value);
+    }
+
+    SECTION("setIcon(NULL) removes the icon")
+    {
+        static const MonoRleIcon icon = { 4, 3, 0, 0 };
+        view.setRleIcon(&icon);
+        view.setIcon(NULL);
+        display.resetCounters();
+        view.repaint();
+        REQUIRE(display.PixelWrites() == 0);
+    }
+}
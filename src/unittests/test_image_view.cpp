@@ -0,0 +1,95 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "host_context.h"
+#include "../display/ui/image_view.h"
+#include <vector>
+
+using namespace mono;
+using namespace mono::ui;
+using namespace mono::display;
+
+// an image of a pattern, read line by line
+class PatternImage : public media::Image
+{
+public:
+    int width, height, line, position;
+
+    PatternImage(int w, int h) : width(w), height(h), line(0), position(0) {}
+
+    static uint16_t pixelAt(int x, int y) { return (uint16_t) (1 + x + y*256); }
+
+    int Width() { return width; }
+    int Height() { return height; }
+    int PixelByteSize() { return 2; }
+    bool IsValid() { return true; }
+
+    int ReadPixelData(void *target, int pixelsToRead)
+    {
+        uint16_t *pixels = (uint16_t*) target;
+        int read = 0;
+        while (read < pixelsToRead && position < width)
+            pixels[read++] = pixelAt(position++, line);
+
+        return read;
+    }
+
+    int SkipPixelData(int pixelsToSkip)
+    {
+        position += pixelsToSkip;
+        return pixelsToSkip;
+    }
+
+    void SeekToHLine(int vertPos)
+    {
+        line = vertPos;
+        position = 0;
+    }
+};
+
+TEST_CASE("ImageView", "[image_view]")
+{
+    HeadlessDisplayController &display = HostContext::Default().display;
+    display.clear(Color(0, 0, 0));
+
+    SECTION("streams lines wider than the portrait screen, in landscape")
+    {
+        display.setOrientation(IDisplayController::LANDSCAPE_RIGHT);
+        PatternImage image(220, 8);
+        ImageView view(&image);
+        view.setRect(geo::Rect(0, 10, 220, 8));
+        view.repaint();
+        std::vector<uint16_t> painted(display.Framebuffer(), display.Framebuffer() + 176*220);
+
+        // the expected image, written a full line at a time
+        display.clear(Color(0, 0, 0));
+        display.setWindow(0, 10, 220, 8);
+        uint16_t line[220];
+        for (int y=0; y<8; y++)
+        {
+            for (int x=0; x<220; x++)
+                line[x] = PatternImage::pixelAt(x, y);
+            display.writeBuffer(line, 220);
+        }
+
+        display.setOrientation(IDisplayController::PORTRAIT);
+        REQUIRE(display.countDifferences(&painted[0]) == 0);
+    }
+
+    SECTION("streams a horizontal crop")
+    {
+        PatternImage image(176, 8);
+        ImageView view(&image);
+        view.setRect(geo::Rect(0, 10, 100, 8));
+        view.setCrop(geo::Point(50, 2));
+        view.repaint();
+
+        bool sheared = false;
+        for (int y=0; y<6; y++)
+            for (int x=0; x<100; x++)
+                sheared |= display.pixel(x, 10+y) != PatternImage::pixelAt(50+x, 2+y);
+        REQUIRE_FALSE(sheared);
+    }
+}
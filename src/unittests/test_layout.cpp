@@ -0,0 +1,236 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+#include "../display/ui/layout.h"
+#include "../display/ui/text_label_view.h"
+
+using namespace mono::ui;
+using namespace mono::geo;
+
+class FakeView : public IViewALike
+{
+public:
+    Rect rect;
+    mono::geo::Size preferred;
+    bool visible;
+    int measures, repaints;
+
+    FakeView(int width, int height) : preferred(width, height)
+    {
+        visible = false;
+        measures = repaints = 0;
+    }
+
+    bool Visible() const { return visible; }
+    void show() { visible = true; }
+    void hide() { visible = false; }
+    void scheduleRepaint() { repaints++; }
+    void setRect(Rect r) { rect = r; }
+    Point &Position() { return rect; }
+    mono::geo::Size &Size() { return rect; }
+    const Rect &ViewRect() const { return rect; }
+
+    mono::geo::Size PreferredSize() const
+    {
+        const_cast<FakeView*>(this)->measures++;
+        return preferred;
+    }
+};
+
+static bool rectIs(const Rect &rect, int x, int y, int width, int height)
+{
+    return rect.X() == x && rect.Y() == y && rect.Width() == width && rect.Height() == height;
+}
+
+TEST_CASE("StackLayout", "[layout]")
+{
+    FakeView a(40, 10), b(60, 20), c(20, 30);
+    StackLayout stack(StackLayout::VERTICAL, Rect(0, 0, 176, 220));
+    stack.setPadding(2);
+    stack.setSpacing(4);
+    stack.addView(a);
+    stack.addView(b);
+    stack.addView(c);
+
+    SECTION("stacks children in a column")
+    {
+        stack.layoutIfNeeded();
+        REQUIRE(rectIs(a.rect, 2, 2, 172, 10));
+        REQUIRE(rectIs(b.rect, 2, 16, 172, 20));
+        REQUIRE(rectIs(c.rect, 2, 40, 172, 30));
+
+        REQUIRE(stack.PreferredSize().Width() == 64);
+        REQUIRE(stack.PreferredSize().Height() == 10+4+20+4+30 + 4);
+    }
+
+    SECTION("aligns children across a row")
+    {
+        stack.setDirection(StackLayout::HORIZONTAL);
+        stack.setAlignment(StackLayout::ALIGN_CENTER);
+        stack.layoutIfNeeded();
+        REQUIRE(rectIs(a.rect, 2, 2 + (216-10)/2, 40, 10));
+        REQUIRE(rectIs(b.rect, 46, 2 + (216-20)/2, 60, 20));
+        REQUIRE(rectIs(c.rect, 110, 2 + (216-30)/2, 20, 30));
+    }
+
+    SECTION("measures only invalidated children")
+    {
+        stack.layoutIfNeeded();
+        REQUIRE(stack.MeasureCount() == 3);
+        REQUIRE_FALSE(stack.NeedsLayout());
+
+        stack.layoutIfNeeded();
+        stack.scheduleRepaint();
+        REQUIRE(stack.MeasureCount() == 3);
+
+        b.preferred = mono::geo::Size(60, 40);
+        stack.invalidate(b);
+        REQUIRE(stack.NeedsLayout());
+        stack.layoutIfNeeded();
+        REQUIRE(stack.MeasureCount() == 4);
+        REQUIRE(a.measures == 1);
+        REQUIRE(b.measures == 2);
+        REQUIRE(rectIs(b.rect, 2, 16, 172, 40));
+        REQUIRE(rectIs(c.rect, 2, 60, 172, 30));
+    }
+
+    SECTION("repaints only moved children")
+    {
+        stack.show();
+        REQUIRE(a.visible);
+
+        c.preferred = mono::geo::Size(20, 50);
+        stack.invalidate(c);
+        stack.layoutIfNeeded();
+        REQUIRE(a.repaints == 0);
+        REQUIRE(b.repaints == 0);
+        REQUIRE(c.repaints == 1);
+    }
+
+    SECTION("repaints only changed children in a pending layout pass")
+    {
+        stack.show();
+        stack.invalidate(b);
+        stack.scheduleRepaint();
+        REQUIRE(a.repaints == 0);
+        REQUIRE(b.repaints == 1);
+        REQUIRE(c.repaints == 0);
+
+        // nothing has changed, so all children are repainted
+        stack.scheduleRepaint();
+        REQUIRE(a.repaints == 1);
+        REQUIRE(b.repaints == 2);
+        REQUIRE(c.repaints == 1);
+    }
+
+    SECTION("lays out a changed child, when visible")
+    {
+        stack.childChanged(b);
+        REQUIRE(stack.NeedsLayout());
+
+        stack.show();
+        b.preferred = mono::geo::Size(60, 40);
+        stack.childChanged(b);
+        REQUIRE_FALSE(stack.NeedsLayout());
+        REQUIRE(rectIs(c.rect, 2, 60, 172, 30));
+        REQUIRE(a.repaints == 0);
+        REQUIRE(b.repaints == 1);
+        REQUIRE(c.repaints == 1);
+    }
+
+    SECTION("passes changes of nested children to the outermost layout")
+    {
+        FakeView d(30, 10);
+        StackLayout row(StackLayout::HORIZONTAL);
+        row.addView(d);
+        stack.removeView(c);
+        stack.addView(row);
+        stack.show();
+
+        d.preferred = mono::geo::Size(30, 20);
+        row.childChanged(d);
+        REQUIRE_FALSE(stack.NeedsLayout());
+        REQUIRE_FALSE(row.NeedsLayout());
+        REQUIRE(rectIs(row.ViewRect(), 2, 40, 172, 20));
+        REQUIRE(rectIs(d.rect, 2, 40, 30, 20));
+        REQUIRE(d.repaints == 1);
+        REQUIRE(a.repaints == 0);
+        stack.removeView(row);
+    }
+
+    SECTION("removes children")
+    {
+        stack.removeView(a);
+        stack.layoutIfNeeded();
+        REQUIRE(rectIs(b.rect, 2, 2, 172, 20));
+    }
+}
+
+TEST_CASE("TextLabelView in a layout", "[layout]")
+{
+    TextLabelView label("short");
+    FakeView after(20, 10);
+    StackLayout row(StackLayout::HORIZONTAL, Rect(0, 0, 176, 30));
+    row.setAlignment(StackLayout::ALIGN_START);
+    row.addView(label);
+    row.addView(after);
+    row.show();
+
+    int shortWidth = label.ViewRect().Width();
+    REQUIRE(after.rect.X() == shortWidth);
+
+    label.setText("a much longer text");
+    REQUIRE_FALSE(row.NeedsLayout());
+    REQUIRE(label.ViewRect().Width() == label.PreferredSize().Width());
+    REQUIRE(label.ViewRect().Width() > shortWidth);
+    REQUIRE(after.rect.X() == label.ViewRect().Width());
+    REQUIRE(after.repaints == 1);
+
+    // the same text does not change the layout
+    label.setText("a much longer text");
+    REQUIRE(after.repaints == 1);
+    row.hide();
+}
+
+TEST_CASE("GridLayout", "[layout]")
+{
+    FakeView a(10, 10), b(20, 25), c(30, 15);
+    GridLayout grid(2, Rect(10, 10, 102, 200));
+    grid.setSpacing(2);
+    grid.addView(a);
+    grid.addView(b);
+    grid.addView(c);
+
+    SECTION("places children row by row")
+    {
+        grid.layoutIfNeeded();
+        REQUIRE(rectIs(a.rect, 10, 10, 50, 25));
+        REQUIRE(rectIs(b.rect, 62, 10, 50, 25));
+        REQUIRE(rectIs(c.rect, 10, 37, 50, 15));
+
+        REQUIRE(grid.PreferredSize().Width() == 2*30 + 2);
+        REQUIRE(grid.PreferredSize().Height() == 25 + 2 + 15);
+    }
+
+    SECTION("uses a fixed row height")
+    {
+        grid.setRowHeight(20);
+        grid.layoutIfNeeded();
+        REQUIRE(rectIs(b.rect, 62, 10, 50, 20));
+        REQUIRE(rectIs(c.rect, 10, 32, 50, 20));
+    }
+
+    SECTION("nests in a stack")
+    {
+        StackLayout stack(StackLayout::VERTICAL, Rect(0, 0, 176, 220));
+        FakeView title(100, 12);
+        stack.addView(title);
+        stack.addView(grid);
+        stack.layoutIfNeeded();
+
+        REQUIRE(rectIs(grid.ViewRect(), 0, 12, 176, 42));
+        grid.layoutIfNeeded();
+        REQUIRE(rectIs(a.rect, 0, 12, 87, 25));
+    }
+}
@@ -0,0 +1,134 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "host_context.h"
+#include "../display/ui/list_view.h"
+#include <string.h>
+#include <vector>
+
+using namespace mono;
+using namespace mono::ui;
+using namespace mono::display;
+
+// rows named by their number, that counts the queries for each row
+class CountingDataSource : public IListViewDataSource
+{
+public:
+    static const int Rows = 1000;
+    int queries[Rows];
+
+    CountingDataSource() { reset(); }
+
+    void reset() { memset(queries, 0, sizeof(queries)); }
+
+    int NumberOfRows() { return Rows; }
+
+    String TextForRow(int row)
+    {
+        queries[row]++;
+        return String::Format("Row %i", row);
+    }
+};
+
+// records the content lines it renders
+class RecordingListView : public ListView
+{
+public:
+    std::vector<int> lines;
+
+    RecordingListView(geo::Rect rect) : ListView(rect) {}
+
+protected:
+
+    void renderLine(int row, int line, uint16_t *pixels, int width)
+    {
+        lines.push_back(row*rowHeight + line);
+        ListView::renderLine(row, line, pixels, width);
+    }
+};
+
+static std::vector<uint16_t> screenPixels(const HeadlessDisplayController &display, const geo::Rect &rect)
+{
+    std::vector<uint16_t> pixels;
+    for (int y=rect.Y(); y<rect.Y2(); y++)
+        for (int x=rect.X(); x<rect.X2(); x++)
+            pixels.push_back(display.pixel(x, y));
+    return pixels;
+}
+
+TEST_CASE("ListView", "[list_view]")
+{
+    HeadlessDisplayController &display = HostContext::Default().display;
+    display.clear(Color(0, 0, 0));
+    CountingDataSource source;
+
+    SECTION("a hardware scroll paints only the lines that came into view")
+    {
+        geo::Rect rect(0, 20, 176, 200);
+        RecordingListView list(rect);
+        list.setDataSource(&source);
+        list.repaint();
+        REQUIRE(list.lines.size() == 200);
+        REQUIRE(list.lines.front() == 0);
+        REQUIRE(list.lines.back() == 199);
+
+        list.lines.clear();
+        display.resetCounters();
+        list.scrollTo(10);
+        list.repaint();
+        REQUIRE(list.lines.size() == 10);
+        REQUIRE(list.lines.front() == 200);
+        REQUIRE(list.lines.back() == 209);
+        uint32_t scrollTransfers = display.BusTransfers();
+
+        list.lines.clear();
+        list.scrollTo(5);
+        list.repaint();
+        REQUIRE(list.lines.size() == 5);
+        REQUIRE(list.lines.front() == 5);
+        REQUIRE(list.lines.back() == 9);
+
+        // the scrolled screen shows the same as a full repaint
+        std::vector<uint16_t> scrolled = screenPixels(display, rect);
+        list.reloadData();
+        display.resetCounters();
+        list.repaint();
+        REQUIRE(list.lines.size() == 5 + 200);
+        REQUIRE(screenPixels(display, rect) == scrolled);
+        REQUIRE(scrollTransfers*10 < display.BusTransfers());
+    }
+
+    SECTION("a list narrower than the screen paints all lines on a scroll")
+    {
+        RecordingListView list(geo::Rect(10, 20, 150, 200));
+        list.setDataSource(&source);
+        list.repaint();
+
+        list.lines.clear();
+        list.scrollTo(10);
+        list.repaint();
+        REQUIRE(list.lines.size() == 200);
+        REQUIRE(list.lines.front() == 10);
+    }
+
+    SECTION("the data source is only queried for the visible rows")
+    {
+        RecordingListView list(geo::Rect(0, 20, 176, 200));
+        list.setDataSource(&source);
+        list.repaint();
+
+        // 200 lines show rows 0 to 8, each is queried once
+        for (int row=0; row<CountingDataSource::Rows; row++)
+            REQUIRE(source.queries[row] == (row <= 8 ? 1 : 0));
+
+        source.reset();
+        list.scrollTo(30);
+        list.repaint();
+
+        // lines 200 to 229 are rows 8 and 9, row 8 is still cached
+        for (int row=0; row<CountingDataSource::Rows; row++)
+            REQUIRE(source.queries[row] == (row == 9 ? 1 : 0));
+    }
+}
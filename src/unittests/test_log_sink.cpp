@@ -0,0 +1,116 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../log_sink.h"
+#include <string.h>
+
+using namespace mono;
+
+static const char *readAll(FILE *file, long *length = 0)
+{
+    static char buffer[2048];
+    long size = ftell(file);
+    rewind(file);
+    size_t count = fread(buffer, 1, sizeof(buffer)-1, file);
+    buffer[count] = 0;
+    if (length != 0)
+        *length = size;
+    return buffer;
+}
+
+TEST_CASE("LogSink", "[log_sink]")
+{
+    FILE *out = tmpfile();
+    REQUIRE(out != 0);
+    LogSink sink(out);
+
+    SECTION("defers writing until drained")
+    {
+        sink.log(LOG_WARNING, LOG_WIRELESS, 1234567, "status: 0x%x\r\n", 0x1f);
+        REQUIRE(sink.Pending() == 1);
+        REQUIRE(ftell(out) == 0);
+
+        REQUIRE(sink.drain() == 1);
+        REQUIRE(sink.Pending() == 0);
+        REQUIRE(strcmp(readAll(out), "1.234 W wireless: status: 0x1f\r\n") == 0);
+    }
+
+    SECTION("drains a limited number of messages")
+    {
+        for (int i=0; i<5; i++)
+            sink.log(LOG_DEBUG, LOG_APP, 0, "%i\r\n", i);
+
+        REQUIRE(sink.drain(2) == 2);
+        REQUIRE(sink.Pending() == 3);
+        REQUIRE(sink.drain() == 3);
+    }
+
+    SECTION("drops messages when the ring is full")
+    {
+        for (uint32_t i=0; i<LogSink::Capacity+3; i++)
+            sink.log(LOG_INFO, LOG_CORE, 0, "x");
+
+        REQUIRE(sink.Pending() == LogSink::Capacity);
+        REQUIRE(sink.Dropped() == 3);
+
+        sink.drain();
+        REQUIRE(strncmp(readAll(out), "(3 log messages dropped)\r\n", 26) == 0);
+    }
+
+    SECTION("writes binary records")
+    {
+        static const char *format = "%u %u";
+        sink.setBinaryOutput(true);
+        sink.log(LOG_ERROR, LOG_POWER, 0x01020304, format, 7, 9);
+        sink.drain();
+
+        long length = 0;
+        const uint8_t *data = (const uint8_t*) readAll(out, &length);
+        REQUIRE(length == 3 + 4 + 4 + 2*4);
+        REQUIRE(data[0] == LogSink::BinaryRecordMarker);
+        REQUIRE(data[1] == ((LOG_ERROR << 4) | LOG_POWER));
+        REQUIRE(data[2] == 2);
+
+        uint32_t time, arg;
+        memcpy(&time, data + 3, 4);
+        memcpy(&arg, data + 15, 4);
+        REQUIRE(time == 0x01020304);
+        REQUIRE(arg == 9);
+    }
+
+    fclose(out);
+}
+
+TEST_CASE("LogSink formatting", "[log_sink]")
+{
+    char buffer[64];
+
+    SECTION("integers with width and zero padding")
+    {
+        intptr_t args[] = { -42, 7, 255, 0xBEEF };
+        LogSink::format(buffer, sizeof(buffer), "%d|%03u|%4x|%X", args, 4);
+        REQUIRE(strcmp(buffer, "-42|007|  ff|BEEF") == 0);
+    }
+
+    SECTION("strings, characters and percent")
+    {
+        intptr_t args[] = { (intptr_t) "mono", 'c', 0 };
+        LogSink::format(buffer, sizeof(buffer), "%6s %c 100%% %s", args, 3);
+        REQUIRE(strcmp(buffer, "  mono c 100% (null)") == 0);
+    }
+
+    SECTION("negative zero padded")
+    {
+        intptr_t args[] = { -5 };
+        LogSink::format(buffer, sizeof(buffer), "%03d", args, 1);
+        REQUIRE(strcmp(buffer, "-05") == 0);
+    }
+
+    SECTION("missing arguments and truncation")
+    {
+        LogSink::format(buffer, 8, "value: %d and more", 0, 0);
+        REQUIRE(strcmp(buffer, "value: ") == 0);
+    }
+}
@@ -0,0 +1,125 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+#include "catch.hpp"
+#include "../managed_pointer.h"
+#include "../heap_monitor.h"
+
+using namespace mono;
+
+static int liveObjects = 0;
+
+class Counted
+{
+public:
+    int a, b;
+    Counted() : a(0), b(0) { liveObjects++; }
+    Counted(int x, int y) : a(x), b(y) { liveObjects++; }
+    ~Counted() { liveObjects--; }
+};
+
+class TestPool : public IAllocator
+{
+public:
+    int allocations, deallocations;
+    TestPool() : allocations(0), deallocations(0) {}
+    void *allocate(uint32_t size) { allocations++; return malloc(size); }
+    void deallocate(void *block) { deallocations++; free(block); }
+};
+
+TEST_CASE("Managed pointer")
+{
+    liveObjects = 0;
+
+    SECTION("make_managed shares the allocation")
+    {
+        {
+            ManagedPointer<Counted> ptr = make_managed<Counted>(3, 4);
+            REQUIRE( ptr->a == 3 );
+            REQUIRE( ptr->b == 4 );
+            REQUIRE( ptr.References() == 1 );
+            REQUIRE( liveObjects == 1 );
+
+            ManagedPointer<Counted> copy = ptr;
+            REQUIRE( ptr.References() == 2 );
+        }
+        REQUIRE( liveObjects == 0 );
+    }
+    SECTION("wrap a new'ed object")
+    {
+        {
+            ManagedPointer<Counted> ptr(new Counted());
+            ManagedPointer<Counted> other;
+            other = ptr;
+            REQUIRE( other.References() == 2 );
+            other = new Counted(1, 2);
+            REQUIRE( ptr.References() == 1 );
+            REQUIRE( liveObjects == 2 );
+        }
+        REQUIRE( liveObjects == 0 );
+    }
+    SECTION("copy and assign empty pointers")
+    {
+        ManagedPointer<Counted> empty;
+        ManagedPointer<Counted> copy(empty);
+        ManagedPointer<Counted> ptr = make_managed<Counted>();
+        ptr = empty;
+        REQUIRE( !ptr );
+        REQUIRE( ptr.References() == 0 );
+        REQUIRE( liveObjects == 0 );
+    }
+    SECTION("allocate from a pool")
+    {
+        TestPool pool;
+        {
+            ManagedPointer<Counted> ptr = make_managed_in<Counted>(&pool, 5, 6);
+            REQUIRE( ptr->b == 6 );
+            REQUIRE( pool.allocations == 1 );
+        }
+        REQUIRE( pool.deallocations == 1 );
+        REQUIRE( liveObjects == 0 );
+    }
+    SECTION("an empty pointer allocates no count")
+    {
+        HeapCheckpoint checkpoint;
+        ManagedPointer<Counted> ptr((Counted*) NULL);
+        uint32_t allocations = checkpoint.Allocations();
+        REQUIRE( allocations == 0 );
+        REQUIRE( !ptr );
+    }
+    SECTION("surrender a new'ed object")
+    {
+        Counted *object = new Counted();
+        HeapCheckpoint checkpoint;
+        bool surrendered, empty;
+        {
+            ManagedPointer<Counted> ptr(object);
+            surrendered = ptr.Surrender();
+            empty = !ptr;
+        }
+        int32_t bytes = checkpoint.BytesDelta();
+        REQUIRE( surrendered );
+        REQUIRE( empty );
+        REQUIRE( bytes == 0 ); // the count is freed
+        REQUIRE( liveObjects == 1 );
+        delete object;
+    }
+    SECTION("content in a shared allocation is not surrendered")
+    {
+        {
+            ManagedPointer<Counted> ptr = make_managed<Counted>();
+            REQUIRE( ptr.Surrender() == false );
+            REQUIRE( ptr );
+        }
+        REQUIRE( liveObjects == 0 );
+    }
+    SECTION("swap")
+    {
+        ManagedPointer<Counted> ptr = make_managed<Counted>(1, 2);
+        ManagedPointer<Counted> other;
+        other.swap(ptr);
+        REQUIRE( !ptr );
+        REQUIRE( other->a == 1 );
+        REQUIRE( other.References() == 1 );
+        REQUIRE( liveObjects == 1 );
+    }
+}
@@ -0,0 +1,62 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+#include "catch.hpp"
+#include "../media/rgb565_image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace mono::media;
+
+// a new file in the temp directory, removed again by the test
+static char imagePath[32];
+
+static void writeImageFile(const char *magic, uint16_t width, uint16_t height)
+{
+    strcpy(imagePath, "/tmp/unittest_image_XXXXXX");
+    int fd = mkstemp(imagePath);
+    REQUIRE( fd >= 0 );
+    FILE *file = fdopen(fd, "wb");
+    fwrite(magic, 1, 4, file);
+    fwrite(&width, sizeof(width), 1, file);
+    fwrite(&height, sizeof(height), 1, file);
+    for (uint16_t pixel = 0; pixel < width*height; pixel++)
+        fwrite(&pixel, sizeof(pixel), 1, file);
+    fclose(file);
+}
+
+TEST_CASE("RGB565 image")
+{
+    SECTION("reject missing file")
+    {
+        RGB565Image img("no_such_image.565");
+        REQUIRE( ! img.IsValid() );
+    }
+    SECTION("reject bad magic")
+    {
+        writeImageFile("BM56", 4, 3);
+        RGB565Image img(imagePath);
+        REQUIRE( ! img.IsValid() );
+        remove(imagePath);
+    }
+    SECTION("read header and contiguous pixels")
+    {
+        writeImageFile("M565", 4, 3);
+        RGB565Image img(imagePath);
+        REQUIRE( img.IsValid() );
+        REQUIRE( img.Width() == 4 );
+        REQUIRE( img.Height() == 3 );
+        REQUIRE( img.PixelByteSize() == 2 );
+        REQUIRE( img.HasContiguousLines() );
+
+        uint16_t pixels[12];
+        img.SeekToHLine(1);
+        REQUIRE( img.SkipPixelData(1) == 1 );
+        REQUIRE( img.ReadPixelData(pixels, 12) == 7 );
+        REQUIRE( pixels[0] == 5 );
+        REQUIRE( pixels[6] == 11 );
+        remove(imagePath);
+    }
+}
@@ -0,0 +1,69 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+#include "catch.hpp"
+#include "../display/sprite_cache.h"
+
+using namespace mono::display;
+
+static int iconA, iconB, iconC;
+
+static void fillSprite(uint16_t *pixels, uint16_t value, int count)
+{
+    for (int i = 0; i < count; i++)
+        pixels[i] = value;
+}
+
+TEST_CASE("Sprite cache")
+{
+    // room for exactly two 4x4 sprites
+    SpriteCache cache(2*4*4*sizeof(uint16_t));
+    SpriteCache::Key a(&iconA, 0, 4, 4), b(&iconB, 0, 4, 4), c(&iconC, 0, 4, 4);
+
+    SECTION("miss, insert and hit")
+    {
+        REQUIRE( cache.lookup(a) == NULL );
+        fillSprite(cache.insert(a), 0xAAAA, 16);
+
+        const uint16_t *pixels = cache.lookup(a);
+        REQUIRE( pixels != NULL );
+        REQUIRE( pixels[15] == 0xAAAA );
+        REQUIRE( cache.Hits() == 1 );
+        REQUIRE( cache.Misses() == 1 );
+        REQUIRE( cache.BytesUsed() == 32 );
+    }
+    SECTION("variants are separate sprites")
+    {
+        fillSprite(cache.insert(a), 1, 16);
+        REQUIRE( cache.lookup(SpriteCache::Key(&iconA, 0xFFFF0000, 4, 4)) == NULL );
+        REQUIRE( cache.lookup(SpriteCache::Key(&iconA, 0, 4, 3)) == NULL );
+    }
+    SECTION("evict least recently used and compact")
+    {
+        fillSprite(cache.insert(a), 0xAAAA, 16);
+        fillSprite(cache.insert(b), 0xBBBB, 16);
+        cache.lookup(a);
+
+        fillSprite(cache.insert(c), 0xCCCC, 16);
+
+        REQUIRE( cache.Evictions() == 1 );
+        REQUIRE( cache.lookup(b) == NULL );
+        REQUIRE( cache.lookup(a)[0] == 0xAAAA );
+        REQUIRE( cache.lookup(c)[15] == 0xCCCC );
+        REQUIRE( cache.Count() == 2 );
+    }
+    SECTION("reject sprites larger than the arena")
+    {
+        REQUIRE( cache.insert(SpriteCache::Key(&iconA, 0, 8, 8)) == NULL );
+        REQUIRE( cache.Count() == 0 );
+    }
+    SECTION("invalidate a source")
+    {
+        fillSprite(cache.insert(a), 0xAAAA, 16);
+        fillSprite(cache.insert(b), 0xBBBB, 16);
+        cache.invalidate(&iconA);
+
+        REQUIRE( cache.lookup(a) == NULL );
+        REQUIRE( cache.lookup(b)[0] == 0xBBBB );
+        REQUIRE( cache.BytesUsed() == 32 );
+    }
+}
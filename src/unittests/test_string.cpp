@@ -0,0 +1,140 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+#include "catch.hpp"
+#include "../mn_string.h"
+#include <string.h>
+
+using namespace mono;
+
+TEST_CASE("String short string storage")
+{
+    SECTION("short strings are not on the heap")
+    {
+        String str("Hello");
+        REQUIRE( str.malloced == false );
+        REQUIRE( str.Length() == 5 );
+        REQUIRE( str == "Hello" );
+    }
+    SECTION("strings at the inline capacity are not on the heap")
+    {
+        String str("123456789012345");
+        REQUIRE( str.Length() == String::InlineCapacity );
+        REQUIRE( str.malloced == false );
+    }
+    SECTION("long strings are shared on the heap")
+    {
+        String str("This string is too long for inline storage");
+        String copy = str;
+        REQUIRE( str.malloced == true );
+        REQUIRE( copy.stringData == str.stringData );
+        REQUIRE( str.refCount->References() == 2 );
+    }
+    SECTION("copies of short strings have their own data")
+    {
+        String str("short");
+        String copy = str;
+        REQUIRE( copy.stringData != str.stringData );
+        copy.stringData[0] = 'S';
+        REQUIRE( str == "short" );
+        REQUIRE( copy == "Short" );
+    }
+    SECTION("self assignment")
+    {
+        String str("This string is too long for inline storage");
+        String &ref = str;
+        str = ref;
+        REQUIRE( str.refCount->References() == 1 );
+        REQUIRE( str.Length() == 42 );
+    }
+}
+
+TEST_CASE("String length")
+{
+    SECTION("format")
+    {
+        String str = String::Format("%i-%s", 42, "a rather long string");
+        REQUIRE( str.Length() == 23 );
+        REQUIRE( str == "42-a rather long string" );
+    }
+    SECTION("fixed length constructor stops at a NULL terminator")
+    {
+        char data[] = "abc\0def";
+        String str(data, 7);
+        REQUIRE( str.Length() == 3 );
+    }
+    SECTION("buffer strings count their length")
+    {
+        String buffer(32);
+        REQUIRE( buffer.Length() == 0 );
+        strcpy(buffer.stringData, "written");
+        REQUIRE( buffer.Length() == 7 );
+    }
+    SECTION("empty strings")
+    {
+        String str;
+        REQUIRE( str.Length() == 0 );
+        REQUIRE( String("").Length() == 0 );
+    }
+}
+
+TEST_CASE("String swap")
+{
+    SECTION("take over a heap string")
+    {
+        String str("This string is too long for inline storage");
+        char *data = str.stringData;
+        String taken;
+        taken.swap(str);
+        REQUIRE( taken.stringData == data );
+        REQUIRE( taken.refCount->References() == 1 );
+        REQUIRE( str.Length() == 0 );
+        REQUIRE( str.malloced == false );
+    }
+    SECTION("swap a short and a heap string")
+    {
+        String shortStr("short"), longStr("This string is too long for inline storage");
+        char *data = longStr.stringData;
+        shortStr.swap(longStr);
+        REQUIRE( shortStr.stringData == data );
+        REQUIRE( shortStr.Length() == 42 );
+        REQUIRE( longStr == "short" );
+        REQUIRE( longStr.Length() == 5 );
+        REQUIRE( longStr.stringData != shortStr.stringData );
+        REQUIRE( longStr.malloced == false );
+    }
+    SECTION("swap two short strings")
+    {
+        String a("one"), b("three");
+        a.swap(b);
+        REQUIRE( a == "three" );
+        REQUIRE( b == "one" );
+        REQUIRE( a.CString() != b.CString() );
+    }
+}
+
+TEST_CASE("String slices")
+{
+    String str("key=a value that is long");
+
+    SECTION("slice a string")
+    {
+        int split = str.slice(0).indexOf('=');
+        REQUIRE( split == 3 );
+        REQUIRE( str.slice(0, split) == StringSlice("key") );
+        REQUIRE( str.slice(split+1).Data() == str.CString() + 4 );
+        REQUIRE( str.slice(split+1).Length() == 20 );
+    }
+    SECTION("slices are clamped")
+    {
+        REQUIRE( str.slice(20, 100).Length() == 4 );
+        REQUIRE( str.slice(100).Length() == 0 );
+    }
+    SECTION("compare and copy")
+    {
+        StringSlice value = str.slice(4, 7);
+        REQUIRE( value.startsWith("a val") );
+        REQUIRE( value != StringSlice("a valve") );
+        REQUIRE( value.toString() == "a value" );
+        REQUIRE( value.indexOf('x') == -1 );
+    }
+}
@@ -0,0 +1,93 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+#include "catch.hpp"
+#include "../string_builder.h"
+#include <stdint.h>
+
+using namespace mono;
+
+TEST_CASE("String builder formatting")
+{
+    StackStringBuilder<48> str;
+
+    SECTION("text and integers")
+    {
+        str.append("x=").appendInt(-42).append(' ').appendUInt(7, 3).append(String(" end"));
+        REQUIRE( str.slice() == "x=-42 007 end" );
+    }
+    SECTION("integer limits")
+    {
+        str.appendInt(INT32_MIN).append(',').appendUInt(UINT32_MAX);
+        REQUIRE( str.slice() == "-2147483648,4294967295" );
+    }
+    SECTION("fixed point")
+    {
+        str.appendFixed(2253, 2).append(' ').appendFixed(-5, 2).append(' ').appendFixed(7, 0);
+        REQUIRE( str.slice() == "22.53 -0.05 7" );
+    }
+    SECTION("hex")
+    {
+        str.appendHex(0xBEEF).append(' ').appendHex(0xA, 4).append(' ').appendHex(0);
+        REQUIRE( str.slice() == "beef 000a 0" );
+    }
+    SECTION("ip addresses")
+    {
+        const uint8_t ipv4[4] = {192, 168, 0, 1};
+        const uint8_t ipv6[16] = {0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 1, 0, 2, 0, 3, 0xab, 0xcd};
+        str.appendIpv4(ipv4).append(' ').appendIpv6(ipv6);
+        REQUIRE( str.slice() == "192.168.0.1 fe80:0:0:0:1:2:3:abcd" );
+    }
+    SECTION("date and time")
+    {
+        str.appendDate(2016, 3, 7).append('T').appendTime(9, 5, 0);
+        REQUIRE( str.slice() == "2016-03-07T09:05:00" );
+        REQUIRE( str.toString() == "2016-03-07T09:05:00" );
+    }
+}
+
+TEST_CASE("String builder overflow")
+{
+    SECTION("truncate")
+    {
+        StackStringBuilder<8> str;
+        str.append("abc").appendInt(123456);
+        REQUIRE( str.slice() == "abc1234" );
+        REQUIRE( str.Length() == str.Capacity() );
+        REQUIRE( str.Overflowed() );
+    }
+    SECTION("discard keeps whole fields")
+    {
+        StackStringBuilder<8> str(StringBuilder::DISCARD_ON_OVERFLOW);
+        str.append("abc").appendInt(123456).append("def");
+        REQUIRE( str.slice() == "abcdef" );
+        REQUIRE( str.Overflowed() );
+    }
+    SECTION("clear")
+    {
+        StackStringBuilder<4> str;
+        str.append("too long");
+        str.clear();
+        REQUIRE( str.Length() == 0 );
+        REQUIRE( str.Overflowed() == false );
+        REQUIRE( str.slice() == "" );
+    }
+    SECTION("no buffer")
+    {
+        StringBuilder str(0, 16);
+        str.append("abc").appendInt(42).append("");
+        REQUIRE( str.Length() == 0 );
+        REQUIRE( str.Overflowed() );
+        REQUIRE( str.slice() == "" );
+    }
+    SECTION("empty buffer")
+    {
+        char guard[2] = { 'x', 'y' };
+        StringBuilder str(guard, 0);
+        str.append("");
+        REQUIRE( str.Overflowed() == false );
+        str.append('a');
+        REQUIRE( str.Overflowed() );
+        REQUIRE( guard[0] == 'x' );
+        REQUIRE( guard[1] == 'y' );
+    }
+}
@@ -0,0 +1,199 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../display/headless/headless_display_controller.h"
+#include "../display/text_render.h"
+#include "../display/Fonts/FreeSans9pt7b.h"
+#include <string.h>
+
+using namespace mono;
+using namespace mono::display;
+
+static const Color textColor(255, 255, 255), backColor(0, 0, 128), screenColor(200, 0, 0);
+
+// paints like drawOpaqueInRect replaces: a background fill, then the text on top
+static void clearAndDraw(HeadlessDisplayController &display, TextRender &render,
+                         const geo::Rect &rect, const char *text, bool lineLayout)
+{
+    display.setWindow(rect.X(), rect.Y(), rect.Width(), rect.Height());
+    display.writeFill(backColor, rect.Width()*rect.Height());
+    render.drawInRect(rect, text, FreeSans9pt7b, lineLayout);
+}
+
+static uint32_t countForeground(const HeadlessDisplayController &display, const geo::Rect &rect)
+{
+    uint32_t count = 0;
+    for (int y=rect.Y(); y<rect.Y2(); y++)
+        for (int x=rect.X(); x<rect.X2(); x++)
+            if (display.pixel(x, y) == textColor.value)
+                count++;
+    return count;
+}
+
+TEST_CASE("TextRender drawOpaqueInRect", "[text_render]")
+{
+    HeadlessDisplayController expected, opaque;
+    expected.clear(screenColor);
+    opaque.clear(screenColor);
+
+    TextRender expectedRender(&expected, textColor, backColor);
+    TextRender opaqueRender(&opaque, textColor, backColor);
+
+    geo::Rect rect(10, 20, 156, 60);
+
+    SECTION("paints the same pixels as a clear and drawInRect")
+    {
+        const char *text = "Temperature 22.5 C";
+        clearAndDraw(expected, expectedRender, rect, text, false);
+        opaqueRender.drawOpaqueInRect(rect, text, FreeSans9pt7b, false);
+
+        REQUIRE(countForeground(opaque, rect) > 0);
+        REQUIRE(opaque.countDifferences(expected.Framebuffer()) == 0);
+    }
+
+    SECTION("paints the same lines with each alignment")
+    {
+        const char *text = "The quick\nbrown fox\njumps";
+        TextRender::HorizontalAlignment alignments[] = {
+            TextRender::ALIGN_LEFT, TextRender::ALIGN_CENTER, TextRender::ALIGN_RIGHT
+        };
+
+        for (int i=0; i<3; i++)
+        {
+            expected.clear(screenColor);
+            opaque.clear(screenColor);
+            expectedRender.setAlignment(alignments[i]);
+            opaqueRender.setAlignment(alignments[i]);
+
+            clearAndDraw(expected, expectedRender, rect, text, true);
+            opaqueRender.drawOpaqueInRect(rect, text, FreeSans9pt7b, true);
+
+            INFO("alignment " << i);
+            REQUIRE(opaque.countDifferences(expected.Framebuffer()) == 0);
+        }
+    }
+
+    SECTION("paints lines wider than the rect from the left edge")
+    {
+        const char *text = "Short\njumps over the lazy dog again";
+        expectedRender.setAlignment(TextRender::ALIGN_CENTER);
+        opaqueRender.setAlignment(TextRender::ALIGN_CENTER);
+
+        clearAndDraw(expected, expectedRender, rect, text, true);
+        opaqueRender.drawOpaqueInRect(rect, text, FreeSans9pt7b, true);
+
+        REQUIRE(opaque.countDifferences(expected.Framebuffer()) == 0);
+
+        // the wide line is clipped, not moved out of the rect
+        geo::Rect secondLine(rect.X(), rect.Y() + rect.Height()/2, rect.Width(), rect.Height()/2);
+        REQUIRE(countForeground(opaque, secondLine) > 0);
+    }
+
+    SECTION("clips lines outside the rect")
+    {
+        const char *text = "one\ntwo\nthree\nfour\nfive\nsix";
+        geo::Rect small(20, 40, 100, 30);
+        expectedRender.setAlignment(TextRender::ALIGN_TOP);
+        opaqueRender.setAlignment(TextRender::ALIGN_TOP);
+
+        clearAndDraw(expected, expectedRender, small, text, true);
+        opaqueRender.drawOpaqueInRect(small, text, FreeSans9pt7b, true);
+
+        REQUIRE(opaque.countDifferences(expected.Framebuffer()) == 0);
+    }
+
+    SECTION("needs fewer bus transfers than a clear and drawInRect")
+    {
+        const char *text = "Temperature 22.5 C";
+        clearAndDraw(expected, expectedRender, rect, text, false);
+        opaqueRender.drawOpaqueInRect(rect, text, FreeSans9pt7b, false);
+
+        REQUIRE(opaque.BusTransfers() < expected.BusTransfers());
+    }
+}
+
+// 'A' is a 3x3 arch in full coverage, 'B' a 2x2 block in half coverage
+static const uint8_t aaBitmap[] = { 0xF0, 0xFF, 0xFF, 0xF0, 0xF0, 0x88, 0x88 };
+static const AAGlyph aaGlyphs[] = {
+    { 0, 3, 3, 4, 0, -3 },
+    { 5, 2, 2, 3, 0, -2 }
+};
+static const AAKernPair aaKerning[] = { { 'A', 'B', -1 } };
+static const AAFont aaFont = { aaBitmap, aaGlyphs, aaKerning, 1, 'A', 'B', 5, 4 };
+
+TEST_CASE("TextRender AAFont drawInRect", "[text_render]")
+{
+    HeadlessDisplayController display;
+    display.clear(screenColor);
+    TextRender render(&display, textColor, backColor);
+    render.setAlignment(TextRender::ALIGN_TOP);
+
+    uint16_t half = textColor.alphaBlend(8*17, backColor).value;
+
+    SECTION("places glyphs by their advance and kerning")
+    {
+        render.drawInRect(geo::Rect(10, 20, 40, 10), "AB", aaFont);
+
+        // the baseline is the ascent below the top
+        REQUIRE(display.pixel(10, 21) == textColor.value);
+        REQUIRE(display.pixel(11, 21) == backColor.value);
+        REQUIRE(display.pixel(12, 21) == textColor.value);
+        REQUIRE(display.pixel(11, 22) == textColor.value);
+        REQUIRE(display.pixel(10, 20) == backColor.value);
+
+        // 'B' follows the advance of 'A' minus the kerning pair
+        REQUIRE(display.pixel(13, 22) == half);
+        REQUIRE(display.pixel(14, 23) == half);
+        REQUIRE(display.pixel(15, 22) == backColor.value);
+    }
+
+    SECTION("aligns each line by its own width")
+    {
+        render.setAlignment(TextRender::ALIGN_CENTER);
+        render.drawInRect(geo::Rect(10, 20, 40, 12), "AB\nB", aaFont);
+
+        // "AB" is 6 wide, "B" is 3 wide
+        REQUIRE(display.pixel(27, 21) == textColor.value);
+        REQUIRE(display.pixel(26, 21) == backColor.value);
+        REQUIRE(display.pixel(28, 27) == half);
+        REQUIRE(display.pixel(29, 28) == half);
+        REQUIRE(display.pixel(27, 27) == backColor.value);
+    }
+
+    SECTION("paints lines with more glyphs than are laid out in advance")
+    {
+        // 44 visible glyphs do not fit the line layout, 20 glyphs do
+        char longLine[45], shortLine[21];
+        memset(longLine, 'A', 44);
+        longLine[44] = '\0';
+        memset(shortLine, 'A', 20);
+        shortLine[20] = '\0';
+
+        HeadlessDisplayController shortDisplay;
+        shortDisplay.clear(screenColor);
+        TextRender shortRender(&shortDisplay, textColor, backColor);
+        shortRender.setAlignment(TextRender::ALIGN_TOP);
+
+        geo::Rect rect(0, 0, 176, 8);
+        render.drawInRect(rect, longLine, aaFont);
+        shortRender.drawInRect(rect, shortLine, aaFont);
+
+        for (int x=0; x<80; x++)
+        {
+            for (int y=0; y<8; y++)
+                REQUIRE(display.pixel(x, y) == shortDisplay.pixel(x, y));
+        }
+
+        REQUIRE(display.pixel(43*4, 1) == textColor.value);
+        REQUIRE(shortDisplay.pixel(43*4, 1) == backColor.value);
+    }
+
+    SECTION("writes each scanline once")
+    {
+        render.drawInRect(geo::Rect(10, 20, 40, 12), "AB\nB", aaFont);
+        REQUIRE(display.WindowChanges() == 1);
+        REQUIRE(display.PixelWrites() == 40*12);
+    }
+}
@@ -0,0 +1,103 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+#include "../touch_filter.h"
+
+using namespace mono;
+
+TEST_CASE("TouchFilter", "[touch_filter]")
+{
+    TouchFilter filter;
+    TouchFilter::Event event;
+
+    SECTION("a touch begins after the press samples")
+    {
+        filter.append(1000, 2000, true, 10);
+        REQUIRE_FALSE(filter.IsTouching());
+        REQUIRE_FALSE(filter.next(event));
+
+        filter.append(1002, 2002, true, 20);
+        REQUIRE(filter.IsTouching());
+        REQUIRE(filter.next(event));
+        REQUIRE(event.type == TouchEvent::TOUCH_BEGIN);
+        REQUIRE(event.x == 1002);
+        REQUIRE(event.y == 2002);
+        REQUIRE(event.time == 20);
+        REQUIRE_FALSE(filter.next(event));
+    }
+
+    SECTION("a single released sample does not end a touch")
+    {
+        filter.append(1000, 2000, true, 0);
+        filter.append(1000, 2000, true, 0);
+        filter.append(0, 0, false, 0);
+        filter.append(1000, 2000, true, 0);
+        REQUIRE(filter.IsTouching());
+
+        filter.append(0, 0, false, 0);
+        filter.append(0, 0, false, 50);
+        REQUIRE_FALSE(filter.IsTouching());
+
+        REQUIRE(filter.next(event));
+        REQUIRE(event.type == TouchEvent::TOUCH_BEGIN);
+        REQUIRE(filter.next(event));
+        REQUIRE(event.type == TouchEvent::TOUCH_END);
+        REQUIRE(event.x == 1000);
+        REQUIRE(event.time == 50);
+    }
+
+    SECTION("the median removes spikes")
+    {
+        filter.append(1000, 2000, true, 0);
+        filter.append(1000, 2000, true, 0);
+        filter.next(event);
+
+        filter.append(3000, 3500, true, 0);
+        filter.append(1000, 2000, true, 0);
+        REQUIRE_FALSE(filter.next(event));
+    }
+
+    SECTION("moves are published past the threshold")
+    {
+        filter.append(1000, 2000, true, 0);
+        filter.append(1000, 2000, true, 0);
+        filter.next(event);
+
+        // small jitter is not a move
+        filter.append(1020, 2010, true, 0);
+        filter.append(1020, 2010, true, 0);
+        REQUIRE_FALSE(filter.next(event));
+
+        for (int i = 0; i < 6; i++)
+            filter.append(1200, 2000, true, 0);
+
+        REQUIRE(filter.next(event));
+        REQUIRE(event.type == TouchEvent::TOUCH_MOVE);
+        REQUIRE(event.x > 1048);
+        REQUIRE(event.x <= 1200);
+    }
+
+    SECTION("a full ring drops moves, not the end")
+    {
+        filter.append(1000, 1000, true, 0);
+        filter.append(1000, 1000, true, 0);
+        for (int i = 1; i < 40; i++)
+        {
+            filter.append(1000 + i*200, 1000, true, 0);
+            filter.append(1000 + i*200, 1000, true, 0);
+        }
+
+        REQUIRE(filter.Pending() == TouchFilter::Capacity - 1);
+        REQUIRE(filter.Dropped() > 0);
+
+        filter.append(0, 0, false, 0);
+        filter.append(0, 0, false, 0);
+        REQUIRE(filter.Pending() == TouchFilter::Capacity);
+
+        TouchEvent::TouchEventType last = TouchEvent::TOUCH_BEGIN;
+        while (filter.next(event))
+            last = event.type;
+        REQUIRE(last == TouchEvent::TOUCH_END);
+    }
+}
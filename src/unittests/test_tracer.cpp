@@ -0,0 +1,85 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../tracer.h"
+#include "../mn_string.h"
+#include <string.h>
+
+using namespace mono;
+
+static String readAll(FILE *file)
+{
+    static char buffer[1024];
+    rewind(file);
+    size_t length = fread(buffer, 1, sizeof(buffer)-1, file);
+    buffer[length] = 0;
+    return String(buffer, length);
+}
+
+TEST_CASE("Tracer", "[tracer]")
+{
+    Tracer::Event events[4];
+    Tracer tracer(events, 4);
+
+    SECTION("records spans and counters in order")
+    {
+        tracer.begin("paint", 100);
+        tracer.counter("dirty", 3, 110);
+        tracer.end("paint", 150);
+
+        REQUIRE(tracer.Count() == 3);
+        REQUIRE(tracer.Overwritten() == 0);
+        REQUIRE(strcmp(tracer.EventAt(0).name, "paint") == 0);
+        REQUIRE(tracer.EventAt(0).type == Tracer::SPAN_BEGIN);
+        REQUIRE(tracer.EventAt(1).type == Tracer::COUNTER);
+        REQUIRE(tracer.EventAt(1).value == 3);
+        REQUIRE(tracer.EventAt(2).type == Tracer::SPAN_END);
+        REQUIRE(tracer.EventAt(2).time == 150);
+    }
+
+    SECTION("overwrites the oldest events when full")
+    {
+        for (uint32_t i=0; i<6; i++)
+            tracer.counter("n", i, i);
+
+        REQUIRE(tracer.Count() == 4);
+        REQUIRE(tracer.Overwritten() == 2);
+        REQUIRE(tracer.EventAt(0).value == 2);
+        REQUIRE(tracer.EventAt(3).value == 5);
+    }
+
+    SECTION("drops events while paused")
+    {
+        tracer.setPaused(true);
+        tracer.begin("a", 1);
+        tracer.setPaused(false);
+        tracer.begin("b", 2);
+
+        REQUIRE(tracer.Count() == 1);
+        REQUIRE(strcmp(tracer.EventAt(0).name, "b") == 0);
+
+        tracer.clear();
+        REQUIRE(tracer.Count() == 0);
+    }
+
+    SECTION("exports Chrome trace JSON relative to the oldest event")
+    {
+        tracer.begin("repaint \"list\"", 0xFFFFFFF0);
+        tracer.counter("views", 2, 0xFFFFFFF8);
+        tracer.end("repaint \"list\"", 0x10);
+
+        FILE *out = tmpfile();
+        REQUIRE(out != 0);
+        tracer.exportChromeTrace(out);
+        String json = readAll(out);
+        fclose(out);
+
+        REQUIRE(strstr(json(), "{\"traceEvents\":[") == json());
+        REQUIRE(strstr(json(), "{\"name\":\"repaint \\\"list\\\"\",\"ph\":\"B\",\"ts\":0,") != 0);
+        REQUIRE(strstr(json(), "\"ph\":\"C\",\"ts\":8,\"pid\":1,\"tid\":1,\"args\":{\"value\":2}") != 0);
+        REQUIRE(strstr(json(), "\"ph\":\"E\",\"ts\":32,") != 0);
+        REQUIRE(strstr(json(), "\"otherData\":{\"overwritten\":0}}") != 0);
+    }
+}
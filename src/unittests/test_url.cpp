@@ -0,0 +1,36 @@
+// This software is part of OpenMono, see http://developer.openmono.com
+// Released under the MIT license, see LICENSE.txt
+
+#include "catch.hpp"
+
+#include "../url.h"
+
+using namespace mono;
+using namespace mono::network;
+
+TEST_CASE("Url encoding")
+{
+    SECTION("escapes reserved characters")
+    {
+        String encoded = Url::urlEncode("a b&c=d");
+        REQUIRE( encoded == "a%20b%26c%3Dd" );
+        REQUIRE( encoded.Length() == 13 );
+    }
+    SECTION("escapes each byte of UTF-8 characters")
+    {
+        String encoded = Url::urlEncode("\xC3\xA6\xE2\x82\xAC");
+        REQUIRE( encoded == "%C3%A6%E2%82%AC" );
+    }
+    SECTION("fills the buffer to its last byte")
+    {
+        // 5 escapes are 15 characters, the inline capacity
+        String encoded = Url::urlEncode("     ");
+        REQUIRE( encoded == "%20%20%20%20%20" );
+        REQUIRE( encoded.Length() == 15 );
+    }
+    SECTION("only the parameters of a url are encoded")
+    {
+        Url url("http://example.com/path?q=a b");
+        REQUIRE( url == "http://example.com/path?q%3Da%20b" );
+    }
+}
@@ -5,10 +5,52 @@
 ## List all (implementation) source files to be tested here
 ##
 UNITTESTS_SOURCES := \
-	sensors/dht.cpp
+	sensors/dht.cpp \
+	mn_string.cpp \
+	ref_count.cpp \
+	regex.cpp \
+	slre.c \
+	url.cpp \
+	media/rgb565_image.cpp \
+	display/sprite_cache.cpp \
+	string_builder.cpp \
+	deferred_call_queue.cpp \
+	block_pool.cpp \
+	heap_monitor.cpp \
+	heap_monitor_wrap.cpp \
+	tracer.cpp \
+	log_sink.cpp \
+	display/color.cpp \
+	display/text_render.cpp \
+	display/headless/headless_display_controller.cpp \
+	display/display_painter.cpp \
+	display/ui/view.cpp \
+	display/ui/animation.cpp \
+	display/ui/responder_view.cpp \
+	display/ui/list_view.cpp \
+	display/ui/text_label_view.cpp \
+	display/ui/icon_view.cpp \
+	display/ui/image_view.cpp \
+	touch_responder.cpp \
+	display/ui/frame_scheduler.cpp \
+	display/ui/easing.cpp \
+	display/ui/layout.cpp \
+	display/ui/hit_test_grid.cpp \
+	display/ui/gesture_recognizer.cpp \
+	touch_filter.cpp \
+	queue.cpp \
+	point.cpp \
+	size.cpp \
+	rect.cpp \
+	circle.cpp
 
 UNITTESTS_PATH := $(FRAMEWORK_PATH)/unittests
 
+# Monitor malloc and friends, so tests can check for HEAP allocations. On the
+# host operator new lives in a shared library, so heap_monitor_wrap.cpp
+# replaces the new and delete operators instead.
+UNITTESTS_LDFLAGS := -Wl,--wrap=malloc,--wrap=free,--wrap=realloc,--wrap=calloc
+
 unittests: $(BUILD_DIR)/unittests
 	$<
 
@@ -16,14 +58,20 @@ unittests-libsources := $(wildcard $(UNITTESTS_PATH)/lib/*.cpp $(UNITTESTS_PATH)
 unittests-libheaders := $(wildcard $(UNITTESTS_PATH)/lib/*.hpp)
 unittests-sources := $(wildcard $(UNITTESTS_PATH)/*.cpp) $(wildcard $(UNITTESTS_PATH)/*.hpp)
 
+# The CMSIS headers, reached through the mbed headers, use the register
+# keyword that C++17 removed. They are vendor headers, so they are included
+# as system headers, without warnings.
 $(BUILD_DIR)/unittests: $(unittests-sources) $(unittests-libsources) $(unittests-libheaders)
 	-mkdir -p $(BUILD_DIR)
-	g++ -Wall -Wno-unused-result \
+	g++ -Wall -Wno-unused-result -DEMUNO \
+		-isystem $(FRAMEWORK_PATH)/cypress/psoc5 \
 		-I $(UNITTESTS_PATH)/lib \
 		$(INCS) \
+		$(UNITTESTS_LDFLAGS) \
 		-o $@ \
+		$(filter %.cpp,$(unittests-libsources)) $(filter %.c,$(unittests-libsources)) \
 		$(foreach SOURCE,$(UNITTESTS_SOURCES),$(FRAMEWORK_PATH)/$(SOURCE)) \
-		$(filter %.cpp,$^) $(filter %.c,$^)
+		$(filter %.cpp,$(unittests-sources))
 
 .PHONY: clean-unittests
 unittests-clean:
@@ -33,14 +33,17 @@ void Url::initWithRaw(String url, bool encode)
         String encodedParams = urlEncode(rawCapure);
         int pathLen = url.Length() - rawCapure.Length();
         int parLen = encodedParams.Length();
-        preAllocbytes(pathLen + parLen + 1);
+        if (!preAllocbytes(pathLen + parLen + 1))
+            return; // HEAP is full
 
         memcpy(stringData, url.stringData, pathLen);
         memcpy(stringData+pathLen, encodedParams.stringData, parLen + 1);
     }
     else
     {
-        preAllocbytes(url.Length() + 1);
+        if (!preAllocbytes(url.Length() + 1))
+            return; // HEAP is full
+
         memcpy(stringData, url.stringData, url.Length()+1);
     }
 }
@@ -95,7 +98,10 @@ String Url::urlEncode(String url)
             newLen += 3;
     }
 
-    String escUrl(newLen);
+    // room for the terminator, that encodeUtf8Byte also writes
+    String escUrl;
+    if (!escUrl.preAllocbytes(newLen + 1))
+        return escUrl; // HEAP is full
 
     int indx = 0;
     int charPos = 0;
@@ -156,7 +162,12 @@ Url Url::Format(const char *format, ...)
     va_list args;
     va_start(args, format);
     uint32_t size = vsnprintf(0, 0, format, args);
-    String str(size+1);
+    String str;
+    if (!str.preAllocbytes(size+1))
+    {
+        va_end(args);
+        return Url(str); // HEAP is full
+    }
 #ifdef __LP64__
     // Workaound for va_start and vsnprintf on 64bit OS X and *nix systems
     // See https://gist.github.com/foobit/4618064
@@ -164,6 +175,7 @@ Url Url::Format(const char *format, ...)
     va_start(args, format);
 #endif
     vsnprintf(str.stringData,size+1, format, args);
+    va_end(args);
 
     return Url(str);
 }
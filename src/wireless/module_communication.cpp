@@ -5,6 +5,7 @@
 #include <mono.h>
 #include <mbed.h>
 #include <consoles.h>
+#include <log_sink.h>
 #include <application_context_interface.h>
 
 extern "C"
@@ -53,25 +54,23 @@ DataReceiveBuffer::DataReceiveBuffer(int size)
 
 void DataReceiveBuffer::alloc(int len)
 {
-    if (this->buffer != 0 && *this->refCount <= 1)
-    {
-        free(this->buffer);
-    }
+    release();
 
     if (len <= 0)
-    {
-        buffer = 0;
-        refCount = 0;
-    }
+        return;
 
-    this->buffer = (uint8_t*) malloc(len+sizeof(int));
+    this->buffer = RefCount::allocateBuffer(len, &this->refCount);
     if (buffer == NULL)
     {
         error("HEAP overflow!\r\n");
     }
+}
 
-    this->refCount = (int*) (this->buffer + len);
-    (*this->refCount) = 1;
+void DataReceiveBuffer::release()
+{
+    RefCount::releaseBuffer(this->buffer, this->refCount);
+    this->buffer = 0;
+    this->refCount = 0;
 }
 
 DataReceiveBuffer::DataReceiveBuffer(const DataReceiveBuffer &other)
@@ -80,30 +79,32 @@ DataReceiveBuffer::DataReceiveBuffer(const DataReceiveBuffer &other)
     this->refCount = other.refCount;
     this->buffer = other.buffer;
     this->bytesToRead = other.bytesToRead;
-    (*this->refCount)++;
+
+    if (this->refCount != 0)
+        this->refCount->retain();
 }
 
 DataReceiveBuffer& DataReceiveBuffer::operator=(const DataReceiveBuffer &other)
 {
+    if (this == &other)
+        return *this;
+
+    release();
+
     this->length = other.length;
     this->refCount = other.refCount;
     this->buffer = other.buffer;
     this->bytesToRead = other.bytesToRead;
-    (*this->refCount)++;
+
+    if (this->refCount != 0)
+        this->refCount->retain();
 
     return *this;
 }
 
 DataReceiveBuffer::~DataReceiveBuffer()
 {
-    if (buffer != 0 && refCount != 0)
-    {
-        (*this->refCount)--;
-        if (*this->refCount <= 0)
-        {
-            free(this->buffer);
-        }
-    }
+    release();
 }
 
 // MARK: SPI Data Buffer
@@ -128,7 +129,7 @@ SPIReceiveDataBuffer& SPIReceiveDataBuffer::operator<<(mbed::SPI *spi)
 {
     if (length < bytesToRead)
     {
-        debug("SPIReceiveDataBuffer read error, buffer is too small!\r\n");
+        MONO_LOG_ERROR(WIRELESS, "SPIReceiveDataBuffer read error, buffer is too small!\r\n");
         return *this;
     }
 
@@ -286,7 +287,7 @@ bool ModuleSPICommunication::readFrameDescriptorHeader(frameDescriptorHeader *bu
     int status = sendC1C2(cmd1, cmd2);
     if (status != CMD_SUCCESS)
     {
-        debug("Failed to fetch frame length header, status: 0x%x!",status);
+        MONO_LOG_ERROR(WIRELESS, "Failed to fetch frame length header, status: 0x%x!",status);
         return false;
     }
 
@@ -302,7 +303,7 @@ bool ModuleSPICommunication::readFrameDescriptorHeader(frameDescriptorHeader *bu
 
     if (retval != true)
     {
-        debug("Failed to fetch frame length header");
+        MONO_LOG_ERROR(WIRELESS, "Failed to fetch frame length header");
         return false;
     }
 
@@ -535,7 +536,7 @@ uint8_t ModuleSPICommunication::readRegister(SpiRegisters reg)
 
     if (retval != CMD_SUCCESS)
     {
-        debug("Failed to sent ReadRegister command to module!\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Failed to sent ReadRegister command to module!\r\n");
         return 0;
     }
 
@@ -549,7 +550,7 @@ uint8_t ModuleSPICommunication::readRegister(SpiRegisters reg)
         setChipSelect(false);
     }
     else
-        debug("Register read failed\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Register read failed\r\n");
 
     return retval;
 }
@@ -571,7 +572,7 @@ uint16 ModuleSPICommunication::readMemory(uint32_t memoryAddress)
 
     if (retval != CMD_SUCCESS)
     {
-        debug("Failed to sent ReadMemory command to module!");
+        MONO_LOG_ERROR(WIRELESS, "Failed to sent ReadMemory command to module!");
         return 0;
     }
 
@@ -597,7 +598,7 @@ uint16 ModuleSPICommunication::readMemory(uint32_t memoryAddress)
         setChipSelect(false);
     }
     else
-        debug("Memory read failed\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Memory read failed\r\n");
 
     return retval;
 }
@@ -619,7 +620,7 @@ void ModuleSPICommunication::writeMemory(uint32_t memoryAddress, uint16_t value)
 
     if (retval != CMD_SUCCESS)
     {
-        debug("Failed to sent WriteMemory command to module!\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Failed to sent WriteMemory command to module!\r\n");
         return;
     }
 
@@ -633,7 +634,7 @@ void ModuleSPICommunication::writeMemory(uint32_t memoryAddress, uint16_t value)
 
     if (retval != CMD_SUCCESS)
     {
-        debug("Failed to WriteMemory address to module!\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Failed to WriteMemory address to module!\r\n");
         setChipSelect(false);
         return;
     }
@@ -645,7 +646,7 @@ void ModuleSPICommunication::writeMemory(uint32_t memoryAddress, uint16_t value)
     setChipSelect(false);
 
     if (retval != CMD_SUCCESS)
-        debug("Failed to WriteMemory value to module!\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Failed to WriteMemory value to module!\r\n");
 }
 
 
@@ -687,7 +688,7 @@ bool ModuleSPICommunication::readManagementFrameResponse(DataReceiveBuffer &buff
     if (!bufferIsMgmtFrame(buffer))
     {
         memdump(buffer.buffer, buffer.length);
-        debug("Frame is not a management frame!\r\n");
+        MONO_LOG_WARNING(WIRELESS, "Frame is not a management frame!\r\n");
         return false;
     }
 
@@ -696,13 +697,13 @@ bool ModuleSPICommunication::readManagementFrameResponse(DataReceiveBuffer &buff
     //check that the frame is a correct response to the request
     if (rawFrame->CommandId != request.commandId)
     {
-        debug("Read frame response. Wrong resp command Id. Was 0x%x expected 0x%x\r\n",rawFrame->CommandId,request.commandId);
+        MONO_LOG_WARNING(WIRELESS, "Read frame response. Wrong resp command Id. Was 0x%x expected 0x%x\r\n",rawFrame->CommandId,request.commandId);
         return false;
     }
 
     if (rawFrame->status != 0)
     {
-        debug("Error response for command: 0x%x. Error code: 0x%x\r\n",rawFrame->CommandId,rawFrame->status);
+        MONO_LOG_ERROR(WIRELESS, "Error response for command: 0x%x. Error code: 0x%x\r\n",rawFrame->CommandId,rawFrame->status);
     }
     // check for payload
     else if (request.responsePayload && (rawFrame->LengthType & 0xFFF) > 0)
@@ -712,7 +713,7 @@ bool ModuleSPICommunication::readManagementFrameResponse(DataReceiveBuffer &buff
     }
     else if (request.responsePayload)
     {
-        debug("command frame request expected a response payload, but response is empty!\r\n");
+        MONO_LOG_WARNING(WIRELESS, "command frame request expected a response payload, but response is empty!\r\n");
         return false;
     }
 
@@ -742,7 +743,7 @@ bool ModuleSPICommunication::readDataFrame(DataReceiveBuffer &buffer, DataPayloa
     }
     else
     {
-        debug("Data frame with no payload!\t\n");
+        MONO_LOG_WARNING(WIRELESS, "Data frame with no payload!\t\n");
     }
 
     return true;
@@ -755,7 +756,7 @@ bool ModuleSPICommunication::writeRawFrame(const uint8_t *rawFrame)
 
     if (regval != 0)
     {
-        debug("Cannot write frame to module, input buffer is full!\r\n");
+        MONO_LOG_WARNING(WIRELESS, "Cannot write frame to module, input buffer is full!\r\n");
         return false;
     }
 
@@ -774,7 +775,7 @@ bool ModuleSPICommunication::writeRawFrame(const uint8_t *rawFrame)
     int statusCode = sendC1C2(cmd1, c2);
     if (statusCode != CMD_SUCCESS)
     {
-        debug("Failed to write frame to module, error status: 0x%x\r\n", statusCode);
+        MONO_LOG_ERROR(WIRELESS, "Failed to write frame to module, error status: 0x%x\r\n", statusCode);
         return false;
     }
 
@@ -789,7 +790,7 @@ bool ModuleSPICommunication::writeRawFrame(const uint8_t *rawFrame)
 
     if (statusCode != CMD_SUCCESS)
     {
-        debug("Failed to send length of frame to module, got response: 0x%x\r\n",statusCode);
+        MONO_LOG_ERROR(WIRELESS, "Failed to send length of frame to module, got response: 0x%x\r\n",statusCode);
         return false;
     }
 
@@ -798,7 +799,7 @@ bool ModuleSPICommunication::writeRawFrame(const uint8_t *rawFrame)
 
     if (statusCode != CMD_SUCCESS)
     {
-        debug("Failed to send raw frame to module, got response: 0x%x\r\n",statusCode);
+        MONO_LOG_ERROR(WIRELESS, "Failed to send raw frame to module, got response: 0x%x\r\n",statusCode);
         return false;
     }
 
@@ -848,7 +849,7 @@ bool ModuleSPICommunication::writeFrame(ManagementFrame *frame)
     // but this size might be too large for embedded memory sizes
     if (payLen > 872)
     {
-        debug("Frame payload data is too large! More than 872 bytes!\r\n");
+        MONO_LOG_WARNING(WIRELESS, "Frame payload data is too large! More than 872 bytes!\r\n");
         return false;
     }
 
@@ -872,7 +873,7 @@ bool ModuleSPICommunication::writePayloadData(const uint8_t *data, uint16_t byte
 {
     if (force4byte && byteLength != (byteLength & ~3))
     {
-        debug("Data Frame payload data is not 4-byte aligned!\r\n");
+        MONO_LOG_WARNING(WIRELESS, "Data Frame payload data is not 4-byte aligned!\r\n");
         return false;
     }
 
@@ -892,7 +893,7 @@ bool ModuleSPICommunication::writePayloadData(const uint8_t *data, uint16_t byte
 
     if (statusCode != CMD_SUCCESS)
     {
-        debug("Failed to write data to module, error status: 0x%x\r\n", statusCode);
+        MONO_LOG_ERROR(WIRELESS, "Failed to write data to module, error status: 0x%x\r\n", statusCode);
         return false;
     }
 
@@ -907,7 +908,7 @@ bool ModuleSPICommunication::writePayloadData(const uint8_t *data, uint16_t byte
 
     if (statusCode != CMD_SUCCESS)
     {
-        debug("Failed to send length of data to module, got response: 0x%x\r\n", statusCode);
+        MONO_LOG_ERROR(WIRELESS, "Failed to send length of data to module, got response: 0x%x\r\n", statusCode);
         return false;
     }
 
@@ -916,7 +917,7 @@ bool ModuleSPICommunication::writePayloadData(const uint8_t *data, uint16_t byte
 
     if (statusCode != CMD_SUCCESS)
     {
-        debug("Failed to transfer data frame payload data, got response: 0x%x\r\n", statusCode);
+        MONO_LOG_ERROR(WIRELESS, "Failed to transfer data frame payload data, got response: 0x%x\r\n", statusCode);
         return false;
     }
 
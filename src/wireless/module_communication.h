@@ -16,6 +16,7 @@
 #include "module_frames.h"
 #include <power_aware_interface.h>
 #include <managed_pointer.h>
+#include <ref_count.h>
 
 #include <stdint.h>
 
@@ -37,11 +38,12 @@ namespace mono { namespace redpine {
     protected:
 
         void alloc(int len);
+        void release();
 
     public:
 
-        /** Whould free memory buffer on dealloc */
-        int *refCount;
+        /** The shared reference count of the buffer, in the same allocation */
+        RefCount *refCount;
 
         /** The pointer to the buffer */
         uint8_t *buffer;
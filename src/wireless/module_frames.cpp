@@ -3,6 +3,8 @@
 
 #include "module_frames.h"
 #include "redpine_module.h"
+#include <async.h>
+#include <tracer.h>
 #include <consoles.h>
 #include <mbed.h>
 
@@ -31,6 +33,33 @@ ModuleFrame::~ModuleFrame()
     }
 }
 
+// MARK: Frame allocation
+
+// Small blocks for command contexts, and two sizes of frames. HTTP post
+// frames are larger than the largest block, and use the HEAP.
+static mono::BlockPool contextPool(32, 8);
+static mono::BlockPool framePool(160, 6);
+static mono::BlockPool largeFramePool(320, 2);
+static mono::BlockPool *framePools[] = { &contextPool, &framePool, &largeFramePool };
+static mono::SizeClassPool frameAllocator(framePools, 3);
+
+void *ModuleFrame::operator new(size_t size)
+{
+    return frameAllocator.allocate(size);
+}
+
+void ModuleFrame::operator delete(void *ptr)
+{
+    frameAllocator.deallocate(ptr);
+}
+
+mono::SizeClassPool &ModuleFrame::FrameAllocator()
+{
+    return frameAllocator;
+}
+
+// MARK: Management Frame
+
 ManagementFrame::ManagementFrame() : ModuleFrame()
 {
     this->length = 0;
@@ -97,6 +126,8 @@ ManagementFrame &ManagementFrame::operator=(const mono::redpine::ManagementFrame
 
 bool ManagementFrame::commit()
 {
+    MONO_TRACE_SCOPE("ManagementFrame::commit");
+
     if (this->direction != TX_FRAME)
     {
         mono::Error << "You cannot send a RX frame to the module!\r\n";
@@ -166,7 +197,7 @@ void ManagementFrame::commitAsync()
     module->requestFrameQueue.enqueue(this);
 
 
-    Timer::callOnce<Module>(0, module, &Module::moduleEventHandler);
+    async<Module>(module, &Module::moduleEventHandler);
 }
 
 void ManagementFrame::abort()
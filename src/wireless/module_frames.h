@@ -6,6 +6,7 @@
 
 #include <mbed.h>
 #include <queue.h>
+#include <block_pool.h>
 
 namespace mono { namespace redpine {
 
@@ -132,7 +133,26 @@ namespace mono { namespace redpine {
          * be removed gracefully.
          */
         virtual ~ModuleFrame();
-        
+
+        /**
+         * @brief Frames created with `new` are allocated from @ref FrameAllocator
+         *
+         * This avoids HEAP fragmentation from the many short lived frames,
+         * when connecting and disconnecting over long uptimes.
+         */
+        static void *operator new(size_t size);
+
+        /** @brief Return the frame memory to @ref FrameAllocator */
+        static void operator delete(void *ptr);
+
+        /**
+         * @brief The size class pools for frames and their command contexts
+         *
+         * Frames that do not fit a pool, or are allocated while the pools are
+         * exhausted, are allocated on the HEAP. Use the pool statistics to
+         * see if the pool sizes fit your application.
+         */
+        static SizeClassPool &FrameAllocator();
     };
     
     
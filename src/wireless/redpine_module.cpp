@@ -3,6 +3,7 @@
 
 #include "redpine_module.h"
 #include <consoles.h>
+#include <log_sink.h>
 #include <mbed.h>
 
 #include <application_context_interface.h>
@@ -32,7 +33,7 @@ bool Module::initialize(ModuleCommunication *commInterface)
 
     if (commInterface == NULL)
     {
-        debug("Cannot init Redpine Module without comm. interface!\r\n");
+        MONO_LOG_WARNING(WIRELESS, "Cannot init Redpine Module without comm. interface!\r\n");
         return false;
     }
 
@@ -50,7 +51,7 @@ bool Module::initialize(ModuleCommunication *commInterface)
 
     if (!success)
     {
-        debug("Initialize failed to init communication interface\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Initialize failed to init communication interface\r\n");
         return false;
     }
 
@@ -58,7 +59,7 @@ bool Module::initialize(ModuleCommunication *commInterface)
 
     //debug("Checking bootloader state...\r\n");
     uint16_t regval = self->comIntf->readMemory(HOST_INTF_REG_OUT);
-    debug("HOST_INTF_REG_OUT: 0x%x\r\n", regval);
+    MONO_LOG_DEBUG(WIRELESS, "HOST_INTF_REG_OUT: 0x%x\r\n", regval);
 
     if ((regval & HOST_INTERACT_REG_VALID) == 0xAB00)
     {
@@ -78,7 +79,7 @@ bool Module::initialize(ModuleCommunication *commInterface)
 
     if (timeout >= 50)
     {
-        debug("Timeout: Did not receive Card ready!\r\n");
+        MONO_LOG_ERROR(WIRELESS, "Timeout: Did not receive Card ready!\r\n");
         return false;
     }
 
@@ -89,7 +90,7 @@ bool Module::initialize(ModuleCommunication *commInterface)
 
     if (!success)
     {
-        debug("failed to read card ready!");
+        MONO_LOG_ERROR(WIRELESS, "failed to read card ready!");
         return false;
     }
 
@@ -104,8 +105,8 @@ bool Module::initialize(ModuleCommunication *commInterface)
     }
     else
     {
-        debug("Initialization failed on receiving card ready\r\n");
-        debug("Initialization got 0x%x, not card ready\r\n",frame.commandId);
+        MONO_LOG_ERROR(WIRELESS, "Initialization failed on receiving card ready\r\n");
+        MONO_LOG_DEBUG(WIRELESS, "Initialization got 0x%x, not card ready\r\n",frame.commandId);
         return false;
     }
 
@@ -118,7 +119,7 @@ bool Module::setupWifiOnly(String ssid, String passphrase, WifiSecurityModes sec
 
     if (!self->communicationInitialized)
     {
-        debug("Module not initialized. You must initialize first!");
+        MONO_LOG_WARNING(WIRELESS, "Module not initialized. You must initialize first!");
         return false;
     }
 
@@ -192,7 +193,7 @@ bool Module::discardIfNeeded(ManagementFrame *respFrame)
     }
     else
     {
-        debug("leaving frame 0x%x\r\n",respFrame->commandId);
+        MONO_LOG_DEBUG(WIRELESS, "leaving frame 0x%x\r\n",respFrame->commandId);
         return false;
     }
 }
@@ -212,17 +213,17 @@ void Module::moduleEventHandler()
             DataReceiveBuffer buffer;
             if (respFrame == 0 && defaultDataFramePayloadHandler != 0)
             {
-                debug("nothing on request queue, probing frame...\r\n");
+                MONO_LOG_DEBUG(WIRELESS, "nothing on request queue, probing frame...\r\n");
                 bool success = comIntf->readFrame(buffer);
 
                 if (success && comIntf->bufferIsDataFrame(buffer))
                 {
-                    debug("parsing as as data frame...\r\n");
+                    MONO_LOG_DEBUG(WIRELESS, "parsing as as data frame...\r\n");
                     success = comIntf->readDataFrame(buffer, *defaultDataFramePayloadHandler);
                 }
                 else if (success && comIntf->bufferIsMgmtFrame(buffer))
                 {
-                    debug("parsing as as async mgmt frame...\r\n");
+                    MONO_LOG_DEBUG(WIRELESS, "parsing as as async mgmt frame...\r\n");
                     ManagementFrame *resp;
                     success = initAsyncFrame(buffer, &resp);
                     if (success && asyncManagementFrameHandler != 0)
@@ -241,12 +242,12 @@ void Module::moduleEventHandler()
 
                 if (!success)
                 {
-                    debug("failed to handle incoming frame!\r\n");
+                    MONO_LOG_ERROR(WIRELESS, "failed to handle incoming frame!\r\n");
                 }
             }
             else
             {
-                debug("resp frame cmd id: 0x%x\r\n",respFrame->commandId);
+                MONO_LOG_DEBUG(WIRELESS, "resp frame cmd id: 0x%x\r\n",respFrame->commandId);
                 bool success = comIntf->readFrame(buffer);
 
                 if (success)
@@ -255,7 +256,7 @@ void Module::moduleEventHandler()
                 }
 
                 if (!success) {
-                    debug("failed to handle incoming response for resp queue head\r\n");
+                    MONO_LOG_ERROR(WIRELESS, "failed to handle incoming response for resp queue head\r\n");
                     respFrame->status = 1;
                     discardIfNeeded(respFrame);
                 }
@@ -278,7 +279,7 @@ void Module::moduleEventHandler()
 
             if (!success)
             {
-                debug("Failed to send MgmtFrame (0x%x) to module\r\n",request->commandId);
+                MONO_LOG_ERROR(WIRELESS, "Failed to send MgmtFrame (0x%x) to module\r\n",request->commandId);
                 request->status = 1;
                 request->triggerCompletionHandler();
 
@@ -306,7 +307,7 @@ bool Module::initAsyncFrame(const DataReceiveBuffer &buffer, ManagementFrame **f
             break;
         case ModuleFrame::AsyncConnAcceptReq:
         default:
-            debug("Redpine rx command (0x%X) not supported!\r\n", raw->CommandId);
+            MONO_LOG_WARNING(WIRELESS, "Redpine rx command (0x%X) not supported!\r\n", raw->CommandId);
             frame = 0;
             return false;
             break;
@@ -335,7 +336,7 @@ void Module::onNetworkReady(ManagementFrame::FrameCompletionData *data)
         memcpy(this->gateway, ip->gateway, 4);
         memcpy(this->macAddress, ip->macAddress, 6);
 
-        debug("Network Ready!\r\n");
+        MONO_LOG_INFO(WIRELESS, "Network Ready!\r\n");
         networkInitialized = true;
 
         if (networkReadyHandler) {
@@ -353,11 +354,11 @@ void Module::onJoinNetworkComplete(ManagementFrame::FrameCompletionData *data)
         if (!data->Success)
         {
             joinFailed = true;
-            debug("Failed joining Network!\r\n");
+            MONO_LOG_ERROR(WIRELESS, "Failed joining Network!\r\n");
             connectFailedHandler.call();
         }
         else {
-            debug("Joined Wifi Network!\r\n");
+            MONO_LOG_DEBUG(WIRELESS, "Joined Wifi Network!\r\n");
         }
     }
 }
@@ -367,7 +368,7 @@ void Module::handleSleepWakeUp()
 
     if (!(CurrentPowerState & (ULTRA_LOW_SLEEP | LOW_SLEEP)))
     {
-        debug("Module not in sleep!\r\n");
+        MONO_LOG_DEBUG(WIRELESS, "Module not in sleep!\r\n");
         return;
     }
 
@@ -383,19 +384,19 @@ void Module::handleSleepWakeUp()
 
         if (frame.commandId == ManagementFrame::WakeFromSleep)
         {
-            debug("putting to sleep again!\r\n");
+            MONO_LOG_DEBUG(WIRELESS, "putting to sleep again!\r\n");
             ManagementFrame sleepAgain(ManagementFrame::PowerSaveACK);
             sleepAgain.commit();
 
         }
         else
         {
-            debug("Unkown commandID for handleSleepWakeUp: 0x%x\r\n",frame.commandId);
+            MONO_LOG_DEBUG(WIRELESS, "Unkown commandID for handleSleepWakeUp: 0x%x\r\n",frame.commandId);
         }
     }
     else
     {
-        debug("nothing in input poll queue\r\n");
+        MONO_LOG_DEBUG(WIRELESS, "nothing in input poll queue\r\n");
     }
 }
 